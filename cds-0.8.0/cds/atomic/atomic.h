@@ -460,6 +460,30 @@ namespace cds {
                 return m_Counter.dec( order ) ;
             }
 
+            /// Adds \p n to the counter. Semantics: postaddition
+            size_t add( size_t n, memory_order order = INC_ORDER::order )
+            {
+                return m_Counter.xadd( n, order )   ;
+            }
+
+            /// Subtracts \p n from the counter. Semantics: postsubtraction
+            size_t sub( size_t n, memory_order order = INC_ORDER::order )
+            {
+                return m_Counter.xadd( 0-n, order ) ;
+            }
+
+            /// Addition. Returns new value
+            size_t operator +=( size_t n )
+            {
+                return add( n ) + n ;
+            }
+
+            /// Substraction. Returns new value
+            size_t operator -=( size_t n )
+            {
+                return sub( n ) - n ;
+            }
+
             /// Preincrement
             size_t operator ++()
             {
@@ -525,6 +549,30 @@ namespace cds {
                 return 0    ;
             }
 
+            /// Dummy addition. Always returns 0
+            size_t add( size_t /*n*/, memory_order /*order*/ = membar_relaxed::order )
+            {
+                return 0    ;
+            }
+
+            /// Dummy subtraction. Always returns 0
+            size_t sub( size_t /*n*/, memory_order /*order*/ = membar_relaxed::order )
+            {
+                return 0    ;
+            }
+
+            /// Dummy addition. Always returns 0
+            size_t operator +=( size_t /*n*/ )
+            {
+                return 0    ;
+            }
+
+            /// Dummy substraction. Always returns 0
+            size_t operator -=( size_t /*n*/ )
+            {
+                return 0    ;
+            }
+
             /// Dummy pre-increment. Always returns 0
             size_t operator ++()
             {
@@ -223,7 +223,7 @@ namespace cds {
             SBag(T sentinel)
                 : SENTINEL ( sentinel )
             {
-                assert( m_nHazardPointerCount <= gc::hrc::GarbageCollector::instance().getHazardPointerCount() )    ;
+                assert( m_nHazardPointerCount <= gc::hrc::GarbageCollector::instance().getMaxHazardPointerCount() )    ;
 
                 for (int i = 0; i < NR_THREADS; i++)
                     m_pGlobalHeadBlock[i] = NULL;
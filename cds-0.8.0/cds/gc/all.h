@@ -11,5 +11,7 @@
 #include <cds/gc/no_gc.h>
 #include <cds/gc/hrc_gc.h>
 #include <cds/gc/hzp_gc.h>
-#include <cds/gc/ptb_gc.h>
+#include <cds/gc/ptb_gc.h>
+#include <cds/gc/epoch_gc.h>
+#include <cds/gc/ibr_gc.h>
 #include <cds/gc/tagged_gc.h>
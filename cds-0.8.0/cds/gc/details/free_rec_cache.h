@@ -0,0 +1,96 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_DETAILS_FREE_REC_CACHE_H
+#define __CDS_GC_DETAILS_FREE_REC_CACHE_H
+
+#include <cds/atomic.h>
+#include <boost/noncopyable.hpp>
+
+namespace cds { namespace gc { namespace details {
+
+    /// Cache of recently released thread records
+    /**
+        HZP and HRC GC keep the per-thread records in the list that only grows; a detached thread
+        marks its record as free and the record is reused by the next attaching thread.
+        Without the cache the attaching thread walks the whole list to find a free record,
+        so the attach cost is proportional to the count of threads ever attached.
+
+        The cache is a small array of pointers to released records. \ref put stores the record
+        into the next slot in round-robin order, \ref get takes any non-empty slot.
+        The cache is only a hint: the caller must claim the record returned (usually by CAS of the owner id)
+        and must fall back to the list walk if the claim fails. Since the records are never deleted
+        while the GC exists, a stale pointer in the cache is harmless.
+
+        The record reused keeps its buffers: the array of retired pointers with the retired pointers
+        left by previous owner, the scan buffer and the hazard pointer blocks.
+        So the thread that attaches and detaches frequently does not allocate memory at all.
+
+        Template arguments:
+        \li \p T - record type
+        \li \p CAPACITY - count of slots
+    */
+    template <typename T, size_t CAPACITY = 16>
+    class free_record_cache: boost::noncopyable
+    {
+        //@cond
+        atomic<T *>     m_arr[CAPACITY] ;   ///< cached records, NULL - empty slot
+        atomic<size_t>  m_nPut          ;   ///< put counter
+        //@endcond
+
+    public:
+        /// Capacity of the cache
+        static const size_t c_nCapacity = CAPACITY  ;
+
+    public:
+        //@cond
+        free_record_cache()
+            : m_nPut( 0 )
+        {
+            for ( size_t i = 0; i < c_nCapacity; ++i )
+                m_arr[i].template store<membar_relaxed>( (T *) NULL )  ;
+        }
+        //@endcond
+
+        /// Puts the record \p p released into the cache
+        /**
+            If the slot is occupied the record stored in it is displaced; the displaced record
+            can be found by the list walk only.
+        */
+        void put( T * p )
+        {
+            size_t nSlot = m_nPut.xadd<membar_relaxed>( 1 ) % c_nCapacity   ;
+            m_arr[nSlot].template store<membar_release>( p )    ;
+        }
+
+        /// Takes a record from the cache. Returns \p NULL if the cache is empty
+        T * get()
+        {
+            for ( size_t i = 0; i < c_nCapacity; ++i ) {
+                if ( m_arr[i].template load<membar_relaxed>() != NULL ) {
+                    T * p = m_arr[i].template xchg<membar_acq_rel>( (T *) NULL ) ;
+                    if ( p )
+                        return p    ;
+                }
+            }
+            return NULL ;
+        }
+
+        /// Clears the cache. The function is not thread-safe
+        void clear()
+        {
+            for ( size_t i = 0; i < c_nCapacity; ++i )
+                m_arr[i].template store<membar_relaxed>( (T *) NULL )  ;
+        }
+    };
+
+}}} // namespace cds::gc::details
+
+#endif // #ifndef __CDS_GC_DETAILS_FREE_REC_CACHE_H
@@ -0,0 +1,327 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_DETAILS_RECLAIMER_H
+#define __CDS_GC_DETAILS_RECLAIMER_H
+
+#include <cds/atomic.h>
+#include <cds/os/thread.h>
+#include <cds/lock/spinlock.h>
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+#if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+namespace cds { namespace gc { namespace details {
+
+    /// Background reclamation thread
+    /**
+        By default the GC scans hazard pointers and frees retired objects in the context of the worker thread
+        that has filled its array of retired pointers. The scan takes a long time compared to an
+        ordinary container operation, so the operation that triggers the scan has a latency spike.
+
+        The reclaimer is a dedicated thread that does the scan instead of the worker thread.
+        The worker hands its full array of retired pointers off to the reclaimer (see \ref retired_batch_queue)
+        and calls \ref wakeup; the reclaimer thread calls \ref reclaim until there is no more work.
+
+        The derived class implements:
+        \li \p onStart - called in the reclaimer thread before the first \ref reclaim call,
+            usually it attaches the thread to the GC
+        \li \p reclaim - does the work handed off by worker threads
+        \li \p onStop - called in the reclaimer thread after the last \ref reclaim call
+
+        \ref stop must be called before the destructor of the derived class.
+    */
+    class reclaimer: boost::noncopyable
+    {
+        //@cond
+        atomic<bool>            m_bSignaled ;   ///< true - there is a work for the reclaimer
+        atomic<bool>            m_bStop     ;   ///< true - the reclaimer thread should terminate
+        atomic<cds::OS::ThreadId>   m_idThread  ;   ///< Reclaimer thread id
+        bool                    m_bStarted  ;   ///< true - the thread has been started
+
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+        HANDLE                  m_hThread   ;
+        HANDLE                  m_hEvent    ;
+#   else
+        pthread_t               m_hThread   ;
+        pthread_mutex_t         m_Mutex     ;
+        pthread_cond_t          m_Cond      ;
+#   endif
+        //@endcond
+
+    protected:
+        /// Called in the reclaimer thread before the first \ref reclaim call
+        virtual void onStart()  {}
+        /// Does the work handed off by worker threads
+        virtual void reclaim() = 0  ;
+        /// Called in the reclaimer thread after the last \ref reclaim call
+        virtual void onStop()   {}
+
+    public:
+        //@cond
+        reclaimer()
+            : m_bSignaled( false )
+            , m_bStop( false )
+            , m_idThread( cds::OS::nullThreadId() )
+            , m_bStarted( false )
+        {
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+            m_hThread = NULL    ;
+            m_hEvent = ::CreateEvent( NULL, FALSE, FALSE, NULL )    ;
+#   else
+            pthread_mutex_init( &m_Mutex, NULL ) ;
+            pthread_cond_init( &m_Cond, NULL )   ;
+#   endif
+        }
+
+        virtual ~reclaimer()
+        {
+            assert( !m_bStarted )   ;
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+            ::CloseHandle( m_hEvent )   ;
+#   else
+            pthread_cond_destroy( &m_Cond )      ;
+            pthread_mutex_destroy( &m_Mutex )    ;
+#   endif
+        }
+        //@endcond
+
+        /// Starts the reclaimer thread. Returns \p false if the thread cannot be created
+        bool start()
+        {
+            assert( !m_bStarted )   ;
+            m_bStop.store<membar_relaxed>( false )  ;
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+            m_hThread = ::CreateThread( NULL, 0, thread_func, this, 0, NULL )   ;
+            m_bStarted = m_hThread != NULL  ;
+#   else
+            m_bStarted = pthread_create( &m_hThread, NULL, thread_func, this ) == 0 ;
+#   endif
+            return m_bStarted   ;
+        }
+
+        /// Stops the reclaimer thread
+        /**
+            The function waits while the reclaimer thread does the last \ref reclaim call and terminates.
+        */
+        void stop()
+        {
+            if ( !m_bStarted )
+                return  ;
+            m_bStop.store<membar_release>( true )   ;
+            signal()    ;
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+            ::WaitForSingleObject( m_hThread, INFINITE )    ;
+            ::CloseHandle( m_hThread )  ;
+            m_hThread = NULL    ;
+#   else
+            pthread_join( m_hThread, NULL ) ;
+#   endif
+            m_bStarted = false  ;
+        }
+
+        /// Wakes the reclaimer thread up
+        /**
+            The reclaimer thread calls \ref reclaim at least once after \p wakeup.
+            The function does a system call only if the reclaimer thread has not been signaled yet.
+        */
+        void wakeup()
+        {
+            if ( !m_bSignaled.exchange<membar_seq_cst>( true ) )
+                signal()    ;
+        }
+
+        /// Checks if the current thread is the reclaimer thread
+        /**
+            The GC uses this function to prevent hand-off from the reclaimer thread to itself.
+        */
+        bool isReclaimerThread() const
+        {
+            return m_idThread.load<membar_relaxed>() == cds::OS::getCurrentThreadId()  ;
+        }
+
+    private:
+        //@cond
+        void signal()
+        {
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+            ::SetEvent( m_hEvent )  ;
+#   else
+            pthread_mutex_lock( &m_Mutex )  ;
+            pthread_cond_signal( &m_Cond )  ;
+            pthread_mutex_unlock( &m_Mutex );
+#   endif
+        }
+
+        bool wait()
+        {
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+            while ( !m_bSignaled.load<membar_acquire>() && !m_bStop.load<membar_acquire>() )
+                ::WaitForSingleObject( m_hEvent, INFINITE ) ;
+#   else
+            pthread_mutex_lock( &m_Mutex )  ;
+            while ( !m_bSignaled.load<membar_acquire>() && !m_bStop.load<membar_acquire>() )
+                pthread_cond_wait( &m_Cond, &m_Mutex )  ;
+            pthread_mutex_unlock( &m_Mutex );
+#   endif
+            return !m_bStop.load<membar_acquire>()  ;
+        }
+
+        void run()
+        {
+            m_idThread.store<membar_release>( cds::OS::getCurrentThreadId() )   ;
+            onStart()   ;
+            bool bContinue ;
+            do {
+                bContinue = wait()  ;
+                // Reset the signal before reclaiming: a hand-off after this point wakes us again
+                m_bSignaled.exchange<membar_seq_cst>( false )   ;
+                reclaim()   ;
+            } while ( bContinue ) ;
+            onStop()    ;
+            m_idThread.store<membar_release>( cds::OS::nullThreadId() )   ;
+        }
+
+#   if CDS_OS_INTERFACE == CDS_OSI_WINDOWS
+        static DWORD WINAPI thread_func( LPVOID pArg )
+        {
+            reinterpret_cast<reclaimer *>( pArg )->run()   ;
+            return 0    ;
+        }
+#   else
+        static void * thread_func( void * pArg )
+        {
+            reinterpret_cast<reclaimer *>( pArg )->run()   ;
+            return NULL ;
+        }
+#   endif
+        //@endcond
+    };
+
+    /// Queue of retired batches handed off to the reclaimer
+    /**
+        A worker thread gets an empty batch by \ref alloc, fills it by its retired objects
+        and passes it to the reclaimer by \ref post. The reclaimer gets the batch by \ref fetch
+        and returns it for reuse by \ref recycle. Batches are reused, so after warm-up
+        the hand-off does not allocate memory.
+
+        The queue length is limited by \p nMaxBacklog batches: if the reclaimer falls behind,
+        \ref alloc returns \p NULL and the worker should reclaim inline. It bounds the memory
+        held by the pending retired objects.
+
+        Template parameter \p T is the type of retired object.
+    */
+    template <typename T>
+    class retired_batch_queue: boost::noncopyable
+    {
+    public:
+        /// Batch of retired objects
+        struct batch {
+            batch *         m_pNext ;   ///< next batch in the list
+            std::vector<T>  m_arr   ;   ///< retired objects
+        };
+
+    private:
+        //@cond
+        cds::lock::Spin     m_Lock          ;   ///< Access to the lists
+        batch *             m_pPendingHead  ;   ///< first posted batch
+        batch *             m_pPendingTail  ;   ///< last posted batch
+        batch *             m_pFree         ;   ///< list of free batches
+        size_t              m_nBacklog      ;   ///< count of allocated and not yet recycled batches
+        const size_t        m_nMaxBacklog   ;   ///< max backlog
+        const size_t        m_nCapacity     ;   ///< batch capacity
+        //@endcond
+
+    public:
+        /// Constructs the queue of batches of capacity \p nCapacity
+        retired_batch_queue( size_t nCapacity, size_t nMaxBacklog )
+            : m_pPendingHead( NULL )
+            , m_pPendingTail( NULL )
+            , m_pFree( NULL )
+            , m_nBacklog( 0 )
+            , m_nMaxBacklog( nMaxBacklog )
+            , m_nCapacity( nCapacity )
+        {}
+
+        /// Destroys all batches. The pending batches must be fetched before
+        ~retired_batch_queue()
+        {
+            assert( m_pPendingHead == NULL )    ;
+            while ( m_pFree ) {
+                batch * p = m_pFree ;
+                m_pFree = p->m_pNext    ;
+                delete p    ;
+            }
+        }
+
+        /// Returns an empty batch or \p NULL if the backlog is full
+        batch * alloc()
+        {
+            batch * p   ;
+            {
+                cds::lock::AutoSpin al( m_Lock )    ;
+                if ( m_nBacklog >= m_nMaxBacklog )
+                    return NULL ;
+                ++m_nBacklog    ;
+                p = m_pFree ;
+                if ( p )
+                    m_pFree = p->m_pNext    ;
+            }
+            if ( !p ) {
+                p = new batch   ;
+                p->m_arr.reserve( m_nCapacity ) ;
+            }
+            p->m_pNext = NULL   ;
+            return p    ;
+        }
+
+        /// Passes the batch \p p to the reclaimer
+        void post( batch * p )
+        {
+            cds::lock::AutoSpin al( m_Lock )    ;
+            if ( m_pPendingTail )
+                m_pPendingTail->m_pNext = p ;
+            else
+                m_pPendingHead = p  ;
+            m_pPendingTail = p  ;
+        }
+
+        /// Gets the first posted batch or \p NULL if no batch is posted
+        batch * fetch()
+        {
+            cds::lock::AutoSpin al( m_Lock )    ;
+            batch * p = m_pPendingHead  ;
+            if ( p ) {
+                m_pPendingHead = p->m_pNext ;
+                if ( !m_pPendingHead )
+                    m_pPendingTail = NULL   ;
+            }
+            return p    ;
+        }
+
+        /// Returns the processed batch \p p for reuse
+        void recycle( batch * p )
+        {
+            p->m_arr.clear()    ;
+            cds::lock::AutoSpin al( m_Lock )    ;
+            p->m_pNext = m_pFree    ;
+            m_pFree = p ;
+            --m_nBacklog    ;
+        }
+    };
+
+}}} // namespace cds::gc::details
+
+#endif // #ifndef __CDS_GC_DETAILS_RECLAIMER_H
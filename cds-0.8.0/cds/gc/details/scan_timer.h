@@ -0,0 +1,56 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_DETAILS_SCAN_TIMER_H
+#define __CDS_GC_DETAILS_SCAN_TIMER_H
+
+#include <cds/atomic.h>
+#include <cds/os/timer.h>
+
+namespace cds { namespace gc { namespace details {
+
+    /// Scoped timer of the reclamation pass
+    /**
+        The object adds the duration of its lifetime in native timer units to the event counter.
+        GC declares it at the beginning of the scan (liberate, advance) function so the time spent
+        in reclamation is accumulated in the GC statistics. If \p bEnabled is \p false the timer
+        does not call the OS timer at all.
+
+        Use <tt>cds::OS::Timer().duration( counter )</tt> to convert the accumulated value to seconds.
+    */
+    class scan_timer
+    {
+        //@cond
+        atomics::event_counter *                m_pCounter  ;
+        cds::OS::Timer::native_timer_type       m_tmStart   ;
+        //@endcond
+    public:
+        /// Starts the timer
+        scan_timer( atomics::event_counter& counter, bool bEnabled = true )
+            : m_pCounter( bEnabled ? &counter : NULL )
+        {
+            if ( m_pCounter )
+                cds::OS::Timer::current( m_tmStart )    ;
+        }
+
+        /// Adds the time elapsed to the counter
+        ~scan_timer()
+        {
+            if ( m_pCounter ) {
+                cds::OS::Timer::native_timer_type tmEnd ;
+                cds::OS::Timer::current( tmEnd )    ;
+                *m_pCounter += size_t( cds::OS::Timer::native_duration( m_tmStart, tmEnd ))   ;
+            }
+        }
+    };
+
+}}} // namespace cds::gc::details
+
+#endif // #ifndef __CDS_GC_DETAILS_SCAN_TIMER_H
@@ -0,0 +1,562 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_EPOCH_EPOCH_H
+#define __CDS_GC_EPOCH_EPOCH_H
+
+#include <cds/gc/epoch_gc.h>
+#include <cds/gc/details/retired_ptr.h>
+#include <cds/gc/details/scan_timer.h>
+#include <cds/details/aligned_type.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/lock/spinlock.h>
+
+#include <boost/noncopyable.hpp>
+#include <vector>
+
+#if CDS_COMPILER == CDS_COMPILER_MSVC
+#   pragma warning(push)
+#   pragma warning(disable:4251)    // C4251: 'identifier' : class 'type' needs to have dll-interface to be used by clients of class 'type2'
+#endif
+
+namespace cds { namespace gc {
+
+    /// Epoch-based reclamation schema
+    /**
+        \par Sources:
+        \li [2004] K. Fraser. Practical lock freedom. PhD thesis, University of Cambridge, 2004
+        \li [2007] T. E. Hart, P. E. McKenney, A. D. Brown, J. Walpole. Performance of memory reclamation
+            for lockless synchronization. Journal of Parallel and Distributed Computing, 67(12), 2007
+
+        @cond
+        \par Usage
+            Epoch-based GC is the singleton. Before use any epoch-related class you must initialize it
+            by contructing cds::gc::epoch::GC object in beginning of your main().
+            See cds::gc::epoch::GC class for explanation.
+        @endcond
+
+        \par Algorithm
+            The GC maintains the global epoch counter. A thread enters the critical region when it creates its first
+            guard (Guard or GuardArray) and leaves it when the last guard is destroyed. On entering, the thread announces
+            the global epoch in its thread record; the store is followed by one full fence, that is, the cost of protection
+            is one fence per critical region, not per pointer as for Hazard Pointers. The pointers loaded inside
+            the critical region are safe until the region ends, so the guard assignment is a plain store.
+
+            A retired pointer is tagged by the global epoch and placed into one of three per-thread limbo lists.
+            The global epoch is advanced by one when all threads that are inside the critical region have
+            announced the current epoch. The pointer retired in epoch \p e may be freed when the global epoch is
+            <tt>e + 2</tt> or greater: no thread can hold a reference to it.
+
+            The price is that one thread stuck in its critical region (for example, preempted forever) stops the
+            reclamation for all threads, the memory is not bounded as for Hazard Pointers.
+
+            The limbo lists of the detached thread are moved to the global list of orphans that is freed by the
+            other threads when the orphans' epoch has expired.
+    */
+    namespace epoch {
+
+        // Forward declarations
+        class Guard ;
+        template <size_t COUNT> class GuardArray    ;
+        class ThreadGC  ;
+        class GarbageCollector  ;
+
+        /// Retired pointer type
+        typedef cds::gc::details::retired_ptr retired_ptr   ;
+
+        using cds::gc::details::free_retired_ptr_func   ;
+
+        /// Details of epoch-based reclamation
+        namespace details {
+
+            /// Thread record
+            /**
+                The records are linked in the global list, the list is never shrunk:
+                the record of the detached thread is reused by the next attached thread.
+            */
+            struct thread_record
+            {
+                /// Epoch announced by the thread shifted left by one; the lowest bit is 1 if the thread is in critical region
+                atomic<size_t>          m_nState    ;
+                atomic<int>             m_bInUse    ;   ///< The record is owned by a thread
+                thread_record *         m_pNext     ;   ///< Next record in the global list
+                char                    m_pad[ c_nCacheLineSize ] ;    // the records must not share the cache line
+
+                //@cond
+                thread_record()
+                    : m_nState( 0 )
+                    , m_bInUse( 1 )
+                    , m_pNext( NULL )
+                {}
+                //@endcond
+            };
+
+            /// Retired pointer tagged by the epoch of retiring
+            struct epoch_retired_ptr
+            {
+                retired_ptr m_ptr   ;   ///< retired pointer
+                size_t      m_nEpoch;   ///< epoch of retiring
+
+                //@cond
+                epoch_retired_ptr( const retired_ptr& p, size_t nEpoch )
+                    : m_ptr( p )
+                    , m_nEpoch( nEpoch )
+                {}
+                //@endcond
+            };
+
+            /// Limbo list of the pointers retired in the same epoch
+            struct limbo_list
+            {
+                std::vector<retired_ptr>    m_arr       ;   ///< retired pointers
+                size_t                      m_nEpoch    ;   ///< epoch of the pointers retired
+
+                //@cond
+                limbo_list()
+                    : m_nEpoch( 0 )
+                {}
+
+                size_t free_all()
+                {
+                    size_t nCount = m_arr.size()    ;
+                    for ( size_t i = 0; i < nCount; ++i )
+                        m_arr[i].free() ;
+                    m_arr.clear()   ;
+                    return nCount   ;
+                }
+                //@endcond
+            };
+
+            /// Uninitialized guard
+            /**
+                The guard in epoch-based schema does not protect anything itself: the protection is the critical region
+                of the thread. The guard keeps the pointer assigned for get() support only.
+            */
+            class guard: public boost::noncopyable
+            {
+                void *  m_p ;
+            public:
+                /// Initialize empty guard.
+                CDS_CONSTEXPR guard()
+                    : m_p( NULL )
+                {}
+
+                /// Guards pointer \p p
+                void set( void * p )
+                {
+                    m_p = p ;
+                }
+
+                /// Clears the guard
+                void clear()
+                {
+                    m_p = NULL  ;
+                }
+
+                /// Guards pointer \p p
+                template <typename T>
+                T * operator =( T * p )
+                {
+                    set( reinterpret_cast<void *>( const_cast<T *>(p) ))      ;
+                    return p    ;
+                }
+
+                /// Returns the pointer assigned
+                void * get() const
+                {
+                    return m_p  ;
+                }
+            };
+
+        } // namespace details
+
+        /// Guard
+        /**
+            The ctor enters the critical region of current thread, the dtor leaves the region.
+            The regions may be nested.
+        */
+        class Guard: public details::guard
+        {
+            //@cond
+            typedef details::guard    base_class    ;
+            //@endcond
+
+            ThreadGC&    m_gc    ;    ///< ThreadGC object of current thread
+        public:
+            /// Enters the critical region. \p gc must be ThreadGC object of current thread
+            Guard( ThreadGC& gc )  ;   // inline after ThreadGC
+
+            /// Leaves the critical region
+            ~Guard();    // inline after ThreadGC
+
+            /// Returns epoch GC object
+            ThreadGC& getGC()
+            {
+                return m_gc    ;
+            }
+
+            /// Guards pointer \p p
+            template <typename T>
+            T * operator =( T * p )
+            {
+                return base_class::operator =<T>( p )    ;
+            }
+        };
+
+        /// Array of guards
+        /**
+            The ctor enters the critical region of current thread, the dtor leaves the region.
+        */
+        template <size_t COUNT>
+        class GuardArray: public boost::noncopyable
+        {
+            details::guard      m_arr[COUNT]    ;    ///< array of guard
+            ThreadGC&           m_gc    ;            ///< ThreadGC object of current thread
+
+        public:
+            /// Rebind array for other size \p COUNT2
+            template <size_t COUNT2>
+            struct rebind {
+                typedef GuardArray<COUNT2>  other   ;   ///< rebinding result
+            };
+
+        public:
+            /// Enters the critical region. \p gc must be ThreadGC object of current thread
+            GuardArray( ThreadGC& gc )    ;    // inline below
+
+            /// Leaves the critical region
+            ~GuardArray()    ;    // inline below
+
+            /// Returns the capacity of array
+            size_t capacity() const
+            {
+                return COUNT    ;
+            }
+
+            /// Returns epoch ThreadGC object
+            ThreadGC& getGC()
+            {
+                return m_gc ;
+            }
+
+            /// Returns reference to the guard of index \p nIndex (0 <= \p nIndex < \p COUNT)
+            details::guard& operator []( size_t nIndex )
+            {
+                assert( nIndex < COUNT )    ;
+                return m_arr[nIndex]        ;
+            }
+
+            /// Set the guard \p nIndex. 0 <= \p nIndex < \p COUNT
+            template <typename T>
+            void set( size_t nIndex, T * p )
+            {
+                assert( nIndex < COUNT )    ;
+                m_arr[nIndex].set( p )      ;
+            }
+
+            /// Clears (sets to NULL) the guard \p nIndex
+            void clear( size_t nIndex )
+            {
+                assert( nIndex < COUNT )    ;
+                m_arr[nIndex].clear()       ;
+            }
+
+            /// Clears all guards in the array
+            void clearAll()
+            {
+                for ( size_t i = 0; i < COUNT; ++i )
+                    clear(i)    ;
+            }
+        };
+
+        /// Memory manager (Garbage collector)
+        class CDS_EXPORT_API GarbageCollector
+        {
+            friend class ThreadGC   ;
+        public:
+            /// Exception "No GarbageCollector object is created"
+            CDS_DECLARE_EXCEPTION( EpochManagerEmpty, "Global epoch GarbageCollector is NULL" )    ;
+
+            /// Internal GC statistics
+            struct InternalState
+            {
+                size_t  m_nEpoch            ;   ///< Current global epoch
+                size_t  m_nThreadRecCount   ;   ///< Count of thread records allocated
+                size_t  m_nAdvanceCount     ;   ///< Count of successful epoch advances
+                size_t  m_nAdvanceFailed    ;   ///< Count of advance attempts failed because of lagging thread
+                size_t  m_nFreedCount       ;   ///< Count of retired pointers freed
+                size_t  m_nOrphanCount      ;   ///< Current count of orphaned retired pointers
+                size_t  m_nScanCount        ;   ///< Count of ThreadGC::scan calls
+                double  m_fScanTime         ;   ///< Total time of ThreadGC::scan calls, seconds
+
+                //@cond
+                InternalState()
+                    : m_nEpoch(0)
+                    , m_nThreadRecCount(0)
+                    , m_nAdvanceCount(0)
+                    , m_nAdvanceFailed(0)
+                    , m_nFreedCount(0)
+                    , m_nOrphanCount(0)
+                    , m_nScanCount(0)
+                    , m_fScanTime(0)
+                {}
+                //@endcond
+            };
+
+        private:
+            static GarbageCollector * m_pManager    ;   ///< GC global instance
+
+            typedef cds::details::aligned_type< atomic<size_t>, c_nCacheLineSize >::type   aligned_epoch ;
+
+            aligned_epoch                       m_nGlobalEpoch  ;   ///< Global epoch
+            atomic<details::thread_record *>    m_pThreadList   ;   ///< List of thread records
+            atomic<size_t>                      m_nThreadRecCount;  ///< Count of thread records
+
+            lock::Spin                                  m_lockOrphans   ;   ///< Access to m_Orphans
+            std::vector<details::epoch_retired_ptr>     m_Orphans       ;   ///< Retired pointers of detached threads
+            atomic<size_t>                              m_nOrphanCount  ;   ///< Size of m_Orphans
+
+            const size_t    m_nScanThreshold    ;   ///< Count of retired pointers after that the thread tries to advance the epoch
+
+            atomic<size_t>  m_nAdvanceCount     ;
+            atomic<size_t>  m_nAdvanceFailed    ;
+            atomic<size_t>  m_nFreedCount       ;
+            atomic<size_t>  m_nScanCount        ;
+            atomics::event_counter  m_ScanTime  ;   ///< Total time of ThreadGC::scan calls, in cds::OS::Timer native units
+
+        public:
+            /// Initializes epoch-based memory manager singleton
+            /**
+                This member function creates and initializes epoch GC global object.
+                The function should be called before using CDS data structure based on cds::gc::epoch_gc GC. Usually,
+                this member function is called in the \p main() function. See cds::gc::epoch for example.
+
+                \par Parameters
+                \li \p nScanThreshold - count of pointers retired by the thread after that the thread tries
+                    to advance the global epoch and to free its expired limbo lists.
+            */
+            static void CDS_STDCALL Construct(
+                size_t nScanThreshold = 128
+            ) ;
+
+            /// Destroys epoch-based memory manager
+            /**
+                The member function destroys the global object and frees all retired pointers.
+                All threads must be detached before calling this function.
+            */
+            static void CDS_STDCALL Destruct()  ;
+
+            /// Returns pointer to GarbageCollector instance
+            /**
+                If epoch GC is not initialized, \p EpochManagerEmpty exception is thrown
+            */
+            static GarbageCollector&   instance()
+            {
+                if ( m_pManager == NULL )
+                    throw EpochManagerEmpty()    ;
+                return *m_pManager   ;
+            }
+
+            /// Checks if global GC object is constructed and may be used
+            static bool isUsed()
+            {
+                return m_pManager != NULL    ;
+            }
+
+            /// Returns current global epoch
+            size_t epoch() const
+            {
+                return m_nGlobalEpoch.load<membar_acquire>()    ;
+            }
+
+            /// Tries to advance the global epoch
+            /**
+                The epoch is advanced if all threads in critical region have announced the current epoch.
+                Returns \p true if the epoch is advanced by current thread.
+            */
+            bool try_advance()  ;
+
+            /// Get internal statistics
+            InternalState& getInternalState(InternalState& stat) const ;
+
+        protected:
+            //@cond
+            details::thread_record * allocRecord()  ;
+            void freeRecord( details::thread_record * pRec, details::limbo_list * pLimbo, size_t nLimboCount )  ;
+            void free_orphans() ;
+
+            size_t retire_epoch()
+            {
+                // The fence orders the unlinking of the node before the epoch load:
+                // a thread that has seen the node announces the epoch not greater than the epoch loaded
+                atomics::fence( membar_seq_cst::order ) ;
+                return m_nGlobalEpoch.load<membar_relaxed>()    ;
+            }
+
+            void onFreed( size_t nCount )
+            {
+                m_nFreedCount.xadd<membar_relaxed>( nCount )   ;
+            }
+            //@endcond
+
+        private:
+            //@cond none
+            GarbageCollector( size_t nScanThreshold )  ;
+            ~GarbageCollector() ;
+            //@endcond
+        };
+
+        /// Thread GC
+        /**
+            To use epoch-based reclamation schema each thread object must be linked with the object of ThreadGC class
+            that interacts with GarbageCollector global object. The linkage is performed by calling cds::threading \p ::Manager::attachThread()
+            on the start of each thread that uses epoch GC. Before terminating the thread linked to epoch GC it is necessary to call
+            cds::threading \p ::Manager::detachThread().
+        */
+        class ThreadGC: boost::noncopyable
+        {
+            GarbageCollector&           m_gc            ;   ///< reference to GC singleton
+            details::thread_record *    m_pRec          ;   ///< thread record
+            size_t                      m_nNestCount    ;   ///< critical region nesting count
+            size_t                      m_nRetiredCount ;   ///< count of pointers retired since last scan
+            details::limbo_list         m_Limbo[3]      ;   ///< limbo lists by epoch modulo 3
+
+        public:
+            ThreadGC()
+                : m_gc( GarbageCollector::instance() )
+                , m_pRec( NULL )
+                , m_nNestCount( 0 )
+                , m_nRetiredCount( 0 )
+            {}
+
+            /// Dtor calls fini()
+            ~ThreadGC()
+            {
+                fini()  ;
+            }
+
+            /// Initialization. Repeat call is available
+            void init()
+            {
+                if ( !m_pRec )
+                    m_pRec = m_gc.allocRecord() ;
+            }
+
+            /// Finalization. Repeat call is available
+            void fini()
+            {
+                if ( m_pRec ) {
+                    assert( m_nNestCount == 0 ) ;
+                    m_gc.freeRecord( m_pRec, m_Limbo, sizeof(m_Limbo) / sizeof(m_Limbo[0]) )   ;
+                    m_pRec = NULL   ;
+                    m_nRetiredCount = 0 ;
+                }
+            }
+
+            /// Enters the critical region
+            void enter()
+            {
+                assert( m_pRec != NULL )    ;
+                if ( m_nNestCount++ == 0 ) {
+                    m_pRec->m_nState.store<membar_relaxed>( (m_gc.m_nGlobalEpoch.load<membar_relaxed>() << 1) | 1 ) ;
+                    atomics::fence( membar_seq_cst::order ) ;
+                }
+            }
+
+            /// Leaves the critical region
+            void leave()
+            {
+                assert( m_nNestCount > 0 )  ;
+                if ( --m_nNestCount == 0 )
+                    m_pRec->m_nState.store<membar_release>( size_t(0) ) ;
+            }
+
+            /// Checks if the thread is in the critical region
+            bool isInCriticalRegion() const
+            {
+                return m_nNestCount != 0    ;
+            }
+
+            /// Places retired pointer \p and its deleter \p pFunc into list of retired pointer for deferred reclamation
+            template <typename T>
+            void retirePtr( T * p, void (* pFunc)(T *) )
+            {
+                retirePtr( retired_ptr( p, pFunc ))  ;
+            }
+
+            /// Places retired pointer \p into list of retired pointer for deferred reclamation
+            void retirePtr( const retired_ptr& p )
+            {
+                size_t nEpoch = m_gc.retire_epoch() ;
+                details::limbo_list& limbo = m_Limbo[ nEpoch % 3 ]   ;
+                if ( limbo.m_nEpoch != nEpoch ) {
+                    // The list contains the pointers retired in epoch nEpoch - 3 or earlier, they are expired
+                    m_gc.onFreed( limbo.free_all() )   ;
+                    limbo.m_nEpoch = nEpoch ;
+                }
+                limbo.m_arr.push_back( p )  ;
+
+                if ( ++m_nRetiredCount >= m_gc.m_nScanThreshold )
+                    scan()  ;
+            }
+
+            /// Tries to advance the global epoch and frees expired limbo lists
+            void scan()
+            {
+                m_gc.m_nScanCount.inc<membar_relaxed>() ;
+                gc::details::scan_timer timer( m_gc.m_ScanTime )    ;
+
+                m_nRetiredCount = 0 ;
+                m_gc.try_advance()  ;
+
+                size_t nEpoch = m_gc.epoch()    ;
+                for ( size_t i = 0; i < sizeof(m_Limbo) / sizeof(m_Limbo[0]); ++i ) {
+                    if ( m_Limbo[i].m_nEpoch + 2 <= nEpoch && !m_Limbo[i].m_arr.empty() )
+                        m_gc.onFreed( m_Limbo[i].free_all() )  ;
+                }
+
+                if ( m_gc.m_nOrphanCount.load<membar_relaxed>() != 0 )
+                    m_gc.free_orphans() ;
+            }
+        };
+
+        //////////////////////////////////////////////////////////
+        // Inlines
+
+        inline Guard::Guard(ThreadGC& gc)
+            : m_gc( gc )
+        {
+            getGC().enter() ;
+        }
+        inline Guard::~Guard()
+        {
+            getGC().leave() ;
+        }
+
+        template <size_t COUNT>
+        inline GuardArray<COUNT>::GuardArray( ThreadGC& gc )
+            : m_gc( gc )
+        {
+            getGC().enter() ;
+        }
+        template <size_t COUNT>
+        inline GuardArray<COUNT>::~GuardArray()
+        {
+            getGC().leave() ;
+        }
+
+    }   // namespace epoch
+}}  // namespace cds::gc
+
+#if CDS_COMPILER == CDS_COMPILER_MSVC
+#   pragma warning(pop)
+#endif
+
+#endif // #ifndef __CDS_GC_EPOCH_EPOCH_H
@@ -0,0 +1,253 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_EPOCH_GC_WRAPPER_H
+#define __CDS_GC_EPOCH_GC_WRAPPER_H
+
+#include <cds/gc/epoch/epoch.h>
+#include <cds/threading/model.h>
+
+//@cond
+namespace cds { namespace gc { namespace epoch {
+
+        /// User-space epoch-based garbage collector
+        /**
+            This class is a wrapper for epoch-based garbage collector internal implementation.
+            It simplifies usage of \p libcds epoch schema hiding implementation-specific details.
+
+            \par Usage
+            In your \p main function you declare a object of class cds::gc::epoch::GC. This declaration
+            initializes internal GarbageCollector singleton.
+            \code
+            #include <cds/gc/epoch/gc.h>
+
+            int main(int argc, char** argv)
+            {
+                // Initialize libcds
+                cds::Initialize() ;
+
+                {
+                    // Initialize epoch GC singleton
+                    cds::gc::epoch::GC epochGC ;
+
+                    // Some useful work
+                    ...
+                }
+
+                // Terminate libcds
+                cds::Terminate()    ;
+            }
+            \endcode
+
+            Each thread that uses cds::gc::epoch_gc -based containers must be attached to epoch GC
+            singleton by cds::threading::Manager::attachThread() or by declaring GC::thread_gc object,
+            see cds::gc::ptb::GC for explanation.
+        */
+        class GC
+        {
+        public:
+
+            /// Wrapper for ThreadGC class
+            /**
+                This class performs automatically attaching/detaching epoch GC
+                for the current thread.
+            */
+            class thread_gc: public ThreadGC
+            {
+                //@cond
+                bool    m_bPersistent   ;
+                //@endcond
+            public:
+                /// Constructor
+                /**
+                    The constructor attaches the current thread to the epoch GC
+                    if it is not yet attached.
+                    The \p bPersistent parameter specifies attachment persistence:
+                    - \p true - the class destructor will not detach the thread from epoch GC.
+                    - \p false (default) - the class destructor will detach the thread from epoch GC.
+                */
+                thread_gc(
+                    bool    bPersistent = false
+                )
+                : m_bPersistent( bPersistent )
+                {
+                    if ( !threading::Manager::isThreadAttached() )
+                        threading::Manager::attachThread() ;
+                }
+
+                /// Destructor
+                ~thread_gc()
+                {
+                    if ( !m_bPersistent )
+                        cds::threading::Manager::detachThread() ;
+                }
+            };
+
+            /// Base for container node
+            /**
+                This struct is empty for epoch GC
+            */
+            struct container_node
+            {};
+
+            /// Epoch guard
+            /**
+                This class is a wrapper for epoch::Guard: it keeps the current thread in critical region.
+            */
+            class Guard: public epoch::Guard
+            {
+                //@cond
+                typedef epoch::Guard base_class  ;
+                //@endcond
+
+            public:
+                //@cond
+                Guard()
+                    : base_class( threading::getGC<epoch_gc>() )
+                {}
+                //@endcond
+
+                /// Guards a pointer of type \p T
+                /**
+                    Inside the critical region the pointer loaded cannot be freed, so the function
+                    loads \p pToGuard once.
+                */
+                template <typename T>
+                T * guard( T * volatile & pToGuard )
+                {
+                    return base_class::operator =( atomics::load<membar_acquire>(pToGuard) ) ;
+                }
+
+                /// Guards a pointer of type \p atomic<T*>
+                template <typename T>
+                T * guard( atomic<T *>& toGuard )
+                {
+                    return base_class::operator =( toGuard.template load<membar_acquire>() )  ;
+                }
+
+                /// Store \p to the guard
+                template <typename T>
+                T * assign( T * p )
+                {
+                    return base_class::operator =(p) ;
+                }
+
+                /// Clear value of the guard
+                void clear()
+                {
+                    base_class::clear() ;
+                }
+
+                /// Get current value guarded
+                template <typename T>
+                T * get() const
+                {
+                    return reinterpret_cast<T *>( base_class::get() )   ;
+                }
+            };
+
+            /// Array of epoch guards
+            /**
+                This class is a wrapper for epoch::GuardArray template.
+                Template parameter \p COUNT defines the size of the array.
+            */
+            template <size_t COUNT>
+            class GuardArray: public epoch::GuardArray<COUNT>
+            {
+                //@cond
+                typedef epoch::GuardArray<COUNT> base_class   ;
+                //@endcond
+            public:
+                /// Rebind array for other size \p COUNT2
+                template <size_t COUNT2>
+                struct rebind {
+                    typedef GuardArray<COUNT2>  other   ;   ///< rebinding result
+                };
+
+            public:
+                //@cond
+                GuardArray()
+                    : base_class( threading::getGC<epoch_gc>() )
+                {}
+                //@endcond
+
+                /// Guards a pointer of type \p T
+                template <typename T>
+                T * guard( size_t nIndex, T * volatile & pToGuard )
+                {
+                    T * pRet = atomics::load<membar_acquire>(pToGuard)  ;
+                    base_class::set( nIndex, pRet ) ;
+                    return pRet ;
+                }
+
+                /// Guards a pointer of type \p atomic<T*>
+                template <typename T>
+                T * guard( size_t nIndex, atomic<T *>& toGuard )
+                {
+                    T * pRet = toGuard.template load<membar_acquire>()  ;
+                    base_class::set( nIndex, pRet ) ;
+                    return pRet ;
+                }
+
+                /// Store \p to the slot \p nIndex
+                template <typename T>
+                T * assign( size_t nIndex, T * p )
+                {
+                    base_class::set(nIndex, p) ;
+                    return p    ;
+                }
+
+                /// Clear value of the slot \p nIndex
+                void clear( size_t nIndex)
+                {
+                    base_class::clear( nIndex );
+                }
+
+                /// Get current value of slot \p nIndex
+                template <typename T>
+                T * get( size_t nIndex) const
+                {
+                    return reinterpret_cast<T *>( const_cast<GuardArray *>(this)->operator[](nIndex).get() )   ;
+                }
+
+                /// Capacity of the guard array
+                size_t capacity() const
+                {
+                    return COUNT ;
+                }
+            };
+
+        public:
+            /// Initializes GarbageCollector singleton
+            /**
+                The constructor calls GarbageCollector::Construct with passed parameters.
+                See GarbageCollector::Construct for explanation of parameters meaning.
+            */
+            GC(
+                size_t nScanThreshold = 128
+            )
+            {
+                GarbageCollector::Construct( nScanThreshold )   ;
+            }
+
+            /// Terminates GarbageCollector singleton
+            /**
+                The destructor calls \code GarbageCollector::Destruct() \endcode
+            */
+            ~GC()
+            {
+                GarbageCollector::Destruct()  ;
+            }
+        };
+
+}}} // namespace cds::gc::epoch
+//@endcond
+
+#endif // #ifndef __CDS_GC_EPOCH_GC_WRAPPER_H
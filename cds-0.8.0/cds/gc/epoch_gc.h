@@ -0,0 +1,36 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_EPOCH_GC_H
+#define __CDS_GC_EPOCH_GC_H
+
+namespace cds {
+    namespace gc {
+
+        // Forward declarations
+        namespace epoch {
+            class GarbageCollector  ;
+            class ThreadGC  ;
+        }
+
+        /// Tag for epoch-based reclamation schema
+        /**
+            For more information about epoch-based reclamation schema see cds::gc::epoch namespace.
+        */
+        struct epoch_gc
+        {
+            /// Thread control data of epoch-based GC
+            typedef gc::epoch::ThreadGC thread_gc   ;
+        };
+    }   // namespace gc
+} // namespace cds
+
+
+#endif // #ifndef __CDS_GC_EPOCH_GC_H
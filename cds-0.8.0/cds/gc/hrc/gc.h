@@ -296,14 +296,16 @@ namespace cds { namespace gc { namespace hrc {
                 size_t nHazardPtrCount = 0,     ///< number of hazard pointers
                 size_t nMaxThreadCount = 0,     ///< max threads count
                 size_t nMaxNodeLinkCount = 0,   ///< max number of links a @ref ContainerNode can contain
-                size_t nMaxTransientLinks = 0   ///< max number of links in live nodes that may transiently point to a deleted node
+                size_t nMaxTransientLinks = 0,  ///< max number of links in live nodes that may transiently point to a deleted node
+                bool bDeferredRC = false        ///< deferred reference counting mode
             )
             {
                 GarbageCollector::Construct(
                     nHazardPtrCount,
                     nMaxThreadCount,
                     nMaxNodeLinkCount,
-                    nMaxTransientLinks
+                    nMaxTransientLinks,
+                    bDeferredRC
                 )   ;
             }
 
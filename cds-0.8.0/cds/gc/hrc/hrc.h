@@ -25,6 +25,7 @@
 #include <cds/gc/hrc/details/hrc_retired.h>
 
 #include <cds/gc/hzp/details/hp_alloc.h>
+#include <cds/gc/details/free_rec_cache.h>
 
 #include <boost/noncopyable.hpp>
 
@@ -164,6 +165,88 @@ namespace cds { namespace gc {
             class HPArray: public gc::hzp::details::HPArrayT<ContainerNode *, COUNT>
             {};
 
+            /// Log of deferred decrements of reference counters
+            /**
+                The log is used in deferred reference counting mode (see GarbageCollector::Construct).
+                The thread does not decrement the reference counter of the node unlinked at once:
+                the node is appended to the log and the log is applied by a batch in GarbageCollector::Scan,
+                GarbageCollector::CleanUpAll, when the log is full and when the thread detaches.
+                A pending decrement only overstates the reference counter, so the node cannot be reclaimed prematurely.
+                If the thread links again the node that has a pending decrement, the increment cancels
+                the decrement and the node header is not written at all.
+
+                The decrements made by the GC itself (ContainerNode::cleanUp and ContainerNode::terminate called
+                from GarbageCollector::Scan, GarbageCollector::CleanUpAll and ThreadGC::cleanUpLocal) are not deferred:
+                otherwise a chain of retired nodes would be reclaimed by one node per \p Scan call.
+
+                The log is accessed by the thread owned the descriptor only.
+            */
+            struct deferred_rc_log {
+                static const size_t c_nCapacity = 16 ; ///< Max count of pending decrements
+
+                ContainerNode *     m_arr[c_nCapacity]  ; ///< Nodes whose reference counter is to be decremented
+                size_t              m_nCount            ; ///< Count of pending decrements
+                size_t              m_nLogged           ; ///< Count of decrements logged since last apply (for statistics)
+                size_t              m_nCancelled        ; ///< Count of increments cancelled since last apply (for statistics)
+                size_t              m_nBypass           ; ///< If not zero the log is bypassed, see \ref scoped_bypass
+
+                //@cond
+                deferred_rc_log()
+                    : m_nCount(0)
+                    , m_nLogged(0)
+                    , m_nCancelled(0)
+                    , m_nBypass(0)
+                {}
+                //@endcond
+
+                /// Bypasses the log while the object is alive: the reference counters are changed immediately
+                class scoped_bypass: boost::noncopyable
+                {
+                    deferred_rc_log&    m_Log   ;
+                public:
+                    //@cond
+                    explicit scoped_bypass( deferred_rc_log& log )
+                        : m_Log( log )
+                    {
+                        ++m_Log.m_nBypass   ;
+                    }
+                    ~scoped_bypass()
+                    {
+                        --m_Log.m_nBypass   ;
+                    }
+                    //@endcond
+                };
+
+                /// Checks if the log is bypassed
+                bool isBypassed() const
+                {
+                    return m_nBypass != 0   ;
+                }
+
+                /// Appends \p pNode to the log. Returns \p true if the log is full
+                bool push( ContainerNode * pNode )
+                {
+                    assert( m_nCount < c_nCapacity )    ;
+                    m_arr[ m_nCount++ ] = pNode ;
+                    ++m_nLogged ;
+                    return m_nCount == c_nCapacity  ;
+                }
+
+                /// Removes one pending decrement of \p pNode. Returns \p false if the log has no decrement of \p pNode
+                bool cancel( ContainerNode * pNode )
+                {
+                    // The node unlinked recently is most likely to be linked again, so search from the tail
+                    for ( size_t i = m_nCount; i > 0; --i ) {
+                        if ( m_arr[i - 1] == pNode ) {
+                            m_arr[i - 1] = m_arr[ --m_nCount ]  ;
+                            ++m_nCancelled  ;
+                            return true ;
+                        }
+                    }
+                    return false    ;
+                }
+            };
+
             /// HP record of the thread
             /**
                 This structure is single writer - multiple reader type. The writer is the thread owned the record
@@ -174,6 +257,7 @@ namespace cds { namespace gc {
 
                 hzp::details::HPAllocator<TEntry>   m_hzp           ;   ///< array of hazard pointers. Implicit \ref CDS_DEFAULT_ALLOCATOR dependence
                 details::retired_vector             m_arrRetired    ;   ///< array of retired pointers
+                deferred_rc_log                     m_RCLog         ;   ///< pending decrements of reference counters (deferred RC mode only)
 
                 //@cond
                 thread_descriptor( const GarbageCollector& HzpMgr ) ;    // inline
@@ -209,6 +293,7 @@ namespace cds { namespace gc {
                 size_t              nMaxThreadCount         ;   ///< Max thread count (const)
                 size_t              nMaxRetiredPtrCount     ;   ///< Max retired pointer count per thread (const)
                 size_t              nHRCRecSize             ;   ///< Size of HRC record, bytes (const)
+                bool                bDeferredRC             ;   ///< Deferred reference counting mode (const)
 
                 size_t              nHRCRecAllocated        ;   ///< Count of HRC record allocations
                 size_t              nHRCRecUsed             ;   ///< Count of HRC record used
@@ -219,15 +304,23 @@ namespace cds { namespace gc {
                 typedef atomics::event_counter::value_type  event_value_type ;
 
                 event_value_type    evcAllocHRCRec        ; ///< Event count of @ref details::thread_descriptor allocation
+                event_value_type    evcAllocHRCRecCached; ///< Event count of @ref details::thread_descriptor allocation served by the free-record cache
                 event_value_type    evcRetireHRCRec        ; ///< Event count of @ref details::thread_descriptor reclamation
                 event_value_type    evcAllocNewHRCRec    ; ///< Event count of new @ref details::thread_descriptor allocation
                 event_value_type    evcDeleteHRCRec        ; ///< Event count of deletion of @ref details::thread_descriptor
+                event_value_type    evcGrowHRCRec          ; ///< Event count of HP block allocations for @ref details::thread_descriptor
                 event_value_type    evcScanCall            ; ///< Number of calls Scan
                 event_value_type    evcHelpScanCalls    ; ///< Number of calls HelpScan
                 event_value_type    evcCleanUpAllCalls  ; ///< Number of calls CleanUpAll
                 event_value_type    evcDeletedNode        ; ///< Node deletion event counter
                 event_value_type    evcScanGuarded      ; ///< Count of retired nodes that could not be deleted on Scan phase
                 event_value_type    evcScanClaimGuarded ; ///< Count of retired node that could not be deleted on Scan phase because of m_nClaim != 0
+                event_value_type    evcHandOff          ; ///< Count of retired arrays handed off to the reclaimer thread
+                event_value_type    evcHandOffReject    ; ///< Count of hand-off failures because the reclaimer backlog is full
+                event_value_type    evcDeferredDecRef   ; ///< Count of reference counter decrements deferred
+                event_value_type    evcDeferredIncCancel; ///< Count of reference counter increments cancelled by pending decrement
+                event_value_type    evcDeferredRCApply  ; ///< Count of batches of deferred decrements applied
+                double              fScanTime           ; ///< Total time of Scan calls, seconds
 
 #ifdef CDS_DEBUG
                 event_value_type    evcNodeConstruct    ; ///< Count of constructed ContainerNode
@@ -245,9 +338,11 @@ namespace cds { namespace gc {
             /// Internal statistics by events
             struct statistics {
                 atomics::event_counter  m_AllocHRCThreadDesc        ; ///< Event count of @ref details::thread_descriptor allocation
+                atomics::event_counter  m_AllocHRCThreadDescCached  ; ///< Event count of @ref details::thread_descriptor allocation served by the free-record cache
                 atomics::event_counter  m_RetireHRCThreadDesc        ; ///< Event count of @ref details::thread_descriptor reclamation
                 atomics::event_counter  m_AllocNewHRCThreadDesc        ; ///< Event count of new @ref details::thread_descriptor allocation
                 atomics::event_counter  m_DeleteHRCThreadDesc        ; ///< Event count of deletion of @ref details::thread_descriptor
+                atomics::event_counter  m_GrowHRCThreadDesc          ; ///< Event count of HP block allocations for @ref details::thread_descriptor
                 atomics::event_counter  m_ScanCalls                    ; ///< Number of calls Scan
                 atomics::event_counter  m_HelpScanCalls             ; ///< Number of calls HelpScan
                 atomics::event_counter  m_CleanUpAllCalls           ; ///< Number of calls CleanUpAll
@@ -255,6 +350,12 @@ namespace cds { namespace gc {
                 atomics::event_counter  m_DeletedNode                ; ///< Node deletion event counter
                 atomics::event_counter  m_ScanGuarded               ; ///< Count of retired nodes that could not be deleted on Scan phase
                 atomics::event_counter  m_ScanClaimGuarded          ; ///< Count of retired node that could not be deleted on Scan phase because of m_nClaim != 0
+                atomics::event_counter  m_HandOff                   ; ///< Count of retired arrays handed off to the reclaimer thread
+                atomics::event_counter  m_HandOffReject             ; ///< Count of hand-off failures because the reclaimer backlog is full
+                atomics::event_counter  m_DeferredDecRef            ; ///< Count of reference counter decrements deferred
+                atomics::event_counter  m_DeferredIncCancel         ; ///< Count of reference counter increments cancelled by pending decrement
+                atomics::event_counter  m_DeferredRCApply           ; ///< Count of batches of deferred decrements applied
+                atomics::event_counter  m_ScanTime                  ; ///< Total time of Scan calls, in cds::OS::Timer native units
 
 #           ifdef CDS_DEBUG
                 atomics::event_counter  m_NodeConstructed           ; ///< Count of ContainerNode constructed
@@ -289,6 +390,7 @@ namespace cds { namespace gc {
 
         private:
             thread_list_node * volatile m_pListHead  ;  ///< Head of thread list
+            cds::gc::details::free_record_cache<thread_list_node>  m_FreeRecCache ; ///< Recently released thread descriptors
 
             static GarbageCollector *    m_pGC    ;    ///< HRC garbage collector instance
 
@@ -298,13 +400,20 @@ namespace cds { namespace gc {
             const size_t            m_nHazardPointerCount    ;    ///< max count of thread's hazard pointer
             const size_t            m_nMaxThreadCount        ;    ///< max count of thread
             const size_t            m_nMaxRetiredPtrCount    ;    ///< max count of retired ptr per thread
+            const bool              m_bDeferredRC            ;    ///< @a true - deferred reference counting mode
+
+            //@cond
+            class reclaimer_impl    ;
+            //@endcond
+            atomic<reclaimer_impl *> m_pReclaimer   ;    ///< background reclaimer; NULL if it is disabled (see \ref enableReclaimer)
 
         private:
             //@cond
             GarbageCollector(
                 size_t nHazardPtrCount,            ///< number of hazard pointers
                 size_t nMaxThreadCount,            ///< max number of threads
-                size_t nRetiredNodeArraySize    ///< size of array of retired node
+                size_t nRetiredNodeArraySize,   ///< size of array of retired node
+                bool bDeferredRC                ///< deferred reference counting mode
             )    ;
             ~GarbageCollector()    ;
             //@endcond
@@ -321,13 +430,29 @@ namespace cds { namespace gc {
             /// Finds HRC control structure for current thread
             thread_list_node *    getHRCThreadDescForCurrentThread() const ;
 
+            /// Returns HRC control structure of current thread via cds::threading::Manager; \p NULL if the thread has no one
+            static details::thread_descriptor * getCurrentThreadDesc()  ;
+
         public:
             /// Create global instance of GarbageCollector
+            /**
+                If \p bDeferredRC is \p true the GC works in deferred reference counting mode:
+                ThreadGC::CASRef, ThreadGC::xchgRef and ThreadGC::storeRef called by a thread attached
+                to cds::threading::Manager do not decrement the reference counter of the node unlinked
+                but log the decrement in the thread descriptor (see details::deferred_rc_log);
+                the log is applied in \ref Scan and \ref CleanUpAll. An increment of the node that has a pending decrement
+                in the log of the current thread cancels the decrement. So the threads that relink the same nodes
+                do not write the shared node headers.
+                Up to details::deferred_rc_log::c_nCapacity nodes per thread may be held by pending decrements
+                of other threads, so in this mode the array of retired nodes of the thread is enlarged
+                by \p nMaxThreadCount * details::deferred_rc_log::c_nCapacity items.
+            */
             static void    CDS_STDCALL    Construct(
                 size_t nHazardPtrCount = 0,        ///< number of hazard pointers
                 size_t nMaxThreadCount = 0,        ///< max threads count
                 size_t nMaxNodeLinkCount = 0,    ///< max number of links a @ref ContainerNode can contain
-                size_t nMaxTransientLinks = 0    ///< max number of links in live nodes that may transiently point to a deleted node
+                size_t nMaxTransientLinks = 0,   ///< max number of links in live nodes that may transiently point to a deleted node
+                bool bDeferredRC = false        ///< deferred reference counting mode
                 );
 
             /// Destroy global instance of GarbageCollector
@@ -347,12 +472,19 @@ namespace cds { namespace gc {
                 return m_pGC != NULL    ;
             }
 
-            /// Get max count of hazard pointers as defined in @ref Construct call
+            /// Get initial count of hazard pointers as defined in @ref Construct call
+            /**
+                It is also the size of HP block the thread descriptor grows by when the thread needs more hazard pointers.
+            */
             size_t            getHazardPointerCount() const        { return m_nHazardPointerCount; }
+            /// Get max count of hazard pointers per thread
+            size_t            getMaxHazardPointerCount() const     { return m_nHazardPointerCount * hzp::details::HPAllocator<ContainerNode *>::c_nMaxBlockCount; }
             /// Get max thread count as defined in @ref Construct call
             size_t            getMaxThreadCount() const             { return m_nMaxThreadCount; }
             /// Get max retired pointers count. It is calculated by the parameters of @ref Construct call
             size_t            getMaxRetiredPtrCount() const        { return m_nMaxRetiredPtrCount; }
+            /// Checks if the GC works in deferred reference counting mode (see @ref Construct)
+            bool              isDeferredRC() const                 { return m_bDeferredRC; }
 
             /// Get internal statistics
             internal_state& getInternalState( internal_state& stat) const ;
@@ -370,22 +502,58 @@ namespace cds { namespace gc {
 
             /// Checks that required hazard pointer count \p nRequiredCount is less or equal then max hazard pointer count
             /**
-                If \p nRequiredCount > getHazardPointerCount() then the exception HZPTooMany is thrown
+                The thread descriptor grows on demand, so the check is against \ref getMaxHazardPointerCount.
+                If \p nRequiredCount > getMaxHazardPointerCount() then the exception HRCTooMany is thrown
             */
             static void checkHPCount( unsigned int nRequiredCount )
             {
-                if ( instance().getHazardPointerCount() < nRequiredCount )
+                if ( instance().getMaxHazardPointerCount() < nRequiredCount )
                     throw HRCTooMany()  ;
             }
 
+            /// Checks if the background reclaimer thread is enabled
+            bool isReclaimerEnabled() const
+            {
+                return m_pReclaimer.load<membar_relaxed>() != NULL ;
+            }
+
+            /// Enables/disables the background reclaimer thread
+            /**
+                When the reclaimer is enabled, a thread that has filled its array of retired nodes
+                moves the nodes to the dedicated reclaimer thread instead of calling \ref Scan, \ref HelpScan
+                and \ref CleanUpAll (see cds::gc::details::reclaimer).
+                If more than \p nMaxBacklog arrays are waiting for the reclaimer, the thread reclaims inline as before.
+
+                The function is not thread-safe: call it when no other thread uses the GC, for example,
+                just after \ref Construct. \ref Destruct stops the reclaimer.
+
+                Returns previous state.
+            */
+            bool enableReclaimer(
+                bool bEnable,               ///< \p true - start the reclaimer, \p false - stop it
+                size_t nMaxBacklog = 16     ///< max count of arrays waiting for the reclaimer
+            )   ;
+
         public:    // Internals for threads
 
             /// Allocates HRC thread descriptor (thread interface)
+            /**
+                The function tries the descriptors recently released by \ref retireHRCThreadDesc first
+                (see cds::gc::details::free_record_cache), then any free descriptor of the list,
+                and only then allocates new descriptor. The descriptor reused keeps its hazard pointer blocks
+                and its retired nodes left by the previous owner.
+            */
             details::thread_descriptor * allocateHRCThreadDesc( ThreadGC * pThreadGC )    ;
 
             /// Retires HRC thread descriptor (thread interface)
             void retireHRCThreadDesc( details::thread_descriptor * pRec )    ;
 
+            /// Appends new block of hazard pointers to \p pRec (thread interface)
+            /**
+                If the max count of blocks is reached the exception HRCTooMany is thrown
+            */
+            void growHRCThreadDesc( details::thread_descriptor * pRec )    ;
+
             /// The main method of GC
             /**
                 The procedure searches through all not yet reclaimed nodes deleted by this thread
@@ -405,6 +573,37 @@ namespace cds { namespace gc {
             */
             void CleanUpAll( ThreadGC * pThreadGC )    ;
 
+            /// Moves retired nodes of \p pThreadGC to the reclaimer thread
+            /**
+                Returns \p false if the reclaimer is disabled or cannot accept the nodes;
+                in this case the caller should reclaim them inline.
+            */
+            bool handOff( ThreadGC * pThreadGC )
+            {
+                // The reclaimer is read once: it may be disabled concurrently
+                reclaimer_impl * pReclaimer = m_pReclaimer.load<membar_acquire>()  ;
+                return pReclaimer != NULL && handOff( pReclaimer, pThreadGC )  ;
+            }
+
+            //@cond
+            bool handOff( reclaimer_impl * pReclaimer, ThreadGC * pThreadGC )   ;
+            //@endcond
+
+            /// Applies the decrements logged in \p pRec (deferred reference counting mode)
+            void applyDeferredRC( details::thread_descriptor * pRec )   ;
+
+            /// Logs the decrement of reference counter of \p pNode in the descriptor of current thread
+            /**
+                Returns \p false if the current thread has no descriptor; in this case the caller should decrement the counter itself.
+            */
+            static bool deferDecRef( ContainerNode * pNode )  ;
+
+            /// Cancels a pending decrement of \p pNode logged by current thread
+            /**
+                Returns \p false if there is no such decrement; in this case the caller should increment the counter itself.
+            */
+            static bool cancelDecRef( ContainerNode * pNode ) ;
+
 #   ifdef CDS_DEBUG
         public:
             //@cond
@@ -454,11 +653,13 @@ namespace cds { namespace gc {
             }
 
             /// Finalization. Multiple calls is allowed
+            /**
+                The function does not scan: the retired nodes are left in the thread descriptor
+                for the next owner of the descriptor or for GarbageCollector::HelpScan.
+            */
             void fini()
             {
                 if ( m_pDesc ) {
-                    cleanUpLocal()      ;
-                    m_gc.Scan( this )   ;
                     details::thread_descriptor * pRec = m_pDesc    ;
                     m_pDesc = NULL    ;
                     if  ( pRec )
@@ -472,6 +673,8 @@ namespace cds { namespace gc {
             void allocGuard( details::HPGuard& guard )
             {
                 assert( m_pDesc != NULL )    ;
+                if ( !m_pDesc->m_hzp.hasFree( 1 ) )
+                    m_gc.growHRCThreadDesc( m_pDesc )   ;
                 m_pDesc->m_hzp.alloc( guard )    ;
             }
 
@@ -487,6 +690,8 @@ namespace cds { namespace gc {
             void allocGuard( details::HPArray<COUNT>& arr )
             {
                 assert( m_pDesc != NULL )    ;
+                if ( !m_pDesc->m_hzp.hasFree( COUNT ) )
+                    m_gc.growHRCThreadDesc( m_pDesc )   ;
                 m_pDesc->m_hzp.alloc( arr )    ;
             }
 
@@ -571,6 +776,24 @@ namespace cds { namespace gc {
                 atomics::store<membar_relaxed>( &hp, (ContainerNode *) NULL )   ;
             }
 
+        private:
+            //@cond
+            static void incRefLink( ContainerNode * pNode )
+            {
+                if ( !GarbageCollector::instance().isDeferredRC() || !GarbageCollector::cancelDecRef( pNode )) {
+                    ++pNode->m_RC   ;
+                    pNode->m_bTrace.store<membar_release>( false ) ;
+                }
+            }
+
+            static void decRefLink( ContainerNode * pNode )
+            {
+                if ( !GarbageCollector::instance().isDeferredRC() || !GarbageCollector::deferDecRef( pNode ))
+                    --pNode->m_RC   ;
+            }
+            //@endcond
+
+        public:
             /// Updates \p *ppLink node from current value \p pOld to new value \p pNew.
             /**
                 May be used when concurrent updates is possible
@@ -581,12 +804,10 @@ namespace cds { namespace gc {
             static bool    CASRef( TNODE * volatile * ppLink, TNODE * pOld, TNODE * pNew )
             {
                 if ( atomics::cas<membar_acquire>( ppLink, pOld, pNew )) {
-                    if ( pNew != NULL ) {
-                        ++pNew->m_RC    ;
-                        pNew->m_bTrace.template store<membar_release>( false ) ;
-                    }
+                    if ( pNew != NULL )
+                        incRefLink( pNew )  ;
                     if ( pOld != NULL )
-                        --pOld->m_RC    ;
+                        decRefLink( pOld )  ;
                     return true    ;
                 }
                 return false    ;
@@ -599,12 +820,10 @@ namespace cds { namespace gc {
                 cds::details::marked_ptr<TNODE, BITS>& pNew )
             {
                 if ( ppLink->template cas<membar_acquire>( pOld, pNew )) {
-                    if ( !pNew.isNull() ) {
-                        ++pNew->m_RC    ;
-                        pNew->m_bTrace.template store<membar_release>( false ) ;
-                    }
+                    if ( !pNew.isNull() )
+                        incRefLink( pNew.ptr() )  ;
                     if ( !pOld.isNull() )
-                        --pOld->m_RC    ;
+                        decRefLink( pOld.ptr() )  ;
                     return true    ;
                 }
                 return false    ;
@@ -621,12 +840,10 @@ namespace cds { namespace gc {
             static TNODE * xchgRef( TNODE * volatile * ppLink, TNODE * pNew )
             {
                 TNODE * pOld = atomics::exchange<membar_acq_rel>( ppLink, pNew )  ;
-                if ( pNew != NULL ) {
-                    ++pNew->m_RC    ;
-                    pNew->m_bTrace.template store<membar_release>( false ) ;
-                }
+                if ( pNew != NULL )
+                    incRefLink( pNew )  ;
                 if ( pOld != NULL )
-                    --pOld->m_RC    ;
+                    decRefLink( pOld )  ;
                 return pOld         ;
             }
 
@@ -639,12 +856,10 @@ namespace cds { namespace gc {
             {
                 ContainerNode * pOld = *ppLink    ;
                 atomics::store<membar_release>( ppLink, pNew )    ;
-                if ( pNew != NULL ) {
-                    ++pNew->m_RC    ;
-                    pNew->m_bTrace.template store<membar_release>( false ) ;
-                }
+                if ( pNew != NULL )
+                    incRefLink( pNew )  ;
                 if ( pOld != NULL )
-                    --pOld->m_RC    ;
+                    decRefLink( pOld )  ;
             }
 
             //@cond
@@ -653,25 +868,21 @@ namespace cds { namespace gc {
             {
                 cds::details::marked_ptr<TNODE, BITS> pOld( *ppLink    ) ;
                 ppLink->set( pNew, pOld.bits() )    ;
-                if ( pNew != NULL ) {
-                    ++pNew->m_RC    ;
-                    pNew->m_bTrace.template store<membar_release>( false ) ;
-                }
+                if ( pNew != NULL )
+                    incRefLink( pNew )  ;
                 if ( !pOld.isNull() )
-                    --pOld->m_RC    ;
+                    decRefLink( pOld.ptr() )  ;
             }
             template <typename TNODE, int BITS>
             static void storeRef( cds::details::marked_ptr<TNODE, BITS> * ppLink, cds::details::marked_ptr<TNODE, BITS>& pNew )
             {
                 cds::details::marked_ptr<TNODE, BITS> pOld = *ppLink    ;
                 atomics::store<membar_release>( ppLink, pNew )    ;
-                if ( !pNew.isNull() ) {
-                    ++pNew->m_RC    ;
-                    pNew->m_bTrace.template store<membar_release>( false ) ;
-                }
+                if ( !pNew.isNull() )
+                    incRefLink( pNew.ptr() )  ;
                 if ( !pOld.isNull() ) {
                     assert( pOld->m_RC != 0 )   ;
-                    --pOld->m_RC    ;
+                    decRefLink( pOld.ptr() )  ;
                 }
             }
             //@endcond
@@ -702,8 +913,19 @@ namespace cds { namespace gc {
                 pNode->m_bDeleted.store<membar_relaxed>( true )   ;   
                 pNode->m_bTrace.store<membar_relaxed>( false )    ;
                 atomics::fence<membar_release>()        ;
+                pushRetired( pNode )    ;
+            }
+
+        protected:
+            /// Places retired node \p pNode into the array of retired nodes; reclaims the array if it is full
+            void pushRetired( ContainerNode * pNode )
+            {
                 m_pDesc->m_arrRetired.push( pNode )     ;
 
+                // Hand the full array off to the reclaimer; if it cannot accept, reclaim inline
+                if ( m_pDesc->m_arrRetired.isFull() )
+                    m_gc.handOff( this )    ;
+
                 while ( m_pDesc->m_arrRetired.isFull() ) {
                     cleanUpLocal()            ;
 
@@ -721,10 +943,10 @@ namespace cds { namespace gc {
                 }
             }
 
-        protected:
             /// The procedure will try to remove redundant claimed references from link in deleted nodes that has been deleted by this thread
             void cleanUpLocal()
             {
+                details::deferred_rc_log::scoped_bypass bypass( m_pDesc->m_RCLog )  ;
                 details::retired_vector::iterator itEnd = m_pDesc->m_arrRetired.end()    ;
                 for ( details::retired_vector::iterator it = m_pDesc->m_arrRetired.begin(); it != itEnd; ++it ) {
                     details::retired_node& node = *it ;
@@ -15,12 +15,40 @@
 #include <cds/atomic.h>
 #include <cds/gc/hzp/details/hp_fwd.h>
 #include <cds/gc/hzp/details/hp_type.h>
+#include <cds/gc/hzp/details/hp_fence.h>
 
 namespace cds {
     namespace gc { namespace hzp {
     /// Hazard Pointer schema implementation details
     namespace details {
 
+        /// Hazard pointer store
+        /**
+            The primary template is used by HRC GC: the hazard pointer is stored with release semantics.
+            The specialization for \ref HazardPtr (Hazard Pointer GC) follows the store by hp_fence::publish.
+        */
+        template <typename HPTYPE>
+        struct hp_publish
+        {
+            /// Stores \p val to the hazard pointer \p pHP
+            static void store( HPTYPE * pHP, HPTYPE val )
+            {
+                atomics::store<membar_release>( pHP, val )  ;
+            }
+        };
+
+        //@cond
+        template <>
+        struct hp_publish<HazardPtr>
+        {
+            static void store( HazardPtr * pHP, HazardPtr val )
+            {
+                atomics::store<membar_relaxed>( pHP, val )  ;
+                hp_fence::publish() ;
+            }
+        };
+        //@endcond
+
         /// Hazard pointer guard
         /**
             It is unsafe to use this class directly.
@@ -50,7 +78,7 @@ namespace cds {
             T * operator =( T * p )
             {
                 // We use atomic store with explicit memory order because other threads may read this hazard pointer concurrently
-                atomics::store<membar_release>( m_hzp, reinterpret_cast<HPTYPE>(p) )    ;
+                hp_publish<HPTYPE>::store( m_hzp, reinterpret_cast<HPTYPE>(p) )    ;
                 return p    ;
             }
 
@@ -113,7 +141,7 @@ namespace cds {
             void set( size_t nIndex, HPTYPE hzPtr )
             {
                 assert( nIndex < COUNT )    ;
-                atomics::store<membar_release>( m_arr + nIndex, hzPtr )   ;
+                hp_publish<HPTYPE>::store( m_arr + nIndex, hzPtr )   ;
             }
 
             /// Returns reference to hazard pointer of index \p nIndex (0 <= \p nIndex < \p COUNT)
@@ -139,9 +167,18 @@ namespace cds {
 
         /// Allocator of hazard pointers for the thread
         /**
-            The max size (capacity) of array is defined at ctor time and cannot be changed during object's lifetime
-            The array contains free item list that manages allocation and deallocation of array's free items
-            (i.e. unused hazard pointers)
+            The hazard pointers are kept in blocks of the same size. The first block is allocated at ctor time,
+            the size of block (\ref blockSize) is defined by the ctor parameter. When the thread needs more
+            hazard pointers than it has the owner calls \ref grow that appends new block.
+            The blocks are never moved or freed during object's lifetime, so the guards that point to a block
+            remain valid, and the other threads may read the hazard pointers concurrently with \ref grow:
+            a reader gets the count of published blocks by \ref blockCount and reads each \ref block.
+            The max count of blocks is \ref c_nMaxBlockCount.
+
+            Each block contains free item list that manages allocation and deallocation of block's free items
+            (i.e. unused hazard pointers). The guards are allocated and freed in LIFO order: when the current block
+            is exhausted, the allocator switches to next block, and when the current block becomes empty on freeing
+            the allocator returns to the previous block.
 
             Template parameters:
                 \li HPTYPE - type of hazard pointer (HazardPtr usually)
@@ -152,67 +189,125 @@ namespace cds {
         template < typename HPTYPE, class ALLOCATOR = CDS_DEFAULT_ALLOCATOR >
         class HPAllocator
         {
-            typedef cds::details::BoundedArray< HPTYPE, ALLOCATOR >    THazardArray    ;    ///< Hazard pointer array type
+        public:
+            /// Max count of blocks
+            static const size_t c_nMaxBlockCount = 32 ;
+
+        private:
+            //@cond
+            typedef typename ALLOCATOR::template rebind<HPTYPE>::other  block_allocator  ;
+
+            struct block {
+                HPTYPE *        m_arr   ;   ///< hazard pointers of the block
+                unsigned int    m_nTop  ;   ///< saved top of the free stack when the owner switches to next block
+            };
+            //@endcond
 
-            THazardArray                    m_arrHazardPtr  ;   ///< Array of hazard pointers
-            unsigned int                    m_nTop          ;   ///< The top of stack
+            block               m_arrBlocks[ c_nMaxBlockCount ] ;   ///< Blocks of hazard pointers
+            atomic<size_t>      m_nBlockCount   ;   ///< Count of published blocks
+            const unsigned int  m_nBlockSize    ;   ///< Count of hazard pointers in a block
+            size_t              m_nCurBlock     ;   ///< Current block (owner only)
+            unsigned int        m_nTop          ;   ///< The top of stack of current block (owner only)
 
         public:
             /// Default ctor
             explicit HPAllocator(
-                size_t nCapacity            ///< capacity
+                size_t nCapacity            ///< initial capacity, it is the size of block
                 )
-                : m_arrHazardPtr( nCapacity )
+                : m_nBlockCount( 0 )
+                , m_nBlockSize( (unsigned int) nCapacity )
             {
+                assert( nCapacity > 0 ) ;
+                m_arrBlocks[0].m_arr = allocBlock()  ;
+                m_nBlockCount.store<membar_release>( 1 )   ;
                 makeFreeStack()    ;
-                assert( m_arrHazardPtr.size() == capacity() )  ;
             }
 
             ~HPAllocator()
             {
-                assert( size() == capacity() ) ;
+                block_allocator a   ;
+                for ( size_t i = 0, nCount = blockCount(); i < nCount; ++i )
+                    a.deallocate( m_arrBlocks[i].m_arr, m_nBlockSize )  ;
             }
 
-            /// Get capacity of array
-            size_t capacity() const        { return m_arrHazardPtr.capacity()    ; }
+            /// Get capacity of array (total count of hazard pointers in all blocks)
+            size_t capacity() const        { return blockCount() * m_nBlockSize ; }
 
             /// Get size of array. The size should be equal to the capacity of array
-            size_t size() const            { return m_arrHazardPtr.size()    ; }
+            size_t size() const            { return capacity() ; }
 
             /// Checks if all items are allocated
-            bool isFull() const            { return m_nTop == 0; }
+            bool isFull() const            { return m_nTop == 0 && m_nCurBlock + 1 == blockCount() ; }
+
+            /// Checks if \p nCount hazard pointers can be allocated without \ref grow
+            bool hasFree( size_t nCount ) const
+            {
+                assert( nCount <= m_nBlockSize )    ;
+                return m_nTop >= nCount || m_nCurBlock + 1 < blockCount()   ;
+            }
+
+            /// Appends new block. Returns \p false if the max count of blocks is reached
+            /**
+                Only the owner thread may call this function.
+            */
+            bool grow()
+            {
+                size_t nCount = m_nBlockCount.load<membar_relaxed>()    ;
+                if ( nCount >= c_nMaxBlockCount )
+                    return false    ;
+                m_arrBlocks[ nCount ].m_arr = allocBlock()  ;
+                // Block content must be visible before the block is published
+                m_nBlockCount.store<membar_release>( nCount + 1 )   ;
+                return true ;
+            }
+
+            /// Returns count of hazard pointers in a block
+            size_t blockSize() const        { return m_nBlockSize; }
+
+            /// Returns count of published blocks
+            size_t blockCount() const       { return m_nBlockCount.load<membar_acquire>(); }
+
+            /// Returns hazard pointers of block \p nBlock, <tt>nBlock < blockCount()</tt>
+            const HPTYPE * block( size_t nBlock ) const
+            {
+                assert( nBlock < c_nMaxBlockCount ) ;
+                return m_arrBlocks[ nBlock ].m_arr  ;
+            }
 
             /// Allocates hazard pointer
             void alloc( HPGuardT<HPTYPE>& hp )
             {
-                assert( m_nTop > 0 )    ;
+                if ( m_nTop == 0 )
+                    nextBlock() ;
                 --m_nTop    ;
-                hp.m_hzp = m_arrHazardPtr + m_nTop  ;
-                assert( m_arrHazardPtr.size() == capacity() )   ;
+                hp.m_hzp = m_arrBlocks[ m_nCurBlock ].m_arr + m_nTop  ;
             }
 
             /// Frees previously allocated hazard pointer
             void free( HPGuardT<HPTYPE>& /*hp*/ )
             {
-                assert( m_nTop < capacity() )   ;
-                m_arrHazardPtr[ m_nTop ] = HPTYPE(0)    ;
+                if ( m_nTop == m_nBlockSize )
+                    prevBlock() ;
+                assert( m_nTop < m_nBlockSize ) ;
+                m_arrBlocks[ m_nCurBlock ].m_arr[ m_nTop ] = HPTYPE(0)    ;
                 ++m_nTop ;
                 CDS_COMPILER_RW_BARRIER ;
-                assert( m_arrHazardPtr.size() == capacity() )   ;
             }
 
             /// Allocates hazard pointers array
             /**
-                Allocates \p COUNT hazard pointers from array \p m_arrHazardPtr
+                Allocates \p COUNT contiguous hazard pointers from current block.
+                \p COUNT should not exceed \ref blockSize.
                 Returns initialized object \p arr
             */
             template <size_t COUNT>
             void alloc( HPArrayT<HPTYPE, COUNT>& arr )
             {
-                assert( m_nTop >= COUNT )   ;
+                assert( COUNT <= m_nBlockSize ) ;
+                if ( m_nTop < COUNT )
+                    nextBlock() ;
                 m_nTop -= COUNT ;
-                arr.m_arr = m_arrHazardPtr.top() + m_nTop   ;
-                assert( m_arrHazardPtr.size() == capacity() )   ;
+                arr.m_arr = m_arrBlocks[ m_nCurBlock ].m_arr + m_nTop   ;
             }
 
             /// Frees hazard pointer array
@@ -222,34 +317,57 @@ namespace cds {
             template <size_t COUNT>
             void free( const HPArrayT<HPTYPE, COUNT>& arr )
             {
-                assert( m_nTop + COUNT <= capacity())   ;
-                std::fill( m_arrHazardPtr.begin() + m_nTop, m_arrHazardPtr.begin() + m_nTop + COUNT, HPTYPE(0) ) ;
+                if ( m_nTop == m_nBlockSize )
+                    prevBlock() ;
+                assert( m_nTop + COUNT <= m_nBlockSize )   ;
+                HPTYPE * pTop = m_arrBlocks[ m_nCurBlock ].m_arr + m_nTop    ;
+                std::fill( pTop, pTop + COUNT, HPTYPE(0) ) ;
                 m_nTop += COUNT ;
-                assert( m_arrHazardPtr.size() == capacity() )   ;
             }
 
             /// Makes all HP free
             void clear()
             {
                 makeFreeStack()    ;
-                assert( m_arrHazardPtr.size() == capacity() )  ;
             }
 
-            /// Returns to i-th hazard pointer
-            HPTYPE operator []( size_t i )
+            /// Returns to i-th hazard pointer, <tt>i < capacity()</tt>
+            HPTYPE operator []( size_t i ) const
             {
-                assert( m_arrHazardPtr.size() == capacity() )  ;
                 assert( i < capacity() )    ;
-                return m_arrHazardPtr[i]    ;
+                return m_arrBlocks[ i / m_nBlockSize ].m_arr[ i % m_nBlockSize ]  ;
             }
 
         private:
             //@cond
+            HPTYPE * allocBlock()
+            {
+                HPTYPE * p = block_allocator().allocate( m_nBlockSize ) ;
+                std::fill( p, p + m_nBlockSize, HPTYPE(0) ) ;
+                return p    ;
+            }
+
             void makeFreeStack()
             {
-                assert( m_arrHazardPtr.size() == capacity() )   ;
-                m_arrHazardPtr.assign( capacity(), HPTYPE(0) )   ;
-                m_nTop = (unsigned int) capacity() ;
+                for ( size_t i = 0, nCount = blockCount(); i < nCount; ++i )
+                    std::fill( m_arrBlocks[i].m_arr, m_arrBlocks[i].m_arr + m_nBlockSize, HPTYPE(0) ) ;
+                m_nCurBlock = 0 ;
+                m_nTop = m_nBlockSize   ;
+            }
+
+            void nextBlock()
+            {
+                assert( m_nCurBlock + 1 < blockCount() )    ;   // grow() must be called before
+                m_arrBlocks[ m_nCurBlock ].m_nTop = m_nTop  ;
+                ++m_nCurBlock   ;
+                m_nTop = m_nBlockSize   ;
+            }
+
+            void prevBlock()
+            {
+                assert( m_nCurBlock > 0 )   ;
+                --m_nCurBlock   ;
+                m_nTop = m_arrBlocks[ m_nCurBlock ].m_nTop  ;
             }
             //@endcond
         };
@@ -0,0 +1,82 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+#ifndef __CDS_GC_HZP_DETAILS_HP_FENCE_H
+#define __CDS_GC_HZP_DETAILS_HP_FENCE_H
+
+#include <cds/atomic.h>
+#include <cds/os/membarrier.h>
+#include <cds/gc/hzp/details/hp_fwd.h>
+
+namespace cds {
+    namespace gc { namespace hzp {
+
+        /// Memory fence mode of hazard pointer publication
+        /**
+            A thread publishes a hazard pointer and then re-reads the source link to validate it.
+            GarbageCollector::Scan must see the hazard pointer if the validation succeeded,
+            therefore the hazard pointer store must be ordered before the validating load (store-load order).
+            The mode is specified in GarbageCollector::Construct.
+        */
+        enum fence_type {
+            fence_full,         ///< full memory fence after each hazard pointer store (classic)
+            fence_asymmetric    ///< compiler barrier after hazard pointer store, Scan forces the memory barrier on all threads (see cds::OS::asymmetric_fence)
+        };
+
+    namespace details {
+
+        /// Hazard pointer publication fence
+        /**
+            In \ref fence_full mode \ref publish is the full memory fence and \ref scan is the full memory fence too.
+
+            In \ref fence_asymmetric mode \ref publish is the compiler barrier only and \ref scan
+            is the process-wide \p membarrier(2) (cds::OS::asymmetric_fence::heavy) that serializes
+            all running threads of the process before Scan reads hazard pointers. The reader's hot path
+            does not pay for the fence instruction, Scan pays one system call.
+            If \p membarrier is not supported the asymmetric mode falls back to \ref fence_full.
+        */
+        class CDS_EXPORT_API hp_fence
+        {
+            //@cond
+            static bool s_bAsymmetric   ;   ///< true - asymmetric mode is on
+
+            friend class cds::gc::hzp::GarbageCollector ;
+            //@endcond
+
+        public:
+            /// Checks if the asymmetric mode is on
+            static bool isAsymmetric()
+            {
+                return s_bAsymmetric    ;
+            }
+
+            /// Reader-side fence: call it after the hazard pointer is stored and before the source is re-read
+            static void publish()
+            {
+                if ( s_bAsymmetric )
+                    CDS_COMPILER_RW_BARRIER ;
+                else
+                    atomics::fence( membar_seq_cst::order ) ;
+            }
+
+            /// Scan-side fence: call it before hazard pointers of other threads are read
+            static void scan()
+            {
+                if ( s_bAsymmetric )
+                    cds::OS::asymmetric_fence::heavy()  ;
+                else
+                    atomics::fence( membar_seq_cst::order ) ;
+            }
+        };
+
+    }   // namespace details
+    }}  // namespace gc::hzp
+}   // namespace cds
+
+#endif // #ifndef __CDS_GC_HZP_DETAILS_HP_FENCE_H
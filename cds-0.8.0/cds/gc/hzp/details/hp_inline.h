@@ -18,7 +18,7 @@ namespace cds {
         /* INLINES                                                              */
         /************************************************************************/
         inline retired_vector::retired_vector( const cds::gc::hzp::GarbageCollector& HzpMgr )
-            : m_arr( HzpMgr.getMaxRetiredPtrCount() ),
+            : m_arr( HzpMgr.getHazardPointerCount() * 2 ),
             m_nSize(0)
         {}
 
@@ -14,7 +14,7 @@
 #include <cds/gc/hzp/details/hp_fwd.h>
 #include <cds/gc/hzp/details/hp_type.h>
 
-#include <cds/details/bounded_array.h>
+#include <vector>
 
 namespace cds {
     namespace gc{ namespace hzp { namespace details {
@@ -27,12 +27,13 @@ namespace cds {
             The vector of retired pointer ready to delete.
 
             The Hazard Pointer schema is build on thread-static arrays. For each HP-enabled thread the HP manager allocates
-            array of retired pointers. The array belongs to the thread: owner thread writes to the array, other threads
-            just read it.
+            array of retired pointers. The array belongs to the thread: only the thread that owns the HP record
+            accesses the array, so the array may grow (see \ref push). The thread calls Scan
+            when the array size reaches GarbageCollector::getScanThreshold().
         */
         class retired_vector {
             /// Underlying vector implementation
-            typedef cds::details::BoundedArray<retired_ptr>    retired_vector_impl    ;
+            typedef std::vector<retired_ptr>    retired_vector_impl    ;
 
             retired_vector_impl m_arr   ;   ///< the array of retired pointers
             size_t              m_nSize ;   ///< Current size of \p m_arr
@@ -48,9 +49,9 @@ namespace cds {
 
             /// Vector capacity.
             /**
-                The capacity is constant for any thread. It is defined by cds::gc::hzp::GarbageCollector.
+                The initial capacity is defined by cds::gc::hzp::GarbageCollector, \ref push doubles it when the vector is full.
             */
-            size_t capacity() const     { return m_arr.capacity(); }
+            size_t capacity() const     { return m_arr.size(); }
 
             /// Current vector size (count of retired pointers in the vector)
             size_t size() const         { return m_nSize; }
@@ -62,10 +63,11 @@ namespace cds {
                 m_nSize = nSize     ;
             }
 
-            /// Pushes retired pointer to the vector
+            /// Pushes retired pointer to the vector. If the vector is full its capacity is doubled
             void push( const retired_ptr& p )
             {
-                assert( m_nSize < capacity() )  ;
+                if ( m_nSize >= capacity() )
+                    m_arr.resize( capacity() * 2 )  ;
                 m_arr[ m_nSize ] = p            ;
                 ++m_nSize                       ;
             }
@@ -79,7 +81,7 @@ namespace cds {
             /// Begin iterator
             iterator    begin()    { return m_arr.begin(); }
             /// End iterator
-            iterator    end()    { return m_arr.end( m_nSize ); }
+            iterator    end()    { return m_arr.begin() + m_nSize; }
 
             /// Clears the vector. After clearing, size() == 0
             void clear()
@@ -0,0 +1,121 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_HZP_DETAILS_HP_SCAN_H
+#define __CDS_GC_HZP_DETAILS_HP_SCAN_H
+
+#include <cds/details/defs.h>
+#include <vector>
+#include <algorithm>    // std::fill
+
+namespace cds {
+    namespace gc{ namespace hzp { namespace details {
+
+        /// Set of hazard pointers collected by Scan
+        /**
+            The set is the private scan buffer of the thread's HP record. Scan collects non-null hazard pointers
+            of all HP records into the snapshot buffer (\ref push) and then builds an open-addressing hash table
+            with linear probing over the snapshot (\ref build). Search of a retired pointer (\ref contains)
+            costs O(1) on average instead of binary search in the sorted list.
+
+            The buffers are reused from scan to scan, so after warm-up the scan does not allocate memory.
+            The hash table size is a power of two not less than twice the count of hazard pointers found,
+            so only the part of the table that is really used is cleared.
+        */
+        class hazard_set
+        {
+            std::vector<void *>     m_arrSnapshot   ;   ///< non-null hazard pointers found
+            std::vector<void *>     m_arrTable      ;   ///< open-addressing hash table; NULL is empty slot
+            size_t                  m_nMask         ;   ///< hash table size - 1
+            unsigned int            m_nShift        ;   ///< bit count of size_t - log2( hash table size )
+
+            //@cond
+            size_t hash( void * p ) const
+            {
+                // Fibonacci hashing: the index is the high bits of the product.
+                // The low bits of the product depend only on the low bits of the pointer that are zero because of alignment
+#       if CDS_BUILD_BITS == 64
+                return ( size_t(p) * size_t(0x9E3779B97F4A7C15ULL) ) >> m_nShift   ;
+#       else
+                return ( size_t(p) * size_t(0x9E3779B9UL) ) >> m_nShift ;
+#       endif
+            }
+            //@endcond
+
+        public:
+            //@cond
+            hazard_set()
+                : m_nMask( 0 )
+                , m_nShift( sizeof(size_t) * 8 - 4 )
+            {}
+            //@endcond
+
+            /// Clears the snapshot. \p nMaxCount is the max count of hazard pointers that can be pushed
+            void reset( size_t nMaxCount )
+            {
+                m_arrSnapshot.clear()   ;
+                if ( m_arrSnapshot.capacity() < nMaxCount )
+                    m_arrSnapshot.reserve( nMaxCount )  ;
+            }
+
+            /// Adds non-null hazard pointer \p p to the snapshot
+            void push( void * p )
+            {
+                assert( p != NULL ) ;
+                m_arrSnapshot.push_back( p )    ;
+            }
+
+            /// Returns count of hazard pointers in the snapshot
+            size_t size() const
+            {
+                return m_arrSnapshot.size() ;
+            }
+
+            /// Builds the hash table from the snapshot
+            void build()
+            {
+                size_t nSize = 16   ;
+                unsigned int nLog2 = 4  ;
+                while ( nSize < m_arrSnapshot.size() * 2 ) {
+                    nSize <<= 1 ;
+                    ++nLog2 ;
+                }
+                if ( m_arrTable.size() < nSize )
+                    m_arrTable.resize( nSize )  ;
+                std::fill( m_arrTable.begin(), m_arrTable.begin() + nSize, (void *) NULL ) ;
+                m_nMask = nSize - 1 ;
+                m_nShift = (unsigned int)( sizeof(size_t) * 8 ) - nLog2  ;
+
+                for ( std::vector<void *>::const_iterator it = m_arrSnapshot.begin(); it != m_arrSnapshot.end(); ++it ) {
+                    size_t i = hash( *it )  ;
+                    while ( m_arrTable[i] != NULL && m_arrTable[i] != *it )
+                        i = (i + 1) & m_nMask   ;
+                    m_arrTable[i] = *it ;
+                }
+            }
+
+            /// Checks if \p p is in the hash table. \ref build must be called before
+            bool contains( void * p ) const
+            {
+                size_t i = hash( p )    ;
+                void * q    ;
+                while ( (q = m_arrTable[i]) != NULL ) {
+                    if ( q == p )
+                        return true ;
+                    i = (i + 1) & m_nMask   ;
+                }
+                return false    ;
+            }
+        };
+
+    } } }    // namespace gc::hzp::details
+}    // namespace cds
+
+#endif // #ifndef __CDS_GC_HZP_DETAILS_HP_SCAN_H
@@ -312,17 +312,19 @@ namespace cds { namespace gc { namespace hzp {
                 See GarbageCollector::Construct for explanation of parameters meaning.
             */
             GC(
-                size_t nHazardPtrCount = 0,     ///< Hazard pointer count per thread
-                size_t nMaxThreadCount = 0,     ///< Max count of thread in your application
-                size_t nMaxRetiredPtrCount = 0, ///< Capacity of the array of retired objects for the thread
-                scan_type nScanType = inplace   ///< Scan type (see \ref scan_type enum)
+                size_t nHazardPtrCount = 0,     ///< Initial hazard pointer count per thread
+                size_t nMaxThreadCount = 0,     ///< Expected count of thread in your application
+                size_t nMaxRetiredPtrCount = 0, ///< Upper limit of scan threshold, 0 - no limit
+                scan_type nScanType = inplace,  ///< Scan type (see \ref scan_type enum)
+                fence_type nFenceType = fence_full  ///< Fence mode (see \ref fence_type enum)
             )
             {
                 GarbageCollector::Construct(
                     nHazardPtrCount,
                     nMaxThreadCount,
                     nMaxRetiredPtrCount,
-                    nScanType
+                    nScanType,
+                    nFenceType
                 )   ;
             }
 
@@ -18,6 +18,8 @@
 #include <cds/gc/hzp/details/hp_fwd.h>
 #include <cds/gc/hzp/details/hp_alloc.h>
 #include <cds/gc/hzp/details/hp_retired.h>
+#include <cds/gc/hzp/details/hp_scan.h>
+#include <cds/gc/details/free_rec_cache.h>
 
 #include <vector>
 #include <boost/noncopyable.hpp>
@@ -63,6 +65,7 @@ namespace cds {
             struct HPRec {
                 HPAllocator<HazardPtr>    m_hzp         ; ///< array of hazard pointers. Implicit \ref CDS_DEFAULT_ALLOCATOR dependency
                 retired_vector            m_arrRetired ; ///< Retired pointer array
+                hazard_set                m_Hazards    ; ///< Scan buffer, private for owner thread
 
                 /// Ctor
                 HPRec( const cds::gc::hzp::GarbageCollector& HzpMgr ) ;    // inline
@@ -95,16 +98,24 @@ namespace cds {
             \li [2003] Maged M.Michael "Hazard Pointers: Safe memory reclamation for lock-free objects"
             \li [2004] Andrei Alexandrescy, Maged Michael "Lock-free Data Structures with Hazard Pointers"
 
+            The reader-side store-load fence of hazard pointer publication is defined by \ref fence_type
+            passed to \ref Construct. In \ref fence_asymmetric mode the reader executes only the compiler barrier
+            and Scan issues the process-wide \p membarrier(2) before it reads hazard pointers
+            (see details::hp_fence). The mode pays off when the containers are read much more often than
+            Scan is called, that is, when the capacity of retired array is large.
         */
         class CDS_EXPORT_API GarbageCollector
         {
         public:
             /// Internal GC statistics
             struct InternalState {
-                size_t              nHPCount                ;   ///< HP count per thread (const)
-                size_t              nMaxThreadCount         ;   ///< Max thread count (const)
-                size_t              nMaxRetiredPtrCount     ;   ///< Max retired pointer count per thread (const)
-                size_t              nHPRecSize              ;   ///< Size of HP record, bytes (const)
+                size_t              nHPCount                ;   ///< Initial HP count per thread, it is the size of HP block (const)
+                size_t              nMaxThreadCount         ;   ///< Expected thread count (const)
+                size_t              nMaxRetiredPtrCount     ;   ///< Upper limit of scan threshold, 0 - no limit (const)
+                size_t              nHPRecSize              ;   ///< Initial size of HP record, bytes (const)
+
+                size_t              nLiveHPCount            ;   ///< Current count of hazard pointers of attached threads
+                size_t              nScanThreshold          ;   ///< Current scan threshold (see GarbageCollector::getScanThreshold)
 
                 size_t              nHPRecAllocated         ;   ///< Count of HP record allocations
                 size_t              nHPRecUsed              ;   ///< Count of HP record used
@@ -112,9 +123,11 @@ namespace cds {
                 size_t              nRetiredPtrInFreeHPRecs ;   ///< Count of retired pointer in free (unused) HP records
 
                 atomics::event_counter::value_type  evcAllocHPRec   ;   ///< Count of HPRec allocations
+                atomics::event_counter::value_type  evcAllocHPRecCached;///< Count of HPRec allocations served by the free-record cache
                 atomics::event_counter::value_type  evcRetireHPRec  ;   ///< Count of HPRec retire events
                 atomics::event_counter::value_type  evcAllocNewHPRec;   ///< Count of new HPRec allocations from heap
                 atomics::event_counter::value_type  evcDeleteHPRec  ;   ///< Count of HPRec deletions
+                atomics::event_counter::value_type  evcGrowHPRec    ;   ///< Count of HP block allocations for HPRec
 
                 atomics::event_counter::value_type  evcScanCall     ;   ///< Count of Scan calling
                 atomics::event_counter::value_type  evcHelpScanCall ;   ///< Count of HelpScan calling
@@ -122,6 +135,11 @@ namespace cds {
 
                 atomics::event_counter::value_type  evcDeletedNode  ;   ///< Count of deleting of retired objects
                 atomics::event_counter::value_type  evcDeferredNode ;   ///< Count of objects that cannot be deleted in Scan phase because of a HazardPtr guards it
+                atomics::event_counter::value_type  evcScanHazard   ;   ///< Total count of non-null hazard pointers seen by Scan
+                double                              fScanTime       ;   ///< Total time of Scan calls, seconds
+
+                atomics::event_counter::value_type  evcHandOff      ;   ///< Count of retired arrays handed off to the reclaimer thread
+                atomics::event_counter::value_type  evcHandOffReject;   ///< Count of hand-off failures because the reclaimer backlog is full
             } ;
 
             /// No GarbageCollector object is created
@@ -134,9 +152,11 @@ namespace cds {
             /// Internal GC statistics
             struct Statistics {
                 atomics::event_counter  m_AllocHPRec            ;    ///< Count of HPRec allocations
+                atomics::event_counter  m_AllocHPRecCached      ;    ///< Count of HPRec allocations served by the free-record cache
                 atomics::event_counter  m_RetireHPRec            ;    ///< Count of HPRec retire events
                 atomics::event_counter  m_AllocNewHPRec            ;    ///< Count of new HPRec allocations from heap
                 atomics::event_counter  m_DeleteHPRec            ;    ///< Count of HPRec deletions
+                atomics::event_counter  m_GrowHPRec             ;    ///< Count of HP block allocations for HPRec
 
                 atomics::event_counter  m_ScanCallCount            ;    ///< Count of Scan calling
                 atomics::event_counter  m_HelpScanCallCount        ;    ///< Count of HelpScan calling
@@ -144,6 +164,11 @@ namespace cds {
 
                 atomics::event_counter  m_DeletedNode            ;    ///< Count of retired objects deleting
                 atomics::event_counter  m_DeferredNode            ;    ///< Count of objects that cannot be deleted in Scan phase because of a HazardPtr guards it
+                atomics::event_counter  m_ScanHazard            ;    ///< Total count of non-null hazard pointers seen by Scan
+                atomics::event_counter  m_ScanTime              ;    ///< Total time of Scan calls, in cds::OS::Timer native units
+
+                atomics::event_counter  m_HandOff               ;    ///< Count of retired arrays handed off to the reclaimer thread
+                atomics::event_counter  m_HandOffReject         ;    ///< Count of hand-off failures because the reclaimer backlog is full
             };
 
             /// Internal list of cds::gc::hzp::details::HPRec
@@ -171,25 +196,33 @@ namespace cds {
 
 
             hplist_node *     m_pListHead  ;            ///< Head of GC list
+            cds::gc::details::free_record_cache<hplist_node>  m_FreeRecCache ; ///< Recently released HP records (see \ref AllocateHPRec)
 
             static GarbageCollector *    m_pHZPManager  ;   ///< GC instance pointer
 
             Statistics              m_Stat              ;   ///< Internal statistics
             bool                    m_bStatEnabled      ;   ///< true - statistics enabled
 
-            const size_t            m_nHazardPointerCount   ;   ///< max count of thread's hazard pointer
-            const size_t            m_nMaxThreadCount       ;   ///< max count of thread
-            const size_t            m_nMaxRetiredPtrCount   ;   ///< max count of retired ptr per thread
+            const size_t            m_nHazardPointerCount   ;   ///< initial count of thread's hazard pointer (size of HP block)
+            const size_t            m_nMaxThreadCount       ;   ///< expected count of thread
+            const size_t            m_nMaxRetiredPtrCount   ;   ///< upper limit of scan threshold, 0 - no limit
             scan_type               m_nScanType             ;   ///< scan type (see \ref scan_type enum)
+            const fence_type        m_nFenceType            ;   ///< effective fence mode (see \ref fence_type enum)
+            atomic<size_t>          m_nLiveHPCount          ;   ///< count of hazard pointers of owned HP records (see \ref getScanThreshold)
 
+            //@cond
+            class reclaimer_impl    ;
+            //@endcond
+            atomic<reclaimer_impl *> m_pReclaimer           ;   ///< background reclaimer; NULL if it is disabled (see \ref enableReclaimer)
 
         private:
             /// Ctor
             GarbageCollector(
-                size_t nHazardPtrCount = 0,         ///< Hazard pointer count per thread
-                size_t nMaxThreadCount = 0,         ///< Max count of thread
-                size_t nMaxRetiredPtrCount = 0,     ///< Capacity of the array of retired objects
-                scan_type nScanType = inplace       ///< Scan type (see \ref scan_type enum)
+                size_t nHazardPtrCount = 0,         ///< Initial hazard pointer count per thread
+                size_t nMaxThreadCount = 0,         ///< Expected count of thread
+                size_t nMaxRetiredPtrCount = 0,     ///< Upper limit of scan threshold, 0 - no limit
+                scan_type nScanType = inplace,      ///< Scan type (see \ref scan_type enum)
+                fence_type nFenceType = fence_full  ///< Fence mode (see \ref fence_type enum)
             )    ;
 
             /// Dtor
@@ -222,21 +255,30 @@ namespace cds {
 
                 The Michael's HP reclamation schema depends of three parameters:
 
-                \p nHazardPtrCount - HP pointer count per thread. Usually it is small number (2-4) depending from
+                \p nHazardPtrCount - initial HP pointer count per thread. Usually it is small number (2-4) depending from
                                      the data structure algorithms. By default, if \p nHazardPtrCount = 0,
                                      the function uses maximum of HP count for CDS library.
+                                     If a thread needs more hazard pointers, its HP record grows by blocks of
+                                     \p nHazardPtrCount pointers (see \ref checkHPCount).
+                                     Size of HP array (details::HPArray) cannot exceed \p nHazardPtrCount.
+
+                \p nMaxThreadCount - expected count of thread with using HP GC in your application. Default is 100.
+                                    It is not a limit: it just reserves the scan buffer.
 
-                \p nMaxThreadCount - max count of thread with using HP GC in your application. Default is 100.
+                \p nMaxRetiredPtrCount - upper limit of the scan threshold (see \ref getScanThreshold).
+                                    Default is 0 - no limit: the threshold and the capacity of the array of retired pointers
+                                    follow the count of hazard pointers of the attached threads.
 
-                \p nMaxRetiredPtrCount - capacity of array of retired pointers for each thread. Must be greater than
-                                    \p nHazardPtrCount * \p nMaxThreadCount.
-                                    Default is 2 * \p nHazardPtrCount * \p nMaxThreadCount.
+                \p nFenceType - reader-side fence mode. \ref fence_asymmetric registers the process
+                                    for expedited \p membarrier(2); if the system call is not supported
+                                    the GC works in \ref fence_full mode (see \ref getFenceType).
             */
             static void    CDS_STDCALL Construct(
-                size_t nHazardPtrCount = 0,     ///< Hazard pointer count per thread
-                size_t nMaxThreadCount = 0,     ///< Max count of thread in your application
-                size_t nMaxRetiredPtrCount = 0, ///< Capacity of the array of retired objects for the thread
-                scan_type nScanType = inplace   ///< Scan type (see \ref scan_type enum)
+                size_t nHazardPtrCount = 0,     ///< Initial hazard pointer count per thread
+                size_t nMaxThreadCount = 0,     ///< Expected count of thread in your application
+                size_t nMaxRetiredPtrCount = 0, ///< Upper limit of scan threshold, 0 - no limit
+                scan_type nScanType = inplace,  ///< Scan type (see \ref scan_type enum)
+                fence_type nFenceType = fence_full  ///< Fence mode (see \ref fence_type enum)
             );
 
             /// Destroys global instance of GarbageCollector
@@ -264,15 +306,37 @@ namespace cds {
                 return m_pHZPManager != NULL    ;
             }
 
-            /// Returns max Hazard Pointer count defined in construction time
+            /// Returns initial Hazard Pointer count per thread defined in construction time
+            /**
+                It is also the size of HP block the thread's HP record grows by.
+            */
             size_t            getHazardPointerCount() const        { return m_nHazardPointerCount; }
 
-            /// Returns max thread count defined in construction time
+            /// Returns max count of hazard pointers per thread
+            size_t            getMaxHazardPointerCount() const     { return m_nHazardPointerCount * details::HPAllocator<HazardPtr>::c_nMaxBlockCount; }
+
+            /// Returns expected thread count defined in construction time
             size_t            getMaxThreadCount() const             { return m_nMaxThreadCount; }
 
-            /// Returns max size of retired objects array. It is defined in construction time
+            /// Returns upper limit of scan threshold, 0 - no limit. It is defined in construction time
             size_t            getMaxRetiredPtrCount() const        { return m_nMaxRetiredPtrCount; }
 
+            /// Returns count of retired objects that triggers Scan
+            /**
+                The threshold is adapted to the count of live (attached) threads: it is
+                twice the total count of hazard pointers of all attached threads
+                limited by \ref getMaxRetiredPtrCount (if it is not 0).
+                So Scan frees at least half of the retired objects whatever the thread count is,
+                and the thread holds no more retired objects than needed for that.
+            */
+            size_t getScanThreshold() const
+            {
+                size_t nThreshold = 2 * m_nLiveHPCount.load<membar_relaxed>() ;
+                if ( nThreshold < m_nHazardPointerCount )
+                    nThreshold = m_nHazardPointerCount  ;
+                return m_nMaxRetiredPtrCount && m_nMaxRetiredPtrCount < nThreshold ? m_nMaxRetiredPtrCount : nThreshold ;
+            }
+
             // Internal statistics
 
             /// Get internal statistics
@@ -291,11 +355,12 @@ namespace cds {
 
             /// Checks that required hazard pointer count \p nRequiredCount is less or equal then max hazard pointer count
             /**
-                If \p nRequiredCount > getHazardPointerCount() then the exception HZPTooMany is thrown
+                The thread's HP record grows on demand, so the check is against \ref getMaxHazardPointerCount.
+                If \p nRequiredCount > getMaxHazardPointerCount() then the exception HZPTooMany is thrown
             */
             static void checkHPCount( unsigned int nRequiredCount )
             {
-                if ( instance().getHazardPointerCount() < nRequiredCount )
+                if ( instance().getMaxHazardPointerCount() < nRequiredCount )
                     throw HZPTooMany()  ;
             }
 
@@ -316,27 +381,79 @@ namespace cds {
                 m_nScanType = nScanType ;
             }
 
+            /// Get effective fence mode
+            /**
+                The result is \ref fence_full if \ref fence_asymmetric has been requested
+                but \p membarrier(2) is not supported.
+            */
+            fence_type getFenceType() const
+            {
+                return m_nFenceType ;
+            }
+
+            /// Checks if the background reclaimer thread is enabled
+            bool isReclaimerEnabled() const
+            {
+                return m_pReclaimer.load<membar_relaxed>() != NULL ;
+            }
+
+            /// Enables/disables the background reclaimer thread
+            /**
+                When the reclaimer is enabled, a thread that has filled its array of retired pointers
+                hands the array off to the dedicated reclaimer thread instead of calling \ref Scan and \ref HelpScan,
+                so the scan latency does not hit the container operation (see cds::gc::details::reclaimer).
+                If more than \p nMaxBacklog arrays are waiting for the reclaimer, the thread scans inline as before.
+
+                The function is not thread-safe: call it when no other thread uses the GC, for example,
+                just after \ref Construct. \ref Destruct stops the reclaimer.
+
+                Returns previous state.
+            */
+            bool enableReclaimer(
+                bool bEnable,               ///< \p true - start the reclaimer, \p false - stop it
+                size_t nMaxBacklog = 16     ///< max count of arrays waiting for the reclaimer
+            )   ;
+
         public:    // Internals for threads
 
             /// Allocates Hazard Pointer GC record. For internal use only
+            /**
+                The function tries the records recently released by \ref RetireHPRec first
+                (see cds::gc::details::free_record_cache), then any free record of the list,
+                and only then allocates new record. The record reused keeps its hazard pointer blocks
+                and its array of retired pointers with the pointers left by the previous owner.
+            */
             details::HPRec * AllocateHPRec()    ;
 
             /// Free HP record. For internal use only
+            /**
+                The function does not scan: the retired pointers are left in the record
+                for the next owner of the record or for \ref HelpScan.
+            */
             void RetireHPRec( details::HPRec * pRec )    ;
 
+            /// Appends new block of hazard pointers to \p pRec. For internal use only
+            /**
+                If the max count of blocks is reached the exception HZPTooMany is thrown
+            */
+            void GrowHPRec( details::HPRec * pRec )    ;
+
             /// The main garbage collecting function
             /**
-                This function is called internally by ThreadGC object when upper bound of thread's list of reclaimed pointers
-                is reached.
+                This function is called internally by ThreadGC object when the thread's list of reclaimed pointers
+                reaches \ref getScanThreshold.
 
                 There are the following scan algorithm:
-                \li \ref classic_scan allocates memory for internal use
-                \li \ref inplace_scan does not allocate any memory
+                \li \ref classic_scan uses hash set of hazard pointers built in the thread's scan buffer
+                \li \ref inplace_scan does not use any buffer
 
                 Use \ref setScanType function to setup appropriate scan algorithm.
             */
             void Scan( details::HPRec * pRec )    
             {
+                // Hazard pointers published before the retired nodes were unlinked must be visible
+                details::hp_fence::scan()   ;
+
                 switch ( m_nScanType ) {
                     case inplace:
                         inplace_scan( pRec )   ;
@@ -360,6 +477,23 @@ namespace cds {
             */
             void HelpScan( details::HPRec * pThis ) ;
 
+            /// Hands the full array of retired pointers of \p pRec off to the reclaimer thread. For internal use only
+            /**
+                Returns \p false if the reclaimer is disabled or cannot accept the array;
+                in this case the caller should call \ref Scan.
+            */
+            bool handOff( details::HPRec * pRec )
+            {
+                // The reclaimer is read once: it may be disabled concurrently
+                reclaimer_impl * pReclaimer = m_pReclaimer.load<membar_acquire>()  ;
+                return pReclaimer != NULL && handOff( pReclaimer, pRec )   ;
+            }
+
+        private:
+            //@cond
+            bool handOff( reclaimer_impl * pReclaimer, details::HPRec * pRec )  ;
+            //@endcond
+
         protected:
             /// Classic scan algorithm
             /**
@@ -369,18 +503,19 @@ namespace cds {
                 Whenever a non-null value is encountered, it is inserted in a local list of currently protected pointer.
                 Only stage 1 accesses shared variables. The following stages operate only on private variables.
 
-                The second stage of a scan involves sorting local list of protected pointers to allow
-                binary search in the third stage.
+                The second stage of a scan involves building the hash set of protected pointers
+                (see details::hazard_set) to allow O(1) search in the third stage.
 
                 The third stage of a scan involves checking each reclaimed node
-                against the pointers in local list of protected pointers. If the binary search yields
+                against the hash set of protected pointers. If the search yields
                 no match, the node is freed. Otherwise, it cannot be deleted now and must kept in thread's list
                 of reclaimed pointers.
 
                 The forth stage prepares new thread's private list of reclaimed pointers
                 that could not be freed during the current scan, where they remain until the next scan.
 
-                This algorithm allocates memory for internal HP array.
+                The list of protected pointers and the hash set are kept in the HP record of the thread
+                and reused, so the algorithm allocates memory only on first scans.
 
                 This function is called internally by ThreadGC object when upper bound of thread's list of reclaimed pointers
                 is reached.
@@ -441,6 +576,8 @@ namespace cds {
             void allocGuard( details::HPGuard& guard )
             {
                 assert( m_pHzpRec != NULL )    ;
+                if ( !m_pHzpRec->m_hzp.hasFree( 1 ) )
+                    m_HzpManager.GrowHPRec( m_pHzpRec ) ;
                 m_pHzpRec->m_hzp.alloc( guard )    ;
             }
 
@@ -456,6 +593,8 @@ namespace cds {
             void allocGuard( details::HPArray<COUNT>& arr )
             {
                 assert( m_pHzpRec != NULL )    ;
+                if ( !m_pHzpRec->m_hzp.hasFree( COUNT ) )
+                    m_HzpManager.GrowHPRec( m_pHzpRec ) ;
                 m_pHzpRec->m_hzp.alloc( arr )    ;
             }
 
@@ -479,10 +618,12 @@ namespace cds {
             {
                 m_pHzpRec->m_arrRetired.push( p ) ;
 
-                if ( m_pHzpRec->m_arrRetired.isFull() ) {
-                    // Max of retired pointer count is reached. Do scan
-                    m_HzpManager.Scan( m_pHzpRec )     ;
-                    m_HzpManager.HelpScan( m_pHzpRec ) ;
+                if ( m_pHzpRec->m_arrRetired.size() >= m_HzpManager.getScanThreshold() ) {
+                    // Scan threshold is reached. Hand off the array to the reclaimer or do scan
+                    if ( !m_HzpManager.handOff( m_pHzpRec ) ) {
+                        m_HzpManager.Scan( m_pHzpRec )     ;
+                        m_HzpManager.HelpScan( m_pHzpRec ) ;
+                    }
                 }
             }
 
@@ -497,7 +638,7 @@ namespace cds {
                 TNODE * p    ;
                 while ( true ) {
                     p = atomics::load<membar_relaxed>( ppNode ) ;
-                    atomics::store<membar_release>( &hp, reinterpret_cast<HazardPtr>(p) )    ;
+                    details::hp_publish<HazardPtr>::store( &hp, reinterpret_cast<HazardPtr>(p) )    ;
                     if ( atomics::load<membar_acquire>( ppNode ) == p )
                         break    ;
                 }
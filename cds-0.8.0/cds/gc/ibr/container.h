@@ -0,0 +1,97 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_IBR_CONTAINER_H
+#define __CDS_GC_IBR_CONTAINER_H
+
+#include <cds/gc/ibr/ibr.h>
+#include <cds/threading/model.h>
+
+namespace cds { namespace gc {
+    namespace ibr {
+
+        ///  The base for all containers based on the interval-based GC
+        /**
+            Template parameters:
+            \li \p NODE            Container's node type
+            \li \p ALLOCATOR    Node allocator. Default is \ref CDS_DEFAULT_ALLOCATOR
+
+            The nodes are allocated by era_allocator over \p ALLOCATOR, so each node carries its birth era.
+        */
+        template <typename NODE, class ALLOCATOR = CDS_DEFAULT_ALLOCATOR >
+        class Container
+        {
+        public:
+            typedef ibr_gc    gc_schema            ;    ///< type of garbage collector
+
+        public:
+            typedef NODE                                                Node            ; ///< container's node type
+            typedef era_allocator< Node, ALLOCATOR >                    TAllocator      ; ///< type of node allocator
+            typedef cds::details::Allocator< Node, TAllocator >         node_allocator  ; ///< wrapper for node allocator
+
+        protected:
+            typedef gc::ibr::ThreadGC                               thread_gc           ; ///< IBR GC thread manager
+            node_allocator                                          m_NodeAllocator     ; ///< Node allocator
+
+        public:
+            /// Default functor to delete retired node
+            /**
+                The functor for deleting retired node relates to the type_traits of a container. The container should
+                define its own functor if it may contain the nodes of various type.
+
+                When a node is being retired the interval-based GC places to the thread's retired array (of type details::retired_vector)
+                the pointer to the node, the pointer to node's freeing function and the lifetime of the node.
+                Then, in GarbageCollector::Scan phase, the function stored is called to delete the node physically
+                if the lifetime of the node does not intersect the interval reserved by any thread.
+
+                The functor frees the node by era_allocator. A node reused from the node cache keeps
+                the birth era of its first allocation; the earlier birth era is conservative, therefore, safe.
+
+                Do not use the functor directly.
+            */
+            typedef cds::details::deferral_deleter<Node, TAllocator>     deferral_node_deleter ;
+
+        protected:
+            /// Returns IBR GC manager object for current thread
+            static thread_gc&    getGC()
+            {
+                return cds::threading::getGC<gc_schema>() ;
+            }
+
+            /// allocates node and initializes it by default ctor
+            Node * allocNode()
+            {
+                return m_NodeAllocator.New()    ;
+            }
+
+            /// allocates node and initializes it by node's ctor with parameters
+            template <typename T>
+            Node * allocNode( const T& data )
+            {
+                return m_NodeAllocator.New( data )    ;
+            }
+
+            /// allocates node and initializes it by node's ctor with two parameters
+            template <typename K, typename V>
+            Node * allocNode( const K& k, const V& v )
+            {
+                return m_NodeAllocator.New( k, v )    ;
+            }
+
+            /// frees node (call dtor and free memory)
+            void freeNode( Node * pNode )
+            {
+                m_NodeAllocator.Delete( pNode )    ;
+            }
+        };
+    }    // namespace ibr
+}} // namespace cds::gc
+
+#endif // #ifndef __CDS_GC_IBR_CONTAINER_H
@@ -0,0 +1,778 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_IBR_IBR_H
+#define __CDS_GC_IBR_IBR_H
+
+#include <cds/gc/ibr_gc.h>
+#include <cds/gc/details/retired_ptr.h>
+#include <cds/atomic.h>
+#include <cds/details/aligned_type.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/user_setup/allocator.h>
+
+#include <boost/noncopyable.hpp>
+#include <vector>
+#include <new>
+
+#if CDS_COMPILER == CDS_COMPILER_MSVC
+#   pragma warning(push)
+#   pragma warning(disable:4251)    // C4251: 'identifier' : class 'type' needs to have dll-interface to be used by clients of class 'type2'
+#endif
+
+namespace cds { namespace gc {
+
+    /// Interval-based reclamation schema (hazard eras)
+    /**
+        \par Sources:
+        \li [2017] P. Ramalhete, A. Correia. Brief announcement: Hazard eras - non-blocking memory reclamation. SPAA 2017
+        \li [2018] H. Wen, J. Izraelevitz, W. Cai, H. A. Beadle, M. L. Scott. Interval-based memory reclamation. PPoPP 2018
+
+        @cond
+        \par Usage
+            Interval-based GC is the singleton. Before use any IBR-related class you must initialize it
+            by contructing cds::gc::ibr::GC object in beginning of your main().
+            See cds::gc::ibr::GC class for explanation.
+        @endcond
+
+        \par Algorithm
+            The GC maintains the global era clock. Each object carries two eras: the birth era is stamped when the object
+            is allocated and the retire era is stamped when the object is retired. The birth era is kept in the allocation header
+            written by era_allocator, so the objects managed by the GC must be allocated by era_allocator
+            (the containers based on cds::gc::ibr::Container do it).
+
+            Instead of the pointers the thread reserves the interval of eras <tt>[lower, upper]</tt>. The lower era
+            is the clock value when the thread enters the critical region (when its first guard is created), the upper era
+            is moved to the current clock value when a pointer is guarded. The store and the following full fence are
+            performed only if the clock has been changed since the last guarding, so most guard assignments
+            cost a load and a compare as for epoch-based reclamation.
+
+            A retired object may be freed when its lifetime <tt>[birth, retire]</tt> does not intersect any reserved interval.
+            Unlike epoch-based reclamation a stalled thread blocks only the objects that were alive in its interval:
+            the objects allocated after the thread has stopped are reclaimed as usual, so the amount of unreclaimed memory
+            is bounded as for Hazard Pointers.
+
+            The pointer loaded from a shared root (the head of the list, the tail of the queue) must be validated by
+            the clock rather than by reloading the root: the root may contain the new incarnation of the object
+            allocated after the reservation. ThreadGC::protect performs such validated load.
+    */
+    namespace ibr {
+
+        // Forward declarations
+        class Guard ;
+        template <size_t COUNT> class GuardArray    ;
+        class ThreadGC  ;
+        class GarbageCollector  ;
+
+        /// Retired pointer type
+        typedef cds::gc::details::retired_ptr retired_ptr   ;
+
+        using cds::gc::details::free_retired_ptr_func   ;
+
+        /// Details of interval-based reclamation
+        namespace details {
+
+            /// The lower era of the thread that is not in critical region
+            static const size_t c_nInactiveEra = ~size_t(0) ;
+
+            /// Allocation header that keeps the birth era of the object
+            /**
+                The union is used to keep the object following the header aligned as by operator \p new.
+            */
+            union era_header
+            {
+                size_t          nBirth      ;   ///< birth era of the object
+                //@cond
+                long double     _align1     ;
+                void *          _align2     ;
+                //@endcond
+
+                /// Returns the header of object \p p allocated by era_allocator
+                static era_header * header( const void * p )
+                {
+                    return reinterpret_cast<era_header *>( const_cast<void *>( p )) - 1 ;
+                }
+
+                /// Returns the birth era of object \p p allocated by era_allocator
+                static size_t birth( const void * p )
+                {
+                    return header( p )->nBirth  ;
+                }
+            };
+
+            /// Retired pointer with the lifetime of the object
+            struct era_retired_ptr
+            {
+                retired_ptr m_ptr       ;   ///< retired pointer
+                size_t      m_nBirth    ;   ///< birth era
+                size_t      m_nRetire   ;   ///< retire era
+
+                //@cond
+                era_retired_ptr()
+                    : m_nBirth( 0 )
+                    , m_nRetire( 0 )
+                {}
+
+                era_retired_ptr( const retired_ptr& p, size_t nBirth, size_t nRetire )
+                    : m_ptr( p )
+                    , m_nBirth( nBirth )
+                    , m_nRetire( nRetire )
+                {}
+                //@endcond
+            };
+
+            /// Interval of eras reserved by a thread
+            struct era_interval
+            {
+                size_t  m_nLower    ;   ///< lower era
+                size_t  m_nUpper    ;   ///< upper era
+
+                //@cond
+                era_interval( size_t nLower, size_t nUpper )
+                    : m_nLower( nLower )
+                    , m_nUpper( nUpper )
+                {}
+                //@endcond
+
+                /// Checks if the lifetime <tt>[nBirth, nRetire]</tt> intersects the interval
+                bool intersects( size_t nBirth, size_t nRetire ) const
+                {
+                    return m_nLower <= nRetire && nBirth <= m_nUpper    ;
+                }
+            };
+
+            /// Array of retired pointers
+            typedef std::vector<era_retired_ptr>    retired_vector  ;
+
+            /// Thread record
+            /**
+                The records are linked in the global list, the list is never shrunk:
+                the record of the detached thread is reused by the next attached thread.
+                The retired pointers of the detached thread stay in its record until they are freed
+                by the next owner or by GarbageCollector::HelpScan.
+            */
+            struct thread_record
+            {
+                atomic<size_t>          m_nLower    ;   ///< Lower era reserved, c_nInactiveEra if the thread is not in critical region
+                atomic<size_t>          m_nUpper    ;   ///< Upper era reserved
+                atomic<int>             m_bInUse    ;   ///< The record is owned by a thread
+                thread_record *         m_pNext     ;   ///< Next record in the global list
+                retired_vector          m_arrRetired;   ///< Retired pointers
+                std::vector<era_interval>   m_arrReserved   ;   ///< Reserved intervals collected by Scan (the buffer is reused)
+                char                    m_pad[ c_nCacheLineSize ] ;    // the records must not share the cache line
+
+                //@cond
+                thread_record()
+                    : m_nLower( c_nInactiveEra )
+                    , m_nUpper( 0 )
+                    , m_bInUse( 1 )
+                    , m_pNext( NULL )
+                {}
+                //@endcond
+            };
+
+            /// Uninitialized guard
+            /**
+                The guard does not reserve the pointer itself: the pointer is protected by the interval of the thread.
+                The assignment extends the upper bound of the interval up to the current era.
+            */
+            class guard: public boost::noncopyable
+            {
+                //@cond
+                template <size_t COUNT> friend class ibr::GuardArray    ;
+                //@endcond
+
+            protected:
+                void *      m_p     ;   ///< the pointer assigned
+                ThreadGC *  m_pGC   ;   ///< ThreadGC object of current thread
+            public:
+                /// Initialize empty guard.
+                CDS_CONSTEXPR guard()
+                    : m_p( NULL )
+                    , m_pGC( NULL )
+                {}
+
+                /// Guards pointer \p p
+                void set( void * p ) ;      // inline after ThreadGC
+
+                /// Clears the guard
+                void clear()
+                {
+                    m_p = NULL  ;
+                }
+
+                /// Guards pointer \p p
+                template <typename T>
+                T * operator =( T * p )
+                {
+                    set( reinterpret_cast<void *>( const_cast<T *>(p) ))      ;
+                    return p    ;
+                }
+
+                /// Loads \p src and guards the value loaded, see ThreadGC::protect
+                template <typename T>
+                T * protect( atomic<T *>& src ) ;   // inline after ThreadGC
+
+                /// Returns the pointer assigned
+                void * get() const
+                {
+                    return m_p  ;
+                }
+
+                /// Returns ThreadGC object of the guard
+                ThreadGC& getGC()
+                {
+                    assert( m_pGC != NULL ) ;
+                    return *m_pGC   ;
+                }
+            };
+
+        } // namespace details
+
+        /// Guard
+        /**
+            The ctor enters the critical region of current thread, the dtor leaves the region.
+            The regions may be nested.
+        */
+        class Guard: public details::guard
+        {
+            //@cond
+            typedef details::guard    base_class    ;
+            //@endcond
+
+        public:
+            /// Enters the critical region. \p gc must be ThreadGC object of current thread
+            Guard( ThreadGC& gc )  ;   // inline after ThreadGC
+
+            /// Leaves the critical region
+            ~Guard();    // inline after ThreadGC
+
+            /// Guards pointer \p p
+            template <typename T>
+            T * operator =( T * p )
+            {
+                return base_class::operator =<T>( p )    ;
+            }
+        };
+
+        /// Array of guards
+        /**
+            The ctor enters the critical region of current thread, the dtor leaves the region.
+        */
+        template <size_t COUNT>
+        class GuardArray: public boost::noncopyable
+        {
+            details::guard      m_arr[COUNT]    ;    ///< array of guard
+            ThreadGC&           m_gc    ;            ///< ThreadGC object of current thread
+
+        public:
+            /// Rebind array for other size \p COUNT2
+            template <size_t COUNT2>
+            struct rebind {
+                typedef GuardArray<COUNT2>  other   ;   ///< rebinding result
+            };
+
+        public:
+            /// Enters the critical region. \p gc must be ThreadGC object of current thread
+            GuardArray( ThreadGC& gc )    ;    // inline below
+
+            /// Leaves the critical region
+            ~GuardArray()    ;    // inline below
+
+            /// Returns the capacity of array
+            size_t capacity() const
+            {
+                return COUNT    ;
+            }
+
+            /// Returns IBR ThreadGC object
+            ThreadGC& getGC()
+            {
+                return m_gc ;
+            }
+
+            /// Returns reference to the guard of index \p nIndex (0 <= \p nIndex < \p COUNT)
+            details::guard& operator []( size_t nIndex )
+            {
+                assert( nIndex < COUNT )    ;
+                return m_arr[nIndex]        ;
+            }
+
+            /// Set the guard \p nIndex. 0 <= \p nIndex < \p COUNT
+            template <typename T>
+            void set( size_t nIndex, T * p )
+            {
+                assert( nIndex < COUNT )    ;
+                m_arr[nIndex].set( p )      ;
+            }
+
+            /// Clears (sets to NULL) the guard \p nIndex
+            void clear( size_t nIndex )
+            {
+                assert( nIndex < COUNT )    ;
+                m_arr[nIndex].clear()       ;
+            }
+
+            /// Clears all guards in the array
+            void clearAll()
+            {
+                for ( size_t i = 0; i < COUNT; ++i )
+                    clear(i)    ;
+            }
+        };
+
+        /// Memory manager (Garbage collector)
+        class CDS_EXPORT_API GarbageCollector
+        {
+            friend class ThreadGC   ;
+        public:
+            /// Internal GC statistics
+            /**
+                The structure has the same shape as cds::gc::hzp::GarbageCollector::InternalState;
+                the thread record plays the role of HP record.
+            */
+            struct InternalState {
+                size_t              nEraFreq                ;   ///< Count of pointers retired by the thread after that the era is advanced (const)
+                size_t              nMaxRetiredPtrCount     ;   ///< Count of retired pointers per thread that triggers Scan (const)
+                size_t              nThreadRecSize          ;   ///< Size of thread record, bytes (const)
+                size_t              nCurrentEra             ;   ///< Current global era
+
+                size_t              nThreadRecAllocated     ;   ///< Count of thread record allocations
+                size_t              nThreadRecUsed          ;   ///< Count of thread record used
+                size_t              nTotalRetiredPtrCount   ;   ///< Current total count of retired pointers
+                size_t              nRetiredPtrInFreeThreadRecs ;   ///< Count of retired pointer in free (unused) thread records
+
+                atomics::event_counter::value_type  evcAllocThreadRec   ;   ///< Count of thread record allocations
+                atomics::event_counter::value_type  evcRetireThreadRec  ;   ///< Count of thread record retire events
+                atomics::event_counter::value_type  evcAllocNewThreadRec;   ///< Count of new thread record allocations from heap
+                atomics::event_counter::value_type  evcDeleteThreadRec  ;   ///< Count of thread record deletions
+
+                atomics::event_counter::value_type  evcScanCall     ;   ///< Count of Scan calling
+                atomics::event_counter::value_type  evcHelpScanCall ;   ///< Count of HelpScan calling
+                atomics::event_counter::value_type  evcScanFromHelpScan;///< Count of Scan calls from HelpScan
+
+                atomics::event_counter::value_type  evcDeletedNode  ;   ///< Count of deleting of retired objects
+                atomics::event_counter::value_type  evcDeferredNode ;   ///< Count of objects that cannot be deleted in Scan phase because of a reserved interval
+                atomics::event_counter::value_type  evcEraAdvance   ;   ///< Count of era clock advances
+
+                double                              fScanTime       ;   ///< Total time of Scan calls, seconds
+            } ;
+
+            /// No GarbageCollector object is created
+            CDS_DECLARE_EXCEPTION( IBRManagerEmpty, "Global interval-based GarbageCollector is NULL" )    ;
+
+        private:
+            /// Internal GC statistics
+            struct Statistics {
+                atomics::event_counter  m_AllocThreadRec        ;    ///< Count of thread record allocations
+                atomics::event_counter  m_RetireThreadRec       ;    ///< Count of thread record retire events
+                atomics::event_counter  m_AllocNewThreadRec     ;    ///< Count of new thread record allocations from heap
+                atomics::event_counter  m_DeleteThreadRec       ;    ///< Count of thread record deletions
+
+                atomics::event_counter  m_ScanCallCount         ;    ///< Count of Scan calling
+                atomics::event_counter  m_HelpScanCallCount     ;    ///< Count of HelpScan calling
+                atomics::event_counter  m_CallScanFromHelpScan  ;    ///< Count of Scan calls from HelpScan
+
+                atomics::event_counter  m_DeletedNode           ;    ///< Count of retired objects deleting
+                atomics::event_counter  m_DeferredNode          ;    ///< Count of objects that cannot be deleted in Scan phase
+                atomics::event_counter  m_EraAdvance            ;    ///< Count of era clock advances
+
+                atomics::event_counter  m_ScanTime              ;    ///< Total time of Scan calls, in cds::OS::Timer native units
+            };
+
+            static GarbageCollector * m_pManager    ;   ///< GC global instance
+
+            typedef cds::details::aligned_type< atomic<size_t>, c_nCacheLineSize >::type   aligned_era ;
+
+            aligned_era                         m_nEra          ;   ///< Global era clock
+            atomic<details::thread_record *>    m_pThreadList   ;   ///< List of thread records
+
+            Statistics      m_Stat              ;   ///< Internal statistics
+            bool            m_bStatEnabled      ;   ///< true - statistics enabled
+
+            const size_t    m_nEraFreq          ;   ///< Count of retired pointers per thread after that the era is advanced
+            const size_t    m_nScanThreshold    ;   ///< Count of retired pointers per thread that triggers Scan
+
+        public:
+            /// Initializes interval-based memory manager singleton
+            /**
+                This member function creates and initializes IBR GC global object.
+                The function should be called before using CDS data structure based on cds::gc::ibr_gc GC. Usually,
+                this member function is called in the \p main() function. See cds::gc::ibr for example.
+
+                \par Parameters
+                \li \p nEraFreq - count of pointers retired by the thread after that the thread advances the era clock.
+                    The less the value the more often the guards reserve new era (one full fence),
+                    the greater the value the more objects are kept by a stalled thread.
+                \li \p nScanThreshold - count of pointers retired by the thread after that the thread scans its retired pointers.
+            */
+            static void CDS_STDCALL Construct(
+                size_t nEraFreq = 64,
+                size_t nScanThreshold = 128
+            ) ;
+
+            /// Destroys interval-based memory manager
+            /**
+                The member function destroys the global object and frees all retired pointers.
+                All threads must be detached before calling this function.
+            */
+            static void CDS_STDCALL Destruct()  ;
+
+            /// Returns pointer to GarbageCollector instance
+            /**
+                If IBR GC is not initialized, \p IBRManagerEmpty exception is thrown
+            */
+            static GarbageCollector&   instance()
+            {
+                if ( m_pManager == NULL )
+                    throw IBRManagerEmpty()    ;
+                return *m_pManager   ;
+            }
+
+            /// Checks if global GC object is constructed and may be used
+            static bool isUsed()
+            {
+                return m_pManager != NULL    ;
+            }
+
+            /// Returns current global era
+            size_t era() const
+            {
+                return m_nEra.load<membar_acquire>()    ;
+            }
+
+            /// Get internal statistics
+            InternalState& getInternalState(InternalState& stat) const    ;
+
+            /// Checks if internal statistics enabled
+            bool              isStatisticsEnabled() const { return m_bStatEnabled; }
+
+            /// Enables/disables internal statistics
+            bool              enableStatistics( bool bEnable )
+            {
+                bool bEnabled = m_bStatEnabled    ;
+                m_bStatEnabled = bEnable        ;
+                return bEnabled                    ;
+            }
+
+        public:    // Internals for threads
+
+            /// Frees the retired pointers of \p pRec whose lifetime does not intersect any reserved interval. For internal use only
+            void Scan( details::thread_record * pRec )  ;
+
+            /// Moves the retired pointers of free thread records to \p pRec and frees them. For internal use only
+            void HelpScan( details::thread_record * pRec )  ;
+
+        protected:
+            //@cond
+            details::thread_record * allocRecord()  ;
+            void freeRecord( details::thread_record * pRec )  ;
+
+            size_t retire_era()
+            {
+                // The fence orders the unlinking of the object before the era load:
+                // a thread that has seen the object has reserved the era not greater than the era loaded
+                atomics::fence( membar_seq_cst::order ) ;
+                return m_nEra.load<membar_relaxed>()    ;
+            }
+
+            void advance()
+            {
+                m_nEra.inc<membar_release>()    ;
+                if ( m_bStatEnabled )
+                    ++m_Stat.m_EraAdvance   ;
+            }
+            //@endcond
+
+        private:
+            //@cond none
+            GarbageCollector( size_t nEraFreq, size_t nScanThreshold )  ;
+            ~GarbageCollector() ;
+            //@endcond
+        };
+
+        /// Thread GC
+        /**
+            To use interval-based reclamation schema each thread object must be linked with the object of ThreadGC class
+            that interacts with GarbageCollector global object. The linkage is performed by calling cds::threading \p ::Manager::attachThread()
+            on the start of each thread that uses IBR GC. Before terminating the thread linked to IBR GC it is necessary to call
+            cds::threading \p ::Manager::detachThread().
+        */
+        class ThreadGC: boost::noncopyable
+        {
+            GarbageCollector&           m_gc            ;   ///< reference to GC singleton
+            details::thread_record *    m_pRec          ;   ///< thread record
+            size_t                      m_nNestCount    ;   ///< critical region nesting count
+            size_t                      m_nRetireCount  ;   ///< count of pointers retired since last era advance
+            size_t                      m_nScanLimit    ;   ///< size of retired array that triggers next scan
+
+        public:
+            ThreadGC()
+                : m_gc( GarbageCollector::instance() )
+                , m_pRec( NULL )
+                , m_nNestCount( 0 )
+                , m_nRetireCount( 0 )
+                , m_nScanLimit( 0 )
+            {}
+
+            /// Dtor calls fini()
+            ~ThreadGC()
+            {
+                fini()  ;
+            }
+
+            /// Initialization. Repeat call is available
+            void init()
+            {
+                if ( !m_pRec ) {
+                    m_pRec = m_gc.allocRecord() ;
+                    m_nScanLimit = m_pRec->m_arrRetired.size() + m_gc.m_nScanThreshold ;
+                }
+            }
+
+            /// Finalization. Repeat call is available
+            void fini()
+            {
+                if ( m_pRec ) {
+                    assert( m_nNestCount == 0 ) ;
+                    if ( !m_pRec->m_arrRetired.empty() )
+                        m_gc.Scan( m_pRec ) ;
+                    m_gc.freeRecord( m_pRec )   ;
+                    m_pRec = NULL   ;
+                    m_nRetireCount = 0  ;
+                }
+            }
+
+            /// Enters the critical region
+            void enter()
+            {
+                assert( m_pRec != NULL )    ;
+                if ( m_nNestCount++ == 0 ) {
+                    size_t nEra = m_gc.m_nEra.load<membar_acquire>()    ;
+                    m_pRec->m_nUpper.store<membar_relaxed>( nEra )  ;
+                    m_pRec->m_nLower.store<membar_release>( nEra )  ;
+                    atomics::fence( membar_seq_cst::order ) ;
+                }
+            }
+
+            /// Leaves the critical region
+            void leave()
+            {
+                assert( m_nNestCount > 0 )  ;
+                if ( --m_nNestCount == 0 )
+                    m_pRec->m_nLower.store<membar_release>( details::c_nInactiveEra ) ;
+            }
+
+            /// Checks if the thread is in the critical region
+            bool isInCriticalRegion() const
+            {
+                return m_nNestCount != 0    ;
+            }
+
+            /// Extends the reserved interval up to the current era
+            /**
+                Returns \p true if the current era has been already reserved, that is, any pointer
+                loaded before the call is protected. Returns \p false if the upper era is moved;
+                in this case the pointer should be reloaded.
+            */
+            bool reserve()
+            {
+                assert( m_nNestCount > 0 )  ;
+                size_t nEra = m_gc.m_nEra.load<membar_acquire>()    ;
+                if ( m_pRec->m_nUpper.load<membar_relaxed>() == nEra )
+                    return true ;
+                m_pRec->m_nUpper.store<membar_relaxed>( nEra ) ;
+                atomics::fence( membar_seq_cst::order ) ;
+                return false    ;
+            }
+
+            /// Loads the pointer from \p src so that it is protected by the reserved interval
+            /**
+                The pointer is reloaded until the era reserved is not changed after the load.
+                The function must be called inside the critical region.
+            */
+            template <typename T>
+            T * protect( atomic<T *>& src )
+            {
+                T * p   ;
+                do {
+                    p = src.template load<membar_acquire>() ;
+                } while ( !reserve() )  ;
+                return p    ;
+            }
+
+            /// Places retired pointer \p and its deleter \p pFunc into list of retired pointer for deferred reclamation
+            /**
+                The pointer \p p must be allocated by era_allocator.
+            */
+            template <typename T>
+            void retirePtr( T * p, void (* pFunc)(T *) )
+            {
+                retirePtr( retired_ptr( p, pFunc ), details::era_header::birth( p ))  ;
+            }
+
+            /// Places retired pointer \p with birth era \p nBirth into list of retired pointer for deferred reclamation
+            void retirePtr( const retired_ptr& p, size_t nBirth )
+            {
+                m_pRec->m_arrRetired.push_back( details::era_retired_ptr( p, nBirth, m_gc.retire_era() ))  ;
+
+                if ( ++m_nRetireCount >= m_gc.m_nEraFreq ) {
+                    m_nRetireCount = 0  ;
+                    m_gc.advance()  ;
+                }
+                if ( m_pRec->m_arrRetired.size() >= m_nScanLimit )
+                    scan()  ;
+            }
+
+            /// Frees the retired pointers that are not reserved by any thread
+            void scan()
+            {
+                m_gc.Scan( m_pRec ) ;
+                m_gc.HelpScan( m_pRec ) ;
+                // The pointers kept are reserved by other threads; do not rescan them on each retiring
+                m_nScanLimit = m_pRec->m_arrRetired.size() + m_gc.m_nScanThreshold ;
+            }
+        };
+
+        /// Allocator that stamps the birth era of the objects
+        /**
+            The allocator places the header of type details::era_header before each block allocated
+            by underlying \p ALLOCATOR and writes the current era into the header. The objects retired to
+            interval-based GC must be allocated by this allocator.
+        */
+        template <typename T, class ALLOCATOR = CDS_DEFAULT_ALLOCATOR>
+        class era_allocator
+        {
+            //@cond
+            typedef typename ALLOCATOR::template rebind<details::era_header>::other   header_allocator  ;
+            //@endcond
+        public:
+            typedef T               value_type      ;   ///< value type
+            typedef T *             pointer         ;   ///< pointer type
+            typedef const T *       const_pointer   ;   ///< const pointer type
+            typedef T&              reference       ;   ///< reference type
+            typedef const T&        const_reference ;   ///< const reference type
+            typedef size_t          size_type       ;   ///< size type
+            typedef ptrdiff_t       difference_type ;   ///< difference type
+
+            /// Rebinds allocator to other type \p Q instead of \p T
+            template <typename Q>
+            struct rebind {
+                typedef era_allocator<Q, ALLOCATOR> other   ;   ///< Rebinding result
+            };
+
+        public:
+            //@cond
+            era_allocator()
+            {}
+            era_allocator( const era_allocator& )
+            {}
+            template <typename Q>
+            era_allocator( const era_allocator<Q, ALLOCATOR>& )
+            {}
+            //@endcond
+
+            /// Allocates memory for \p n objects and stamps it by the current era
+            pointer allocate( size_type n, const void * /*hint*/ = NULL )
+            {
+                details::era_header * pHeader = header_allocator().allocate( header_count( n ))   ;
+                pHeader->nBirth = GarbageCollector::instance().era()    ;
+                return reinterpret_cast<pointer>( pHeader + 1 )  ;
+            }
+
+            /// Deallocates memory \p p allocated by \ref allocate
+            void deallocate( pointer p, size_type n )
+            {
+                header_allocator().deallocate( details::era_header::header( p ), header_count( n ))  ;
+            }
+
+            /// Constructs the object \p p by copy ctor
+            void construct( pointer p, const T& val )
+            {
+                new( p ) T( val )   ;
+            }
+
+            /// Calls dtor of \p p
+            void destroy( pointer p )
+            {
+                p->~T() ;
+            }
+
+            /// Returns max count of objects that can be allocated
+            size_type max_size() const
+            {
+                return size_type(-1) / sizeof(T) - 1   ;
+            }
+
+            //@cond
+            bool operator ==( const era_allocator& ) const { return true; }
+            bool operator !=( const era_allocator& ) const { return false; }
+            //@endcond
+
+        private:
+            //@cond
+            static size_type header_count( size_type n )
+            {
+                return 1 + ( n * sizeof(T) + sizeof(details::era_header) - 1 ) / sizeof(details::era_header) ;
+            }
+            //@endcond
+        };
+
+        //////////////////////////////////////////////////////////
+        // Inlines
+
+        namespace details {
+            inline void guard::set( void * p )
+            {
+                m_p = p ;
+                getGC().reserve()   ;
+            }
+
+            template <typename T>
+            inline T * guard::protect( atomic<T *>& src )
+            {
+                T * p = getGC().protect( src )  ;
+                m_p = reinterpret_cast<void *>( p ) ;
+                return p    ;
+            }
+        }   // namespace details
+
+        inline Guard::Guard(ThreadGC& gc)
+        {
+            m_pGC = &gc ;
+            gc.enter()  ;
+        }
+        inline Guard::~Guard()
+        {
+            getGC().leave() ;
+        }
+
+        template <size_t COUNT>
+        inline GuardArray<COUNT>::GuardArray( ThreadGC& gc )
+            : m_gc( gc )
+        {
+            for ( size_t i = 0; i < COUNT; ++i )
+                m_arr[i].m_pGC = &gc    ;
+            gc.enter()  ;
+        }
+        template <size_t COUNT>
+        inline GuardArray<COUNT>::~GuardArray()
+        {
+            getGC().leave() ;
+        }
+
+    }   // namespace ibr
+}}  // namespace cds::gc
+
+#if CDS_COMPILER == CDS_COMPILER_MSVC
+#   pragma warning(pop)
+#endif
+
+#endif // #ifndef __CDS_GC_IBR_IBR_H
@@ -0,0 +1,36 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_GC_IBR_GC_H
+#define __CDS_GC_IBR_GC_H
+
+namespace cds {
+    namespace gc {
+
+        // Forward declarations
+        namespace ibr {
+            class GarbageCollector  ;
+            class ThreadGC  ;
+        }
+
+        /// Tag for interval-based reclamation schema
+        /**
+            For more information about interval-based reclamation (hazard eras) schema see cds::gc::ibr namespace.
+        */
+        struct ibr_gc
+        {
+            /// Thread control data of interval-based GC
+            typedef gc::ibr::ThreadGC thread_gc   ;
+        };
+    }   // namespace gc
+} // namespace cds
+
+
+#endif // #ifndef __CDS_GC_IBR_GC_H
@@ -17,6 +17,7 @@
 #include <cds/details/markptr.h>
 #include <cds/details/aligned_allocator.h>
 #include <cds/details/allocator.h>
+#include <cds/os/timer.h>
 
 #include <cds/lock/spinlock.h>
 
@@ -229,6 +230,8 @@ namespace cds { namespace gc {
                 /// Allocates list of guard
                 /**
                     The list returned is linked by guard's \p pThreadNext and \p pNextFree fields.
+                    The guards are taken from the free-list under single lock; if the free-list
+                    has less than \p nCount guards the rest is allocated from the heap.
 
                     cds::gc::ptb::ThreadGC supporting method
                 */
@@ -236,18 +239,40 @@ namespace cds { namespace gc {
                 {
                     assert( nCount != 0 )   ;
 
-                    guard_data * pHead   ;
-                    guard_data * pLast   ;
+                    guard_data * pHead  ;
+                    guard_data * pLast  ;
+                    size_t nFree = 0    ;
 
+                    m_freeListLock.lock()   ;
                     pHead =
-                        pLast = alloc() ;
+                        pLast = m_FreeGuardList.load<membar_relaxed>() ;
+                    if ( pHead ) {
+                        // The guards of free-list are already linked by pNextFree
+                        for ( nFree = 1; nFree < nCount && pLast->pNextFree.load<membar_relaxed>(); ++nFree )
+                            pLast = pLast->pNextFree.load<membar_relaxed>()   ;
+                        m_FreeGuardList.store<membar_relaxed>( pLast->pNextFree.load<membar_relaxed>() )  ;
+                    }
+                    m_freeListLock.unlock() ;
 
                     // The guard list allocated is private for the thread,
                     // so, we may use relaxed membar
-                    while ( --nCount ) {
+                    if ( pHead ) {
+                        for ( guard_data * p = pHead; p != pLast; p = p->pThreadNext ) {
+                            p->init()   ;
+                            p->pThreadNext = p->pNextFree.load<membar_relaxed>()  ;
+                        }
+                        pLast->init()   ;
+                    }
+                    else {
+                        pHead =
+                            pLast = allocNew()  ;
+                        nFree = 1   ;
+                    }
+
+                    for ( ; nFree < nCount; ++nFree ) {
                         pLast =
                             pLast->pThreadNext =
-                            pLast->pNextFree.store<membar_relaxed>( alloc() ) ;
+                            pLast->pNextFree.store<membar_relaxed>( allocNew() ) ;
                     }
                     pLast->pThreadNext =
                         pLast->pNextFree.store<membar_relaxed>( NULL ) ;
@@ -321,6 +346,21 @@ namespace cds { namespace gc {
                     return m_nItemCount.inc<membar_release>() + 1  ;
                 }
 
+                /// Pushes the list [\p pHead, \p pTail] of \p nCount nodes linked by \p m_pNext into the buffer. Returns current buffer size
+                size_t pushList( retired_ptr_node * pHead, retired_ptr_node * pTail, size_t nCount )
+                {
+                    assert( pHead != NULL ) ;
+                    assert( pTail != NULL ) ;
+
+                    retired_ptr_node * pCurHead  ;
+                    do {
+                        pTail->m_pNext =
+                            pCurHead = m_pHead.load<membar_acquire>() ;
+                    } while ( !m_pHead.cas<membar_release>( pCurHead, pHead ))    ;
+
+                    return m_nItemCount.xadd<membar_release>( nCount ) + nCount  ;
+                }
+
                 /// Gets current list of retired pointer and clears the list
                 retired_ptr_node *    steal()
                 {
@@ -350,9 +390,10 @@ namespace cds { namespace gc {
                 The class acts as an allocator of retired node.
 
                 Retired pointers are linked in the lock-free list. 
-                Each thread allocates the retired pointers from the list when needed and pushes them back to the list only when the thread terminating.
-                It seems, theoretically, well-known ABA-problem is possible when manipulating with the list.
-                However, if threads are long-lived then ABA-problem is practically impossible.
+                The thread takes the retired pointers from the pool by batches (see \ref allocList)
+                into its private cache and returns the cache to the pool when the thread terminating.
+                The batch is detached by single CAS under the short lock that serializes
+                the batch allocations only; \ref alloc, \ref free and \ref freeList are lock-free.
             */
             template <class ALLOCATOR = CDS_DEFAULT_ALLOCATOR>
             class retired_ptr_pool {
@@ -370,12 +411,13 @@ namespace cds { namespace gc {
 
                 atomic<block *> m_pBlockListHead    ;   ///< head of of allocated block list
                 atomic<item *>  m_pFreeHead         ;   ///< head of list of free items
+                SpinLock        m_allocListLock     ;   ///< serializes batch allocations (see \ref allocList)
 
                 cds::details::Allocator< block, ALLOCATOR > m_BlockAllocator    ;   ///< block allocator
 
             private:
                 //@cond
-                void allocNewBlock()
+                block * newBlock()
                 {
                     // allocate new block
                     block * pNew = m_BlockAllocator.New()   ;
@@ -385,6 +427,7 @@ namespace cds { namespace gc {
                     for ( item * pItem = pNew->items; pItem != pLastItem; ++pItem ) {
                         pItem->m_pNextFree = pItem + 1  ;
                     }
+                    pLastItem->m_pNextFree = NULL   ;
 
                     // link new block to block list
                     {
@@ -394,15 +437,13 @@ namespace cds { namespace gc {
                                 pHead = m_pBlockListHead.template load<membar_acquire>()    ;
                         } while ( !m_pBlockListHead.template cas<membar_release>( pHead, pNew ))    ;
                     }
+                    return pNew ;
+                }
 
-                    // link block's items to free list
-                    {
-                        item * pHead    ;
-                        do {
-                            pLastItem->m_pNextFree =
-                                pHead = m_pFreeHead.template load<membar_acquire>() ;
-                        } while ( !m_pFreeHead.template cas<membar_release>( pHead, pNew->items )) ;
-                    }
+                void allocNewBlock()
+                {
+                    block * pNew = newBlock()   ;
+                    freeList( pNew->items, pNew->items + m_nItemPerBlock - 1 )  ;
                 }
                 //@endcond
 
@@ -425,6 +466,46 @@ namespace cds { namespace gc {
                 }
                 //@endcond
 
+                /// Allocates list of at most \p nCount retired pointers
+                /**
+                    The list returned is linked by \p m_pNextFree field and is terminated by \p NULL.
+                    The list is not empty but it may contain less than \p nCount items.
+                    The first \p nCount items of the pool are detached by single CAS. The batch allocations
+                    are serialized by the lock, so the pool head can be changed concurrently
+                    only by \ref alloc and \ref free, as for \ref alloc itself.
+                    A new block is allocated only if the pool is empty.
+                */
+                retired_ptr_node * allocList( size_t nCount )
+                {
+                    assert( nCount != 0 )   ;
+
+                    item * pHead    ;
+                    item * pLast    ;
+                    {
+                        cds::lock::Auto<SpinLock> al( m_allocListLock ) ;
+                        do {
+                            pHead = m_pFreeHead.template load<membar_acquire>() ;
+                            if ( pHead == NULL )
+                                break   ;
+                            pLast = pHead   ;
+                            for ( size_t n = 1; n < nCount && pLast->m_pNextFree; ++n )
+                                pLast = pLast->m_pNextFree  ;
+                        } while ( !m_pFreeHead.template cas<membar_release>( pHead, pLast->m_pNextFree )) ;
+                    }
+
+                    if ( pHead == NULL ) {
+                        // The pool is empty - take the batch from new block and put the rest of the block to the pool
+                        block * pNew = newBlock()   ;
+                        pHead = pNew->items ;
+                        pLast = pNew->items + ( nCount < m_nItemPerBlock ? nCount : m_nItemPerBlock ) - 1   ;
+                        if ( pLast->m_pNextFree )
+                            freeList( pLast->m_pNextFree, pNew->items + m_nItemPerBlock - 1 )  ;
+                    }
+                    pLast->m_pNextFree = NULL   ;
+
+                    return pHead    ;
+                }
+
                 /// Allocates new retired pointer
                 retired_ptr_node&  alloc()
                 {
@@ -661,6 +742,18 @@ namespace cds { namespace gc {
                 atomic<size_t>  m_nGuardCount       ;   ///< Total guard count
                 atomic<size_t>  m_nFreeGuardCount   ;   ///< Count of free guard
 
+                size_t          nRetiredBatchSize   ;   ///< Size of thread's batch of retired pointers (const)
+
+                atomics::event_counter::value_type  evcGuardAllocList   ;   ///< Count of guard batches taken from the global guard pool
+                atomics::event_counter::value_type  evcGuardAlloc       ;   ///< Count of guards taken from the global guard pool
+                atomics::event_counter::value_type  evcGuardFreeList    ;   ///< Count of thread's guard lists returned to the global guard pool
+                atomics::event_counter::value_type  evcRetiredAllocList ;   ///< Count of retired node batches taken from the global pool
+                atomics::event_counter::value_type  evcRetiredFreeList  ;   ///< Count of thread's retired node caches returned to the global pool
+                atomics::event_counter::value_type  evcRetiredPushList  ;   ///< Count of retired pointer batches pushed to the global retired buffer
+                atomics::event_counter::value_type  evcRetiredPush      ;   ///< Count of retired pointers pushed to the global retired buffer
+                atomics::event_counter::value_type  evcLiberateCall     ;   ///< Count of liberate calls
+                double                              fLiberateTime       ;   ///< Total time of liberate calls, seconds
+
                 //@cond
                 InternalState()
                     : m_nGuardCount(0)
@@ -670,11 +763,34 @@ namespace cds { namespace gc {
                 InternalState( const InternalState& s )
                     : m_nGuardCount( s.m_nGuardCount.load<membar_relaxed>())
                     , m_nFreeGuardCount( s.m_nFreeGuardCount.load<membar_relaxed>())
+                    , nRetiredBatchSize( s.nRetiredBatchSize )
+                    , evcGuardAllocList( s.evcGuardAllocList )
+                    , evcGuardAlloc( s.evcGuardAlloc )
+                    , evcGuardFreeList( s.evcGuardFreeList )
+                    , evcRetiredAllocList( s.evcRetiredAllocList )
+                    , evcRetiredFreeList( s.evcRetiredFreeList )
+                    , evcRetiredPushList( s.evcRetiredPushList )
+                    , evcRetiredPush( s.evcRetiredPush )
+                    , evcLiberateCall( s.evcLiberateCall )
+                    , fLiberateTime( s.fLiberateTime )
                 {}
                 //@endcond
             };
 
         private:
+            /// Global pool traffic statistics
+            struct Statistics {
+                atomics::event_counter  m_GuardAllocList    ;   ///< Count of guard batches taken from the global guard pool
+                atomics::event_counter  m_GuardAlloc        ;   ///< Count of guards taken from the global guard pool
+                atomics::event_counter  m_GuardFreeList     ;   ///< Count of thread's guard lists returned to the global guard pool
+                atomics::event_counter  m_RetiredAllocList  ;   ///< Count of retired node batches taken from the global pool
+                atomics::event_counter  m_RetiredFreeList   ;   ///< Count of thread's retired node caches returned to the global pool
+                atomics::event_counter  m_RetiredPushList   ;   ///< Count of retired pointer batches pushed to the global retired buffer
+                atomics::event_counter  m_RetiredPush       ;   ///< Count of retired pointers pushed to the global retired buffer
+                atomics::event_counter  m_LiberateCall      ;   ///< Count of liberate calls
+                atomics::event_counter  m_LiberateTime      ;   ///< Total time of liberate calls, in cds::OS::Timer native units
+            };
+
             static GarbageCollector * m_pManager    ;   ///< GC global instance
 
             details::guard_allocator<>      m_GuardPool         ;   ///< Guard pool
@@ -684,10 +800,21 @@ namespace cds { namespace gc {
 
             const size_t    m_nLiberateThreshold    ;   ///< Max size of retired pointer buffer to call liberate
             const size_t    m_nInitialThreadGuardCount; ///< Initial count of guards allocated for ThreadGC
+            const size_t    m_nRetiredBatchSize     ;   ///< Size of thread's batch of retired pointers
 
             InternalState   m_stat  ;   ///< Internal statistics
+            Statistics      m_PoolStat  ;   ///< Global pool traffic statistics
             bool            m_bStatEnabled  ;   ///< Internal Statistics enabled
 
+            //@cond
+            class reclaimer_impl    ;
+            //@endcond
+            atomic<reclaimer_impl *> m_pReclaimer   ;   ///< background reclaimer; NULL if it is disabled (see \ref enableReclaimer)
+
+        public:
+            /// Max size of thread's batch of retired pointers
+            static const size_t c_nRetiredBatchSize = 32    ;
+
         public:
             /// Initializes PTB memory manager singleton
             /**
@@ -702,9 +829,14 @@ namespace cds { namespace gc {
                     If \p nLiberateThreshold <= 1, \p liberate would called after each \ref retirePtr call.
                 \li \p nInitialThreadGuardCount - initial count of guard allocated for ThreadGC. When a thread
                     is initialized the GC allocates local guard pool for the thread from common guard pool.
-                    By perforce the local thread's guard pool is grown automatically from common pool. When
+                    By perforce the local thread's guard pool is grown automatically from common pool
+                    by batches of \p nInitialThreadGuardCount guards. When
                     the thread terminated its guard pool is backed to common GC's pool.
 
+                The thread collects its retired pointers in the private batch and pushes the whole batch
+                to the global retired buffer; the nodes for retired pointers are taken from the global pool
+                by batches too. The batch size is \ref c_nRetiredBatchSize but not greater than \p nLiberateThreshold.
+
             */
             static void CDS_STDCALL Construct(
                 size_t nLiberateThreshold = 1024
@@ -755,15 +887,58 @@ namespace cds { namespace gc {
             /// Allocates guard list for a thread.
             details::guard_data * allocGuardList( size_t nCount )
             {
+                if ( m_bStatEnabled ) {
+                    ++m_PoolStat.m_GuardAllocList   ;
+                    m_PoolStat.m_GuardAlloc += nCount   ;
+                }
                 return m_GuardPool.allocList( nCount )  ;
             }
 
             /// Frees thread's guard list pointed by \p pList
             void freeGuardList( details::guard_data * pList )
             {
+                if ( m_bStatEnabled )
+                    ++m_PoolStat.m_GuardFreeList    ;
                 m_GuardPool.freeList( pList )    ;
             }
 
+            /// Allocates list of at most \ref getRetiredBatchSize nodes for thread's cache of retired pointers
+            details::retired_ptr_node * allocRetiredList()
+            {
+                if ( m_bStatEnabled )
+                    ++m_PoolStat.m_RetiredAllocList ;
+                return m_RetiredAllocator.allocList( m_nRetiredBatchSize ) ;
+            }
+
+            /// Returns thread's cache [\p pHead, \p pTail] of free retired pointer nodes to the global pool
+            void freeRetiredList( details::retired_ptr_node * pHead, details::retired_ptr_node * pTail )
+            {
+                if ( m_bStatEnabled )
+                    ++m_PoolStat.m_RetiredFreeList  ;
+                m_RetiredAllocator.freeList( pHead, pTail ) ;
+            }
+
+            /// Places thread's batch [\p pHead, \p pTail] of \p nCount retired pointers into the retired buffer
+            void retireList( details::retired_ptr_node * pHead, details::retired_ptr_node * pTail, size_t nCount )
+            {
+                if ( m_bStatEnabled ) {
+                    ++m_PoolStat.m_RetiredPushList  ;
+                    m_PoolStat.m_RetiredPush += nCount  ;
+                }
+                size_t nSize = m_RetiredBuffer.pushList( pHead, pTail, nCount ) ;
+                if ( nSize >= m_nLiberateThreshold ) {
+                    // The reclaimer liberates in background unless it falls behind
+                    if ( !wakeupReclaimer( nSize ) )
+                        try_liberate()  ;
+                }
+            }
+
+            /// Returns size of thread's batch of retired pointers
+            size_t getRetiredBatchSize() const
+            {
+                return m_nRetiredBatchSize  ;
+            }
+
             /// Places retired pointer \p and its deleter \p pFunc into thread's array of retired pointer for deferred reclamation
             template <typename T>
             void retirePtr( T * p, void (* pFunc)(T *) )
@@ -774,10 +949,42 @@ namespace cds { namespace gc {
             /// Places retired pointer \p into thread's array of retired pointer for deferred reclamation
             void retirePtr( const retired_ptr& p )
             {
-                if ( m_RetiredBuffer.push( m_RetiredAllocator.alloc(p)) >= m_nLiberateThreshold )
-                    try_liberate()  ;
+                if ( m_bStatEnabled ) {
+                    ++m_PoolStat.m_RetiredAllocList ;
+                    ++m_PoolStat.m_RetiredPushList  ;
+                    ++m_PoolStat.m_RetiredPush  ;
+                }
+                size_t nSize = m_RetiredBuffer.push( m_RetiredAllocator.alloc(p)) ;
+                if ( nSize >= m_nLiberateThreshold ) {
+                    // The reclaimer liberates in background unless it falls behind
+                    if ( !wakeupReclaimer( nSize ) )
+                        try_liberate()  ;
+                }
+            }
+
+            /// Checks if the background reclaimer thread is enabled
+            bool isReclaimerEnabled() const
+            {
+                return m_pReclaimer.load<membar_relaxed>() != NULL ;
             }
 
+            /// Enables/disables the background reclaimer thread
+            /**
+                When the reclaimer is enabled, the thread whose \ref retirePtr call reaches the liberate threshold
+                wakes up the dedicated reclaimer thread instead of calling \ref liberate itself
+                (see cds::gc::details::reclaimer). If the retired buffer grows over
+                \p nMaxBacklog * liberate threshold the thread liberates inline as before.
+
+                The function is not thread-safe: call it when no other thread uses the GC, for example,
+                just after \ref Construct. \ref Destruct stops the reclaimer.
+
+                Returns previous state.
+            */
+            bool enableReclaimer(
+                bool bEnable,               ///< \p true - start the reclaimer, \p false - stop it
+                size_t nMaxBacklog = 16     ///< max size of retired buffer in units of liberate threshold
+            )   ;
+
             /// Calls liberate function 
             /**
                 This function tries to call \ref liberate procedure if it is not active.
@@ -809,6 +1016,13 @@ namespace cds { namespace gc {
             //@cond
             void liberate( details::liberate_set& set )    ;
             void free_liberated( details::liberate_set& set )    ;
+            bool wakeupReclaimer( size_t nRetiredCount )
+            {
+                // The reclaimer is read once: it may be disabled concurrently
+                reclaimer_impl * pReclaimer = m_pReclaimer.load<membar_acquire>()  ;
+                return pReclaimer != NULL && wakeupReclaimer( pReclaimer, nRetiredCount )  ;
+            }
+            bool wakeupReclaimer( reclaimer_impl * pReclaimer, size_t nRetiredCount )   ;
             //@endcond
 
         public:
@@ -819,6 +1033,16 @@ namespace cds { namespace gc {
             InternalState& getInternalState(InternalState& stat) const
             {
                 stat = m_stat   ;
+                stat.nRetiredBatchSize   = m_nRetiredBatchSize  ;
+                stat.evcGuardAllocList   = m_PoolStat.m_GuardAllocList   ;
+                stat.evcGuardAlloc       = m_PoolStat.m_GuardAlloc       ;
+                stat.evcGuardFreeList    = m_PoolStat.m_GuardFreeList    ;
+                stat.evcRetiredAllocList = m_PoolStat.m_RetiredAllocList ;
+                stat.evcRetiredFreeList  = m_PoolStat.m_RetiredFreeList  ;
+                stat.evcRetiredPushList  = m_PoolStat.m_RetiredPushList  ;
+                stat.evcRetiredPush      = m_PoolStat.m_RetiredPush      ;
+                stat.evcLiberateCall     = m_PoolStat.m_LiberateCall     ;
+                stat.fLiberateTime       = cds::OS::Timer().duration( m_PoolStat.m_LiberateTime )  ;
                 return stat   ;
             }
 
@@ -829,6 +1053,10 @@ namespace cds { namespace gc {
             }
 
             /// Enables/disables internal statistics
+            /**
+                The statistics is disabled by default: the pool traffic counters are shared
+                by all threads and are incremented on each retired batch push.
+            */
             bool              enableStatistics( bool bEnable )
             {
                 bool bEnabled = m_bStatEnabled    ;
@@ -856,6 +1084,13 @@ namespace cds { namespace gc {
             \li Thread guard list: the list of thread-local guards (linked by \p pThreadNext field)
             \li Free guard list: the list of thread-local free guards (linked by \p pNextFree field)
             Free guard list is a subset of thread guard list.
+            When the free guard list is empty it is refilled from the global guard pool by batch.
+
+            Retired pointers are cached too:
+            \li Free retired node list: the nodes for retired pointers taken from the global pool by batch
+            \li Retired batch: the retired pointers that are not yet placed into the global retired buffer.
+                When the batch is full it is pushed to the retired buffer by single CAS.
+            Both lists are returned to the GC by \ref fini.
         */
         class ThreadGC: boost::noncopyable
         {
@@ -863,11 +1098,20 @@ namespace cds { namespace gc {
             details::guard_data *    m_pList ;   ///< Local list of guards owned by the thread
             details::guard_data *    m_pFree ;   ///< The list of free guard from m_pList
 
+            details::retired_ptr_node * m_pRetiredFree  ;   ///< Free retired nodes cached (linked by m_pNextFree)
+            details::retired_ptr_node * m_pRetiredHead  ;   ///< Head of retired batch (linked by m_pNext)
+            details::retired_ptr_node * m_pRetiredTail  ;   ///< Tail of retired batch
+            size_t                      m_nRetiredCount ;   ///< Size of retired batch
+
         public:
             ThreadGC()
                 : m_gc( GarbageCollector::instance() )
                 , m_pList( NULL )
                 , m_pFree( NULL )
+                , m_pRetiredFree( NULL )
+                , m_pRetiredHead( NULL )
+                , m_pRetiredTail( NULL )
+                , m_nRetiredCount( 0 )
             {}
 
             /// Dtor calls fini()
@@ -876,6 +1120,9 @@ namespace cds { namespace gc {
                 fini()  ;
             }
 
+            /// Checks if thread GC is initialized
+            bool    isInitialized() const   { return m_pList != NULL ; }
+
             /// Initialization. Repeat call is available
             void init()
             {
@@ -888,6 +1135,14 @@ namespace cds { namespace gc {
             /// Finalization. Repeat call is available
             void fini()
             {
+                flushRetired()  ;
+                if ( m_pRetiredFree ) {
+                    details::retired_ptr_node * pTail = m_pRetiredFree  ;
+                    while ( pTail->m_pNextFree )
+                        pTail = pTail->m_pNextFree  ;
+                    m_gc.freeRetiredList( m_pRetiredFree, pTail )   ;
+                    m_pRetiredFree = NULL   ;
+                }
                 if ( m_pList ) {
                     m_gc.freeGuardList( m_pList )   ;
                     m_pList =
@@ -895,20 +1150,31 @@ namespace cds { namespace gc {
                 }
             }
 
+        private:
+            //@cond
+            // Refills empty free guard list from the global guard pool
+            void refillGuards()
+            {
+                assert( m_pFree == NULL )   ;
+                details::guard_data * pHead = m_gc.allocGuardList( m_gc.m_nInitialThreadGuardCount )   ;
+                details::guard_data * pLast = pHead ;
+                while ( pLast->pThreadNext )
+                    pLast = pLast->pThreadNext  ;
+                pLast->pThreadNext = m_pList    ;
+                m_pList =
+                    m_pFree = pHead ;
+            }
+            //@endcond
+
         public:
             /// Initializes guard \p g
             void allocGuard( Guard& g )
             {
                 assert( m_pList != NULL )   ;
-                if ( m_pFree ) {
-                    g.m_pGuard = m_pFree    ;
-                    m_pFree = m_pFree->pNextFree.load<membar_relaxed>()    ;
-                }
-                else {
-                    g.m_pGuard = m_gc.allocGuard()        ;
-                    g.m_pGuard->pThreadNext = m_pList    ;
-                    m_pList = g.m_pGuard    ;
-                }
+                if ( !m_pFree )
+                    refillGuards()  ;
+                g.m_pGuard = m_pFree    ;
+                m_pFree = m_pFree->pNextFree.load<membar_relaxed>()    ;
             }
 
             /// Frees guard \p g
@@ -924,19 +1190,11 @@ namespace cds { namespace gc {
             void allocGuard( GuardArray<COUNT>& arr )
             {
                 assert( m_pList != NULL )   ;
-                size_t nCount = 0    ;
-
-                while ( m_pFree && nCount < COUNT ) {
+                for ( size_t nCount = 0; nCount < COUNT; ++nCount ) {
+                    if ( !m_pFree )
+                        refillGuards()  ;
                     arr[nCount].set_guard( m_pFree )    ;
                     m_pFree = m_pFree->pNextFree.load<membar_relaxed>()    ;
-                    ++nCount    ;
-                }
-
-                while ( nCount < COUNT ) {
-                    details::guard& g = arr[nCount++]    ;
-                    g.set_guard( m_gc.allocGuard() )   ;
-                    g.get_guard()->pThreadNext = m_pList    ;
-                    m_pList = g.get_guard()    ;
                 }
             }
 
@@ -954,10 +1212,37 @@ namespace cds { namespace gc {
             }
 
             /// Places retired pointer \p and its deleter \p pFunc into list of retired pointer for deferred reclamation
+            /**
+                The pointer is placed into thread's batch of retired pointers. When the batch is full
+                it is pushed to the global retired buffer (see \ref flushRetired).
+            */
             template <typename T>
             void retirePtr( T * p, void (* pFunc)(T *) )
             {
-                m_gc.retirePtr( p, pFunc )  ;
+                if ( !m_pRetiredFree )
+                    m_pRetiredFree = m_gc.allocRetiredList()    ;
+                details::retired_ptr_node * pNode = m_pRetiredFree  ;
+                m_pRetiredFree = pNode->m_pNextFree ;
+
+                pNode->m_ptr = retired_ptr( reinterpret_cast<void *>( p ), reinterpret_cast<free_retired_ptr_func>( pFunc ) ) ;
+                pNode->m_pNext = m_pRetiredHead ;
+                if ( !m_pRetiredHead )
+                    m_pRetiredTail = pNode  ;
+                m_pRetiredHead = pNode  ;
+
+                if ( ++m_nRetiredCount >= m_gc.getRetiredBatchSize() )
+                    flushRetired()  ;
+            }
+
+            /// Pushes thread's batch of retired pointers to the global retired buffer
+            void flushRetired()
+            {
+                if ( m_pRetiredHead ) {
+                    m_gc.retireList( m_pRetiredHead, m_pRetiredTail, m_nRetiredCount )  ;
+                    m_pRetiredHead =
+                        m_pRetiredTail = NULL   ;
+                    m_nRetiredCount = 0 ;
+                }
             }
 
             /// Places retired pointer \p into list of retired pointer for deferred reclamation
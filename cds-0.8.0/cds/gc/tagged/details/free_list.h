@@ -15,11 +15,15 @@
     Editions:
         2007.03.03  Maxim.Khiszinsky    Created
         2008.10.01    Maxim.Khiszinsky    Refactoring
+        2011.03.20  Maxim.Khiszinsky    Per-processor node caches
 */
 
 #include <cds/gc/tagged/container_node.h>
 #include <cds/backoff_strategy.h>
 #include <cds/details/aligned_allocator.h>
+#include <cds/os/topology.h>
+#include <cds/user_setup/cache_line.h>
+#include <algorithm>    // std::swap
 
 #ifdef CDS_DWORD_CAS_SUPPORTED
 
@@ -32,10 +36,25 @@ namespace cds { namespace gc { namespace tagged {
         named free-list. So free-list may be considered as an allocator for data of type \p NODE.
         The implementation of free-list is canonical stack.
 
+        Since the stack top is single DWCAS-updated location, every alloc and free of a node
+        contends on it. So the free-list has small caches of nodes in front of the stack, two caches per processor:
+        the node freed is placed into the cache of current processor (see cds::OS::topology::current_processor),
+        the node is allocated from the cache first. The cache consists of two magazines of up to \p BATCH_SIZE nodes.
+        When both magazines are full the one is pushed to the global stack by single CAS; when both are empty
+        up to \p BATCH_SIZE nodes are popped from the global stack by single CAS. Thus, the global stack
+        is accessed once per \p BATCH_SIZE operations at most. The cache is owned by a thread for the time
+        of one operation; if the cache is owned by another thread (the owner has been preempted),
+        the next cache is tried, and if all caches are owned the node is taken from or placed to the global stack directly.
+        The caches are allocated on first \ref free call, the nodes in the caches are never freed physically
+        until the free-list is destroyed, so the type-stable memory guarantee is kept.
+        The traffic of the global stack can be checked by \ref getStatistics.
+
         \par Template parameters:
             \li \p NODE - type of node
             \li \p BACKOFF - back-off cshema. The default is backoff::empty
             \li \p ALLOCATOR - aligned memory allocator. The default class is defined by \ref CDS_DEFAULT_ALIGNED_ALLOCATOR macro
+            \li \p BATCH_SIZE - capacity of the magazine of processor cache, i.e. the count of nodes moved
+                between the cache and the global stack by one CAS. The value 0 disables the caches. Default is 32.
 
         \par
         The main problem of tagged reclamation schema is destroying a node. The node of tagged containers
@@ -60,6 +79,7 @@ namespace cds { namespace gc { namespace tagged {
     template <typename NODE,
         class BACKOFF = backoff::empty
         ,class ALLOCATOR = CDS_DEFAULT_ALIGNED_ALLOCATOR
+        ,size_t BATCH_SIZE = 32
     >
     class FreeList
     {
@@ -72,10 +92,24 @@ namespace cds { namespace gc { namespace tagged {
         typedef BACKOFF     backoff_strategy    ;   ///< Back-off strategy
         typedef typename    aligned_allocator::allocator_type      allocator_type   ; ///< Aligned allocator
 
+        static const size_t c_nBatchSize = BATCH_SIZE   ;   ///< Magazine capacity of processor cache, 0 - no cache
+
         /// To support rebind to type \p OTHER_NODE, and back-off strategy \p OTHER_BACKOFF, and allocator \p OTHER_ALLOC
-        template <typename OTHER_NODE, typename OTHER_BACKOFF = BACKOFF, typename OTHER_ALLOC = ALLOCATOR >
+        template <typename OTHER_NODE, typename OTHER_BACKOFF = BACKOFF, typename OTHER_ALLOC = ALLOCATOR, size_t OTHER_BATCH_SIZE = BATCH_SIZE >
         struct rebind {
-            typedef FreeList< OTHER_NODE, OTHER_BACKOFF, OTHER_ALLOC >    other ;   ///< Rebinding result
+            typedef FreeList< OTHER_NODE, OTHER_BACKOFF, OTHER_ALLOC, OTHER_BATCH_SIZE >    other ;   ///< Rebinding result
+        };
+
+        /// Free-list statistics (see \ref getStatistics)
+        struct statistics {
+            size_t  m_nCacheAlloc       ;   ///< Count of nodes allocated from processor caches
+            size_t  m_nCacheFree        ;   ///< Count of nodes freed to processor caches
+            size_t  m_nCacheBusy        ;   ///< Count of operations that have found all processor caches owned by other threads
+            size_t  m_nGlobalPop        ;   ///< Count of successful pops from the global stack (one CAS each)
+            size_t  m_nGlobalPopNodes   ;   ///< Count of nodes popped from the global stack
+            size_t  m_nGlobalPush       ;   ///< Count of pushes to the global stack (one CAS each)
+            size_t  m_nGlobalPushNodes  ;   ///< Count of nodes pushed to the global stack
+            size_t  m_nHeapAlloc        ;   ///< Count of nodes allocated from the heap
         };
 
     private:
@@ -86,29 +120,148 @@ namespace cds { namespace gc { namespace tagged {
 
         typedef tagged_type< node_type * >  tagged_node    ;    ///< Tagged node
 
+        //@cond
+        // The list of nodes linked by m_pNextFree, owned by one thread
+        struct magazine {
+            node_type * m_pHead     ;
+            node_type * m_pTail     ;
+            size_t      m_nCount    ;
+
+            magazine()
+                : m_pHead( NULL )
+                , m_pTail( NULL )
+                , m_nCount( 0 )
+            {}
+
+            void push( node_type * pNode )
+            {
+                set_next_free( pNode, m_pHead ) ;
+                if ( !m_pHead )
+                    m_pTail = pNode ;
+                m_pHead = pNode ;
+                ++m_nCount  ;
+            }
+
+            node_type * pop()
+            {
+                assert( m_pHead != NULL )   ;
+                node_type * pNode = m_pHead ;
+                m_pHead = next_free( pNode ) ;
+                if ( !m_pHead )
+                    m_pTail = NULL  ;
+                --m_nCount  ;
+                return pNode    ;
+            }
+        };
+
+        struct processor_cache {
+            atomic<unsigned int>    m_nOwned    ;   // 1 - the cache is owned by a thread
+            magazine                m_Loaded    ;   // magazine the nodes are allocated from and freed to
+            magazine                m_Prev      ;   // full or empty magazine
+            size_t                  m_nAlloc    ;   // count of nodes allocated from the cache
+            size_t                  m_nFree     ;   // count of nodes freed to the cache
+            char                    m_pad[ c_nCacheLineSize ]  ;   // the caches must not share the cache line
+
+            processor_cache()
+                : m_nOwned( 0 )
+                , m_nAlloc( 0 )
+                , m_nFree( 0 )
+            {}
+        };
+        typedef cds::details::Allocator< processor_cache, CDS_DEFAULT_ALLOCATOR >  cache_allocator ;
+        //@endcond
+
         tagged_node         m_Top   ;   ///< top of the stack of free nodes
         aligned_allocator   m_Alloc ;   ///< aligned allocator
 
+        atomic<processor_cache *>   m_pCaches       ;   ///< processor caches, allocated on first \ref free call
+        size_t const                m_nCacheCount   ;   ///< count of processor caches
+
+        //@cond
+        atomics::event_counter  m_nCacheBusy        ;
+        atomics::event_counter  m_nGlobalPop        ;
+        atomics::event_counter  m_nGlobalPopNodes   ;
+        atomics::event_counter  m_nGlobalPush       ;
+        atomics::event_counter  m_nGlobalPushNodes  ;
+        atomics::event_counter  m_nHeapAlloc        ;
+        //@endcond
+
     private:
-        /// Places the node \p node to internal stack
-        void push( node_type * pNode )
+        //@cond
+        static node_type * next_free( node_type * pNode )
         {
-            assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( pNode ) )   ;
+            return static_cast<node_type *>( static_cast<container_node *>( pNode )->m_pNextFree.data() )    ;
+        }
+        static void set_next_free( node_type * pNode, node_type * pNext )
+        {
+            static_cast<container_node *>( pNode )->m_pNextFree.ref() = pNext   ;
+        }
+        //@endcond
+
+        /// Places the list [\p pHead, \p pTail] of \p nCount nodes to internal stack by one CAS
+        void push( node_type * pHead, node_type * pTail, size_t nCount )
+        {
+            assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( pHead ) )   ;
 
             BACKOFF backoff    ;
             tagged_node t    ;
             while ( true ) {
                 t = atomics::load<membar_acquire>( &m_Top )    ;
-                static_cast< container_node *>( pNode )->m_pNextFree.set<membar_relaxed>( static_cast<container_node *>( t.data() ) )   ;
-                if ( cas_tagged<membar_release>( m_Top, t, pNode ))
+                static_cast< container_node *>( pTail )->m_pNextFree.set<membar_relaxed>( static_cast<container_node *>( t.data() ) )   ;
+                if ( cas_tagged<membar_release>( m_Top, t, pHead ))
                     break        ;
                 backoff();
             }
+            ++m_nGlobalPush ;
+            m_nGlobalPushNodes += nCount    ;
         }
 
-        /** Pops cached node from internal stack. If free-list is not empty this method calls \p destroy_data of
-            popped node before return.
+        /// Places the node \p node to internal stack
+        void push( node_type * pNode )
+        {
+            push( pNode, pNode, 1 ) ;
+        }
+
+        /// Pops up to \ref c_nBatchSize nodes from internal stack to the magazine \p mag by one CAS
+        /**
+            The nodes popped are walked from the top before the CAS; the walk may read the nodes
+            that are popped concurrently, but type-stable memory makes the reading safe and the tag of the top
+            guarantees that the list has not been changed if the CAS succeeds.
         */
+        bool pop( magazine& mag )
+        {
+            assert( mag.m_nCount == 0 ) ;
+
+            tagged_node t    ;
+            node_type * pLast   ;
+            node_type * pNext   ;
+            size_t      nCount  ;
+            BACKOFF backoff    ;
+            while ( true ) {
+                t = atomics::load<membar_acquire>( &m_Top )    ;
+                if ( t.data() == NULL )
+                    return false    ;
+                pLast = t.data()    ;
+                pNext = next_free( pLast )  ;
+                for ( nCount = 1; pNext && nCount < c_nBatchSize; ++nCount ) {
+                    pLast = pNext   ;
+                    pNext = next_free( pLast )  ;
+                }
+                if ( cas_tagged<membar_release>( m_Top, t, pNext ))
+                    break    ;
+                backoff();
+            }
+            set_next_free( pLast, NULL )    ;
+            mag.m_pHead = t.data()  ;
+            mag.m_pTail = pLast     ;
+            mag.m_nCount = nCount   ;
+
+            ++m_nGlobalPop  ;
+            m_nGlobalPopNodes += nCount ;
+            return true ;
+        }
+
+        /// Pops one node from internal stack. Returns \p NULL if the stack is empty
         node_type * pop()
         {
             tagged_node t    ;
@@ -122,13 +275,85 @@ namespace cds { namespace gc { namespace tagged {
                 backoff();
             }
             assert( t.m_data != NULL )    ;
-            node_type * p = static_cast< node_type *>( t.data() )   ;
-            assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( p ) )   ;
-            p->destroy_data()   ;
-            static_cast<container_node *>(p)->m_pNextFree.ref() = NULL      ;
-            return p            ;
+            ++m_nGlobalPop  ;
+            ++m_nGlobalPopNodes ;
+            return static_cast< node_type *>( t.data() ) ;
+        }
+
+        //@cond
+        processor_cache * lock_cache( bool bCreate )
+        {
+            if ( c_nBatchSize == 0 )
+                return NULL ;
+
+            processor_cache * pCaches = m_pCaches.template load<membar_acquire>()   ;
+            if ( !pCaches ) {
+                if ( !bCreate )
+                    return NULL ;
+                pCaches = cache_allocator().NewArray( m_nCacheCount )   ;
+                if ( !m_pCaches.template cas<membar_acq_rel>( (processor_cache *) NULL, pCaches )) {
+                    cache_allocator().Delete( pCaches, m_nCacheCount )  ;
+                    pCaches = m_pCaches.template load<membar_acquire>()   ;
+                }
+            }
+
+            // If the cache of current processor is owned by a preempted thread, the caches of other processors are tried
+            size_t nIdx = cds::OS::topology::current_processor()    ;
+            for ( size_t i = 0; i < m_nCacheCount; ++i ) {
+                processor_cache * pCache = pCaches + ( nIdx + i ) % m_nCacheCount   ;
+                if ( pCache->m_nOwned.template load<membar_relaxed>() == 0 && pCache->m_nOwned.template xchg<membar_acquire>( 1 ) == 0 )
+                    return pCache   ;
+            }
+            ++m_nCacheBusy  ;
+            return NULL ;
         }
 
+        static void unlock_cache( processor_cache * pCache )
+        {
+            pCache->m_nOwned.template store<membar_release>( 0 )    ;
+        }
+
+        // Returns a free node with destroyed data or NULL if the free-list is empty
+        node_type * get()
+        {
+            node_type * p   ;
+            processor_cache * pCache = lock_cache( false )   ;
+            if ( pCache ) {
+                if ( pCache->m_Loaded.m_nCount == 0 ) {
+                    if ( pCache->m_Prev.m_nCount > 0 )
+                        std::swap( pCache->m_Loaded, pCache->m_Prev )   ;
+                    else
+                        pop( pCache->m_Loaded ) ;
+                }
+                if ( pCache->m_Loaded.m_nCount > 0 ) {
+                    p = pCache->m_Loaded.pop()  ;
+                    ++pCache->m_nAlloc  ;
+                }
+                else
+                    p = NULL    ;
+                unlock_cache( pCache )  ;
+            }
+            else
+                p = pop()   ;
+
+            if ( p ) {
+                assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( p ) )   ;
+                p->destroy_data()   ;
+                set_next_free( p, NULL )    ;
+            }
+            return p    ;
+        }
+
+        void delete_list( node_type * p )
+        {
+            while ( p ) {
+                node_type * pNext = next_free( p )  ;
+                m_Alloc.Delete( p )    ;
+                p = pNext    ;
+            }
+        }
+        //@endcond
+
         /// Clears internal stack. This method physically deletes all cached nodes.
         void clear()
         {
@@ -140,16 +365,22 @@ namespace cds { namespace gc { namespace tagged {
             } while ( !cas_tagged<membar_release>( m_Top, t, (node_type *) NULL ) )    ;
 
             // t contains the list's head and it is private for current thread
-            node_type * p = t.data()    ;
-            while ( p ) {
-                node_type * pNext = static_cast<node_type *>( static_cast<container_node *>(p)->m_pNextFree.data() )   ;
-                m_Alloc.Delete( p )    ;
-                p = pNext    ;
+            delete_list( t.data() ) ;
+
+            processor_cache * pCaches = m_pCaches.template xchg<membar_acquire>( (processor_cache *) NULL )  ;
+            if ( pCaches ) {
+                for ( size_t i = 0; i < m_nCacheCount; ++i ) {
+                    delete_list( pCaches[i].m_Loaded.m_pHead )  ;
+                    delete_list( pCaches[i].m_Prev.m_pHead )    ;
+                }
+                cache_allocator().Delete( pCaches, m_nCacheCount )  ;
             }
         }
 
     public:
         FreeList()
+            : m_pCaches( NULL )
+            , m_nCacheCount( cds::OS::topology::processor_count() * 2 )
         {
             CDS_STATIC_ASSERT( sizeof(node_type) >= sizeof(void *) )    ;
         }
@@ -162,10 +393,11 @@ namespace cds { namespace gc { namespace tagged {
         /// Get new node from free-list. If free-list is empty the new node is allocated
         node_type * alloc()
         {
-            node_type * pNew = pop()    ;
+            node_type * pNew = get()    ;
             if ( pNew )
                 pNew->construct_data()  ;
             else {
+                ++m_nHeapAlloc  ;
                 pNew = m_Alloc.New( CDS_TAGGED_ALIGNMENT )    ;
                 assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( pNew ) )   ;
             }
@@ -176,12 +408,13 @@ namespace cds { namespace gc { namespace tagged {
         template <typename T1>
         node_type * alloc( const T1& init)
         {
-            node_type * pNew = pop()    ;
+            node_type * pNew = get()    ;
             if ( pNew ) {
                 assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( pNew ) )   ;
                 pNew->construct_data( init )    ;
             }
             else {
+                ++m_nHeapAlloc  ;
                 pNew = m_Alloc.New( CDS_TAGGED_ALIGNMENT, init )    ;
                 assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( pNew ) )   ;
             }
@@ -192,12 +425,13 @@ namespace cds { namespace gc { namespace tagged {
         template <typename T1, typename T2>
         node_type * alloc( const T1& init1, const T2& init2)
         {
-            node_type * pNew = pop()    ;
+            node_type * pNew = get()    ;
             if ( pNew ) {
                 assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( pNew ) )   ;
                 pNew->construct_data( init1, init2 )    ;
             }
             else {
+                ++m_nHeapAlloc  ;
                 pNew = m_Alloc.New( CDS_TAGGED_ALIGNMENT, init1, init2 )    ;
                 assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( pNew ) )   ;
             }
@@ -208,7 +442,48 @@ namespace cds { namespace gc { namespace tagged {
         void free( node_type * p )
         {
             assert( cds::details::is_aligned<CDS_TAGGED_ALIGNMENT>( p ) )   ;
-            push( p )    ;
+
+            processor_cache * pCache = lock_cache( true )   ;
+            if ( pCache ) {
+                if ( pCache->m_Loaded.m_nCount >= c_nBatchSize ) {
+                    // Both magazines are full - the previous one goes to the global stack
+                    if ( pCache->m_Prev.m_nCount > 0 )
+                        push( pCache->m_Prev.m_pHead, pCache->m_Prev.m_pTail, pCache->m_Prev.m_nCount ) ;
+                    pCache->m_Prev = pCache->m_Loaded   ;
+                    pCache->m_Loaded = magazine()       ;
+                }
+                pCache->m_Loaded.push( p )  ;
+                ++pCache->m_nFree   ;
+                unlock_cache( pCache )  ;
+            }
+            else
+                push( p )    ;
+        }
+
+        /// Returns the statistics of the free-list
+        /**
+            The counters of processor caches are read without synchronization, so the result is approximate
+            while other threads work with the free-list.
+        */
+        statistics getStatistics() const
+        {
+            statistics s    ;
+            s.m_nCacheAlloc =
+                s.m_nCacheFree = 0  ;
+            processor_cache * pCaches = m_pCaches.template load<membar_acquire>()   ;
+            if ( pCaches ) {
+                for ( size_t i = 0; i < m_nCacheCount; ++i ) {
+                    s.m_nCacheAlloc += pCaches[i].m_nAlloc  ;
+                    s.m_nCacheFree += pCaches[i].m_nFree    ;
+                }
+            }
+            s.m_nCacheBusy = m_nCacheBusy   ;
+            s.m_nGlobalPop = m_nGlobalPop   ;
+            s.m_nGlobalPopNodes = m_nGlobalPopNodes ;
+            s.m_nGlobalPush = m_nGlobalPush ;
+            s.m_nGlobalPushNodes = m_nGlobalPushNodes   ;
+            s.m_nHeapAlloc = m_nHeapAlloc   ;
+            return s    ;
         }
     };
 }}} // namespace cds::gc::tagged
@@ -24,6 +24,9 @@
 #include <cds/memory/michael/bound_check.h>
 #include <cds/memory/michael/procheap_stat.h>
 #include <cds/memory/michael/osalloc_stat.h>
+#include <cds/memory/michael/thread_cache.h>
+#include <cds/memory/michael/remote_free.h>
+#include <cds/memory/michael/huge_page_heap.h>
 
 #include <cds/os/topology.h>
 #include <cds/os/alloc_aligned.h>
@@ -32,6 +35,8 @@
 #include <cds/details/markptr.h>
 #include <cds/queue/vyukov_mpmc_bounded.h>
 #include <cds/user_setup/cache_line.h>
+#include <cds/threading/model.h>
+#include <cds/details/allocator.h>
 
 #include <stdlib.h>
 #include <boost/intrusive/list.hpp>
@@ -461,6 +466,23 @@ namespace michael {
         */
         size_t      nPartialAnchorCASFailureCount;   
 
+        // Per-thread cache statistics (see opt::thread_cache)
+        size_t      nCacheAllocHit      ;  ///< Count of \p alloc served from the cache of current thread
+        size_t      nCacheRefillCount   ;  ///< Count of cache refilling from the processor heaps (cache miss of \p alloc)
+        size_t      nCacheFreeHit       ;  ///< Count of \p free that places the block into the cache of current thread
+        size_t      nCacheFlushCount    ;  ///< Count of cache flushing to the processor heaps (the cache is full)
+
+        // Remote-free batching statistics (see opt::remote_free)
+        size_t      nRemoteFreeCount    ;  ///< Count of remote blocks sent to the owner processor heaps
+        size_t      nRemoteBatchCount   ;  ///< Count of batches of remote blocks
+        size_t      nRemoteDrainCount   ;  ///< Count of draining of remote-free lists by the owners
+
+        // Huge page heap statistics (see huge_page_allocator)
+        size_t      nHugeTLBChunkCount  ;  ///< Count of page heap chunks backed by explicit huge pages
+        size_t      nTHPChunkCount      ;  ///< Count of page heap chunks backed by transparent huge pages
+        size_t      nRegularChunkCount  ;  ///< Count of page heap chunks backed by regular pages
+        size_t      nNodeBindCount      ;  ///< Count of page heap chunks bound to NUMA node
+        size_t      nNodeBindFailCount  ;  ///< Count of failed NUMA bindings of page heap chunks
 
     public:
         /// Constructs empty statistics. All counters are zero.
@@ -497,6 +519,21 @@ namespace michael {
             nPartialDescCASFailureCount     -= stat.nPartialDescCASFailureCount     ;
             nPartialAnchorCASFailureCount   -= stat.nPartialAnchorCASFailureCount   ;
 
+            nCacheAllocHit      -= stat.nCacheAllocHit      ;
+            nCacheRefillCount   -= stat.nCacheRefillCount   ;
+            nCacheFreeHit       -= stat.nCacheFreeHit       ;
+            nCacheFlushCount    -= stat.nCacheFlushCount    ;
+
+            nRemoteFreeCount    -= stat.nRemoteFreeCount    ;
+            nRemoteBatchCount   -= stat.nRemoteBatchCount   ;
+            nRemoteDrainCount   -= stat.nRemoteDrainCount   ;
+
+            nHugeTLBChunkCount  -= stat.nHugeTLBChunkCount  ;
+            nTHPChunkCount      -= stat.nTHPChunkCount      ;
+            nRegularChunkCount  -= stat.nRegularChunkCount  ;
+            nNodeBindCount      -= stat.nNodeBindCount      ;
+            nNodeBindFailCount  -= stat.nNodeBindFailCount  ;
+
             return *this    ;
         }
 
@@ -529,6 +566,10 @@ namespace michael {
             nPartialDescCASFailureCount     += stat.partialDescCASFailureCount()   ;
             nPartialAnchorCASFailureCount   += stat.partialAnchorCASFailureCount() ;
 
+            nRemoteFreeCount    += stat.remoteFreeCount()   ;
+            nRemoteBatchCount   += stat.remoteBatchCount()  ;
+            nRemoteDrainCount   += stat.remoteDrainCount()  ;
+
             return *this    ;
         }
 
@@ -543,6 +584,29 @@ namespace michael {
 
             return *this;
         }
+
+        template <typename STAT>
+        summary_stat& add_thread_cache_stat( const STAT& stat )
+        {
+            nCacheAllocHit      += stat.allocHit()      ;
+            nCacheRefillCount   += stat.refillCount()   ;
+            nCacheFreeHit       += stat.freeHit()       ;
+            nCacheFlushCount    += stat.flushCount()    ;
+
+            return *this;
+        }
+
+        template <typename STAT>
+        summary_stat& add_huge_page_stat( const STAT& stat )
+        {
+            nHugeTLBChunkCount  += stat.hugeTLBCount()      ;
+            nTHPChunkCount      += stat.thpCount()          ;
+            nRegularChunkCount  += stat.regularCount()      ;
+            nNodeBindCount      += stat.nodeBindCount()     ;
+            nNodeBindFailCount  += stat.nodeBindFailCount() ;
+
+            return *this;
+        }
         //@endcond
     };
 
@@ -564,7 +628,8 @@ namespace michael {
         With opt:topology you can set as many allocation arena ("processor heap") as you need. 
         You can manually bound any your thread to any arena ("processor"). With opt::sizeclass_selector option you can manage 
         allocation granularity. With opt::page_heap you can utilize any OS-provided features for page allocation 
-        like \p mmap, \p VirtualAlloc etc. The heap can gather internal statistics that helps you to tune your application.
+        like \p mmap, \p VirtualAlloc etc. (see \ref huge_page_allocator and \ref numa_page_allocator).
+        The heap can gather internal statistics that helps you to tune your application.
         The opt::check_bounds feature can help you to find a memory buffer overflow. 
 
         Brief algorithm description from Michael's work:
@@ -596,7 +661,8 @@ namespace michael {
         - \ref opt::aligned_heap - option setter for a heap used for internal aligned memory management.
             Default is \ref aligned_malloc_heap
         - \ref opt::page_heap - option setter for a heap used for page (superblock) allocation of 64K/1M size.
-            Default is \ref page_cached_allocator
+            Default is \ref page_cached_allocator. If the page heap is \ref numa_page_allocator
+            the heap binds page heaps of each processor to NUMA node of the processor.
         - \ref opt::sizeclass_selector - option setter for a class used to select appropriate size-class
             for incoming allocation request.
             Default is \ref default_sizeclass_selector
@@ -614,6 +680,12 @@ namespace michael {
             Default is \ref os_allocated_empty
         - \ref opt::check_bounds - a bound checker. 
             Default is no bound checker (cds::opt::none)
+        - \ref opt::thread_cache - per-thread cache of free blocks in front of the processor heaps.
+            Default is \ref no_thread_cache
+        - \ref opt::thread_cache_stat - option setter for a class to gather statistics of per-thread cache.
+            Default is \ref thread_cache_empty_stat
+        - \ref opt::remote_free - remote-free batching policy: the blocks freed by a thread running on other processor
+            are sent to the owner processor heap by batches. Default is \ref no_remote_free
 
         \par Usage:
         The heap is the basic building block for your allocator or <tt> operator new</tt> implementation.
@@ -725,6 +797,9 @@ namespace michael {
             typedef procheap_empty_stat         procheap_stat   ;
             typedef os_allocated_empty          os_allocated_stat   ;
             typedef cds::opt::none              check_bounds    ;
+            typedef no_thread_cache             thread_cache    ;
+            typedef thread_cache_empty_stat     thread_cache_stat   ;
+            typedef no_remote_free              remote_free     ;
         };
         //@endcond
 
@@ -749,6 +824,9 @@ namespace michael {
         typedef typename options::procheap_stat         procheap_stat       ;   ///< effective processor heap statistics 
         typedef typename options::os_allocated_stat     os_allocated_stat   ;   ///< effective OS-allocated memory statistics
         typedef details::bound_checker_selector< typename options::check_bounds >    bound_checker   ;  ///< effective bound checker 
+        typedef typename options::thread_cache          thread_cache        ;   ///< effective per-thread cache policy
+        typedef typename options::thread_cache_stat     thread_cache_stat   ;   ///< effective per-thread cache statistics
+        typedef typename options::remote_free           remote_free         ;   ///< effective remote-free batching policy
 
         // forward declarations
         //@cond
@@ -956,6 +1034,10 @@ namespace michael {
         struct free_block_header: block_header {
             unsigned int    nNextFree   ;
         };
+
+        struct cached_block_header: block_header {
+            block_header *  pNextCached ;   // next block in the per-thread cache bin
+        };
         //@endcond
 
 #if CDS_BUILD_BITS == 32
@@ -1081,6 +1163,7 @@ namespace michael {
             superblock_desc *   pPartial    ;   ///< pointer to partial filled superblock (may be NULL)
             partial_list        partialList ;   ///< list of partial filled superblocks owned by the processor heap
             unsigned int        nPageIdx    ;   ///< page size-class index 
+            block_header *      pRemoteFree ;   ///< lock-free list of blocks freed by other processors (see opt::remote_free)
 
             procheap_stat       stat        ;   ///< heap statistics
             //processor_heap_statistics   stat    ;   
@@ -1090,6 +1173,7 @@ namespace michael {
                 : pPartial(NULL)
                 , pSizeClass( NULL )
                 , pProcDesc( NULL )
+                , pRemoteFree( NULL )
             {
                 assert( (reinterpret_cast<uptr_atomic_t>(this) & (c_nAlignment - 1)) == 0 ) ;
             }
@@ -1148,6 +1232,70 @@ namespace michael {
             //@endcond
         };
 
+        //@cond
+        /// Per-thread cache bin: free blocks of one size class
+        struct thread_cache_bin
+        {
+            block_header *  pHead   ;   ///< head of the list of cached blocks
+            size_t          nCount  ;   ///< count of blocks in the list
+
+            thread_cache_bin()
+                : pHead( NULL )
+                , nCount( 0 )
+            {}
+        };
+
+        /// Per-thread buffer of remote blocks of one destination processor heap
+        struct remote_free_slot
+        {
+            processor_heap_base *   pDest   ;   ///< destination processor heap
+            block_header *          pHead   ;   ///< first block of the chain
+            block_header *          pTail   ;   ///< last block of the chain
+            size_t                  nCount  ;   ///< count of blocks in the chain
+
+            remote_free_slot()
+                : pDest( NULL )
+                , pHead( NULL )
+                , pTail( NULL )
+                , nCount( 0 )
+            {}
+        };
+
+        /// Per-thread cache of the heap
+        /**
+            The cache is the extension of cds::threading::ThreadData identified by the heap address.
+            It contains the bins of free blocks (see opt::thread_cache) and the buffers of remote blocks
+            (see opt::remote_free).
+            All caches of the heap are linked into the list of the heap, so the heap destructor can
+            detach them from the heap.
+        */
+        struct thread_cache_rec: public cds::threading::ThreadData::extension
+        {
+            typedef cds::threading::ThreadData::extension   base_class  ;
+
+            Heap *              pHeap       ;   ///< owner heap, NULL if the heap has been destroyed
+            thread_cache_rec *  pPrevCache  ;   ///< previous cache in the list of the heap
+            thread_cache_rec *  pNextCache  ;   ///< next cache in the list of the heap
+            thread_cache_bin *  pBins       ;   ///< array of bins, one for each size class
+            size_t              nAllocHit   ;   ///< alloc hit count not yet added to heap's statistics
+            size_t              nFreeHit    ;   ///< free hit count not yet added to heap's statistics
+            remote_free_slot    arrRemote[ remote_free::slot_count != 0 ? remote_free::slot_count : 1 ] ; ///< buffers of remote blocks
+
+            thread_cache_rec( Heap * heap, thread_cache_bin * pBinArray )
+                : base_class( heap, destroy_thread_cache )
+                , pHeap( heap )
+                , pPrevCache( NULL )
+                , pNextCache( NULL )
+                , pBins( pBinArray )
+                , nAllocHit( 0 )
+                , nFreeHit( 0 )
+            {}
+        };
+
+        typedef cds::details::Allocator< thread_cache_rec, CDS_DEFAULT_ALLOCATOR >  thread_cache_allocator  ;
+        typedef cds::details::Allocator< thread_cache_bin, CDS_DEFAULT_ALLOCATOR >  thread_cache_bin_allocator  ;
+        //@endcond
+
 
     protected:
         sys_topology        m_Topology           ;  ///< System topology
@@ -1160,6 +1308,10 @@ namespace michael {
 
         os_allocated_stat   m_OSAllocStat        ;  ///< OS-allocated memory statistics
 
+        thread_cache_rec *  m_pThreadCacheList   ;  ///< List of per-thread caches of the heap
+        cds::lock::Spin     m_ThreadCacheLock    ;  ///< Lock for the list of per-thread caches
+        thread_cache_stat   m_ThreadCacheStat    ;  ///< Per-thread cache statistics
+
     protected:
         //@cond
 
@@ -1172,6 +1324,13 @@ namespace michael {
             return p            ;
         }
 
+        /// Frees large block allocated from system memory
+        void free_to_OS( block_header * pBlock )
+        {
+            m_OSAllocStat.incBytesDeallocated( pBlock->getOSAllocSize() )   ;
+            m_LargeHeap.free( pBlock )  ;
+        }
+
         /// Allocates from the active superblock if it possible
         block_header * alloc_from_active( processor_heap * pProcHeap ) 
         {
@@ -1245,6 +1404,109 @@ namespace michael {
             return reinterpret_cast<block_header *>( pAddr )    ;
         }
 
+        /// Allocates up to \p nCount blocks from the active superblock into the thread cache bin \p bin
+        /**
+            The blocks are reserved by one CAS of \p active field (up to the credits of the active superblock)
+            and popped from the superblock by one CAS of its anchor.
+            Returns the count of blocks placed into \p bin, 0 if the processor heap has no active superblock.
+        */
+        size_t alloc_batch_from_active( processor_heap * pProcHeap, size_t nCount, thread_cache_bin& bin )
+        {
+            assert( nCount > 0 )    ;
+
+            // Reserve blocks
+            active_tag  oldActive   ;
+            active_tag  newActive   ;
+            unsigned int nReserved  ;
+            bool bLastCredits       ;
+            int nCollision = -1 ;
+
+            do {
+                ++nCollision    ;
+                newActive = oldActive = atomics::load<membar_acquire>( &(pProcHeap->active) ) ;
+                if ( !oldActive.ptr() )
+                    return 0    ;
+                unsigned int nCredits = oldActive.credits() ;
+                bLastCredits = nCount > nCredits    ;
+                if ( bLastCredits ) {
+                    // Take all nCredits + 1 blocks
+                    nReserved = nCredits + 1    ;
+                    newActive.clear()   ;
+                }
+                else {
+                    nReserved = (unsigned int) nCount   ;
+                    newActive.credits( nCredits - nReserved )   ;
+                }
+            } while ( !atomics::cas<membar_release>( &(pProcHeap->active), oldActive, newActive ) ) ;
+
+            if ( nCollision )
+                pProcHeap->stat.incActiveDescCASFailureCount( nCollision ) ;
+
+            // pop reserved blocks
+            superblock_desc * pDesc = oldActive.ptr()   ;
+
+            anchor_tag  oldAnchor   ;
+            anchor_tag  newAnchor   ;
+            unsigned int nMoreCredits = 0  ;
+
+            nCollision = -1 ;
+            do {
+                ++nCollision    ;
+                newAnchor = oldAnchor = atomics::load<membar_acquire>( &(pDesc->anchor) )  ;
+
+                assert( oldAnchor.avail < pDesc->nCapacity )    ;
+                unsigned int nNext = (unsigned int) oldAnchor.avail ;
+                for ( unsigned int i = 0; i < nReserved; ++i ) {
+                    // The index may be stale if another thread has changed the anchor; the CAS fails in this case
+                    if ( nNext >= pDesc->nCapacity )
+                        break   ;
+                    nNext = reinterpret_cast<free_block_header *>( pDesc->pSB + nNext * pDesc->nBlockSize )->nNextFree ;
+                }
+                newAnchor.avail = nNext ;
+                newAnchor.tag += 1  ;
+
+                if ( bLastCredits ) {
+                    // state must be ACTIVE
+                    if ( oldAnchor.count == 0 )
+                        newAnchor.state = SBSTATE_FULL  ;
+                    else {
+                        nMoreCredits = oldAnchor.count < active_tag::c_nMaxCredits ? ((unsigned int) oldAnchor.count) : active_tag::c_nMaxCredits ;
+                        newAnchor.count -= nMoreCredits ;
+                    }
+                }
+            } while ( !atomics::cas<membar_release>( &(pDesc->anchor), oldAnchor, newAnchor ) ) ;
+
+            if ( nCollision )
+                pProcHeap->stat.incActiveAnchorCASFailureCount( nCollision ) ;
+
+            assert( newAnchor.state != SBSTATE_EMPTY )  ;
+
+            if ( newAnchor.state == SBSTATE_FULL )
+                pProcHeap->stat.incDescFull() ;
+            if ( bLastCredits && oldAnchor.count > 0 )
+                update_active( pProcHeap, pDesc, nMoreCredits ) ;
+
+            // The popped blocks are owned by current thread, move them to the bin
+            unsigned int nIdx = (unsigned int) oldAnchor.avail  ;
+            for ( unsigned int i = 0; i < nReserved; ++i ) {
+                block_header * p = reinterpret_cast<block_header *>( pDesc->pSB + nIdx * pDesc->nBlockSize )  ;
+                nIdx = reinterpret_cast<free_block_header *>( p )->nNextFree    ;
+
+                assert( p->desc() == pDesc ) ;
+                assert( !p->isOSAllocated() );
+                assert( !p->isAligned() )    ;
+
+                reinterpret_cast<cached_block_header *>( p )->pNextCached = bin.pHead    ;
+                bin.pHead = p   ;
+            }
+            bin.nCount += nReserved ;
+
+            pProcHeap->stat.incAllocFromActive( nReserved )    ;
+            pProcHeap->stat.incAllocatedBytes( nReserved * pProcHeap->pSizeClass->nBlockSize )  ;
+
+            return nReserved    ;
+        }
+
         /// Allocates from a partial filled superblock if it possible
         block_header * alloc_from_partial( processor_heap * pProcHeap )
         {
@@ -1412,6 +1674,26 @@ namespace michael {
             pDesc->pProcHeap->add_partial( pDesc )  ;
         }
 
+        //@cond
+        // Binds NUMA-aware page heap to the node of processor nProcessorId; other page heaps are not bound
+        template <typename STAT>
+        static void bind_page_heap( numa_page_allocator<STAT> * pPageHeap, unsigned int nProcessorId )
+        {
+            pPageHeap->bind_processor( nProcessorId )   ;
+        }
+        static void bind_page_heap( void * /*pPageHeap*/, unsigned int /*nProcessorId*/ )
+        {}
+
+        // Collects the statistics of huge page heaps; other page heaps have no statistics
+        template <typename STAT>
+        static void add_page_heap_stat( summary_stat& st, huge_page_allocator<STAT> const * pPageHeap )
+        {
+            st.add_huge_page_stat( pPageHeap->stat() )  ;
+        }
+        static void add_page_heap_stat( summary_stat& /*st*/, void const * /*pPageHeap*/ )
+        {}
+        //@endcond
+
         /// Allocates new processor descriptor
         processor_desc * new_processor_desc( unsigned int nProcessorId )
         {
@@ -1447,8 +1729,10 @@ namespace michael {
             pDesc = new( m_AlignedHeap.alloc( szTotal, c_nAlignment ) ) processor_desc    ;
 
             pDesc->pageHeaps = reinterpret_cast<page_heap *>( pDesc + 1 )   ;
-            for ( size_t i = 0; i < nPageHeapCount; ++i )
-                new (pDesc->pageHeaps + i) page_heap( m_SizeClassSelector.page_size(i))  ;           
+            for ( size_t i = 0; i < nPageHeapCount; ++i ) {
+                new (pDesc->pageHeaps + i) page_heap( m_SizeClassSelector.page_size(i))  ;
+                bind_page_heap( pDesc->pageHeaps + i, nProcessorId )    ;
+            }
 
             // initialize processor heaps
             pDesc->arrProcHeap = 
@@ -1572,6 +1856,21 @@ namespace michael {
             }
             assert( nSizeClassIndex < m_SizeClassSelector.size() )   ;
 
+            if ( thread_cache::capacity != 0 ) {
+                thread_cache_rec * pCache = get_thread_cache()  ;
+                if ( pCache )
+                    return alloc_from_thread_cache( pCache, nSizeClassIndex, nSize ) ;
+            }
+
+            return alloc_from_procheap( nSizeClassIndex, nSize )  ;
+        }
+
+        /// Allocates memory block of size-class \p nSizeClassIndex from the processor heap
+        block_header * alloc_from_procheap( 
+            typename sizeclass_selector::sizeclass_index nSizeClassIndex,   ///< Size-class index
+            size_t nSize    ///< Size of memory block to allocate in bytes
+            )
+        {
             block_header * pBlock   ;
             processor_heap * pProcHeap  ;
             while ( true ) {
@@ -1581,6 +1880,8 @@ namespace michael {
 
                 if ( (pBlock = alloc_from_active( pProcHeap )) != NULL )
                     break   ;
+                if ( remote_free::batch_size != 0 && (pBlock = alloc_from_remote( pProcHeap )) != NULL )
+                    break   ;
                 if ( (pBlock = alloc_from_partial( pProcHeap )) != NULL )
                     break   ;
                 if ( (pBlock = alloc_from_new_superblock( pProcHeap )) != NULL )
@@ -1593,10 +1894,348 @@ namespace michael {
             return pBlock ;
         }
 
+        /// Returns the block \p pBlock of superblock \p pDesc to the superblock
+        void free_to_superblock( block_header * pBlock, superblock_desc * pDesc )
+        {
+            free_chain_to_superblock( pBlock, pBlock, 1, pDesc )    ;
+        }
+
+        /// Returns the chain of \p nCount blocks of superblock \p pDesc to the superblock by one anchor CAS
+        /**
+            The blocks from \p pFirst to \p pLast must be linked by \p nNextFree indices.
+        */
+        void free_chain_to_superblock( block_header * pFirst, block_header * pLast, unsigned int nCount, superblock_desc * pDesc )
+        {
+            anchor_tag oldAnchor    ;
+            anchor_tag newAnchor    ;
+            processor_heap_base * pProcHeap = pDesc->pProcHeap    ;
+
+            pProcHeap->stat.incDeallocatedBytes( nCount * pDesc->nBlockSize )    ;
+
+            const unsigned int nFirst = (unsigned int)( (reinterpret_cast<byte *>( pFirst ) - pDesc->pSB) / pDesc->nBlockSize ) ;
+            do {
+                newAnchor = oldAnchor = atomics::load<membar_acquire>( &(pDesc->anchor) )       ;
+                reinterpret_cast<free_block_header *>( pLast )->nNextFree = oldAnchor.avail    ;
+                newAnchor.avail = nFirst    ;
+                newAnchor.tag += 1  ;
+
+                assert( oldAnchor.state != SBSTATE_EMPTY )  ;
+                assert( oldAnchor.count + nCount <= pDesc->nCapacity )  ;
+
+                if ( oldAnchor.state == SBSTATE_FULL )
+                    newAnchor.state = SBSTATE_PARTIAL   ;
+
+                if ( oldAnchor.count + nCount == pDesc->nCapacity ) {
+                    //pProcHeap = pDesc->pProcHeap    ;
+                    //CDS_COMPILER_RW_BARRIER         ;   // instruction fence is needed?..
+                    newAnchor.state = SBSTATE_EMPTY ;
+                    newAnchor.count += nCount - 1   ;
+                }
+                else
+                    newAnchor.count += nCount   ;
+            } while ( !atomics::cas<membar_release>( &(pDesc->anchor), oldAnchor, newAnchor ) )  ;
+
+            pProcHeap->stat.incFreeCount( nCount )  ;
+
+            if ( newAnchor.state == SBSTATE_EMPTY ) {
+                if ( pProcHeap->unlink_partial( pDesc ))
+                    free_superblock( pDesc )    ;
+            }
+            else if (oldAnchor.state == SBSTATE_FULL ) {
+                assert( pProcHeap != NULL )     ;
+                pProcHeap->stat.decDescFull()   ;
+                pProcHeap->add_partial( pDesc ) ;
+            }
+        }
+
+        /// Returns the blocks of the list \p pList linked by \p pNextCached to their superblocks
+        /**
+            The blocks of one superblock are chained by \p nNextFree indices and returned
+            by one anchor CAS, see \ref free_chain_to_superblock.
+        */
+        void free_list_to_superblocks( block_header * pList )
+        {
+            while ( pList ) {
+                block_header * pFirst = pList   ;
+                superblock_desc * pDesc = pFirst->desc()    ;
+                pList = reinterpret_cast<cached_block_header *>( pFirst )->pNextCached ;
+
+                // Move the blocks of pDesc from pList to the chain.
+                // nNextFree and pNextCached share the memory, so the next block of the list is read first
+                block_header * pLast = pFirst   ;
+                unsigned int nCount = 1 ;
+                block_header ** ppPrev = &pList ;
+                for ( block_header * p = pList; p; ) {
+                    block_header * pNext = reinterpret_cast<cached_block_header *>( p )->pNextCached ;
+                    if ( p->desc() == pDesc ) {
+                        *ppPrev = pNext ;
+                        reinterpret_cast<free_block_header *>( pLast )->nNextFree = (unsigned int)( (reinterpret_cast<byte *>( p ) - pDesc->pSB) / pDesc->nBlockSize ) ;
+                        pLast = p   ;
+                        ++nCount    ;
+                    }
+                    else
+                        ppPrev = &( reinterpret_cast<cached_block_header *>( p )->pNextCached )  ;
+                    p = pNext   ;
+                }
+
+                free_chain_to_superblock( pFirst, pLast, nCount, pDesc )    ;
+            }
+        }
+
+        /// Returns the cache of current thread, creates it if needed. Returns \p NULL if the thread is not attached
+        thread_cache_rec * get_thread_cache()
+        {
+            cds::threading::ThreadData * pData = cds::threading::Manager::thread_data()  ;
+            if ( !pData )
+                return NULL ;
+
+            thread_cache_rec * pCache = static_cast<thread_cache_rec *>( pData->findExtension( this ))  ;
+            if ( pCache ) {
+                if ( pCache->pHeap == this )
+                    return pCache   ;
+
+                // The heap that has created the cache was destroyed and this heap is constructed at the same address
+                assert( pCache->pHeap == NULL ) ;
+                pCache->pHeap = this    ;
+            }
+            else {
+                pCache = thread_cache_allocator().New( this, 
+                    thread_cache::capacity != 0 ? thread_cache_bin_allocator().NewArray( m_SizeClassSelector.size() ) : (thread_cache_bin *) NULL )   ;
+                pData->attachExtension( pCache )    ;
+            }
+
+            cds::lock::Auto<cds::lock::Spin> al( m_ThreadCacheLock )    ;
+            pCache->pNextCache = m_pThreadCacheList ;
+            if ( m_pThreadCacheList )
+                m_pThreadCacheList->pPrevCache = pCache ;
+            m_pThreadCacheList = pCache ;
+            return pCache   ;
+        }
+
+        /// Destroys the cache \p pExt when the thread is detached from \p libcds
+        static void destroy_thread_cache( cds::threading::ThreadData::extension * pExt )
+        {
+            thread_cache_rec * pCache = static_cast<thread_cache_rec *>( pExt )    ;
+            if ( pCache->pHeap )
+                pCache->pHeap->release_thread_cache( pCache )   ;
+
+            if ( pCache->pBins )
+                thread_cache_bin_allocator().Delete( pCache->pBins, sizeclass_selector::size() )  ;
+            thread_cache_allocator().Delete( pCache )   ;
+        }
+
+        /// Returns all blocks of \p pCache to the processor heaps and removes \p pCache from the list of the heap
+        void release_thread_cache( thread_cache_rec * pCache )
+        {
+            {
+                cds::lock::Auto<cds::lock::Spin> al( m_ThreadCacheLock )    ;
+                if ( pCache->pPrevCache )
+                    pCache->pPrevCache->pNextCache = pCache->pNextCache ;
+                else
+                    m_pThreadCacheList = pCache->pNextCache ;
+                if ( pCache->pNextCache )
+                    pCache->pNextCache->pPrevCache = pCache->pPrevCache ;
+                pCache->pPrevCache = pCache->pNextCache = NULL  ;
+            }
+
+            if ( pCache->pBins ) {
+                for ( size_t i = 0; i < m_SizeClassSelector.size(); ++i ) {
+                    thread_cache_bin& bin = pCache->pBins[i]    ;
+                    free_list_to_superblocks( bin.pHead )   ;
+                    bin.pHead = NULL    ;
+                    bin.nCount = 0  ;
+                }
+            }
+
+            // The thread is leaving - its remote blocks are returned to their superblocks directly
+            for ( size_t i = 0; i < remote_free::slot_count; ++i ) {
+                remote_free_slot& slot = pCache->arrRemote[i]   ;
+                free_list_to_superblocks( slot.pHead )  ;
+                slot.pHead = NULL   ;
+                slot.pDest = NULL   ;
+                slot.pTail = NULL   ;
+                slot.nCount = 0 ;
+            }
+
+            m_ThreadCacheStat.incAllocHit( pCache->nAllocHit )  ;
+            m_ThreadCacheStat.incFreeHit( pCache->nFreeHit )    ;
+            pCache->nAllocHit = pCache->nFreeHit = 0    ;
+            pCache->pHeap = NULL    ;
+        }
+
+        /// Allocates memory block of size-class \p nSizeClassIndex from the cache of current thread
+        /**
+            If the cache bin is empty it is refilled from the processor heap by thread_cache::batch_size blocks
+            reserved in the active superblock by one CAS, see \ref alloc_batch_from_active.
+        */
+        block_header * alloc_from_thread_cache( thread_cache_rec * pCache, typename sizeclass_selector::sizeclass_index nSizeClassIndex, size_t nSize )
+        {
+            thread_cache_bin& bin = pCache->pBins[ nSizeClassIndex ]  ;
+            block_header * pBlock = bin.pHead   ;
+            if ( pBlock ) {
+                bin.pHead = reinterpret_cast<cached_block_header *>( pBlock )->pNextCached   ;
+                --bin.nCount    ;
+                ++pCache->nAllocHit ;
+                return pBlock   ;
+            }
+
+            // Cache miss - refill the bin
+            if ( alloc_batch_from_active( find_heap( nSizeClassIndex ), thread_cache::batch_size, bin ) != 0 ) {
+                pBlock = bin.pHead  ;
+                bin.pHead = reinterpret_cast<cached_block_header *>( pBlock )->pNextCached   ;
+                --bin.nCount    ;
+            }
+            else {
+                // No active superblock. The block is allocated by the general way that installs
+                // new active superblock, the rest of the batch is reserved in it
+                pBlock = alloc_from_procheap( nSizeClassIndex, nSize )  ;
+                if ( pBlock->isOSAllocated() )
+                    return pBlock   ;
+                if ( thread_cache::batch_size > 1 )
+                    alloc_batch_from_active( find_heap( nSizeClassIndex ), thread_cache::batch_size - 1, bin )  ;
+            }
+
+            m_ThreadCacheStat.incRefillCount()  ;
+            m_ThreadCacheStat.incAllocHit( pCache->nAllocHit )  ;
+            pCache->nAllocHit = 0   ;
+            return pBlock   ;
+        }
+
+        /// Places the block \p pBlock of superblock \p pDesc to the cache of current thread
+        /**
+            If the cache bin is full thread_cache::batch_size blocks are returned to their superblocks first,
+            one anchor CAS per superblock; remote blocks of the batch are buffered if remote-free batching is enabled.
+        */
+        void free_to_thread_cache( thread_cache_rec * pCache, block_header * pBlock, superblock_desc * pDesc )
+        {
+            typename sizeclass_selector::sizeclass_index nSizeClassIndex = m_SizeClassSelector.find( pDesc->nBlockSize )  ;
+            assert( nSizeClassIndex < m_SizeClassSelector.size() )   ;
+
+            thread_cache_bin& bin = pCache->pBins[ nSizeClassIndex ]  ;
+            if ( bin.nCount >= thread_cache::capacity ) {
+                // The bin is full - flush the batch
+                block_header * pLocal = NULL    ;
+                for ( size_t i = 0; i < thread_cache::batch_size; ++i ) {
+                    block_header * p = bin.pHead    ;
+                    assert( p != NULL ) ;
+                    bin.pHead = reinterpret_cast<cached_block_header *>( p )->pNextCached    ;
+                    if ( is_remote_block( p->desc() ))
+                        free_remote( pCache, p, p->desc()->pProcHeap )  ;
+                    else {
+                        reinterpret_cast<cached_block_header *>( p )->pNextCached = pLocal   ;
+                        pLocal = p  ;
+                    }
+                }
+                bin.nCount -= thread_cache::batch_size  ;
+                free_list_to_superblocks( pLocal )  ;
+
+                m_ThreadCacheStat.incFlushCount()   ;
+                m_ThreadCacheStat.incFreeHit( pCache->nFreeHit )    ;
+                pCache->nFreeHit = 0    ;
+            }
+
+            reinterpret_cast<cached_block_header *>( pBlock )->pNextCached = bin.pHead   ;
+            bin.pHead = pBlock  ;
+            ++bin.nCount    ;
+            ++pCache->nFreeHit  ;
+        }
+
+        /// Frees the block \p pBlock of superblock \p pDesc by the thread that owns \p pCache
+        /**
+            If the block is remote (it belongs to the processor heap of other processor) and
+            remote-free batching is enabled, the block is buffered in \p pCache.
+            Otherwise, the block is returned to its superblock.
+        */
+        void free_block( thread_cache_rec * pCache, block_header * pBlock, superblock_desc * pDesc )
+        {
+            if ( is_remote_block( pDesc ))
+                free_remote( pCache, pBlock, pDesc->pProcHeap ) ;
+            else
+                free_to_superblock( pBlock, pDesc ) ;
+        }
+
+        /// Checks if the blocks of superblock \p pDesc should be buffered as remote ones
+        /**
+            Returns \p true if remote-free batching is enabled and the superblock belongs
+            to the processor heap of other processor.
+        */
+        bool is_remote_block( superblock_desc * pDesc )
+        {
+            if ( remote_free::batch_size != 0 ) {
+                unsigned int nProcessorId = m_Topology.current_processor()  ;
+                if ( nProcessorId >= m_nProcessorCount )
+                    nProcessorId = 0    ;
+                return pDesc->pProcHeap->pProcDesc != atomics::load<membar_relaxed>( m_arrProcDesc + nProcessorId ) ;
+            }
+            return false    ;
+        }
+
+        /// Places the remote block \p pBlock into the buffer of its processor heap \p pDest
+        void free_remote( thread_cache_rec * pCache, block_header * pBlock, processor_heap_base * pDest )
+        {
+            // The processor heaps of one processor are the array, so the heaps of adjacent size classes get adjacent slots
+            remote_free_slot& slot = pCache->arrRemote[ (reinterpret_cast<uptr_atomic_t>( pDest ) / sizeof(processor_heap)) % remote_free::slot_count ] ;
+            if ( slot.pDest != pDest ) {
+                if ( slot.nCount )
+                    send_remote_batch( slot )   ;
+                slot.pDest = pDest  ;
+            }
+
+            reinterpret_cast<cached_block_header *>( pBlock )->pNextCached = slot.pHead    ;
+            if ( !slot.pHead )
+                slot.pTail = pBlock ;
+            slot.pHead = pBlock ;
+            if ( ++slot.nCount >= remote_free::batch_size )
+                send_remote_batch( slot )   ;
+        }
+
+        /// Pushes the chain of remote blocks of \p slot into the remote-free list of the destination processor heap
+        void send_remote_batch( remote_free_slot& slot )
+        {
+            assert( slot.pHead != NULL )    ;
+            assert( slot.pDest != NULL )    ;
+
+            processor_heap_base * pDest = slot.pDest    ;
+            block_header * pHead    ;
+            do {
+                pHead = atomics::load<membar_relaxed>( &(pDest->pRemoteFree) )  ;
+                reinterpret_cast<cached_block_header *>( slot.pTail )->pNextCached = pHead ;
+            } while ( !atomics::cas<membar_release>( &(pDest->pRemoteFree), pHead, slot.pHead )) ;
+
+            pDest->stat.incRemoteBatch( slot.nCount )   ;
+
+            slot.pHead = slot.pTail = NULL  ;
+            slot.nCount = 0 ;
+        }
+
+        /// Drains the remote-free list of \p pProcHeap
+        /**
+            The first block of the list is returned to the caller, other blocks are returned to their superblocks.
+            Returns \p NULL if the list is empty.
+        */
+        block_header * alloc_from_remote( processor_heap * pProcHeap )
+        {
+            if ( atomics::load<membar_relaxed>( &(pProcHeap->pRemoteFree) ) == NULL )
+                return NULL ;
+
+            block_header * pBlock = atomics::exchange<membar_acquire>( &(pProcHeap->pRemoteFree), (block_header *) NULL ) ;
+            if ( !pBlock )
+                return NULL ;
+
+            pProcHeap->stat.incRemoteDrain()    ;
+
+            free_list_to_superblocks( reinterpret_cast<cached_block_header *>( pBlock )->pNextCached )  ;
+
+            // The block is reused without returning to the superblock
+            pProcHeap->stat.incDeallocatedBytes( pProcHeap->pSizeClass->nBlockSize )  ;
+            return pBlock   ;
+        }
+
         //@endcond
     public:
         /// Heap constructor
         Heap()
+            : m_pThreadCacheList( NULL )
         {
             // Explicit libcds initialization is needed since a static object may be constructed
             cds::Initialize()   ;
@@ -1612,6 +2251,27 @@ namespace michael {
         */
         ~Heap()
         {
+            // The blocks of per-thread caches and remote-free lists are freed together with their superblocks.
+            // The caches stay in the extension lists of the threads until the threads are detached
+            {
+                cds::lock::Auto<cds::lock::Spin> al( m_ThreadCacheLock )    ;
+                while ( m_pThreadCacheList ) {
+                    thread_cache_rec * pCache = m_pThreadCacheList  ;
+                    m_pThreadCacheList = pCache->pNextCache ;
+                    if ( pCache->pBins ) {
+                        for ( size_t i = 0; i < m_SizeClassSelector.size(); ++i ) {
+                            pCache->pBins[i].pHead = NULL   ;
+                            pCache->pBins[i].nCount = 0     ;
+                        }
+                    }
+                    for ( size_t i = 0; i < remote_free::slot_count; ++i )
+                        pCache->arrRemote[i] = remote_free_slot()   ;
+                    pCache->pPrevCache = pCache->pNextCache = NULL  ;
+                    pCache->nAllocHit = pCache->nFreeHit = 0    ;
+                    pCache->pHeap = NULL    ;
+                }
+            }
+
             for ( unsigned int i = 0; i < m_nProcessorCount; ++i ) {
                 if ( m_arrProcDesc[i] )
                     free_processor_desc( m_arrProcDesc[i] )    ;
@@ -1656,8 +2316,7 @@ namespace michael {
 
             if ( pBlock->isOSAllocated() ) {
                 // Block has been allocated from OS
-                m_OSAllocStat.incBytesDeallocated( pBlock->getOSAllocSize() )   ;
-                m_LargeHeap.free( pBlock )  ;
+                free_to_OS( pBlock )    ;
                 return ;
             }
 
@@ -1670,44 +2329,18 @@ namespace michael {
                 pDesc->nBlockSize
             );
 
-
-            anchor_tag oldAnchor    ;
-            anchor_tag newAnchor    ;
-            processor_heap_base * pProcHeap = pDesc->pProcHeap    ;
-
-            pProcHeap->stat.incDeallocatedBytes( pDesc->nBlockSize )    ;
-
-            do {
-                newAnchor = oldAnchor = atomics::load<membar_acquire>( &(pDesc->anchor) )       ;
-                reinterpret_cast<free_block_header *>( pBlock )->nNextFree = oldAnchor.avail    ;
-                newAnchor.avail = (reinterpret_cast<byte *>( pBlock ) - pDesc->pSB) / pDesc->nBlockSize ;
-                newAnchor.tag += 1  ;
-
-                assert( oldAnchor.state != SBSTATE_EMPTY )  ;
-
-                if ( oldAnchor.state == SBSTATE_FULL )
-                    newAnchor.state = SBSTATE_PARTIAL   ;
-
-                if ( oldAnchor.count == pDesc->nCapacity - 1 ) {
-                    //pProcHeap = pDesc->pProcHeap    ;
-                    //CDS_COMPILER_RW_BARRIER         ;   // instruction fence is needed?..
-                    newAnchor.state = SBSTATE_EMPTY ;
+            if ( thread_cache::capacity != 0 || remote_free::batch_size != 0 ) {
+                thread_cache_rec * pCache = get_thread_cache()  ;
+                if ( pCache ) {
+                    if ( thread_cache::capacity != 0 )
+                        free_to_thread_cache( pCache, pBlock, pDesc )   ;
+                    else
+                        free_block( pCache, pBlock, pDesc ) ;
+                    return  ;
                 }
-                else
-                    newAnchor.count += 1    ;
-            } while ( !atomics::cas<membar_release>( &(pDesc->anchor), oldAnchor, newAnchor ) )  ;
-
-            pProcHeap->stat.incFreeCount()  ;
-
-            if ( newAnchor.state == SBSTATE_EMPTY ) {
-                if ( pProcHeap->unlink_partial( pDesc ))
-                    free_superblock( pDesc )    ;
-            }
-            else if (oldAnchor.state == SBSTATE_FULL ) {
-                assert( pProcHeap != NULL )     ;
-                pProcHeap->stat.decDescFull()   ;
-                pProcHeap->add_partial( pDesc ) ;
             }
+
+            free_to_superblock( pBlock, pDesc ) ;
         }
 
         /// Reallocate memory block
@@ -1809,6 +2442,7 @@ namespace michael {
         void summaryStat( summary_stat& st )
         {
             size_t nProcHeapCount = m_SizeClassSelector.size()  ;
+            const size_t nPageHeapCount = m_SizeClassSelector.pageTypeCount() ;
             for ( unsigned int nProcessor = 0; nProcessor < m_nProcessorCount; ++nProcessor ) {
                 processor_desc * pProcDesc = m_arrProcDesc[nProcessor]  ;
                 if ( pProcDesc ) {
@@ -1818,10 +2452,13 @@ namespace michael {
                             st.add_procheap_stat( pProcHeap->stat ) ;
                         }
                     }
+                    for ( size_t i = 0; i < nPageHeapCount; ++i )
+                        add_page_heap_stat( st, pProcDesc->pageHeaps + i )  ;
                 }
             }
 
             st.add_heap_stat( m_OSAllocStat )   ;
+            st.add_thread_cache_stat( m_ThreadCacheStat )   ;
         }
     };
 
@@ -0,0 +1,311 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_MEMORY_MICHAEL_ALLOCATOR_HUGE_PAGE_HEAP_H
+#define __CDS_MEMORY_MICHAEL_ALLOCATOR_HUGE_PAGE_HEAP_H
+
+#include <cds/atomic.h>
+#include <cds/os/huge_page.h>
+#include <cds/lock/spinlock.h>
+
+#include <stdlib.h>
+
+namespace cds { namespace memory { namespace michael {
+
+    /// Statistics of huge page heap
+    /**
+        The counters are incremented when the heap maps a new chunk of memory.
+        This class is one of available statistics of \ref huge_page_allocator and \ref numa_page_allocator.
+    */
+    template <typename INC_FENCE = membar_release, typename READ_FENCE = membar_acquire >
+    struct huge_page_atomic_stat
+    {
+        //@cond
+        atomic<size_t>      nHugeTLBCount       ;   ///< Count of chunks backed by explicit huge pages
+        atomic<size_t>      nTHPCount           ;   ///< Count of chunks backed by transparent huge pages
+        atomic<size_t>      nRegularCount       ;   ///< Count of chunks backed by regular pages
+        atomic<size_t>      nNodeBindCount      ;   ///< Count of chunks bound to NUMA node
+        atomic<size_t>      nNodeBindFailCount  ;   ///< Count of failed NUMA bindings
+        //@endcond
+
+    public:
+        /// Increments the chunk counter of backing \p kind
+        void onMap( cds::OS::huge_page::backing kind )
+        {
+            switch ( kind ) {
+            case cds::OS::huge_page::backing_hugetlb:
+                nHugeTLBCount.inc<INC_FENCE>()  ;
+                break;
+            case cds::OS::huge_page::backing_thp:
+                nTHPCount.inc<INC_FENCE>()  ;
+                break;
+            default:
+                nRegularCount.inc<INC_FENCE>()  ;
+            }
+        }
+        /// Increments NUMA binding counter
+        void incNodeBind()
+        {
+            nNodeBindCount.inc<INC_FENCE>() ;
+        }
+        /// Increments failed NUMA binding counter
+        void incNodeBindFail()
+        {
+            nNodeBindFailCount.inc<INC_FENCE>() ;
+        }
+
+        /// Count of chunks backed by explicit huge pages (\p MAP_HUGETLB)
+        size_t hugeTLBCount() const
+        {
+            return nHugeTLBCount.load<READ_FENCE>() ;
+        }
+        /// Count of chunks backed by transparent huge pages (\p MADV_HUGEPAGE)
+        size_t thpCount() const
+        {
+            return nTHPCount.load<READ_FENCE>() ;
+        }
+        /// Count of chunks backed by regular pages
+        size_t regularCount() const
+        {
+            return nRegularCount.load<READ_FENCE>() ;
+        }
+        /// Count of chunks bound to NUMA node
+        size_t nodeBindCount() const
+        {
+            return nNodeBindCount.load<READ_FENCE>()    ;
+        }
+        /// Count of failed NUMA bindings
+        size_t nodeBindFailCount() const
+        {
+            return nNodeBindFailCount.load<READ_FENCE>()    ;
+        }
+    };
+
+    /// Empty statistics of huge page heap
+    /**
+        This class does not gather any statistics.
+        Class interface is the same as \ref huge_page_atomic_stat.
+    */
+    struct huge_page_empty_stat
+    {
+    //@cond
+        void onMap( cds::OS::huge_page::backing /*kind*/ )
+        {}
+        void incNodeBind()
+        {}
+        void incNodeBindFail()
+        {}
+
+        size_t hugeTLBCount() const
+        {
+            return 0    ;
+        }
+        size_t thpCount() const
+        {
+            return 0    ;
+        }
+        size_t regularCount() const
+        {
+            return 0    ;
+        }
+        size_t nodeBindCount() const
+        {
+            return 0    ;
+        }
+        size_t nodeBindFailCount() const
+        {
+            return 0    ;
+        }
+    //@endcond
+    };
+
+    /// Page heap backed by huge pages
+    /**
+        The heap maps chunks of 2M (a multiple of cds::OS::huge_page::c_nSize) by cds::OS::huge_page::map
+        and cuts them into pages. The chunk is backed by explicit huge page if the hugetlbfs pool is not empty,
+        otherwise by transparent huge page (THP) if THP is enabled. All superblocks carved from the chunk share
+        one dTLB entry: 32 superblocks of 64K or 2 superblocks of 1M.
+
+        Free pages are kept in the free-list of the heap and are reused by next \ref alloc calls,
+        the chunks are unmapped when the heap is destroyed. The heap is intended for long-running
+        processes with stable memory footprint.
+
+        Template parameters:
+            \li \p STAT - statistics, \ref huge_page_empty_stat (the default) or \ref huge_page_atomic_stat.
+                Heap collects the statistics of its page heaps into \ref summary_stat.
+
+        This class is one of available implementation of opt::page_heap option.
+    */
+    template <class STAT = huge_page_empty_stat>
+    class huge_page_allocator
+    {
+    public:
+        typedef STAT    stat_type   ;   ///< statistics type
+
+    protected:
+        //@cond
+        struct free_page {
+            free_page * pNext   ;
+        };
+
+        struct chunk {
+            chunk *     pNext   ;
+            void *      pRegion ;
+        };
+
+        size_t const        m_nPageSize     ;   ///< page size
+        size_t const        m_nChunkSize    ;   ///< size of the chunk mapped from OS
+        int                 m_nNode         ;   ///< NUMA node of the chunks, -1 - no binding
+        cds::lock::Spin     m_Lock          ;   ///< lock of free-list and chunk list
+        free_page *         m_pFreeList     ;
+        chunk *             m_pChunkList    ;
+        stat_type           m_Stat          ;
+        //@endcond
+
+    public:
+        /// Initializes heap
+        huge_page_allocator(
+            size_t nPageSize    ///< page size in bytes
+        )
+            : m_nPageSize( nPageSize )
+            , m_nChunkSize( (nPageSize + cds::OS::huge_page::c_nSize - 1) / cds::OS::huge_page::c_nSize * cds::OS::huge_page::c_nSize )
+            , m_nNode( -1 )
+            , m_pFreeList( NULL )
+            , m_pChunkList( NULL )
+        {
+            assert( m_nChunkSize % m_nPageSize == 0 )   ;
+        }
+
+        /// Unmaps all chunks
+        ~huge_page_allocator()
+        {
+            chunk * pChunk = m_pChunkList   ;
+            while ( pChunk ) {
+                chunk * pNext = pChunk->pNext   ;
+                cds::OS::huge_page::unmap( pChunk->pRegion, m_nChunkSize )  ;
+                ::free( pChunk )    ;
+                pChunk = pNext  ;
+            }
+        }
+
+        /// Allocate new page
+        void * alloc()
+        {
+            {
+                cds::lock::Auto<cds::lock::Spin> al( m_Lock )   ;
+                free_page * pPage = m_pFreeList ;
+                if ( pPage ) {
+                    m_pFreeList = pPage->pNext  ;
+                    return pPage    ;
+                }
+            }
+            return alloc_chunk()    ;
+        }
+
+        /// Free page \p pPage
+        void free( void * pPage )
+        {
+            free_page * p = reinterpret_cast<free_page *>( pPage )  ;
+            cds::lock::Auto<cds::lock::Spin> al( m_Lock )   ;
+            p->pNext = m_pFreeList  ;
+            m_pFreeList = p ;
+        }
+
+        /// Returns NUMA node of the heap or -1 if the heap is not bound
+        int node() const
+        {
+            return m_nNode  ;
+        }
+
+        /// Returns statistics of the heap
+        const stat_type& stat() const
+        {
+            return m_Stat   ;
+        }
+
+    protected:
+        //@cond
+        void * alloc_chunk()
+        {
+            cds::OS::huge_page::backing kind    ;
+            char * pRegion = reinterpret_cast<char *>( cds::OS::huge_page::map( m_nChunkSize, kind ))   ;
+            if ( !pRegion )
+                return NULL ;
+            m_Stat.onMap( kind )    ;
+
+            // The node must be set before the pages are touched
+            if ( m_nNode >= 0 ) {
+                if ( cds::OS::huge_page::bind_node( pRegion, m_nChunkSize, m_nNode ))
+                    m_Stat.incNodeBind()    ;
+                else
+                    m_Stat.incNodeBindFail()    ;
+            }
+
+            chunk * pChunk = reinterpret_cast<chunk *>( ::malloc( sizeof(chunk) ))  ;
+            pChunk->pRegion = pRegion   ;
+
+            // The first page is returned to the caller, others are placed into the free-list
+            cds::lock::Auto<cds::lock::Spin> al( m_Lock )   ;
+            pChunk->pNext = m_pChunkList    ;
+            m_pChunkList = pChunk   ;
+            for ( char * pPage = pRegion + m_nChunkSize - m_nPageSize; pPage != pRegion; pPage -= m_nPageSize ) {
+                free_page * p = reinterpret_cast<free_page *>( pPage )  ;
+                p->pNext = m_pFreeList  ;
+                m_pFreeList = p ;
+            }
+            return pRegion  ;
+        }
+        //@endcond
+    };
+
+    /// NUMA-aware page heap backed by huge pages
+    /**
+        The heap is \ref huge_page_allocator that binds its chunks to NUMA node of a processor.
+        Michael's \ref Heap calls \ref bind_processor for page heaps of each processor descriptor,
+        so the superblocks of a processor heap are placed on the node of that processor
+        (the first-touch policy does not guarantee it since the superblock may be touched first
+        by a thread running on other node).
+
+        The processor number is the number of Heap's topology (opt::topology option);
+        the NUMA node of the processor is determined by cds::OS::huge_page::processor_node.
+        If the node is unknown the chunks are not bound.
+
+        Template parameters:
+            \li \p STAT - statistics, \ref huge_page_empty_stat (the default) or \ref huge_page_atomic_stat
+
+        This class is one of available implementation of opt::page_heap option.
+    */
+    template <class STAT = huge_page_empty_stat>
+    class numa_page_allocator: public huge_page_allocator<STAT>
+    {
+        //@cond
+        typedef huge_page_allocator<STAT>   base_class  ;
+        //@endcond
+    public:
+        /// Initializes heap
+        numa_page_allocator(
+            size_t nPageSize    ///< page size in bytes
+        )
+            : base_class( nPageSize )
+        {}
+
+        /// Binds the chunks of the heap to NUMA node of processor \p nProcessor
+        /**
+            The function affects the chunks mapped after the call.
+        */
+        void bind_processor( unsigned int nProcessor )
+        {
+            base_class::m_nNode = cds::OS::huge_page::processor_node( nProcessor )  ;
+        }
+    };
+
+}}} // namespace cds::memory::michael
+
+#endif  /// __CDS_MEMORY_MICHAEL_ALLOCATOR_HUGE_PAGE_HEAP_H
@@ -92,6 +92,8 @@ namespace cds { namespace memory { namespace michael {
             Available \p HEAP implementations:
                 - page_allocator 
                 - page_cached_allocator 
+                - huge_page_allocator - superblocks are carved from 2M huge pages
+                - numa_page_allocator - huge page heap bound to NUMA node of the processor
         */
         template <typename HEAP>
         struct page_heap {
@@ -255,6 +257,82 @@ namespace cds { namespace memory { namespace michael {
             };
             //@endcond
         };
+
+        /// Option setter for per-thread block cache
+        /**
+            The option specifies the policy of per-thread cache of free blocks that is placed
+            in front of the processor heaps. The cache serves \p alloc and \p free of current thread
+            without atomic operations and exchanges the blocks with the processor heaps by batches.
+            The aligned blocks are cached too; the large (OS-allocated) blocks are never cached.
+
+            Available \p TYPE implementations:
+                - \ref no_thread_cache - no cache (default)
+                - \ref thread_magazine_cache - bounded per-thread, per-size-class magazine
+
+            \p TYPE should declare the following enum:
+            \code
+            enum {
+                capacity = numeric_const,   // max count of blocks of one size class in the cache of a thread; 0 - no cache
+                batch_size = numeric_const  // count of blocks moved between the cache and the processor heap at once
+            };
+            \endcode
+        */
+        template <typename TYPE>
+        struct thread_cache {
+            //@cond
+            template <class BASE> struct pack: public BASE
+            {
+                typedef TYPE thread_cache   ;
+            };
+            //@endcond
+        };
+
+        /// Option setter for per-thread cache statistics
+        /**
+            The option specifies a type for gathering statistics of per-thread block cache
+            (see \ref thread_cache option).
+
+            Available \p TYPE implementations:
+                - \ref thread_cache_atomic_stat
+                - \ref thread_cache_empty_stat (default)
+        */
+        template <typename TYPE>
+        struct thread_cache_stat {
+            //@cond
+            template <class BASE> struct pack: public BASE
+            {
+                typedef TYPE thread_cache_stat  ;
+            };
+            //@endcond
+        };
+
+        /// Option setter for remote-free batching
+        /**
+            The option specifies the policy of freeing the blocks that belong to the processor heap
+            of other processor (remote blocks). The remote blocks may be buffered by the freeing thread
+            and sent to the owner processor heap by batches.
+
+            Available \p TYPE implementations:
+                - \ref no_remote_free - no batching (default)
+                - \ref remote_free_batch - per-thread buffers of remote blocks
+
+            \p TYPE should declare the following enum:
+            \code
+            enum {
+                batch_size = numeric_const, // count of blocks in the batch; 0 - no batching
+                slot_count = numeric_const  // count of per-thread buffers
+            };
+            \endcode
+        */
+        template <typename TYPE>
+        struct remote_free {
+            //@cond
+            template <class BASE> struct pack: public BASE
+            {
+                typedef TYPE remote_free    ;
+            };
+            //@endcond
+        };
     }
 
 }}} // namespace cds::memory::michael
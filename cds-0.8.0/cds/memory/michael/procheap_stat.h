@@ -43,6 +43,10 @@ namespace cds { namespace memory { namespace michael {
         atomic<size_t>      nActiveAnchorCASFailureCount;   ///< CAS failure counter for active block of \p alloc_from_active Heap function
         atomic<size_t>      nPartialDescCASFailureCount ;   ///< CAS failure counter for partial block of \p alloc_from_partial Heap function 
         atomic<size_t>      nPartialAnchorCASFailureCount;   ///< CAS failure counter for partial block of \p alloc_from_partial Heap function
+
+        atomic<size_t>      nRemoteFreeCount    ;  ///< Count of remote blocks sent to the processor heap (see opt::remote_free)
+        atomic<size_t>      nRemoteBatchCount   ;  ///< Count of batches of remote blocks sent to the processor heap
+        atomic<size_t>      nRemoteDrainCount   ;  ///< Count of draining of remote-free list by the owner
         //@endcond
 
     public:
@@ -179,6 +183,19 @@ namespace cds { namespace memory { namespace michael {
             nPartialAnchorCASFailureCount.xadd<INC_FENCE>( size_t(nCount) )    ;
         }
 
+        /// Add the batch of \p nCount remote blocks sent to the processor heap
+        void incRemoteBatch( size_t nCount )
+        {
+            nRemoteBatchCount.inc<INC_FENCE>()  ;
+            nRemoteFreeCount.xadd<INC_FENCE>( nCount )  ;
+        }
+
+        /// Increment counter of draining of remote-free list
+        void incRemoteDrain()
+        {
+            nRemoteDrainCount.inc<INC_FENCE>()  ;
+        }
+
         // -----------------------------------------------------------------
         // Reading 
 
@@ -276,6 +293,24 @@ namespace cds { namespace memory { namespace michael {
         {
             return nPartialAnchorCASFailureCount.load<READ_FENCE>() ;
         }
+
+        /// Get count of remote blocks sent to the processor heap
+        size_t remoteFreeCount() const
+        {
+            return nRemoteFreeCount.load<READ_FENCE>()  ;
+        }
+
+        /// Get count of batches of remote blocks sent to the processor heap
+        size_t remoteBatchCount() const
+        {
+            return nRemoteBatchCount.load<READ_FENCE>() ;
+        }
+
+        /// Get count of draining of remote-free list by the owner
+        size_t remoteDrainCount() const
+        {
+            return nRemoteDrainCount.load<READ_FENCE>() ;
+        }
     };
 
     /// Empty processor heap statistics
@@ -340,6 +375,10 @@ namespace cds { namespace memory { namespace michael {
         {}
         void incPartialAnchorCASFailureCount( int nCount )
         {}
+        void incRemoteBatch( size_t nCount )
+        {}
+        void incRemoteDrain()
+        {}
 
         // -----------------------------------------------------------------
         // Reading 
@@ -372,6 +411,12 @@ namespace cds { namespace memory { namespace michael {
         { return 0; }
         size_t partialAnchorCASFailureCount() const 
         { return 0; }
+        size_t remoteFreeCount() const
+        { return 0; }
+        size_t remoteBatchCount() const
+        { return 0; }
+        size_t remoteDrainCount() const
+        { return 0; }
 
     //@endcond
     };
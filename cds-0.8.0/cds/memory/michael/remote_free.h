@@ -0,0 +1,74 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_MEMORY_MICHAEL_ALLOCATOR_REMOTE_FREE_H
+#define __CDS_MEMORY_MICHAEL_ALLOCATOR_REMOTE_FREE_H
+
+#include <cds/details/defs.h>
+
+namespace cds { namespace memory { namespace michael {
+
+    /// No remote-free batching
+    /**
+        This class is the default value of \ref opt::remote_free option of Michael's \ref Heap.
+        The block is returned to its superblock by the thread that frees it.
+    */
+    struct no_remote_free
+    {
+        enum {
+            batch_size = 0, ///< Count of blocks in the batch sent to the owner processor heap
+            slot_count = 0  ///< Count of per-thread buffers of remote blocks
+        };
+    };
+
+    /// Remote-free batching
+    /**
+        This class is one of available implementation of \ref opt::remote_free option of Michael's \ref Heap.
+
+        A block is remote for a thread if it belongs to the processor heap of other processor than the processor
+        the thread is running on. Usually it is the case of producer/consumer ownership transfer: one thread allocates
+        a node or a message and another thread frees it. Without batching each remote free is a CAS on the anchor
+        of the producer's superblock that contends with the producer's own allocations.
+
+        With this policy the thread attached to \p libcds buffers the remote blocks per destination processor heap.
+        When the buffer contains \p BATCH_SIZE blocks, the chain of blocks is pushed into the lock-free
+        remote-free list of the processor heap by single CAS. The owner drains the list by single atomic exchange
+        on its next allocation miss (when the active superblock is exhausted): one block of the list
+        is returned to the caller and others are returned to their superblocks.
+
+        The thread has \p SLOT_COUNT buffers; the buffer is selected by hashing the address of destination
+        processor heap. If the buffer is occupied by other destination, the buffer is sent to its destination
+        before reusing. The buffers of the thread are returned to their superblocks when the thread is detached
+        from \p libcds (see cds::threading::Manager::detachThread). The threads that are not attached
+        free the blocks directly.
+
+        Note that the blocks waiting in the remote-free list of a processor heap are not available for allocation
+        by other processor heaps until the owner drains the list.
+
+        Template parameters:
+            \li \p BATCH_SIZE - count of blocks in the batch, default is 32
+            \li \p SLOT_COUNT - count of per-thread buffers, default is 16
+    */
+    template <size_t BATCH_SIZE = 32, size_t SLOT_COUNT = 16>
+    struct remote_free_batch
+    {
+        enum {
+            batch_size = BATCH_SIZE,    ///< Count of blocks in the batch sent to the owner processor heap
+            slot_count = SLOT_COUNT     ///< Count of per-thread buffers of remote blocks
+        };
+
+        //@cond
+        CDS_STATIC_ASSERT( BATCH_SIZE > 0 && SLOT_COUNT > 0 )   ;
+        //@endcond
+    };
+
+}}} // namespace cds::memory::michael
+
+#endif  /// __CDS_MEMORY_MICHAEL_ALLOCATOR_REMOTE_FREE_H
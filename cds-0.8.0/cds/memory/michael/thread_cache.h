@@ -0,0 +1,179 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_MEMORY_MICHAEL_ALLOCATOR_THREAD_CACHE_H
+#define __CDS_MEMORY_MICHAEL_ALLOCATOR_THREAD_CACHE_H
+
+#include <cds/atomic.h>
+
+namespace cds { namespace memory { namespace michael {
+
+    /// No per-thread cache
+    /**
+        This class is the default value of \ref opt::thread_cache option of Michael's \ref Heap.
+        Each \p alloc / \p free call goes to the processor heap.
+    */
+    struct no_thread_cache
+    {
+        enum {
+            capacity = 0,   ///< Max count of blocks of one size class in the cache of a thread
+            batch_size = 0  ///< Count of blocks moved between the cache and the processor heap at once
+        };
+    };
+
+    /// Per-thread magazine cache
+    /**
+        This class is one of available implementation of \ref opt::thread_cache option of Michael's \ref Heap.
+
+        Each thread attached to \p libcds has a cache of free blocks for each size class. The cache of size class
+        is a LIFO list of up to \p CAPACITY blocks ("magazine"). \p alloc takes the block from the magazine
+        of current thread without any atomic operation; if the magazine is empty, \p BATCH_SIZE blocks
+        are allocated from the processor heap at once, one of them is returned and others are placed
+        into the magazine. \p free places the block into the magazine of current thread;
+        if the magazine is full, \p BATCH_SIZE blocks are returned to their superblocks first.
+
+        Note that the block freed goes to the cache of the thread that frees it, not to the cache of the thread
+        that allocates it. The blocks in the caches are counted as allocated blocks in the processor heap statistics.
+        The cache of a thread is flushed when the thread is detached from \p libcds
+        (see cds::threading::Manager::detachThread). The threads that are not attached do not use the cache.
+
+        Template parameters:
+            \li \p CAPACITY - max count of blocks of each size class in the cache of a thread, default is 64
+            \li \p BATCH_SIZE - count of blocks moved between the magazine and the processor heap at once,
+                default is \p CAPACITY / 2. The value must be in range <tt>[1, CAPACITY]</tt>
+    */
+    template <size_t CAPACITY = 64, size_t BATCH_SIZE = CAPACITY / 2>
+    struct thread_magazine_cache
+    {
+        enum {
+            capacity = CAPACITY,    ///< Max count of blocks of one size class in the cache of a thread
+            batch_size = BATCH_SIZE ///< Count of blocks moved between the cache and the processor heap at once
+        };
+
+        //@cond
+        CDS_STATIC_ASSERT( BATCH_SIZE > 0 && BATCH_SIZE <= CAPACITY )   ;
+        //@endcond
+    };
+
+    /// Per-thread cache statistics
+    /**
+        This class is implementation of \ref opt::thread_cache_stat option.
+        The hit counters are gathered by each thread in its cache and are added to the counters of this class
+        on refilling or flushing the cache, so the cache hit does not perform any atomic operation.
+
+        Template parameters:
+            - \p INC_FENCE - memory fence for increment operation (default is release semantics)
+            - \p READ_FENCE - memory fence for reading of statistic values (default is acquire semantics)
+    */
+    template <typename INC_FENCE = membar_release, typename READ_FENCE = membar_acquire >
+    class thread_cache_atomic_stat
+    {
+        //@cond
+        atomic<size_t>      nAllocHit       ;   ///< Count of \p alloc served from the cache
+        atomic<size_t>      nRefillCount    ;   ///< Count of cache refilling (cache miss of \p alloc)
+        atomic<size_t>      nFreeHit        ;   ///< Count of \p free that places the block into the cache
+        atomic<size_t>      nFlushCount     ;   ///< Count of cache flushing (the cache is full)
+        //@endcond
+
+    public:
+        //@cond
+        thread_cache_atomic_stat()
+            : nAllocHit( 0 )
+            , nRefillCount( 0 )
+            , nFreeHit( 0 )
+            , nFlushCount( 0 )
+        {}
+        //@endcond
+
+        /// Adds \p n to the counter of \p alloc served from the cache
+        void incAllocHit( size_t n )
+        {
+            nAllocHit.xadd<INC_FENCE>( n )  ;
+        }
+        /// Increments the counter of cache refilling
+        void incRefillCount()
+        {
+            nRefillCount.inc<INC_FENCE>()   ;
+        }
+        /// Adds \p n to the counter of \p free that places the block into the cache
+        void incFreeHit( size_t n )
+        {
+            nFreeHit.xadd<INC_FENCE>( n )   ;
+        }
+        /// Increments the counter of cache flushing
+        void incFlushCount()
+        {
+            nFlushCount.inc<INC_FENCE>()    ;
+        }
+
+        /// Returns count of \p alloc served from the cache
+        size_t allocHit() const
+        {
+            return nAllocHit.load<READ_FENCE>() ;
+        }
+        /// Returns count of cache refilling
+        size_t refillCount() const
+        {
+            return nRefillCount.load<READ_FENCE>()  ;
+        }
+        /// Returns count of \p free that places the block into the cache
+        size_t freeHit() const
+        {
+            return nFreeHit.load<READ_FENCE>()  ;
+        }
+        /// Returns count of cache flushing
+        size_t flushCount() const
+        {
+            return nFlushCount.load<READ_FENCE>()   ;
+        }
+    };
+
+    /// Empty per-thread cache statistics
+    /**
+        This class is dummy implementation of \ref opt::thread_cache_stat option.
+        No statistics gathered.
+
+        Interface - see thread_cache_atomic_stat.
+    */
+    class thread_cache_empty_stat
+    {
+    public:
+    //@cond
+        void incAllocHit( size_t n )
+        {}
+        void incRefillCount()
+        {}
+        void incFreeHit( size_t n )
+        {}
+        void incFlushCount()
+        {}
+
+        size_t allocHit() const
+        {
+            return 0    ;
+        }
+        size_t refillCount() const
+        {
+            return 0    ;
+        }
+        size_t freeHit() const
+        {
+            return 0    ;
+        }
+        size_t flushCount() const
+        {
+            return 0    ;
+        }
+    //@endcond
+    };
+
+}}} // namespace cds::memory::michael
+
+#endif  /// __CDS_MEMORY_MICHAEL_ALLOCATOR_THREAD_CACHE_H
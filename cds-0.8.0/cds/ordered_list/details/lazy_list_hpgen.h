@@ -13,7 +13,7 @@
 
 /*
     Generic implementation of LazyList class for HP-like garbage collectors:
-        hzp_gc, hrc_gc, ptb_gc
+        hzp_gc, hrc_gc, ptb_gc, epoch_gc
 
     Editions:
         2010.09.19  Maxim Khiszinsky    Creation. Generalization current implementation of HP-like GC
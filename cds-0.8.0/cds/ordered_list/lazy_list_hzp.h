@@ -80,7 +80,8 @@ namespace cds {
             public:
                 static node_type * getAndGuard( atomic<node_type *>& pSrc, node_type *& pTarget, gc::hzp::HazardPtr& hp )
                 {
-                    hp = pTarget = pSrc.template load<membar_relaxed>()    ;
+                    pTarget = pSrc.template load<membar_relaxed>()    ;
+                    gc::hzp::details::hp_publish<gc::hzp::HazardPtr>::store( &hp, pTarget )    ;
                     return pSrc.template load<membar_acquire>()  ;
                 }
                 static node_type * getAndGuard( atomic<node_type *>&  pSrc, node_type *& pTarget, auto_guard& hp )
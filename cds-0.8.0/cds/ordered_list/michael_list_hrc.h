@@ -299,7 +299,7 @@ namespace cds {
             MichaelList()
             {
                 assert( gc::hrc::GarbageCollector::isUsed() )   ;
-                assert( c_nMaxHazardPtrCount <= gc::hrc::GarbageCollector::instance().getHazardPointerCount() ) ;
+                assert( c_nMaxHazardPtrCount <= gc::hrc::GarbageCollector::instance().getMaxHazardPointerCount() ) ;
             }
         };
 
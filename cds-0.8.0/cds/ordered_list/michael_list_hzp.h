@@ -85,7 +85,7 @@ namespace cds {
                 static node_type * getAndGuard( marked_node * pSrc, marked_node& pTarget, gc::hzp::HazardPtr& hp )
                 {
                     pTarget = *pSrc     ;
-                    hp = pTarget.ptr()    ;
+                    gc::hzp::details::hp_publish<gc::hzp::HazardPtr>::store( &hp, pTarget.ptr() )   ;
                     return pSrc->template load<membar_acquire>().all() ;
                 }
                 static node_type * getAndGuard( marked_node * pSrc, marked_node& pTarget, auto_guard& hp )
@@ -200,7 +200,7 @@ namespace cds {
             MichaelList()
             {
                 assert( gc::hzp::GarbageCollector::isUsed() )   ;
-                assert( c_nMaxHazardPtrCount <= gc::hzp::GarbageCollector::instance().getHazardPointerCount() ) ;
+                assert( c_nMaxHazardPtrCount <= gc::hzp::GarbageCollector::instance().getMaxHazardPointerCount() ) ;
             }
         };
 
@@ -0,0 +1,205 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_ORDERED_LIST_MICHAEL_LIST_IBR_H
+#define __CDS_ORDERED_LIST_MICHAEL_LIST_IBR_H
+
+#include <cds/ordered_list/details/michael_list_node.h>
+#include <cds/ordered_list/details/michael_list_hpgen.h>
+#include <cds/gc/ibr/container.h>
+
+namespace cds {
+    namespace ordered_list {
+
+        //@cond
+        namespace details { namespace michael_list {
+
+            template <
+                typename KEY
+                , typename VALUE
+                , typename PAIR_TRAITS
+                , typename TRAITS
+                , class ALLOCATOR
+            >
+            class adapter<gc::ibr_gc, KEY, VALUE, PAIR_TRAITS, TRAITS, ALLOCATOR >
+            {
+                typedef typename cds::details::void_selector<TRAITS, ordered_list::type_traits >::type   reduced_type_traits ;
+            public:
+                typedef details::michael_list::Node<gc::ibr_gc, KEY, VALUE, ALLOCATOR>  node_type   ;
+                typedef typename node_type::marked_node marked_node ;
+                typedef gc::ibr::Guard              auto_guard  ;
+                typedef gc::ibr::GuardArray<3>      guard_array ;
+
+                typedef typename cds::details::void_selector<PAIR_TRAITS, cds::map::pair_traits< KEY, VALUE > >::type    pair_traits ;
+
+            private:
+                typedef gc::ibr::Container< node_type, ALLOCATOR >  gc_container ;
+
+            public:
+                class container_base    ;
+                struct type_traits: public reduced_type_traits
+                {
+                    typedef reduced_type_traits  original    ;   ///< Original (non-void) type traits
+
+                    /// Functor to delete retired node
+                    typedef typename cds::details::void_selector<
+                        typename original::node_deleter_functor,
+                        typename container_base::deferral_node_deleter
+                    >::type                 node_deleter_functor ;
+                } ;
+
+                class container_base: public gc_container
+                {
+                protected:
+                    /// Allocate new node
+                    node_type * allocNode( const KEY& key, const VALUE& val )
+                    {
+                        return gc_container::allocNode( key, val )    ;
+                    }
+                    node_type * allocNode( const KEY& key )
+                    {
+                        return gc_container::allocNode( key )    ;
+                    }
+                    /// Free node
+                    void   freeNode( node_type * pNode )
+                    {
+                        type_traits::node_deleter_functor::free( pNode )    ;
+                    }
+                };
+
+                static node_type * getAndGuard( marked_node * pSrc, marked_node& pTarget, gc::ibr::details::guard& hp )
+                {
+                    // *pSrc may contain the new incarnation of the node, so the pointer is validated
+                    // by the era clock, see gc::ibr::ThreadGC::protect
+                    do {
+                        pTarget = pSrc->template load<membar_acquire>() ;
+                    } while ( !hp.getGC().reserve() )   ;
+                    hp = pTarget.ptr()    ;
+                    return pSrc->template load<membar_acquire>().all() ;
+                }
+
+                static bool linkNode( node_type * pNewNode, marked_node * pPrev, node_type * pNext )
+                {
+                    pNewNode->m_pNext.template store<membar_relaxed>( pNext, false ) ;
+                    return pPrev->template cas<membar_release>( marked_node( pNext ), marked_node( pNewNode ) ) ;
+                }
+
+                static bool logicalDeletion( marked_node * p, node_type * pVal )
+                {
+                    return p->template cas<membar_release>( marked_node( pVal ), marked_node( pVal, true ))    ;
+                }
+
+                static bool physicalDeletion( marked_node * p, marked_node pCur, marked_node pNew )
+                {
+                    return p->template cas<membar_release>( pCur, pNew )   ;
+                }
+
+                static void retirePtr( gc::ibr::ThreadGC& gc, node_type * p, gc::ibr::details::guard& /*hp*/ )
+                {
+                    gc.retirePtr( p, type_traits::node_deleter_functor::free )  ;
+                }
+            };
+
+        }}  // namespace details::michael_list
+        //@endcond
+
+        /// Lock-free ordered single-linked list developed by Michael based on interval-based reclamation schema.
+        /**
+            The implementation is based on interval-based memory reclamation schema (gc::ibr_gc)
+
+            \par Source
+                [2002] Maged Michael "High performance dynamic lock-free hash tables and list-based sets"
+
+            The split-ordered list is not supported for interval-based GC: the split list allocates
+            its dummy nodes by its own allocator bypassing era_allocator, so the dummy nodes carry no birth era.
+
+            \par Template parameters
+                \li \p KEY        type of key stored in list
+                \li \p VALUE    type of value stored in list
+                \li \p PAIR_TRAITS (key, value) pair traits. The default is cds::map::pair_traits <\p KEY, \p VALUE>
+                \li \p TRAITS    list traits. The default is cds::ordered_list::type_traits
+                \li \p ALLOCATOR node allocator. The default is \ref CDS_DEFAULT_ALLOCATOR
+
+            \par
+                Common interface: see \ref ordered_list_common_interface.
+        */
+        template <
+            typename KEY,
+            typename VALUE,
+            typename PAIR_TRAITS,
+            typename TRAITS,
+            class ALLOCATOR
+        >
+        class MichaelList<
+            gc::ibr_gc,
+            KEY,
+            VALUE,
+            PAIR_TRAITS,
+            TRAITS,
+            ALLOCATOR
+        > : public details::michael_list::implementation<
+                gc::ibr_gc
+                ,details::michael_list::adapter< gc::ibr_gc, KEY, VALUE, PAIR_TRAITS, TRAITS, ALLOCATOR>
+                ,ALLOCATOR
+            >
+        {
+            //@cond
+            typedef details::michael_list::implementation<
+                gc::ibr_gc
+                ,details::michael_list::adapter< gc::ibr_gc, KEY, VALUE, PAIR_TRAITS, TRAITS, ALLOCATOR>
+                ,ALLOCATOR
+            >   implementation  ;
+            //@endcond
+
+        public:
+            /// Max count of Hazard Pointer for the list
+            static const unsigned int   c_nMaxHazardPtrCount = 4    ;
+
+            typedef typename implementation::gc_schema      gc_schema        ;    ///< Garbage collection schema
+            typedef typename implementation::type_traits    type_traits     ;   ///< List traits
+
+            typedef typename implementation::key_type        key_type        ;    ///< Key type
+            typedef typename implementation::value_type        value_type        ;    ///< Value type
+            typedef typename implementation::pair_traits    pair_traits        ;    ///< Pair traits type
+            typedef typename implementation::key_traits        key_traits        ;    ///< Key traits
+            typedef typename implementation::value_traits    value_traits    ;    ///< Value traits
+            typedef typename implementation::key_comparator    key_comparator    ;    ///< Key comparator (binary predicate)
+            typedef typename implementation::node_type      node_type       ;   ///< node type
+
+            /// Rebind type of key-value pair stored in the list
+            template <
+                typename KEY2,
+                typename VALUE2,
+                typename PAIR_TRAITS2,
+                typename TRAITS2 = typename type_traits::original
+            >
+            struct rebind {
+                typedef MichaelList<
+                    gc_schema,
+                    KEY2,
+                    VALUE2,
+                    PAIR_TRAITS2,
+                    TRAITS2,
+                    ALLOCATOR
+                >    other ;         ///< Rebinding result
+            };
+
+        public:
+            MichaelList()
+            {
+                assert( gc::ibr::GarbageCollector::isUsed() )   ;
+            }
+        };
+
+    }    // namespace ordered_list
+}    // namespace cds
+
+
+#endif // #ifndef __CDS_ORDERED_LIST_MICHAEL_LIST_IBR_H
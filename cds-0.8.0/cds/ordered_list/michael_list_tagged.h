@@ -25,6 +25,7 @@
 
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/type_traits/is_reference.hpp>
+#include <boost/mpl/if.hpp>
 
 namespace cds {
     namespace ordered_list {
@@ -223,6 +224,13 @@ namespace cds {
         namespace michael_list_tagged {
 
             /// Free-list traits
+            /**
+                If \p TRAITS::free_list_type is a reference the free-list is shared (for example, by all buckets
+                of MichaelHashMap) and it is rebound to \p NODE as is. Otherwise each list owns its free-list;
+                such free-list is rebound with zero batch size, i.e. without processor caches,
+                since a hash map of N buckets would allocate N sets of caches.
+                The free-list with the caches of the source free-list is \p cached_freelist_type.
+            */
             template <typename NODE, typename TRAITS>
             class free_list_traits
             {
@@ -249,16 +257,26 @@ namespace cds {
                 //@endcond
 
             public:
+                //@cond
+                typedef typename boost::is_reference< source_freelist_type >    is_freelist_ref ;
+                //@endcond
+
+                /// Type of free-list with processor caches of the source free-list
+                typedef typename source_freelist_noref::template rebind< node_type >::other  cached_freelist_type ;
+
                 /// Type of free-list
-                typedef typename source_freelist_noref::template rebind< node_type >::other  freelist_type   ;
+                typedef typename boost::mpl::if_< is_freelist_ref,
+                    cached_freelist_type,
+                    typename source_freelist_noref::template rebind< node_type,
+                        typename source_freelist_noref::backoff_strategy,
+                        typename source_freelist_noref::allocator_type,
+                        0
+                    >::other
+                >::type     freelist_type   ;
                 /// Type of the free-list (non-reference)
                 typedef freelist_type       freelist_noref  ;
                 /// Reference to the free-list
                 typedef freelist_noref&     freelist_ref    ;
-
-                //@cond
-                typedef typename boost::is_reference< source_freelist_type >    is_freelist_ref ;
-                //@endcond
             };
 
             /// Michael's ordered list with Tagged Pointer GC
@@ -302,6 +320,7 @@ namespace cds {
                     typedef typename freelist_traits::backoff_strategy  backoff_strategy    ;   ///< back-off strategy
 
                     typedef typename freelist_traits::freelist_type     free_list_type      ;   ///< Source free-list type (maybe a reference)
+                    typedef typename freelist_traits::cached_freelist_type  cached_free_list_type   ;   ///< free-list type with processor caches
 
                     typedef typename freelist_traits::freelist_noref    freelist_noref      ;   ///< free-list type (no reference)
                     typedef typename freelist_traits::freelist_ref      freelist_ref        ;   ///< free-list reference type
@@ -1211,7 +1230,8 @@ namespace cds {
 
                     struct type_traits: public list_implementation::type_traits::original
                     {
-                        typedef typename list_implementation::type_traits::free_list_type               regular_node_freelist   ;
+                        // Split-ordered list is one list, so it keeps the processor caches of the free-list
+                        typedef typename list_implementation::type_traits::cached_free_list_type        regular_node_freelist   ;
                         typedef typename regular_node_freelist::template rebind<dummy_node>::other      dummy_node_freelist     ;
 
                         class free_list_type
@@ -1225,7 +1245,7 @@ namespace cds {
                             typedef typename regular_node_freelist::allocator_type      allocator_type      ;
                             typedef typename regular_node_freelist::backoff_strategy    backoff_strategy    ;
 
-                            template <typename Q, typename B = backoff_strategy, typename A = allocator_type >
+                            template <typename Q, typename B = backoff_strategy, typename A = allocator_type, size_t BATCH_SIZE = 0 >
                             struct rebind {
                                 typedef free_list_type  other ;
                             };
@@ -0,0 +1,179 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_OS_HUGE_PAGE_H
+#define __CDS_OS_HUGE_PAGE_H
+
+#include <cds/details/defs.h>
+#include <cds/os/alloc_aligned.h>
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+#   include <sys/mman.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#   include <dirent.h>
+#   include <stdio.h>
+#   include <stdlib.h>
+#   include <string.h>
+#endif
+
+namespace cds { namespace OS {
+
+    /// Huge page mapping
+    /**
+        The wrapper maps memory regions backed by huge pages (2M on x86/amd64) and binds the regions
+        to NUMA nodes. The size of the region must be a multiple of \ref c_nSize, the region is aligned
+        on \ref c_nSize boundary.
+
+        On Linux \ref map tries:
+            \li \p mmap with \p MAP_HUGETLB flag - explicit huge pages from the pool of hugetlbfs
+                (see <tt>/proc/sys/vm/nr_hugepages</tt>);
+            \li if the pool is exhausted, \p mmap of anonymous region aligned on huge page boundary
+                and advised by <tt>madvise( MADV_HUGEPAGE )</tt> - transparent huge pages (THP) that are used
+                if THP is enabled in \p madvise or \p always mode;
+            \li if \p madvise fails the region is backed by regular pages.
+
+        \ref bind_node sets the preferred NUMA node of the region by \p mbind system call
+        (\p MPOL_PREFERRED policy). The preferred policy is used instead of strict \p MPOL_BIND:
+        if the node has no free (huge) pages the kernel takes the pages from other node
+        instead of killing the process by \p SIGBUS or OOM.
+
+        On other OSes the region is allocated by \p cds::OS::aligned_malloc,
+        \ref bind_node and \ref processor_node are not supported.
+    */
+    struct huge_page
+    {
+        /// Huge page size
+        static const size_t c_nSize = 2 * 1024 * 1024 ;
+
+        /// Max NUMA node count supported by \ref bind_node
+        static const unsigned int c_nMaxNodeCount = 1024  ;
+
+        /// Backing of mapped region
+        enum backing {
+            backing_hugetlb,    ///< explicit huge pages (\p MAP_HUGETLB)
+            backing_thp,        ///< transparent huge pages (\p MADV_HUGEPAGE)
+            backing_regular     ///< regular pages
+        };
+
+        /// Maps a region of \p nSize bytes
+        /**
+            \p nSize must be a multiple of \ref c_nSize.
+            The backing of the region is returned in \p kind.
+            Returns \p NULL if the region cannot be mapped.
+        */
+        static void * map( size_t nSize, backing& kind )
+        {
+            assert( nSize % c_nSize == 0 )  ;
+#   if CDS_OS_TYPE == CDS_OS_LINUX
+#       ifdef MAP_HUGETLB
+            void * p = ::mmap( NULL, nSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 ) ;
+            if ( p != MAP_FAILED ) {
+                kind = backing_hugetlb  ;
+                return p    ;
+            }
+#       endif
+            // Map a region larger by one huge page and trim it to huge page boundary
+            char * pRegion = reinterpret_cast<char *>( ::mmap( NULL, nSize + c_nSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 )) ;
+            if ( pRegion == reinterpret_cast<char *>( MAP_FAILED ))
+                return NULL ;
+
+            char * pAligned = reinterpret_cast<char *>(
+                ( reinterpret_cast<uptr_atomic_t>( pRegion ) + c_nSize - 1 ) & ~( uptr_atomic_t(c_nSize) - 1 )
+            ) ;
+            if ( pAligned != pRegion )
+                ::munmap( pRegion, pAligned - pRegion ) ;
+            if ( pAligned + nSize != pRegion + nSize + c_nSize )
+                ::munmap( pAligned + nSize, (pRegion + nSize + c_nSize) - (pAligned + nSize) )  ;
+
+#       ifdef MADV_HUGEPAGE
+            if ( ::madvise( pAligned, nSize, MADV_HUGEPAGE ) == 0 ) {
+                kind = backing_thp  ;
+                return pAligned ;
+            }
+#       endif
+            kind = backing_regular  ;
+            return pAligned ;
+#   else
+            kind = backing_regular  ;
+            return cds::OS::aligned_malloc( nSize, c_nSize )    ;
+#   endif
+        }
+
+        /// Unmaps the region \p p of \p nSize bytes previously mapped by \ref map
+        static void unmap( void * p, size_t nSize )
+        {
+#   if CDS_OS_TYPE == CDS_OS_LINUX
+            ::munmap( p, nSize )    ;
+#   else
+            cds::OS::aligned_free( p )  ;
+#   endif
+        }
+
+        /// Sets preferred NUMA node \p nNode for the region \p p of \p nSize bytes
+        /**
+            The function should be called before the region is touched: the policy affects
+            the pages that are not faulted yet.
+            Returns \p false if the binding is not supported by the system.
+        */
+        static bool bind_node( void * p, size_t nSize, int nNode )
+        {
+#   if CDS_OS_TYPE == CDS_OS_LINUX && defined(SYS_mbind)
+            enum {
+                mpol_preferred  = 1,
+                c_nMaskBits     = sizeof(unsigned long) * 8
+            };
+
+            if ( nNode < 0 || (unsigned int) nNode >= c_nMaxNodeCount )
+                return false    ;
+
+            unsigned long arrMask[ c_nMaxNodeCount / c_nMaskBits ]  ;
+            memset( arrMask, 0, sizeof(arrMask) )   ;
+            arrMask[ nNode / c_nMaskBits ] = 1UL << ( nNode % c_nMaskBits ) ;
+
+            // The kernel treats maxnode argument as bit count + 1
+            return syscall( SYS_mbind, p, nSize, mpol_preferred, arrMask, c_nMaxNodeCount + 1, 0 ) == 0 ;
+#   else
+            return false    ;
+#   endif
+        }
+
+        /// Returns NUMA node of processor \p nProcessor or -1 if the node is unknown
+        /**
+            On Linux the node is taken from <tt>/sys/devices/system/cpu/cpuN/nodeM</tt> entry.
+        */
+        static int processor_node( unsigned int nProcessor )
+        {
+#   if CDS_OS_TYPE == CDS_OS_LINUX
+            char szPath[64] ;
+            snprintf( szPath, sizeof(szPath), "/sys/devices/system/cpu/cpu%u", nProcessor ) ;
+
+            DIR * pDir = ::opendir( szPath )    ;
+            if ( !pDir )
+                return -1   ;
+
+            int nNode = -1  ;
+            for ( struct dirent * pEntry = ::readdir( pDir ); pEntry; pEntry = ::readdir( pDir )) {
+                if ( strncmp( pEntry->d_name, "node", 4 ) == 0 && pEntry->d_name[4] >= '0' && pEntry->d_name[4] <= '9' ) {
+                    nNode = atoi( pEntry->d_name + 4 )  ;
+                    break   ;
+                }
+            }
+            ::closedir( pDir )  ;
+            return nNode    ;
+#   else
+            return -1   ;
+#   endif
+        }
+    };
+
+}} // namespace cds::OS
+
+#endif // #ifndef __CDS_OS_HUGE_PAGE_H
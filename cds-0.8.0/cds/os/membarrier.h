@@ -0,0 +1,94 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_OS_MEMBARRIER_H
+#define __CDS_OS_MEMBARRIER_H
+
+#include <cds/details/defs.h>
+#include <cds/atomic.h>
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#endif
+
+namespace cds { namespace OS {
+
+    /// Asymmetric memory fence
+    /**
+        The asymmetric fence is the pair of barriers for the Dekker-like synchronization where one side
+        is executed very often (fast path) and another side is executed rarely (slow path).
+        The fast path calls \ref light that is a compiler barrier only, the slow path calls \ref heavy
+        that forces a full memory barrier on all running threads of the process. Thus, the pair
+        <tt>light() / heavy()</tt> is equivalent to the pair of <tt>membar_seq_cst</tt> fences
+        but the fast path does not pay for the fence instruction.
+
+        On Linux 4.14+ \ref heavy is the \p membarrier(2) system call with \p MEMBARRIER_CMD_PRIVATE_EXPEDITED command.
+        If the system call is not supported both \ref light and \ref heavy are the full memory fence
+        (see \ref is_expedited).
+    */
+    struct asymmetric_fence
+    {
+        //@cond
+#   if CDS_OS_TYPE == CDS_OS_LINUX && defined(SYS_membarrier)
+        enum {
+            membarrier_cmd_query                        = 0,
+            membarrier_cmd_private_expedited            = 1 << 3,
+            membarrier_cmd_register_private_expedited   = 1 << 4
+        };
+
+        static bool init()
+        {
+            int nCmd = (int) syscall( SYS_membarrier, membarrier_cmd_query, 0 )   ;
+            if ( nCmd < 0 || !(nCmd & membarrier_cmd_private_expedited) )
+                return false    ;
+            return syscall( SYS_membarrier, membarrier_cmd_register_private_expedited, 0 ) == 0 ;
+        }
+#   else
+        static bool init()
+        {
+            return false    ;
+        }
+#   endif
+        //@endcond
+
+        /// Checks if \ref heavy is the process-wide barrier and \ref light is the compiler barrier only
+        /**
+            The first call registers the process for expedited \p membarrier.
+        */
+        static bool is_expedited()
+        {
+            static bool const s_bExpedited = init()   ;
+            return s_bExpedited ;
+        }
+
+        /// Fast-path barrier
+        static void light()
+        {
+            if ( is_expedited() )
+                CDS_COMPILER_RW_BARRIER ;
+            else
+                atomics::fence( membar_seq_cst::order ) ;
+        }
+
+        /// Slow-path barrier
+        static void heavy()
+        {
+#   if CDS_OS_TYPE == CDS_OS_LINUX && defined(SYS_membarrier)
+            if ( is_expedited() && syscall( SYS_membarrier, membarrier_cmd_private_expedited, 0 ) == 0 )
+                return  ;
+#   endif
+            atomics::fence( membar_seq_cst::order ) ;
+        }
+    };
+
+}} // namespace cds::OS
+
+#endif // #ifndef __CDS_OS_MEMBARRIER_H
@@ -0,0 +1,429 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_ADAPTIVE_QUEUE_H
+#define __CDS_QUEUE_ADAPTIVE_QUEUE_H
+
+#include <cds/queue/details/queue_base.h>
+#include <cds/os/membarrier.h>
+#include <cds/lock/spinlock.h>
+#include <cds/details/allocator.h>
+#include <cds/details/aligned_type.h>
+#include <cds/user_setup/cache_line.h>
+
+namespace cds { namespace queue {
+
+    /// Bounded queue that switches between SPSC and MPMC modes by attached thread count
+    /**
+        The queue is intended for the case when the queue has one producer and one consumer
+        almost all the time but sometimes another producer or consumer appears (for example, during failover).
+        While exactly one producer and one consumer are attached the queue works as a single-producer
+        single-consumer ring: each side advances its own position by a plain store and the sides communicate
+        only through the cells (like FastForward queue). When the second thread of a side is attached,
+        the side is switched to shared mode where the position is advanced by CAS (Dmitry Vyukov's bounded MPMC queue).
+        When the thread is detached and only one thread of the side remains, the side is switched back.
+
+        The producer side and the consumer side are switched independently, so the queue also is
+        SPMC or MPSC when only one of the sides has several threads.
+        Both modes use the same cell array with per-cell sequence numbers, so the items are never moved
+        and FIFO order is kept across the switch.
+
+        The switch to shared mode waits until the single thread of the side completes its current operation.
+        The single-thread operation announces itself by the store into its own cache line and does not
+        execute any fence instruction: the switching thread executes cds::OS::asymmetric_fence::heavy instead
+        (\p membarrier(2) on Linux). If the expedited \p membarrier is not supported, the single-thread operation
+        executes one full fence, it still does not contend on the position with other threads.
+
+        Each thread that enqueues must call \ref attach_producer before its first \ref enqueue and \ref detach_producer
+        after the last one (or use \ref scoped_producer); the same is for consumers (\ref attach_consumer,
+        \ref detach_consumer, \ref scoped_consumer). A thread may be the producer and the consumer at the same time.
+        If no thread of the side is attached the side works in single-thread mode, so the queue may be used
+        by one thread without attaching.
+
+        \par Template parameters
+            \li \p T - item type. Must be default-constructible and assignable.
+            \li \p TRAITS - queue traits, default is cds::queue::traits. \p backoff_strategy is used
+                when CAS fails in shared mode, \p item_counter_type and \p statistics are used as well.
+                queue_statistics counts the mode switches as \p m_ModeUpgrade and \p m_ModeDowngrade.
+            \li \p ALLOCATOR - allocator for the cell array
+
+        \par Example
+        \code
+        #include <cds/queue/adaptive_queue.h>
+
+        typedef cds::queue::adaptive_queue< int >   queue_type  ;
+        queue_type q( 1024 )  ;
+
+        // Producer thread
+        {
+            queue_type::scoped_producer producer( q )   ;
+            q.enqueue( 42 ) ;
+        }
+
+        // Consumer thread
+        {
+            queue_type::scoped_consumer consumer( q )   ;
+            int n   ;
+            if ( q.dequeue( n ))
+                ...
+        }
+        \endcode
+    */
+    template <typename T, class TRAITS = traits, class ALLOCATOR = CDS_DEFAULT_ALLOCATOR>
+    class adaptive_queue
+    {
+    public:
+        typedef T                               value_type  ;   ///< Value type
+        typedef normalized_type_traits<TRAITS>  type_traits ;   ///< Normalized queue traits
+
+        static const size_t c_nDefaultCapacity = 1024   ;   ///< Default queue capacity
+
+    protected:
+        //@cond
+        struct cell_type
+        {
+            atomic<size_t>  m_nSequence ;
+            value_type      m_data      ;
+        };
+        typedef cds::details::Allocator< cell_type, ALLOCATOR >   cell_allocator  ;
+
+        // Position and mode of producers or consumers
+        struct side
+        {
+            atomic<size_t>  m_nPos      ;   // enqueue or dequeue position
+            atomic<int>     m_bShared   ;   // 0 - single-thread mode, 1 - shared mode
+            atomic<int>     m_bBusy     ;   // the thread is inside single-thread operation
+            size_t          m_nAttached ;   // attached thread count, guarded by m_Lock
+        };
+        typedef typename cds::details::aligned_type< side, c_nCacheLineSize >::type    aligned_side ;
+
+        cell_type *     m_arrCells  ;
+        size_t const    m_nMask     ;
+        aligned_side    m_Enqueue   ;
+        aligned_side    m_Dequeue   ;
+        char            m_pad[ c_nCacheLineSize ]  ;   // the rest must not share the cache line with m_Dequeue
+        typename type_traits::item_counter_type m_ItemCounter   ;
+        typename type_traits::statistics        m_Stat          ;
+        cds::lock::Spin m_Lock      ;   // serializes attach/detach
+        //@endcond
+
+    public:
+        /// Scoped attachment of the current thread as a producer
+        class scoped_producer
+        {
+            adaptive_queue& m_Queue ;
+        public:
+            /// Calls \ref attach_producer
+            explicit scoped_producer( adaptive_queue& q )
+                : m_Queue( q )
+            {
+                m_Queue.attach_producer()   ;
+            }
+            /// Calls \ref detach_producer
+            ~scoped_producer()
+            {
+                m_Queue.detach_producer()   ;
+            }
+        };
+
+        /// Scoped attachment of the current thread as a consumer
+        class scoped_consumer
+        {
+            adaptive_queue& m_Queue ;
+        public:
+            /// Calls \ref attach_consumer
+            explicit scoped_consumer( adaptive_queue& q )
+                : m_Queue( q )
+            {
+                m_Queue.attach_consumer()   ;
+            }
+            /// Calls \ref detach_consumer
+            ~scoped_consumer()
+            {
+                m_Queue.detach_consumer()   ;
+            }
+        };
+
+    public:
+        /// Constructs the queue of capacity \p nCapacity rounded up to the power of 2
+        explicit adaptive_queue( size_t nCapacity = c_nDefaultCapacity )
+            : m_nMask( ceil_power2( nCapacity ) - 1 )
+        {
+            m_arrCells = cell_allocator().NewArray( capacity() ) ;
+            for ( size_t i = 0; i < capacity(); ++i )
+                m_arrCells[i].m_nSequence.template store<membar_relaxed>( i ) ;
+            init_side( m_Enqueue )  ;
+            init_side( m_Dequeue )  ;
+
+            // Registers the process for expedited membarrier before the first switch
+            OS::asymmetric_fence::is_expedited()  ;
+        }
+
+        ~adaptive_queue()
+        {
+            cell_allocator().Delete( m_arrCells, capacity() )  ;
+        }
+
+        /// Attaches the current thread as a producer
+        /**
+            If another producer is attached, the producer side is switched to shared mode.
+            The function waits until the producer that worked in single-thread mode completes its current \ref enqueue.
+        */
+        void attach_producer()
+        {
+            attach( m_Enqueue ) ;
+        }
+
+        /// Detaches the current thread from the producers
+        /**
+            The thread must not call \ref enqueue after detaching.
+            If only one producer remains the producer side is switched to single-thread mode.
+        */
+        void detach_producer()
+        {
+            detach( m_Enqueue ) ;
+        }
+
+        /// Attaches the current thread as a consumer, see \ref attach_producer
+        void attach_consumer()
+        {
+            attach( m_Dequeue ) ;
+        }
+
+        /// Detaches the current thread from the consumers, see \ref detach_producer
+        void detach_consumer()
+        {
+            detach( m_Dequeue ) ;
+        }
+
+        /// Checks if both sides work in single-thread mode
+        bool is_spsc() const
+        {
+            return !m_Enqueue.m_bShared.template load<membar_relaxed>()
+                && !m_Dequeue.m_bShared.template load<membar_relaxed>() ;
+        }
+
+        /// Enqueues \p data
+        /**
+            Returns \p false if the queue is full.
+        */
+        bool enqueue( value_type const& data )
+        {
+            side& s = m_Enqueue ;
+            if ( !s.m_bShared.template load<membar_acquire>() ) {
+                s.m_bBusy.template store<membar_relaxed>( 1 )   ;
+                OS::asymmetric_fence::light()   ;
+                if ( !s.m_bShared.template load<membar_acquire>() ) {
+                    bool bRet = enqueue_single( data ) ;
+                    s.m_bBusy.template store<membar_release>( 0 )   ;
+                    return bRet ;
+                }
+                s.m_bBusy.template store<membar_release>( 0 )   ;
+            }
+            return enqueue_shared( data )   ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool push( value_type const& data )
+        {
+            return enqueue( data )  ;
+        }
+
+        /// Dequeues an item to \p dest
+        /**
+            If the queue is empty returns \p false, \p dest is unchanged.
+        */
+        bool dequeue( value_type& dest )
+        {
+            side& s = m_Dequeue ;
+            if ( !s.m_bShared.template load<membar_acquire>() ) {
+                s.m_bBusy.template store<membar_relaxed>( 1 )   ;
+                OS::asymmetric_fence::light()   ;
+                if ( !s.m_bShared.template load<membar_acquire>() ) {
+                    bool bRet = dequeue_single( dest ) ;
+                    s.m_bBusy.template store<membar_release>( 0 )   ;
+                    return bRet ;
+                }
+                s.m_bBusy.template store<membar_release>( 0 )   ;
+            }
+            return dequeue_shared( dest )   ;
+        }
+
+        /// Synonym for \ref dequeue
+        bool pop( value_type& dest )
+        {
+            return dequeue( dest )  ;
+        }
+
+        /// Checks if the queue is empty
+        bool empty() const
+        {
+            size_t pos = m_Dequeue.m_nPos.template load<membar_relaxed>()    ;
+            size_t seq = m_arrCells[ pos & m_nMask ].m_nSequence.template load<membar_acquire>()  ;
+            return (intptr_t) seq - (intptr_t)(pos + 1) < 0 ;
+        }
+
+        /// Clears the queue. The current thread must be a consumer or the queue must have no consumers
+        size_t clear()
+        {
+            return generic_clear( *this )   ;
+        }
+
+        /// Returns the item count, see \p item_counter_type of the traits
+        size_t size() const
+        {
+            return m_ItemCounter.value()    ;
+        }
+
+        /// Returns queue capacity
+        size_t capacity() const
+        {
+            return m_nMask + 1  ;
+        }
+
+        /// Returns queue's statistics
+        const typename type_traits::statistics& getStatistics() const
+        {
+            return m_Stat   ;
+        }
+
+    protected:
+        //@cond
+        static size_t ceil_power2( size_t n )
+        {
+            size_t nPow = 2 ;
+            while ( nPow < n )
+                nPow <<= 1  ;
+            return nPow ;
+        }
+
+        static void init_side( side& s )
+        {
+            s.m_nPos.template store<membar_relaxed>( 0 )    ;
+            s.m_bShared.template store<membar_relaxed>( 0 ) ;
+            s.m_bBusy.template store<membar_relaxed>( 0 )   ;
+            s.m_nAttached = 0   ;
+        }
+
+        void attach( side& s )
+        {
+            cds::lock::AutoSpin al( m_Lock )    ;
+            if ( ++s.m_nAttached != 2 )
+                return  ;
+
+            // Dekker-like handshake with the single thread of the side:
+            // either the thread sees m_bShared in its operation, or we see its m_bBusy flag
+            s.m_bShared.template store<membar_relaxed>( 1 )    ;
+            OS::asymmetric_fence::heavy()   ;
+            backoff::yield bkoff    ;
+            while ( s.m_bBusy.template load<membar_acquire>() )
+                bkoff() ;
+            m_Stat.onModeUpgrade()  ;
+        }
+
+        void detach( side& s )
+        {
+            cds::lock::AutoSpin al( m_Lock )    ;
+            assert( s.m_nAttached > 0 ) ;
+            if ( --s.m_nAttached != 1 )
+                return  ;
+
+            // The remaining thread is alone, it may leave shared mode at any moment
+            s.m_bShared.template store<membar_release>( 0 )    ;
+            m_Stat.onModeDowngrade()    ;
+        }
+
+        bool enqueue_single( value_type const& data )
+        {
+            size_t pos = m_Enqueue.m_nPos.template load<membar_relaxed>()   ;
+            cell_type& cell = m_arrCells[ pos & m_nMask ] ;
+            if ( cell.m_nSequence.template load<membar_acquire>() != pos )
+                return false    ;   // full
+
+            cell.m_data = data  ;
+            m_Enqueue.m_nPos.template store<membar_relaxed>( pos + 1 )  ;
+            cell.m_nSequence.template store<membar_release>( pos + 1 )  ;
+            ++m_ItemCounter ;
+            m_Stat.onEnqueue()  ;
+            return true ;
+        }
+
+        bool enqueue_shared( value_type const& data )
+        {
+            typename type_traits::backoff_strategy bkoff    ;
+            cell_type * pCell   ;
+            size_t pos = m_Enqueue.m_nPos.template load<membar_relaxed>()   ;
+            for (;;) {
+                pCell = m_arrCells + (pos & m_nMask)  ;
+                intptr_t dif = (intptr_t) pCell->m_nSequence.template load<membar_acquire>() - (intptr_t) pos ;
+                if ( dif == 0 ) {
+                    if ( m_Enqueue.m_nPos.template cas<membar_relaxed>( pos, pos + 1 ))
+                        break   ;
+                    m_Stat.onEnqueueRace()  ;
+                    bkoff() ;
+                }
+                else if ( dif < 0 )
+                    return false    ;   // full
+                pos = m_Enqueue.m_nPos.template load<membar_relaxed>()   ;
+            }
+
+            pCell->m_data = data    ;
+            pCell->m_nSequence.template store<membar_release>( pos + 1 )   ;
+            ++m_ItemCounter ;
+            m_Stat.onEnqueue()  ;
+            return true ;
+        }
+
+        bool dequeue_single( value_type& dest )
+        {
+            size_t pos = m_Dequeue.m_nPos.template load<membar_relaxed>()   ;
+            cell_type& cell = m_arrCells[ pos & m_nMask ] ;
+            if ( cell.m_nSequence.template load<membar_acquire>() != pos + 1 )
+                return false    ;   // empty
+
+            dest = cell.m_data  ;
+            m_Dequeue.m_nPos.template store<membar_relaxed>( pos + 1 )  ;
+            cell.m_nSequence.template store<membar_release>( pos + m_nMask + 1 )  ;
+            --m_ItemCounter ;
+            m_Stat.onDequeue()  ;
+            return true ;
+        }
+
+        bool dequeue_shared( value_type& dest )
+        {
+            typename type_traits::backoff_strategy bkoff    ;
+            cell_type * pCell   ;
+            size_t pos = m_Dequeue.m_nPos.template load<membar_relaxed>()   ;
+            for (;;) {
+                pCell = m_arrCells + (pos & m_nMask)  ;
+                intptr_t dif = (intptr_t) pCell->m_nSequence.template load<membar_acquire>() - (intptr_t)(pos + 1) ;
+                if ( dif == 0 ) {
+                    if ( m_Dequeue.m_nPos.template cas<membar_relaxed>( pos, pos + 1 ))
+                        break   ;
+                    m_Stat.onDequeueRace()  ;
+                    bkoff() ;
+                }
+                else if ( dif < 0 )
+                    return false    ;   // empty
+                pos = m_Dequeue.m_nPos.template load<membar_relaxed>()   ;
+            }
+
+            dest = pCell->m_data    ;
+            pCell->m_nSequence.template store<membar_release>( pos + m_nMask + 1 )   ;
+            --m_ItemCounter ;
+            m_Stat.onDequeue()  ;
+            return true ;
+        }
+        //@endcond
+    };
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_ADAPTIVE_QUEUE_H
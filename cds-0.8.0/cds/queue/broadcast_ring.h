@@ -0,0 +1,280 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_BROADCAST_RING_H
+#define __CDS_QUEUE_BROADCAST_RING_H
+
+#include <cds/opt/options.h>
+#include <cds/opt/buffer.h>
+#include <cds/atomic.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/details/aligned_type.h>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace queue {
+
+    /// Broadcast ring: bounded multi-producer multi-consumer ring where every consumer receives every item
+    /**
+        The ring is built in the manner of LMAX Disruptor on sequence-numbered cells (like \ref vyukov_mpmc_bounded):
+        \li a producer claims next sequence number by CAS on the claim position, copies the item into the cell
+            and publishes the cell by storing the sequence number into the cell's sequence word;
+        \li each consumer has its own cursor (the sequence number of the next item to read), only the consumer
+            modifies its cursor. The item is read without any RMW operation;
+        \li a producer may claim a sequence number only if the slowest consumer has read the item stored
+            in the cell <tt>capacity</tt> sequences ago (gating). The minimum of consumer's cursors
+            is cached and recalculated only when the cached value does not allow to claim a cell.
+
+        The item is copied into the ring once and is read by all consumers, instead of one queue per consumer
+        with its own copy of each item. The consumer count is fixed at construction time; consumers are identified
+        by number <tt>0 .. consumer_count() - 1</tt> and each consumer number must be used by one thread at a time.
+        The ring with one producer is SPMC ring; in this case the claim CAS never fails.
+
+        A consumer that does not read the items stops the producers when the ring is full,
+        so each consumer must read all items.
+
+        \par Template parameters
+            \li \p T - type stored in the ring. Must be default-constructible and assignable.
+            \li \p OPTIONS - ring's options
+
+        Options \p OPTIONS are:
+            \li cds::opt::buffer - buffer to store items. Mandatory option, see option description for full list of possible types.
+                The buffer capacity must be a power of two.
+
+        \par Example
+        \code
+        #include <cds/queue/broadcast_ring.h>
+
+        // The ring of capacity 1024 with 4 consumers
+        typedef cds::queue::broadcast_ring< int, cds::opt::buffer< cds::opt::v::dynamic_buffer<int> > > ring_type ;
+        ring_type ring( 1024, 4 ) ;
+
+        // producer
+        ring.enqueue( 42 ) ;
+
+        // consumer #2
+        int arr[16] ;
+        size_t n = ring.dequeue_batch( 2, arr, 16 ) ;
+        \endcode
+    */
+#ifdef CDS_COMPILER_SUPPORTS_VARIADIC_TEMPLATE
+    template <typename T, typename... OPTIONS>
+#else
+    template <typename T
+        , typename O1= opt::none
+    >
+#endif
+    class broadcast_ring
+    {
+    public:
+        typedef T value_type  ;   ///< Value type stored in the ring
+
+    private:
+        //@cond
+        struct default_options
+        {};
+
+#ifdef CDS_COMPILER_SUPPORTS_VARIADIC_TEMPLATE
+        typedef typename opt::make_options<default_options, OPTIONS...>::type   options ;
+#else
+        typedef typename opt::make_options<default_options, O1>::type   options ;
+#endif
+        //@endcond
+
+    protected:
+        //@cond
+        struct cell_type
+        {
+            cds::atomic<size_t>     sequence;   // sequence number of the item published + 1
+            value_type              data;
+        };
+
+        // Consumer's cursor; the padding places the cursors into different cache lines
+        struct cursor_type
+        {
+            cds::atomic<size_t>     pos ;
+            char                    pad[ c_nCacheLineSize - sizeof(cds::atomic<size_t>) ] ;
+        };
+
+        typedef typename options::buffer::template rebind<cell_type>::other     buffer  ;
+        typedef cds::details::Allocator< cursor_type >  cursor_allocator    ;
+        //@endcond
+
+    protected:
+        //@cond
+        typename cds::details::aligned_type<buffer, c_nCacheLineSize>::type  m_buffer    ;
+        size_t const    m_nBufferMask   ;
+        size_t const    m_nConsumerCount ;
+        cursor_type *   m_arrCursors    ;
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posClaim    ;
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posGate     ;   // cached minimum of consumer's cursors
+        //@endcond
+
+    public:
+        /// Constructs the ring of capacity \p nCapacity for \p nConsumerCount consumers
+        /**
+            For cds::opt::v::static_buffer the \p nCapacity parameter is ignored.
+        */
+        broadcast_ring( size_t nCapacity, size_t nConsumerCount )
+            : m_buffer( nCapacity )
+            , m_nBufferMask( m_buffer.capacity() - 1 )
+            , m_nConsumerCount( nConsumerCount )
+        {
+            nCapacity = m_buffer.capacity()  ;
+
+            // Buffer capacity must be power of 2
+            assert( nCapacity >= 2 && (nCapacity & (nCapacity - 1)) == 0 ) ;
+            assert( nConsumerCount > 0 )    ;
+
+            for ( size_t i = 0; i < nCapacity; ++i )
+                m_buffer[i].sequence.template store<membar_relaxed>( 0 )   ;
+
+            m_arrCursors = cursor_allocator().NewArray( nConsumerCount )    ;
+            for ( size_t i = 0; i < nConsumerCount; ++i )
+                m_arrCursors[i].pos.template store<membar_relaxed>( 0 ) ;
+
+            m_posGate.store<membar_relaxed>( 0 )    ;
+            m_posClaim.store<membar_release>( 0 )   ;
+        }
+
+        ~broadcast_ring()
+        {
+            cursor_allocator().Delete( m_arrCursors, m_nConsumerCount ) ;
+        }
+
+        /// Enqueues \p data to the ring
+        /**
+            Returns \p false if the ring is full, i.e. the slowest consumer has not read
+            the item stored in the cell to be claimed.
+        */
+        bool enqueue( value_type const& data )
+        {
+            size_t const nCapacity = capacity() ;
+            size_t pos = m_posClaim.load<membar_relaxed>()   ;
+
+            for (;;) {
+                if ( pos - m_posGate.load<membar_acquire>() >= nCapacity ) {
+                    // The cached gate does not allow to claim the cell, recalculate it
+                    size_t nGate = minCursor()  ;
+                    m_posGate.store<membar_release>( nGate ) ;
+                    if ( pos - nGate >= nCapacity ) {
+                        size_t nCur = m_posClaim.load<membar_relaxed>() ;
+                        if ( nCur == pos )
+                            return false    ;   // the ring is full
+                        pos = nCur  ;
+                        continue    ;
+                    }
+                }
+
+                if ( m_posClaim.cas<membar_relaxed>( pos, pos + 1 ))
+                    break   ;
+                pos = m_posClaim.load<membar_relaxed>() ;
+            }
+
+            cell_type& cell = m_buffer[ pos & m_nBufferMask ]  ;
+            cell.data = data    ;
+            cell.sequence.template store<membar_release>( pos + 1 ) ;
+            return true ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool push( value_type const& data )
+        {
+            return enqueue( data )  ;
+        }
+
+        /// Reads next item for the consumer \p nConsumer
+        /**
+            Returns \p false if no item is published for the consumer yet, \p data is unchanged.
+        */
+        bool dequeue( size_t nConsumer, value_type& data )
+        {
+            assert( nConsumer < m_nConsumerCount )  ;
+            cds::atomic<size_t>& cursor = m_arrCursors[ nConsumer ].pos ;
+
+            size_t pos = cursor.template load<membar_relaxed>()   ;
+            cell_type& cell = m_buffer[ pos & m_nBufferMask ]  ;
+            if ( cell.sequence.template load<membar_acquire>() != pos + 1 )
+                return false    ;
+
+            data = cell.data    ;
+            cursor.template store<membar_release>( pos + 1 )    ;
+            return true ;
+        }
+
+        /// Synonym for \ref dequeue
+        bool pop( size_t nConsumer, value_type& data )
+        {
+            return dequeue( nConsumer, data )   ;
+        }
+
+        /// Reads up to \p nMax consecutive items for the consumer \p nConsumer
+        /**
+            The items are copied to output iterator \p itOut, the consumer's cursor
+            is moved once for all items read.
+            Returns the number of items read.
+        */
+        template <typename OUTPUT_ITERATOR>
+        size_t dequeue_batch( size_t nConsumer, OUTPUT_ITERATOR itOut, size_t nMax )
+        {
+            assert( nConsumer < m_nConsumerCount )  ;
+            cds::atomic<size_t>& cursor = m_arrCursors[ nConsumer ].pos ;
+
+            size_t const posStart = cursor.template load<membar_relaxed>()   ;
+            size_t pos = posStart ;
+            for ( ; pos - posStart < nMax; ++pos, ++itOut ) {
+                cell_type& cell = m_buffer[ pos & m_nBufferMask ]  ;
+                if ( cell.sequence.template load<membar_acquire>() != pos + 1 )
+                    break   ;
+                *itOut = cell.data  ;
+            }
+
+            if ( pos != posStart )
+                cursor.template store<membar_release>( pos ) ;
+            return pos - posStart   ;
+        }
+
+        /// Checks if there is no item to read for the consumer \p nConsumer
+        bool empty( size_t nConsumer ) const
+        {
+            assert( nConsumer < m_nConsumerCount )  ;
+            size_t pos = m_arrCursors[ nConsumer ].pos.template load<membar_relaxed>()  ;
+            return m_buffer[ pos & m_nBufferMask ].sequence.template load<membar_acquire>() != pos + 1 ;
+        }
+
+        /// Returns the ring's capacity
+        size_t capacity() const
+        {
+            return m_nBufferMask + 1    ;
+        }
+
+        /// Returns the consumer count
+        size_t consumer_count() const
+        {
+            return m_nConsumerCount ;
+        }
+
+    protected:
+        //@cond
+        size_t minCursor() const
+        {
+            size_t nMin = m_arrCursors[0].pos.template load<membar_acquire>()  ;
+            for ( size_t i = 1; i < m_nConsumerCount; ++i ) {
+                size_t pos = m_arrCursors[i].pos.template load<membar_acquire>()  ;
+                if ( (intptr_t)(pos - nMin) < 0 )
+                    nMin = pos  ;
+            }
+            return nMin ;
+        }
+        //@endcond
+    };
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_BROADCAST_RING_H
@@ -0,0 +1,259 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_BYTE_RING_H
+#define __CDS_QUEUE_BYTE_RING_H
+
+#include <cds/atomic.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/details/aligned_type.h>
+#include <cds/os/alloc_aligned.h>
+#include <cds/concept.h>
+
+#include <string.h>     // memset
+
+namespace cds { namespace queue {
+
+    /// Byte ring of variable-length records
+    /**
+        The ring is a circular byte buffer that stores length-prefixed records of variable size.
+        The records are written and read in place (zero-copy):
+        \li the producer calls \ref reserve to get the pointer to \p nLength bytes inside the ring,
+            writes the message and calls \ref commit to publish it;
+        \li the consumer calls \ref read to get the pointer to the next record and its length,
+            processes the message in place and calls \ref release to free the space of the record.
+
+        Each record starts on a cache line boundary and consists of the record header
+        (the record size and the message length) followed by the message. The record size is rounded up
+        to the cache line size, so the records of different producers do not share cache lines.
+        If the record does not fit before the end of the buffer, the rest of the buffer is filled
+        by a padding record that is skipped by the consumer; so each record is contiguous.
+
+        The record is published by the release-store of its header. The consumer clears the first word of
+        each cache line of the released record, so a stale header of previous lap cannot be taken as published.
+
+        \par Template parameters
+            \li \p MULTIPLE_PRODUCERS - if \p true, many producers may reserve the records concurrently (MPSC ring);
+                the space is reserved by CAS and the records may be committed in any order, the consumer reads
+                them in reservation order. If \p false, only one producer is allowed (SPSC ring) and no CAS is used.
+
+        Only one consumer is allowed in any case.
+
+        \par Example
+        \code
+        #include <cds/queue/byte_ring.h>
+
+        cds::queue::mpsc_byte_ring  ring( 1024 * 1024 ) ;
+
+        // producer
+        void * p = ring.reserve( nMsgLen )  ;
+        if ( p ) {
+            memcpy( p, pMsg, nMsgLen )  ;   // or build the message in place
+            ring.commit( p )    ;
+        }
+
+        // consumer
+        size_t nLen ;
+        void * pRecord = ring.read( nLen )  ;
+        if ( pRecord ) {
+            process( pRecord, nLen )   ;
+            ring.release()      ;
+        }
+        \endcode
+    */
+    template <bool MULTIPLE_PRODUCERS>
+    class byte_ring: public cds::concept::bounded_container
+    {
+    protected:
+        //@cond
+        struct record_header {
+            cds::atomic<size_t> m_nTag      ;   // record size | flags; 0 - the record is not committed
+            size_t              m_nLength   ;   // message length
+        };
+
+        static const size_t c_nCommitted    = 1 ;
+        static const size_t c_nPadding      = 2 ;
+        static const size_t c_nFlagMask     = c_nCommitted | c_nPadding ;
+        //@endcond
+
+    public:
+        static const bool   c_bMultipleProducers = MULTIPLE_PRODUCERS   ;   ///< Multiple producers are allowed
+        static const size_t c_nRecordAlignment = c_nCacheLineSize   ;       ///< Record alignment
+        static const size_t c_nHeaderSize = sizeof( record_header ) ;       ///< Size of record header
+
+    protected:
+        //@cond
+        char *          m_pBuffer       ;
+        size_t const    m_nBufferMask   ;
+
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posReserve ;   // producers
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posRelease ;   // consumer
+        size_t          m_nReadSize     ;   // size of the record returned by read()
+        //@endcond
+
+    public:
+        /// Constructs the ring of \p nCapacity bytes
+        /**
+            The capacity is rounded up to the power of two and is at least 2 cache lines.
+        */
+        byte_ring( size_t nCapacity )
+            : m_nBufferMask( calc_capacity( nCapacity ) - 1 )
+            , m_nReadSize( 0 )
+        {
+            m_pBuffer = reinterpret_cast<char *>( cds::OS::aligned_malloc( capacity(), c_nCacheLineSize ))  ;
+            memset( m_pBuffer, 0, capacity() )  ;
+            m_posReserve.store<membar_relaxed>( 0 ) ;
+            m_posRelease.store<membar_release>( 0 ) ;
+        }
+
+        ~byte_ring()
+        {
+            cds::OS::aligned_free( m_pBuffer )  ;
+        }
+
+        /// Reserves the space for the message of \p nLength bytes
+        /**
+            Returns the pointer to \p nLength bytes inside the ring, or \p NULL if the ring has not enough
+            free space. The pointer is aligned at least by 16 bytes. The producer must call \ref commit
+            for the pointer returned; the record is invisible for the consumer until it is committed.
+
+            In the MPSC ring the producer may hold several uncommitted records.
+        */
+        void * reserve( size_t nLength )
+        {
+            size_t const nCapacity = capacity() ;
+            size_t const nSize = record_size( nLength )  ;
+            if ( nSize > nCapacity )
+                return NULL ;
+
+            size_t pos = m_posReserve.load<membar_relaxed>()  ;
+            size_t nPadding ;
+            for (;;) {
+                size_t nOffset = pos & m_nBufferMask   ;
+                nPadding = nOffset + nSize > nCapacity ? nCapacity - nOffset : 0  ;
+
+                if ( pos + nPadding + nSize - m_posRelease.load<membar_acquire>() > nCapacity )
+                    return NULL ;   // no free space
+
+                if ( !c_bMultipleProducers ) {
+                    m_posReserve.store<membar_relaxed>( pos + nPadding + nSize ) ;
+                    break   ;
+                }
+                size_t nCur = m_posReserve.vcas<membar_relaxed>( pos, pos + nPadding + nSize )   ;
+                if ( nCur == pos )
+                    break   ;
+                pos = nCur  ;
+            }
+
+            if ( nPadding ) {
+                // The padding record up to the end of the buffer is committed immediately
+                header( pos )->m_nTag.template store<membar_release>( nPadding | c_nPadding | c_nCommitted ) ;
+                pos += nPadding ;
+            }
+
+            record_header * pHeader = header( pos ) ;
+            pHeader->m_nLength = nLength    ;
+            return pHeader + 1  ;
+        }
+
+        /// Publishes the record \p pRecord returned by \ref reserve
+        void commit( void * pRecord )
+        {
+            record_header * pHeader = reinterpret_cast<record_header *>( pRecord ) - 1 ;
+            pHeader->m_nTag.template store<membar_release>( record_size( pHeader->m_nLength ) | c_nCommitted )  ;
+        }
+
+        /// Returns the next committed record. Consumer only
+        /**
+            Returns the pointer to the message and its length in \p nLength, or \p NULL if the next record
+            is not committed yet. The record stays in the ring until \ref release is called, the next call of
+            \ref read before \ref release returns the same record.
+        */
+        void * read( size_t& nLength )
+        {
+            for (;;) {
+                size_t pos = m_posRelease.load<membar_relaxed>()  ;
+                record_header * pHeader = header( pos ) ;
+                size_t nTag = pHeader->m_nTag.template load<membar_acquire>()   ;
+                if ( !(nTag & c_nCommitted) )
+                    return NULL ;
+
+                if ( nTag & c_nPadding ) {
+                    release_record( pos, nTag & ~c_nFlagMask )  ;
+                    continue    ;
+                }
+
+                m_nReadSize = nTag & ~c_nFlagMask   ;
+                nLength = pHeader->m_nLength    ;
+                return pHeader + 1  ;
+            }
+        }
+
+        /// Releases the record returned by last \ref read. Consumer only
+        void release()
+        {
+            assert( m_nReadSize != 0 )  ;
+            release_record( m_posRelease.load<membar_relaxed>(), m_nReadSize )  ;
+            m_nReadSize = 0 ;
+        }
+
+        /// Checks if the ring has no committed record. Consumer only
+        bool empty()
+        {
+            size_t nLength  ;
+            return read( nLength ) == NULL  ;
+        }
+
+        /// Returns the ring capacity in bytes
+        size_t capacity() const
+        {
+            return m_nBufferMask + 1    ;
+        }
+
+        /// Returns the size of the record (with header and alignment) for the message of \p nLength bytes
+        static size_t record_size( size_t nLength )
+        {
+            return (c_nHeaderSize + nLength + c_nRecordAlignment - 1) & ~(c_nRecordAlignment - 1)  ;
+        }
+
+    protected:
+        //@cond
+        static size_t calc_capacity( size_t nCapacity )
+        {
+            size_t nPow2 = 2 * c_nRecordAlignment   ;
+            while ( nPow2 < nCapacity )
+                nPow2 <<= 1 ;
+            return nPow2    ;
+        }
+
+        record_header * header( size_t pos ) const
+        {
+            return reinterpret_cast<record_header *>( m_pBuffer + (pos & m_nBufferMask) )  ;
+        }
+
+        void release_record( size_t pos, size_t nSize )
+        {
+            // Clear the possible header place in each cache line of the record
+            for ( size_t nOffset = 0; nOffset < nSize; nOffset += c_nRecordAlignment )
+                header( pos + nOffset )->m_nTag.template store<membar_relaxed>( 0 )  ;
+            m_posRelease.store<membar_release>( pos + nSize )   ;
+        }
+        //@endcond
+    };
+
+    /// Single-producer single-consumer byte ring, see \ref byte_ring
+    typedef byte_ring<false>    spsc_byte_ring  ;
+
+    /// Multi-producer single-consumer byte ring, see \ref byte_ring
+    typedef byte_ring<true>     mpsc_byte_ring  ;
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_BYTE_RING_H
@@ -163,9 +163,16 @@ namespace cds { namespace queue { namespace details {
         dummyNode_allocator     m_DummyNodeAllocator    ;   ///< Dummy node allocator
 
         protected:
-            /// Allocates new regular node from the heap
+            /// Allocates new regular node from the node cache of current thread or from the heap
             node_type * allocNode( const value_type& data )
             {
+                void * p = type_traits::node_cache::alloc()   ;
+                if ( p ) {
+                    m_Stat.onNodeCacheHit() ;
+                    return base_class::m_NodeAllocator.Construct( p, data ) ;
+                }
+                if ( type_traits::node_cache::c_bEnabled )
+                    m_Stat.onNodeCacheMiss()    ;
                 return base_class::allocNode( data ) ;
             }
 
@@ -219,18 +226,21 @@ namespace cds { namespace queue { namespace details {
                 pCurNode = pTail        ;
                 while ( (pHead == m_pHead.load<membar_acquire>()) && (pCurNode != pHead) ) { // While not at head
                     while ( true ) {
-                        hp[0] = pCurNodeNext = pCurNode->next<membar_relaxed>() ;
+                        pCurNodeNext = pCurNode->next<membar_relaxed>() ;
+                        hp.set( 0, pCurNodeNext )   ;
                         if ( pCurNodeNext == pCurNode->next<membar_acquire>() )
                             break   ;
                     }
                     while ( true ) {
-                        hp[1] = pNextNodePrev = pCurNodeNext->prev<membar_relaxed>()   ;
+                        pNextNodePrev = pCurNodeNext->prev<membar_relaxed>()   ;
+                        hp.set( 1, pNextNodePrev )   ;
                         if ( pNextNodePrev == pCurNodeNext->prev<membar_acquire>() )
                             break   ;
                     }
                     if ( pNextNodePrev != pCurNode )            // Ptr dont equal?
                         pCurNodeNext->prev<membar_release>( pCurNode )     ;    // Fix
-                    hp[2] = pCurNode = pCurNodeNext        ;    // Advance curNode
+                    pCurNode = pCurNodeNext        ;    // Advance curNode
+                    hp.set( 2, pCurNode )   ;
                 }
             }
 
@@ -293,8 +303,10 @@ namespace cds { namespace queue { namespace details {
 
             while ( true ) { // Try till success or empty
                 while ( true ) {
-                    hpArr[0] = pHead = m_pHead.load<membar_relaxed>() ;    // Read the head
-                    hpArr[1] = pTail = m_pTail.load<membar_relaxed>() ;    // Read the tail
+                    pHead = m_pHead.load<membar_relaxed>() ;    // Read the head
+                    hpArr.set( 0, pHead )   ;
+                    pTail = m_pTail.load<membar_relaxed>() ;    // Read the tail
+                    hpArr.set( 1, pTail )   ;
                     if ( pHead == m_pHead.load<membar_acquire>() && pTail == m_pTail.load<membar_acquire>() )
                         break;
                 }
@@ -302,7 +314,8 @@ namespace cds { namespace queue { namespace details {
 
                 if ( pHead == m_pHead.load<membar_acquire>() && pTail == m_pTail.load<membar_acquire>() ) { // Check consistency
                     if ( !pHead->isDummy() ) { // Head is dummy?
-                        hpArr[2] = pFirstNodePrev = pHead->prev<membar_relaxed>() ; // Read first node prev
+                        pFirstNodePrev = pHead->prev<membar_relaxed>() ; // Read first node prev
+                        hpArr.set( 2, pFirstNodePrev )   ;
                         if ( pFirstNodePrev != pHead->prev<membar_acquire>() )
                             continue ;
 
@@ -336,7 +349,8 @@ namespace cds { namespace queue { namespace details {
                             return false    ;               // Empty queue, done!
                         }
                         else {                              // Need to skip dummy
-                            hpArr[2] = pFirstNodePrev = pHead->prev<membar_relaxed>() ; // Read first node prev
+                            pFirstNodePrev = pHead->prev<membar_relaxed>() ; // Read first node prev
+                            hpArr.set( 2, pFirstNodePrev )   ;
                             if ( pFirstNodePrev != pHead->prev<membar_acquire>() )
                                 continue ;
 
@@ -17,6 +17,7 @@
 */
 
 #include <cds/queue/moir_queue.h>
+#include <cds/queue/details/msqueue_hp_impl.h>
 
 //@cond
 namespace cds { namespace queue { namespace details {
@@ -49,15 +50,14 @@ namespace cds { namespace queue { namespace details {
             node_type * pNext    ;
             node_type * h        ;
             while ( true ) {
-                h = base_class::m_pHead.template load<membar_relaxed>()  ;
-                hpArr[0] = h    ;
+                h = guarded_load<gc_schema>::load( hpArr[0], base_class::m_pHead ) ;
                 if ( base_class::m_pHead.template load<membar_acquire>() != h ) {
                     bkoff()    ;
                     continue    ;
                 }
 
                 pNext = h->m_pNext.template load<membar_acquire>()   ;
-                hpArr[1] = pNext    ;
+                guarded_load<gc_schema>::publish( hpArr[1], pNext ) ;
                 if ( base_class::m_pHead.template load<membar_acquire>() != h )
                     continue    ;
 
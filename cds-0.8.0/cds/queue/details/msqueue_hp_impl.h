@@ -27,6 +27,32 @@ namespace cds { namespace queue { namespace details {
         class ALLOCATOR
     > class msqueue_adapter ;
 
+    /// Loads the pointer from shared root \p src and assigns it to the guard \p g
+    /**
+        The caller validates the pointer by reloading \p src; that is enough for the schemas
+        that guard the pointer itself. The schema that guards the pointer in other way specializes the template
+        (see msqueue_ibr.h). \p publish assigns the pointer that the caller validates by reloading
+        its source; the schema that needs a fence between the assignment and the reload
+        specializes it (see msqueue_hzp.h).
+    */
+    template <typename GC>
+    struct guarded_load
+    {
+        template <typename GUARD, typename T>
+        static T * load( GUARD& g, atomic<T *>& src )
+        {
+            T * p = src.template load<membar_relaxed>() ;
+            return publish( g, p )  ;
+        }
+
+        template <typename GUARD, typename T>
+        static T * publish( GUARD& g, T * p )
+        {
+            g = p   ;
+            return p    ;
+        }
+    };
+
     template < typename ADAPTER >
     class msqueue_implementation: public ADAPTER::container_base
     {
@@ -49,6 +75,19 @@ namespace cds { namespace queue { namespace details {
         typename type_traits::item_counter_type m_ItemCounter   ;
         typename type_traits::statistics        m_Stat          ;
 
+    protected:
+        node_type * allocNode( const value_type& data )
+        {
+            void * p = type_traits::node_cache::alloc()   ;
+            if ( p ) {
+                m_Stat.onNodeCacheHit() ;
+                return base_class::m_NodeAllocator.Construct( p, data ) ;
+            }
+            if ( type_traits::node_cache::c_bEnabled )
+                m_Stat.onNodeCacheMiss()    ;
+            return base_class::allocNode( data )    ;
+        }
+
     public:
         msqueue_implementation()
         {
@@ -86,12 +125,12 @@ namespace cds { namespace queue { namespace details {
         {
             guard grd( base_class::getGC() )  ;
 
-            node_type * pNew = base_class::allocNode( data )    ;
+            node_type * pNew = allocNode( data )    ;
             typename type_traits::backoff_strategy bkoff ;
 
             node_type * t    ;
             while ( true ) {
-                grd = t = m_pTail.template load<membar_relaxed>()   ;
+                t = guarded_load<gc_schema>::load( grd, m_pTail ) ;
                 if ( m_pTail.template load<membar_acquire>() != t ) {
                     bkoff()    ;
                     continue    ;
@@ -125,8 +164,7 @@ namespace cds { namespace queue { namespace details {
             typename type_traits::backoff_strategy bkoff    ;
 
             while ( true ) {
-                h = m_pHead.template load<membar_relaxed>()    ;
-                hpArr[0] = h    ;
+                h = guarded_load<gc_schema>::load( hpArr[0], m_pHead ) ;
                 if ( m_pHead.template load<membar_acquire>() != h ) {
                     bkoff()    ;
                     continue    ;
@@ -134,7 +172,7 @@ namespace cds { namespace queue { namespace details {
 
                 node_type * t = m_pTail.template load<membar_acquire>() ;
                 pNext = h->m_pNext.template load<membar_acquire>() ;
-                hpArr[1] = pNext    ;
+                guarded_load<gc_schema>::publish( hpArr[1], pNext ) ;
                 if ( m_pHead.template load<membar_acquire>() != h )
                     continue    ;
 
@@ -161,6 +199,133 @@ namespace cds { namespace queue { namespace details {
             return true    ;
         }
 
+        template <typename ITERATOR>
+        size_t enqueue_batch( ITERATOR itFirst, ITERATOR itLast )
+        {
+            if ( itFirst == itLast )
+                return 0    ;
+
+            // Build the chain privately; it becomes visible by one CAS on t->m_pNext
+            node_type * pFirst = allocNode( *itFirst )  ;
+            node_type * pLast = pFirst  ;
+            size_t nCount = 1   ;
+            for ( ++itFirst; itFirst != itLast; ++itFirst, ++nCount ) {
+                node_type * pNode = allocNode( *itFirst )   ;
+                pLast->m_pNext.template store<membar_relaxed>( pNode )  ;
+                pLast = pNode   ;
+            }
+
+            guard grd( base_class::getGC() )  ;
+            typename type_traits::backoff_strategy bkoff ;
+
+            node_type * t    ;
+            while ( true ) {
+                t = guarded_load<gc_schema>::load( grd, m_pTail ) ;
+                if ( m_pTail.template load<membar_acquire>() != t ) {
+                    bkoff()    ;
+                    continue    ;
+                }
+                node_type * pNext = t->m_pNext.template load<membar_acquire>()  ;
+                if ( pNext != NULL ) {
+                    // Tail is misplaced, advance it
+                    m_pTail.template cas<membar_release>( t, pNext ) ;
+                    m_Stat.onBadTail()    ;
+                    continue    ;
+                }
+                if ( t->m_pNext.template cas<membar_release>( reinterpret_cast<node_type *>(NULL), pFirst ))
+                    break    ;
+                m_Stat.onEnqueueRace()    ;
+                bkoff()    ;
+            }
+            m_ItemCounter += nCount    ;
+            m_Stat.onEnqueueBatch( nCount ) ;
+
+            // If this CAS fails the other threads will advance the tail up to pLast by the "bad tail" path
+            if ( !m_pTail.template cas<membar_acq_rel>( t, pLast ))
+                m_Stat.onAdvanceTailFailed() ;
+            return nCount ;
+        }
+
+        template <typename OUTPUT_ITERATOR>
+        size_t dequeue_batch( OUTPUT_ITERATOR itOut, size_t nMax )
+        {
+            if ( nMax == 0 )
+                return 0    ;
+
+            // hpArr[0] guards the head, hpArr[1] and hpArr[2] alternately guard the walk
+            typename guard_array::template rebind<3>::other   hpArr( base_class::getGC() )    ;
+
+            node_type * h        ;
+            node_type * pLast    ;
+            size_t      nCount   ;
+            typename type_traits::backoff_strategy bkoff    ;
+
+            while ( true ) {
+                h = guarded_load<gc_schema>::load( hpArr[0], m_pHead ) ;
+                if ( m_pHead.template load<membar_acquire>() != h ) {
+                    bkoff()    ;
+                    continue    ;
+                }
+
+                node_type * t = m_pTail.template load<membar_acquire>() ;
+                if ( h == t ) {
+                    node_type * pNext = h->m_pNext.template load<membar_acquire>() ;
+                    if ( m_pHead.template load<membar_acquire>() != h )
+                        continue    ;
+                    if ( pNext == NULL )
+                        return 0    ;    // empty queue
+
+                    // It is needed to help enqueue
+                    m_Stat.onBadTail()            ;
+                    m_pTail.template cas<membar_release>( t, pNext ) ;
+                    continue    ;
+                }
+
+                // Walk from h up to nMax items but never beyond t
+                pLast = h       ;
+                nCount = 0      ;
+                size_t nGuard = 1   ;
+                bool bRestart = false   ;
+                while ( nCount < nMax && pLast != t ) {
+                    node_type * pNext = pLast->m_pNext.template load<membar_acquire>() ;
+                    guarded_load<gc_schema>::publish( hpArr[nGuard], pNext ) ;
+                    if ( m_pHead.template load<membar_acquire>() != h || pNext == NULL ) {
+                        // The head is changed or the tail is behind the head (transient state of MoirQueue)
+                        bRestart = true ;
+                        break   ;
+                    }
+                    pLast = pNext   ;
+                    nGuard = 3 - nGuard ;
+                    ++nCount    ;
+                }
+                if ( bRestart ) {
+                    bkoff() ;
+                    continue    ;
+                }
+
+                if ( m_pHead.template cas<membar_release>( h, pLast ))
+                    break    ;
+
+                m_Stat.onDequeueRace()    ;
+                bkoff()    ;
+            }
+
+            m_ItemCounter -= nCount     ;
+            m_Stat.onDequeueBatch( nCount ) ;
+
+            // Nodes from h up to pLast (exclusive) are unreachable now and owned by current thread.
+            // pLast is the new dummy node and it is still guarded
+            node_type * p = h   ;
+            for ( size_t i = 0; i < nCount; ++i ) {
+                node_type * pNext = p->m_pNext.template load<membar_relaxed>()  ;
+                *itOut = pNext->m_data  ;
+                ++itOut ;
+                hpArr.getGC().retirePtr( p, type_traits::node_deleter_functor::free ) ;
+                p = pNext   ;
+            }
+            return nCount   ;
+        }
+
         bool push( const value_type& data )
         {
             return enqueue( data );
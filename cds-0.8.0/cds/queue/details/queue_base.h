@@ -79,8 +79,31 @@
     In any cases, \c size()==0 is not equal to \c empty()==true. The \c empty method is the more reliable way
     to check if the queue is empty.
 
-*/
+    \par Optional batch interface
+
+    Some queues (for example, \ref cds::queue::MSQueue "MSQueue" and \ref cds::queue::MoirQueue "MoirQueue")
+    support the batch operations. A batch is linked privately and is published by a single CAS
+    on the tail (for enqueue) or on the head (for dequeue), so the cost of the contended CAS
+    is amortized over the whole batch.
+
+\member{enqueue_batch}
+\code
+    template <typename ITERATOR>
+    size_t enqueue_batch( ITERATOR itFirst, ITERATOR itLast )
+\endcode
+        Places the items of range <tt>[itFirst, itLast)</tt> into the queue. The items of the batch
+        are placed contiguously and in range order, no other item can be interleaved with them.
+        \return count of enqueued items
 
+\member{dequeue_batch}
+\code
+    template <typename OUTPUT_ITERATOR>
+    size_t dequeue_batch( OUTPUT_ITERATOR itOut, size_t nMax )
+\endcode
+        Dequeues up to \a nMax items from the queue to output iterator \a itOut.
+        \return count of dequeued items, 0 if the queue is empty
+
+*/
 
 namespace cds {
 
@@ -98,6 +121,14 @@ namespace queue {
         atomics::event_counter    m_DequeueRace    ;    ///< Count of dequeue race conditions encountered
         atomics::event_counter    m_AdvanceTailError;    ///< Count of "advance tail failed" events
         atomics::event_counter    m_BadTail        ;    ///< Count of events "Tail is not pointed to the last item in the queue"
+        atomics::event_counter    m_EnqueueBatchCount;  ///< Enqueue batch call count
+        atomics::event_counter    m_DequeueBatchCount;  ///< Dequeue batch call count (only non-empty batches)
+        atomics::event_counter    m_NodeCacheHit    ;   ///< Count of nodes allocated from per-thread node cache
+        atomics::event_counter    m_NodeCacheMiss   ;   ///< Count of nodes allocated from the heap when the node cache is empty
+        atomics::event_counter    m_DequeueSteal    ;   ///< Count of items dequeued from non-local shard (sharded queues only)
+        atomics::event_counter    m_ParkCount       ;   ///< Count of waits that ended spinning and parked the thread (dual queues only)
+        atomics::event_counter    m_ModeUpgrade     ;   ///< Count of switches from single-thread to shared mode (adaptive queues only)
+        atomics::event_counter    m_ModeDowngrade   ;   ///< Count of switches from shared to single-thread mode (adaptive queues only)
 
         /// Register enqueue call
         void onEnqueue()                { ++m_EnqueueCount; }
@@ -111,6 +142,22 @@ namespace queue {
         void onAdvanceTailFailed()        { ++m_AdvanceTailError; }
         /// Register event "Tail is not pointed to last item in the queue"
         void onBadTail()                { ++m_BadTail; }
+        /// Register enqueue batch call of \p nCount items
+        void onEnqueueBatch( size_t nCount )    { ++m_EnqueueBatchCount; m_EnqueueCount += nCount; }
+        /// Register dequeue batch call of \p nCount items
+        void onDequeueBatch( size_t nCount )    { ++m_DequeueBatchCount; m_DequeueCount += nCount; }
+        /// Register node allocation from the node cache
+        void onNodeCacheHit()           { ++m_NodeCacheHit; }
+        /// Register node allocation from the heap when the node cache is empty
+        void onNodeCacheMiss()          { ++m_NodeCacheMiss; }
+        /// Register dequeue from non-local shard
+        void onDequeueSteal()           { ++m_DequeueSteal; }
+        /// Register parking of waiting thread
+        void onPark()                   { ++m_ParkCount; }
+        /// Register switch of producer or consumer side to shared mode
+        void onModeUpgrade()            { ++m_ModeUpgrade; }
+        /// Register switch of producer or consumer side to single-thread mode
+        void onModeDowngrade()          { ++m_ModeDowngrade; }
     };
 
     /// Empty queue statistics - does nothing. Support interface like as queue_statistics
@@ -122,6 +169,36 @@ namespace queue {
         void onDequeueRace()            {}
         void onAdvanceTailFailed()        {}
         void onBadTail()                {}
+        void onEnqueueBatch( size_t )   {}
+        void onDequeueBatch( size_t )   {}
+        void onNodeCacheHit()           {}
+        void onNodeCacheMiss()          {}
+        void onDequeueSteal()           {}
+        void onPark()                   {}
+        void onModeUpgrade()            {}
+        void onModeDowngrade()          {}
+        //@endcond
+    };
+
+    /// No node cache (default node cache policy)
+    /**
+        Each node is allocated from the node allocator and is freed by the node deleter of the queue.
+        See also \ref thread_node_cache.
+    */
+    struct no_node_cache {
+        //@cond
+        template <typename NODE, typename DELETER>
+        struct rebind {
+            struct other: public DELETER
+            {
+                static const bool c_bEnabled = false    ;
+
+                static void * alloc()
+                {
+                    return NULL ;
+                }
+            };
+        };
         //@endcond
     };
 
@@ -132,6 +209,7 @@ namespace queue {
         typedef atomics::empty_item_counter    item_counter_type    ;    ///< Item counter implementation. Default is atomics::empty_item_counter
         typedef dummy_statistics    statistics            ;    ///< Internal statistics implementation, default is empty (no statistics)
         typedef void                free_list_type        ;    ///< FreeList implementation (only for queues based on gc::tagged memory reclamation schema)
+        typedef void                node_cache_type       ;    ///< Node cache policy (only for queues based on gc::hzp_gc, gc::ptb_gc and gc::epoch_gc), default is no_node_cache
 
         /// Node deletion function
         /**
@@ -170,6 +248,12 @@ namespace queue {
             typename original::backoff_strategy,
             cds::backoff::empty
         >::type        backoff_strategy    ;
+
+        /// Node cache policy. Default is no_node_cache
+        typedef typename cds::details::void_selector<
+            typename original::node_cache_type,
+            no_node_cache
+        >::type        node_cache_type    ;
     } ;
     //@endcond
 
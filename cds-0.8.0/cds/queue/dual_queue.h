@@ -0,0 +1,400 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_DUAL_QUEUE_H
+#define __CDS_QUEUE_DUAL_QUEUE_H
+
+#include <cds/queue/details/queue_base.h>
+#include <cds/gc/hzp/hp_object.h>
+#include <cds/details/aligned_type.h>
+#include <cds/user_setup/cache_line.h>
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#   include <linux/futex.h>
+#   include <limits.h>
+#endif
+
+namespace cds { namespace queue {
+
+    //@cond
+    namespace details {
+        template <typename T>
+        struct dual_queue_node {
+            atomic<dual_queue_node *>   m_pNext     ;
+            atomic<int>                 m_nState    ;   // see dual_queue::c_nWaiting etc.
+            atomic<int>                 m_nParked   ;   // the owner thread is parked or is going to park
+            bool                        m_bIsData   ;
+            T                           m_data      ;
+
+            dual_queue_node()
+                : m_pNext( NULL )
+                , m_nState( 0 )
+                , m_nParked( 0 )
+                , m_bIsData( false )
+            {}
+
+            dual_queue_node( const T& data )
+                : m_pNext( NULL )
+                , m_nState( 0 )
+                , m_nParked( 0 )
+                , m_bIsData( true )
+                , m_data( data )
+            {}
+        };
+
+        /// Blocks current thread while \p nState == \p nExpected or until spurious wake-up
+        static inline void dual_queue_park( atomic<int>& nState, int nExpected )
+        {
+#       if CDS_OS_TYPE == CDS_OS_LINUX
+            ::syscall( SYS_futex, reinterpret_cast<int volatile *>( &nState ), FUTEX_WAIT_PRIVATE, nExpected, NULL, NULL, 0 ) ;
+#       else
+            if ( nState.load<membar_acquire>() == nExpected )
+                OS::yield() ;
+#       endif
+        }
+
+        /// Wakes all threads parked on \p nState
+        static inline void dual_queue_unpark( atomic<int>& nState )
+        {
+#       if CDS_OS_TYPE == CDS_OS_LINUX
+            ::syscall( SYS_futex, reinterpret_cast<int volatile *>( &nState ), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0 ) ;
+#       endif
+        }
+    }   // namespace details
+    //@endcond
+
+    /// Lock-free dual queue with transfer semantics (Hazard Pointer GC)
+    /**
+        \par Source:
+            \li [2004] William N. Scherer III, Michael L. Scott "Nonblocking Concurrent Data Structures with Condition Synchronization"
+            \li [2009] William N. Scherer III, Doug Lea, Michael L. Scott "Scalable Synchronous Queues"
+
+        The dual queue is Michael & Scott queue that can contain either data nodes or request nodes
+        of waiting consumers (reservations). A consumer that finds no data appends the request node and
+        waits; a producer that finds a request hands its item directly to the waiting consumer.
+        The queue is a C++ counterpart of Java's \p LinkedTransferQueue:
+        \li \ref enqueue (\ref push, \ref put) - appends the item, never blocks (Java \p add)
+        \li \ref transfer - appends the item and waits until a consumer receives it
+        \li \ref tryTransfer - hands the item to a waiting consumer if any, never blocks
+        \li \ref take - receives an item, waits if the queue has no data
+        \li \ref poll (\ref dequeue, \ref pop) - receives an item if any, never blocks
+
+        A waiting thread spins \p c_nSpinCount times and then parks (Linux futex; on other systems
+        the thread yields). The nodes are reclaimed by Hazard Pointer GC, so each thread that uses
+        the queue must be attached to cds::gc::hzp_gc. The operations use 3 hazard pointers.
+        The queue must not be destroyed while a thread waits in \ref take or \ref transfer.
+
+        Template parameters:
+            \li \p T - type of item stored in queue
+            \li \p TRAITS - traits class, see cds::queue::traits. The \p node_cache_type is not supported.
+            \li \p ALLOCATOR - node allocator
+    */
+    template <typename T, class TRAITS = traits, class ALLOCATOR = CDS_DEFAULT_ALLOCATOR>
+    class dual_queue: public gc::hzp::Container< details::dual_queue_node<T>, ALLOCATOR >
+    {
+        //@cond
+        typedef gc::hzp::Container< details::dual_queue_node<T>, ALLOCATOR >   base_class  ;
+        //@endcond
+    public:
+        typedef gc::hzp_gc  gc_schema   ;   ///< Garbage collector
+        typedef T           value_type  ;   ///< Item type
+        typedef normalized_type_traits<TRAITS>  type_traits ;   ///< Normalized traits
+
+        static const unsigned int c_nSpinCount = 1024 ;  ///< Spin iteration count before the waiting thread parks
+
+    protected:
+        //@cond
+        typedef typename base_class::Node       node_type   ;
+        typedef gc::hzp::AutoHPArray<3>         guard_array ;
+
+        // Node state
+        static const int c_nWaiting = 0 ;   // unmatched: data node holds the item, request node waits for an item
+        static const int c_nClaimed = 1 ;   // a producer is writing the item into the request node
+        static const int c_nMatched = 2 ;   // the item is received
+
+        // How xfer waits
+        enum xfer_mode {
+            xfer_now,       // fail if no complementary node
+            xfer_async,     // append and return (data only)
+            xfer_sync       // append and wait until matched
+        };
+
+        typedef typename cds::details::aligned_type< atomic<node_type *>, c_nCacheLineSize >::type  aligned_node_ptr ;
+        aligned_node_ptr m_pHead ;
+        aligned_node_ptr m_pTail ;
+
+        typename type_traits::item_counter_type m_ItemCounter   ;
+        typename type_traits::statistics        m_Stat          ;
+        //@endcond
+
+    public:
+        /// Constructs empty queue
+        dual_queue()
+        {
+            node_type * pNode = base_class::allocNode() ;
+            pNode->m_nState.template store<membar_relaxed>( c_nMatched )  ;
+            m_pHead.template store<membar_relaxed>( pNode ) ;
+            m_pTail.template store<membar_release>( pNode ) ;
+        }
+
+        /// Destroys the queue. No thread may wait in the queue
+        ~dual_queue()
+        {
+            node_type * p = m_pHead.template load<membar_relaxed>() ;
+            while ( p ) {
+                node_type * pNext = p->m_pNext.template load<membar_relaxed>()  ;
+                base_class::getGC().retirePtr( p, base_class::deferral_node_deleter::free ) ;
+                p = pNext   ;
+            }
+            m_pHead.template store<membar_relaxed>( reinterpret_cast<node_type *>(NULL) )   ;
+            m_pTail.template store<membar_relaxed>( reinterpret_cast<node_type *>(NULL) )   ;
+        }
+
+        /// Appends \p data to the queue, or hands it to a waiting consumer. Never blocks, always returns \p true
+        bool enqueue( const value_type& data )
+        {
+            return xfer( const_cast<value_type *>( &data ), true, xfer_async ) ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool push( const value_type& data )
+        {
+            return enqueue( data )  ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool put( const value_type& data )
+        {
+            return enqueue( data )  ;
+        }
+
+        /// Transfers \p data to a consumer, waits until it is received
+        void transfer( const value_type& data )
+        {
+            xfer( const_cast<value_type *>( &data ), true, xfer_sync )  ;
+        }
+
+        /// Transfers \p data to a waiting consumer if any. Returns \p false if no consumer is waiting
+        bool tryTransfer( const value_type& data )
+        {
+            return xfer( const_cast<value_type *>( &data ), true, xfer_now )    ;
+        }
+
+        /// Receives an item into \p dest, waits until an item is available
+        void take( value_type& dest )
+        {
+            xfer( &dest, false, xfer_sync ) ;
+        }
+
+        /// Receives an item into \p dest if any. Returns \p false if the queue has no item
+        bool poll( value_type& dest )
+        {
+            return xfer( &dest, false, xfer_now )   ;
+        }
+
+        /// Synonym for \ref poll
+        bool dequeue( value_type& dest )
+        {
+            return poll( dest ) ;
+        }
+
+        /// Synonym for \ref poll
+        bool pop( value_type& dest )
+        {
+            return poll( dest ) ;
+        }
+
+        /// Checks if the queue has no item to receive
+        bool empty() const
+        {
+            typename guard_array::template rebind<2>::other hpArr( base_class::getGC() )    ;
+            for (;;) {
+                node_type * h = m_pHead.template load<membar_relaxed>() ;
+                hpArr.set( 0, h )   ;
+                if ( m_pHead.template load<membar_acquire>() != h )
+                    continue    ;
+
+                node_type * p = h   ;
+                size_t nGuard = 1   ;
+                for (;;) {
+                    node_type * pNext = p->m_pNext.template load<membar_acquire>()  ;
+                    hpArr.set( nGuard, pNext )  ;
+                    if ( m_pHead.template load<membar_acquire>() != h )
+                        break   ;   // restart
+                    if ( pNext == NULL )
+                        return true ;
+                    if ( pNext->m_nState.template load<membar_acquire>() == c_nWaiting )
+                        return !pNext->m_bIsData    ;
+                    // p and its successor are guarded by alternate hazard pointers
+                    p = pNext   ;
+                    nGuard = 1 - nGuard ;
+                }
+            }
+        }
+
+        /// Returns the item count, see \p item_counter_type of the traits
+        size_t size() const
+        {
+            return m_ItemCounter.value()    ;
+        }
+
+        /// Removes all items from the queue. Returns the count of removed items
+        size_t clear()
+        {
+            return generic_clear( *this )   ;
+        }
+
+        /// Returns internal statistics
+        const typename type_traits::statistics& getStatistics() const
+        {
+            return m_Stat   ;
+        }
+
+    protected:
+        //@cond
+        bool xfer( value_type * pData, bool bIsData, xfer_mode nMode )
+        {
+            assert( bIsData || nMode != xfer_async )    ;
+
+            // hpArr[0] guards the head, hpArr[1] guards the tail or the node being matched, hpArr[2] guards own node
+            guard_array hpArr( base_class::getGC() )    ;
+            node_type * pNode = NULL    ;
+            typename type_traits::backoff_strategy bkoff ;
+
+            for (;;) {
+                node_type * h = m_pHead.template load<membar_relaxed>() ;
+                hpArr.set( 0, h )   ;
+                if ( m_pHead.template load<membar_acquire>() != h )
+                    continue    ;
+                node_type * t = m_pTail.template load<membar_relaxed>() ;
+                hpArr.set( 1, t )   ;
+                if ( m_pTail.template load<membar_acquire>() != t )
+                    continue    ;
+
+                if ( h == t || t->m_bIsData == bIsData ) {
+                    // The queue is empty or contains the nodes of the same mode: append own node
+                    node_type * pNext = t->m_pNext.template load<membar_acquire>()  ;
+                    if ( m_pTail.template load<membar_acquire>() != t )
+                        continue    ;
+                    if ( pNext != NULL ) {
+                        // Tail is misplaced, advance it
+                        m_pTail.template cas<membar_release>( t, pNext ) ;
+                        m_Stat.onBadTail()  ;
+                        continue    ;
+                    }
+                    if ( nMode == xfer_now ) {
+                        if ( pNode )
+                            base_class::freeNode( pNode )   ;
+                        return false    ;
+                    }
+
+                    if ( !pNode ) {
+                        pNode = bIsData ? base_class::allocNode( *pData ) : base_class::allocNode() ;
+                        hpArr[2] = pNode    ;
+                    }
+                    if ( !t->m_pNext.template cas<membar_release>( reinterpret_cast<node_type *>(NULL), pNode )) {
+                        m_Stat.onEnqueueRace()  ;
+                        bkoff() ;
+                        continue    ;
+                    }
+                    if ( !m_pTail.template cas<membar_acq_rel>( t, pNode ))
+                        m_Stat.onAdvanceTailFailed()    ;
+
+                    if ( bIsData ) {
+                        ++m_ItemCounter ;
+                        m_Stat.onEnqueue()  ;
+                        if ( nMode == xfer_async )
+                            return true ;
+                    }
+
+                    // The node is guarded by hpArr[2] while waiting
+                    await( pNode )  ;
+                    if ( !bIsData ) {
+                        *pData = pNode->m_data  ;
+                        m_Stat.onDequeue()  ;
+                    }
+                    return true ;
+                }
+
+                // The queue contains complementary nodes: match the first one
+                node_type * pMatch = h->m_pNext.template load<membar_acquire>()  ;
+                hpArr.set( 1, pMatch )  ;
+                if ( m_pHead.template load<membar_acquire>() != h || pMatch == NULL )
+                    continue    ;
+
+                bool bMatched   ;
+                if ( bIsData ) {
+                    // pMatch is the request of a waiting consumer
+                    bMatched = pMatch->m_nState.template cas<membar_acquire>( c_nWaiting, c_nClaimed ) ;
+                    if ( bMatched ) {
+                        pMatch->m_data = *pData ;
+                        wake( pMatch )  ;
+                        m_Stat.onEnqueue()  ;
+                    }
+                }
+                else {
+                    // pMatch holds the item
+                    bMatched = pMatch->m_nState.template cas<membar_acquire>( c_nWaiting, c_nClaimed ) ;
+                    if ( bMatched ) {
+                        *pData = pMatch->m_data ;
+                        wake( pMatch )  ;
+                        --m_ItemCounter ;
+                        m_Stat.onDequeue()  ;
+                    }
+                }
+
+                // pMatch is matched by this or other thread; it becomes the dummy node
+                if ( m_pHead.template cas<membar_release>( h, pMatch ))
+                    hpArr.getGC().retirePtr( h, base_class::deferral_node_deleter::free )  ;
+
+                if ( bMatched ) {
+                    if ( pNode )
+                        base_class::freeNode( pNode )   ;
+                    return true ;
+                }
+                m_Stat.onDequeueRace()  ;
+                bkoff() ;
+            }
+        }
+
+        // Marks the claimed node as matched and wakes its owner
+        void wake( node_type * pNode )
+        {
+            pNode->m_nState.template store<membar_seq_cst>( c_nMatched )  ;
+            if ( pNode->m_nParked.template load<membar_seq_cst>() )
+                details::dual_queue_unpark( pNode->m_nState )  ;
+        }
+
+        // Waits until own node is matched: spin, then park
+        void await( node_type * pNode )
+        {
+            for ( unsigned int i = 0; i < c_nSpinCount; ++i ) {
+                if ( pNode->m_nState.template load<membar_acquire>() == c_nMatched )
+                    return  ;
+                backoff::hint()()   ;
+            }
+
+            m_Stat.onPark() ;
+            pNode->m_nParked.template store<membar_seq_cst>( 1 )  ;
+            for (;;) {
+                int nState = pNode->m_nState.template load<membar_seq_cst>()   ;
+                if ( nState == c_nMatched )
+                    return  ;
+                details::dual_queue_park( pNode->m_nState, nState )    ;
+            }
+        }
+        //@endcond
+    };
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_DUAL_QUEUE_H
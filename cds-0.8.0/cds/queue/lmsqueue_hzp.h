@@ -40,9 +40,14 @@ namespace cds {
 
                 struct type_traits: public normalized_type_traits<TRAITS>
                 {
+                    typedef typename normalized_type_traits<TRAITS>::node_cache_type::template rebind<
+                        node_type,
+                        typename container_base::deferral_node_deleter
+                    >::other      node_cache  ;
+
                     typedef typename cds::details::void_selector<
                         typename normalized_type_traits<TRAITS>::original::node_deleter_functor,
-                        typename container_base::deferral_node_deleter
+                        node_cache
                     >::type       node_deleter_functor   ;
                 };
 
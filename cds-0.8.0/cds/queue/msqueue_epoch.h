@@ -0,0 +1,81 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_MSQUEUE_EPOCH_H
+#define __CDS_QUEUE_MSQUEUE_EPOCH_H
+
+/*
+    Michael & Scott lock-free queue algorithm based on epoch-based reclamation schema
+*/
+
+#include <cds/queue/details/msqueue_hp_impl.h>
+#include <cds/gc/epoch/container.h>
+
+namespace cds {
+    namespace queue {
+
+        //@cond
+        namespace details {
+
+            template <
+                typename T,
+                class TRAITS,
+                class ALLOCATOR
+            >
+            class msqueue_adapter<gc::epoch_gc, T, TRAITS, ALLOCATOR >
+            {
+            public:
+                typedef gc::epoch_gc  gc_schema   ;
+                typedef gc::epoch::Container<details::msqueue_node<T>, ALLOCATOR >    container_base  ;
+                typedef T   value_type  ;
+                typedef typename container_base::Node   node_type   ;
+
+                struct type_traits: public normalized_type_traits<TRAITS>
+                {
+                    typedef typename normalized_type_traits<TRAITS>::node_cache_type::template rebind<
+                        node_type,
+                        typename container_base::deferral_node_deleter
+                    >::other      node_cache  ;
+
+                    typedef typename cds::details::void_selector<
+                        typename normalized_type_traits<TRAITS>::original::node_deleter_functor,
+                        node_cache
+                    >::type       node_deleter_functor   ;
+                };
+
+                typedef gc::epoch::Guard          guard   ;
+                typedef gc::epoch::GuardArray<2>  guard_array ;
+            };
+        }   // namespace details
+        //@endcond
+
+        /// Michael's epoch-based queue
+        /**
+            \par Source:
+                \li [1998] Maged Michael, Michael Scott "Simple, fast, and practical non-blocking and blocking
+                            concurrent queue algorithms"
+
+            \par Template parameters:
+                \li \p T        Type of data stored in queue's node
+                \li \p TRAITS    Traits class, see cds::queue::traits
+                \li \p ALLOCATOR Memory allocator template
+
+            \par
+                Interface: see \ref queue_common_interface.
+        */
+        template <typename T, class TRAITS, class ALLOCATOR >
+        class MSQueue< gc::epoch_gc, T, TRAITS, ALLOCATOR >
+            : public details::msqueue_implementation< details::msqueue_adapter< gc::epoch_gc, T, TRAITS, ALLOCATOR > >
+        {};
+
+    } // namespace queue
+} // namespace cds
+
+#endif    // #ifndef __CDS_QUEUE_MSQUEUE_EPOCH_H
@@ -142,7 +142,7 @@ namespace cds {
                 : m_pHead( NULL ),
                 m_pTail( NULL )
             {
-                assert( m_nHazardPointerCount <= gc::hrc::GarbageCollector::instance().getHazardPointerCount() )    ;
+                assert( m_nHazardPointerCount <= gc::hrc::GarbageCollector::instance().getMaxHazardPointerCount() )    ;
 
                 Node * pNode = allocNode()        ;
                 TThreadGC& gc = getGC()    ;
@@ -243,6 +243,108 @@ namespace cds {
                 return true            ;
             }
 
+            /// Enqueues items of range [\p itFirst, \p itLast) as a contiguous batch. Returns count of enqueued items
+            /**
+                The items are linked privately and the chain is published by one CAS on the last node's link.
+            */
+            template <typename ITERATOR>
+            size_t enqueue_batch( ITERATOR itFirst, ITERATOR itLast )
+            {
+                if ( itFirst == itLast )
+                    return 0    ;
+
+                typename type_traits::backoff_strategy backoff    ;
+                gc::hrc::AutoHPArray<3> hpArr( base_class::getGC() )    ;
+
+                Node * pFirst = allocNode( *itFirst )   ;
+                Node * pLast = pFirst   ;
+                size_t nCount = 1   ;
+                for ( ++itFirst; itFirst != itLast; ++itFirst, ++nCount ) {
+                    Node * pNode = allocNode( *itFirst )    ;
+                    hpArr.getGC().storeRef( &( pLast->m_pNext ), pNode )    ;
+                    pLast = pNode   ;
+                }
+                hpArr.set( 0, pLast ) ;
+
+                Node * pOld = hpArr.getGC().derefLink( &m_pTail, hpArr[1] )    ;
+                Node * pPrev = pOld    ;
+                while ( true ) {
+                    while ( true ) {
+                        Node * p = hpArr.getGC().derefLink( &( pPrev->m_pNext), hpArr[2] ) ;
+                        if ( p == NULL )
+                            break   ;
+                        pPrev = p   ;
+                        m_Stat.onBadTail()    ;
+                    }
+
+                    if ( hpArr.getGC().CASRef( &( pPrev->m_pNext ), (Node *) NULL, pFirst ) )
+                        break ;
+                    m_Stat.onEnqueueRace()    ;
+                    backoff()    ;
+                }
+                m_ItemCounter += nCount    ;
+                m_Stat.onEnqueueBatch( nCount ) ;
+                if ( !hpArr.getGC().CASRef( &m_pTail, pOld, pLast ))
+                    m_Stat.onAdvanceTailFailed() ;
+                return nCount    ;
+            }
+
+            /// Dequeues up to \p nMax items to output iterator \p itOut by one CAS on the head. Returns count of dequeued items
+            template <typename OUTPUT_ITERATOR>
+            size_t dequeue_batch( OUTPUT_ITERATOR itOut, size_t nMax )
+            {
+                if ( nMax == 0 )
+                    return 0    ;
+
+                // hpArr[0] guards the head, hpArr[1] and hpArr[2] alternately guard the walk
+                gc::hrc::AutoHPArray<3> hpArr( base_class::getGC() )    ;
+                Node * pNode    ;
+                Node * pLast    ;
+                size_t nCount   ;
+                typename type_traits::backoff_strategy backoff ;
+
+                while ( true ) {
+                    pNode = hpArr.getGC().derefLink( &m_pHead, hpArr[0] )    ;
+                    pLast = pNode   ;
+                    nCount = 0      ;
+                    size_t nGuard = 1   ;
+                    while ( nCount < nMax ) {
+                        Node * pNext = hpArr.getGC().derefLink( &( pLast->m_pNext ), hpArr[nGuard] ) ;
+                        if ( pNext == NULL )
+                            break   ;
+                        pLast = pNext   ;
+                        nGuard = 3 - nGuard ;
+                        ++nCount    ;
+                    }
+                    if ( nCount == 0 ) {
+                        hpArr.getGC().releaseRef( hpArr[0] )    ;
+                        return 0        ;
+                    }
+
+                    if ( hpArr.getGC().CASRef( &m_pHead, pNode, pLast ))
+                        break    ;
+
+                    m_Stat.onDequeueRace()    ;
+                    backoff()            ;
+                }
+                m_ItemCounter -= nCount    ;
+                m_Stat.onDequeueBatch( nCount ) ;
+
+                // The nodes between pNode and pLast are not retired yet so they cannot be reclaimed
+                Node * p = pNode->m_pNext    ;
+                *itOut = p->m_data   ;
+                ++itOut ;
+                hpArr.getGC().retireNode( pNode, hpArr[0] )    ;
+                for ( size_t i = 1; i < nCount; ++i ) {
+                    Node * pNext = p->m_pNext   ;
+                    *itOut = pNext->m_data   ;
+                    ++itOut ;
+                    hpArr.getGC().retireNode( p )    ;
+                    p = pNext   ;
+                }
+                return nCount   ;
+            }
+
             /// Synonym for @ref enqueue
             bool push( const T& data )        { return enqueue( data ); }
             /// Synonym for  \ref dequeue
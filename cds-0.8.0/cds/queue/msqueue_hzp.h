@@ -43,15 +43,46 @@ namespace cds {
 
                 struct type_traits: public normalized_type_traits<TRAITS>
                 {
+                    typedef typename normalized_type_traits<TRAITS>::node_cache_type::template rebind<
+                        node_type,
+                        typename container_base::deferral_node_deleter
+                    >::other      node_cache  ;
+
                     typedef typename cds::details::void_selector<
                         typename normalized_type_traits<TRAITS>::original::node_deleter_functor,
-                        typename container_base::deferral_node_deleter
+                        node_cache
                     >::type       node_deleter_functor   ;
                 };
 
                 typedef gc::hzp::AutoHPGuard     guard   ;
                 typedef gc::hzp::AutoHPArray<2>  guard_array ;
             };
+
+            // The slot of guard_array is the raw hazard pointer, its store needs the publication fence
+            // (AutoHPGuard issues it by itself)
+            template <>
+            struct guarded_load<gc::hzp_gc>
+            {
+                template <typename GUARD, typename T>
+                static T * load( GUARD& g, atomic<T *>& src )
+                {
+                    return publish( g, src.template load<membar_relaxed>() )    ;
+                }
+
+                template <typename GUARD, typename T>
+                static T * publish( GUARD& g, T * p )
+                {
+                    g = p   ;
+                    return p    ;
+                }
+
+                template <typename T>
+                static T * publish( gc::hzp::HazardPtr& hp, T * p )
+                {
+                    gc::hzp::details::hp_publish<gc::hzp::HazardPtr>::store( &hp, p )  ;
+                    return p    ;
+                }
+            };
         }   // namespace details
         //@endcond
 
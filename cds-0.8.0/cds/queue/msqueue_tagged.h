@@ -150,6 +150,9 @@ namespace cds {
                     /// Returns internal statistics
                     const typename type_traits::statistics&    getStatistics() const { return m_Stat; }
 
+                    /// Returns the free-list of the queue (for example, to get free-list statistics)
+                    const typename type_traits::free_list_type& getFreeList() const { return m_FreeList; }
+
                     /// Enqueues new node with \p data to queue
                     bool enqueue( const T& data )
                     {
@@ -230,6 +233,128 @@ namespace cds {
                     /// Synonym for @ref dequeue operation
                     bool pop( T& dest )                { return dequeue( dest ) ; }
 
+                    /// Enqueues items of range [\p itFirst, \p itLast) as a contiguous batch. Returns count of enqueued items
+                    template <typename ITERATOR>
+                    size_t enqueue_batch( ITERATOR itFirst, ITERATOR itLast )
+                    {
+                        if ( itFirst == itLast )
+                            return 0    ;
+
+                        typename type_traits::backoff_strategy backoff    ;
+
+                        // Build the chain privately; it becomes visible by one CAS on the tail's link
+                        node_ptr pFirst = allocNode( *itFirst )    ;
+                        node_ptr pLast = pFirst ;
+                        size_t nCount = 1   ;
+                        for ( ++itFirst; itFirst != itLast; ++itFirst, ++nCount ) {
+                            node_ptr pNode = allocNode( *itFirst )   ;
+                            pLast->m_Next.m_data = pNode    ;
+                            pLast = pNode   ;
+                        }
+                        pLast->m_Next.m_data = NULL     ;
+
+                        tagged_ptr tail ;
+                        while ( true ) {
+                            tail = atomics::load<membar_acquire>( &m_Tail )    ;
+                            tagged_ptr next = atomics::load<membar_acquire>( &(tail.m_data->m_Next) )    ;
+                            if ( tail == atomics::load<membar_acquire>( &m_Tail ) ) {
+                                if ( next.m_data == NULL ) {
+                                    if ( gc::tagged::cas_tagged<membar_release>( tail.m_data->m_Next, next, pFirst ))
+                                        break    ;
+                                }
+                                else {
+                                    // Tail is misplaced, advance it
+                                    if ( gc::tagged::cas_tagged<membar_release>( m_Tail, tail, next.data() )) {
+                                        m_Stat.onBadTail()  ;
+                                        continue ;
+                                    }
+                                }
+                            }
+                            m_Stat.onEnqueueRace()  ;
+                            backoff();
+                        }
+
+                        if ( !gc::tagged::cas_tagged<membar_release>( m_Tail, tail, pLast ))
+                            m_Stat.onAdvanceTailFailed()    ;
+
+                        m_ItemCounter += nCount    ;
+                        m_Stat.onEnqueueBatch( nCount ) ;
+
+                        return nCount ;
+                    }
+
+                    /// Dequeues up to \p nMax items to output iterator \p itOut by one CAS on the head. Returns count of dequeued items
+                    template <typename OUTPUT_ITERATOR>
+                    size_t dequeue_batch( OUTPUT_ITERATOR itOut, size_t nMax )
+                    {
+                        if ( nMax == 0 )
+                            return 0    ;
+
+                        typename type_traits::backoff_strategy    backoff ;
+                        tagged_ptr  head    ;
+                        node_ptr    pLast   ;
+                        size_t      nCount  ;
+                        T           lastData    ;
+                        while ( true ) {
+                            head = atomics::load<membar_acquire>( &m_Head )    ;
+                            tagged_ptr tail = atomics::load<membar_acquire>( &m_Tail )    ;
+                            tagged_ptr next = atomics::load<membar_acquire>( &head.m_data->m_Next ) ;
+                            if ( head == atomics::load<membar_acquire>( &m_Head )) {
+                                if ( head.data() == tail.data() ) {
+                                    if ( next.data() == NULL )        // Is queue empty?..
+                                        return 0    ;
+                                    // Tail is misplaced, advance it
+                                    if ( gc::tagged::cas_tagged<membar_release>( m_Tail, tail, next.data() )) {
+                                        m_Stat.onBadTail()  ;
+                                        continue ;
+                                    }
+                                }
+                                else {
+                                    // Walk up to nMax nodes but never beyond the tail.
+                                    // The nodes are type-stable so the reading is safe while the head is unchanged
+                                    pLast = next.data() ;
+                                    nCount = 1  ;
+                                    bool bRestart = false   ;
+                                    while ( nCount < nMax && pLast != tail.data() ) {
+                                        node_ptr pNext = atomics::load<membar_acquire>( &pLast->m_Next ).data()    ;
+                                        if ( head != atomics::load<membar_acquire>( &m_Head ) || pNext == NULL ) {
+                                            bRestart = true ;
+                                            break   ;
+                                        }
+                                        pLast = pNext   ;
+                                        ++nCount    ;
+                                    }
+                                    if ( !bRestart ) {
+                                        // pLast becomes the new dummy node and may be freed by other thread after CAS
+                                        lastData = pLast->m_data   ;
+                                        if ( gc::tagged::cas_tagged<membar_release>( m_Head, head, pLast ) )
+                                            break    ;
+                                    }
+                                }
+                            }
+                            m_Stat.onDequeueRace()    ;
+                            backoff();
+                        }
+
+                        // The nodes from head up to pLast (exclusive) are owned by current thread now
+                        node_ptr p = head.data()->m_Next.data()    ;
+                        freeNode( head.data() )    ;
+                        for ( size_t i = 1; i < nCount; ++i ) {
+                            node_ptr pNext = p->m_Next.data()  ;
+                            *itOut = p->m_data  ;
+                            ++itOut ;
+                            freeNode( p )   ;
+                            p = pNext   ;
+                        }
+                        *itOut = lastData   ;
+                        ++itOut ;
+
+                        m_ItemCounter -= nCount    ;
+                        m_Stat.onDequeueBatch( nCount ) ;
+
+                        return nCount    ;
+                    }
+
                     /// Checks if queue is empty
                     bool empty() const
                     {
@@ -0,0 +1,164 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_NODE_CACHE_H
+#define __CDS_QUEUE_NODE_CACHE_H
+
+#include <cds/queue/details/queue_base.h>
+#include <cds/threading/model.h>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace queue {
+
+    //@cond
+    namespace details {
+
+        template <typename NODE, typename DELETER, size_t CAPACITY>
+        class thread_node_cache_impl
+        {
+            typedef cds::threading::ThreadData::extension   extension   ;
+            typedef cds::details::Allocator< NODE, typename DELETER::allocator_type >   node_allocator  ;
+
+            struct free_item {
+                free_item * m_pNext ;
+            };
+
+            struct thread_cache: public extension
+            {
+                free_item * m_pHead     ;
+                size_t      m_nCount    ;
+
+                thread_cache()
+                    : extension( &s_Key, destroy )
+                    , m_pHead( NULL )
+                    , m_nCount( 0 )
+                {}
+            };
+            typedef cds::details::Allocator< thread_cache, CDS_DEFAULT_ALLOCATOR >    cache_allocator ;
+
+            static char s_Key   ;   ///< Unique key of the cache in cds::threading::ThreadData extensions list
+
+            static void destroy( extension * pExt )
+            {
+                thread_cache * pCache = static_cast<thread_cache *>( pExt ) ;
+                node_allocator alloc    ;
+                while ( pCache->m_pHead ) {
+                    free_item * p = pCache->m_pHead ;
+                    pCache->m_pHead = p->m_pNext    ;
+                    alloc.deallocate( reinterpret_cast<NODE *>( p ), 1 )    ;
+                }
+                cache_allocator().Delete( pCache )  ;
+            }
+
+            static thread_cache * get( bool bCreate )
+            {
+                cds::threading::ThreadData * pData = cds::threading::Manager::thread_data()  ;
+                if ( !pData )
+                    return NULL ;
+
+                extension * pExt = pData->findExtension( &s_Key )   ;
+                if ( pExt )
+                    return static_cast<thread_cache *>( pExt )  ;
+
+                if ( !bCreate )
+                    return NULL ;
+                thread_cache * pCache = cache_allocator().New() ;
+                pData->attachExtension( pCache )    ;
+                return pCache   ;
+            }
+
+        public:
+            static const bool c_bEnabled = true ;
+
+            /// Returns raw memory of a cached node or \p NULL if the cache of current thread is empty
+            static void * alloc()
+            {
+                thread_cache * pCache = get( false )    ;
+                if ( pCache && pCache->m_pHead ) {
+                    free_item * p = pCache->m_pHead ;
+                    pCache->m_pHead = p->m_pNext    ;
+                    --pCache->m_nCount  ;
+                    return p    ;
+                }
+                return NULL ;
+            }
+
+            /// Destroys the node \p pNode and places its memory to the cache of current thread
+            /**
+                If the cache is full or current thread is not attached to \p libcds the node is freed by \p DELETER
+            */
+            static void free( NODE * pNode )
+            {
+                thread_cache * pCache = get( true )     ;
+                if ( pCache && pCache->m_nCount < CAPACITY ) {
+                    cds::details::call_dtor( pNode )    ;
+                    free_item * p = reinterpret_cast<free_item *>( pNode )  ;
+                    p->m_pNext = pCache->m_pHead    ;
+                    pCache->m_pHead = p ;
+                    ++pCache->m_nCount  ;
+                }
+                else
+                    DELETER::free( pNode )  ;
+            }
+        };
+
+        template <typename NODE, typename DELETER, size_t CAPACITY>
+        char thread_node_cache_impl<NODE, DELETER, CAPACITY>::s_Key = 0 ;
+
+    }   // namespace details
+    //@endcond
+
+    /// Per-thread node cache policy
+    /**
+        The policy may be used as \p node_cache_type of queue's traits for the queues based on
+        gc::hzp_gc, gc::ptb_gc and gc::epoch_gc reclamation schemas (MSQueue, MoirQueue, LMSQueue).
+
+        Each thread has a bounded cache of up to \p CAPACITY nodes for each node type.
+        When the GC reclaims a retired node, the node is destroyed and its memory is placed into the cache
+        of the reclaiming thread instead of returning to the heap; the queue allocates new nodes from the cache
+        of current thread first. Thus, in producer/consumer workloads the most of node allocations
+        do not call the node allocator at all. The cache hit/miss counts are collected by queue_statistics.
+
+        Note that the nodes are returned to the cache of the thread that reclaims them (the thread calling GC's scan),
+        so the cache is effective when the threads both enqueue and dequeue. The Hazard Pointer GC reclaims the nodes
+        by large bursts (up to 2 * <max thread count> * <HP count per thread> nodes per scan),
+        therefore small \p CAPACITY gives small hit ratio.
+
+        The cache of a thread is freed when the thread is detached from \p libcds
+        (see cds::threading::Manager::detachThread). The threads that are not attached do not use the cache.
+
+        The node allocator of the queue should be stateless (it is the requirement of the GC's deferral deleter too).
+
+        Example:
+        \code
+        #include <cds/queue/msqueue_hzp.h>
+        #include <cds/queue/node_cache.h>
+
+        struct cached_traits: public cds::queue::traits {
+            typedef cds::queue::thread_node_cache<128>  node_cache_type ;
+        };
+        typedef cds::queue::MSQueue< cds::gc::hzp_gc, int, cached_traits >  queue_type   ;
+        \endcode
+    */
+    template <size_t CAPACITY = 1024>
+    struct thread_node_cache {
+        static const size_t c_nCapacity = CAPACITY  ;   ///< Max count of nodes in the cache of each thread
+
+        //@cond
+        template <typename NODE, typename DELETER>
+        struct rebind {
+            typedef details::thread_node_cache_impl< NODE, DELETER, CAPACITY >  other   ;
+        };
+        //@endcond
+    };
+
+}}  // namespace cds::queue
+
+#endif  // #ifndef __CDS_QUEUE_NODE_CACHE_H
@@ -0,0 +1,219 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_SHARDED_QUEUE_H
+#define __CDS_QUEUE_SHARDED_QUEUE_H
+
+#include <cds/queue/details/queue_base.h>
+#include <cds/os/topology.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace queue {
+
+    /// Per-processor sharded queue
+    /**
+        The queue consists of \p N sub-queues (shards) of type \p QUEUE, by default \p N is equal to
+        the processor count of the system (cds::OS::topology::processor_count()).
+        \ref enqueue places the item to the local shard that is selected by
+        current processor number (cds::OS::topology::current_processor() modulo \p N).
+        \ref dequeue tries the local shard first and then steals the item from other shards
+        in topology order, i.e. from the shards of processors <tt>current + 1, current + 2, ...</tt>
+
+        Thus, the threads running on different processors do not contend on the same head and tail,
+        and the queue scales with the number of processors. The price is a relaxed FIFO order:
+        the items of a shard are dequeued in FIFO order, but there is no order among the shards.
+        Moreover, the thread may be moved to another processor by the OS scheduler, so even the items enqueued
+        by one thread may be dequeued out of order. \ref dequeue returns \p false only if all shards are empty
+        at the moment they are checked.
+
+        If the system does not support current processor number (see cds::OS::topology::current_processor),
+        the fake processor number assigned to each thread attached to \p libcds is used.
+
+        \par Template parameters
+            \li \p QUEUE - the type of sub-queue. It must be a thread-safe multi-producer multi-consumer queue,
+                for example, cds::queue::MSQueue. The sub-queue must be default-constructible or
+                constructible from \p size_t capacity (for bounded queues).
+            \li \p TRAITS - queue traits, default is cds::queue::traits. Only \p statistics is used;
+                queue_statistics counts the items dequeued from non-local shard as \p m_DequeueSteal.
+            \li \p ALLOCATOR - allocator for the array of shards
+
+        \par Example
+        \code
+        #include <cds/queue/msqueue_hzp.h>
+        #include <cds/queue/sharded_queue.h>
+
+        typedef cds::queue::sharded_queue< cds::queue::MSQueue< cds::gc::hzp_gc, int > >   queue_type ;
+        queue_type q    ;   // shard count is equal to processor count
+        \endcode
+    */
+    template <class QUEUE, class TRAITS = traits, class ALLOCATOR = CDS_DEFAULT_ALLOCATOR>
+    class sharded_queue
+    {
+    public:
+        typedef QUEUE                               shard_type  ;   ///< Sub-queue type
+        typedef typename shard_type::value_type     value_type  ;   ///< Value type
+        typedef normalized_type_traits<TRAITS>      type_traits ;   ///< Normalized queue traits
+
+    protected:
+        //@cond
+        struct shard {
+            shard_type  m_Queue ;
+            char        m_pad[ c_nCacheLineSize ]  ;   // the shards must not share the cache line
+
+            shard()
+            {}
+            explicit shard( size_t nCapacity )
+                : m_Queue( nCapacity )
+            {}
+        };
+        typedef cds::details::Allocator< shard, ALLOCATOR >     shard_allocator ;
+
+        shard *         m_arrShard      ;
+        size_t const    m_nShardCount   ;
+        typename type_traits::statistics    m_Stat  ;
+        //@endcond
+
+    public:
+        /// Constructs the queue of \p nShardCount shards
+        /**
+            If \p nShardCount is 0 the shard count is equal to processor count.
+        */
+        explicit sharded_queue( size_t nShardCount = 0 )
+            : m_nShardCount( normalize_shard_count( nShardCount ))
+        {
+            m_arrShard = shard_allocator().NewArray( m_nShardCount )  ;
+        }
+
+        /// Constructs the queue of \p nShardCount bounded shards of capacity \p nShardCapacity each
+        sharded_queue( size_t nShardCount, size_t nShardCapacity )
+            : m_nShardCount( normalize_shard_count( nShardCount ))
+        {
+            m_arrShard = shard_allocator().NewArray( m_nShardCount, nShardCapacity )  ;
+        }
+
+        ~sharded_queue()
+        {
+            shard_allocator().Delete( m_arrShard, m_nShardCount )   ;
+        }
+
+        /// Enqueues \p data to the shard of current processor
+        bool enqueue( value_type const& data )
+        {
+            if ( m_arrShard[ local_shard() ].m_Queue.enqueue( data )) {
+                m_Stat.onEnqueue()  ;
+                return true ;
+            }
+            return false    ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool push( value_type const& data )
+        {
+            return enqueue( data )  ;
+        }
+
+        /// Dequeues an item from the shard of current processor or, if it is empty, from other shards
+        /**
+            If all shards are empty returns \p false.
+        */
+        bool dequeue( value_type& dest )
+        {
+            size_t const nLocal = local_shard() ;
+            if ( m_arrShard[ nLocal ].m_Queue.dequeue( dest )) {
+                m_Stat.onDequeue()  ;
+                return true ;
+            }
+
+            for ( size_t i = 1; i < m_nShardCount; ++i ) {
+                size_t nShard = nLocal + i  ;
+                if ( nShard >= m_nShardCount )
+                    nShard -= m_nShardCount ;
+                if ( m_arrShard[ nShard ].m_Queue.dequeue( dest )) {
+                    m_Stat.onDequeue()      ;
+                    m_Stat.onDequeueSteal() ;
+                    return true ;
+                }
+            }
+            return false    ;
+        }
+
+        /// Synonym for \ref dequeue
+        bool pop( value_type& dest )
+        {
+            return dequeue( dest )  ;
+        }
+
+        /// Checks if all shards are empty
+        bool empty() const
+        {
+            for ( size_t i = 0; i < m_nShardCount; ++i ) {
+                if ( !m_arrShard[i].m_Queue.empty() )
+                    return false    ;
+            }
+            return true ;
+        }
+
+        /// Clears all shards
+        size_t clear()
+        {
+            size_t nRemoved = 0 ;
+            for ( size_t i = 0; i < m_nShardCount; ++i )
+                nRemoved += m_arrShard[i].m_Queue.clear()  ;
+            return nRemoved ;
+        }
+
+        /// Returns the sum of shard's sizes. Valid only if the sub-queue has an item counter
+        size_t size() const
+        {
+            size_t nSize = 0    ;
+            for ( size_t i = 0; i < m_nShardCount; ++i )
+                nSize += m_arrShard[i].m_Queue.size()   ;
+            return nSize    ;
+        }
+
+        /// Returns the shard count
+        size_t shard_count() const
+        {
+            return m_nShardCount    ;
+        }
+
+        /// Returns the shard \p nShard. For debugging only
+        shard_type& get_shard( size_t nShard )
+        {
+            assert( nShard < m_nShardCount )    ;
+            return m_arrShard[ nShard ].m_Queue ;
+        }
+
+        /// Returns queue's statistics
+        const typename type_traits::statistics& getStatistics() const
+        {
+            return m_Stat   ;
+        }
+
+    protected:
+        //@cond
+        static size_t normalize_shard_count( size_t nShardCount )
+        {
+            if ( nShardCount == 0 )
+                nShardCount = cds::OS::topology::processor_count()  ;
+            return nShardCount ? nShardCount : 1    ;
+        }
+
+        size_t local_shard() const
+        {
+            return cds::OS::topology::current_processor() % m_nShardCount   ;
+        }
+        //@endcond
+    };
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_SHARDED_QUEUE_H
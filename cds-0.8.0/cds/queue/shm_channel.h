@@ -0,0 +1,323 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_SHM_CHANNEL_H
+#define __CDS_QUEUE_SHM_CHANNEL_H
+
+#include <cds/atomic.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/details/aligned_type.h>
+#include <cds/os/syserror.h>
+
+#if CDS_OS_TYPE == CDS_OS_WIN32
+#   error cds::queue::shm_channel is supported on POSIX systems only
+#endif
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string>
+
+namespace cds { namespace queue {
+
+    /// Bounded single-consumer channel in shared memory
+    /**
+        The channel lives entirely in a shared memory object (POSIX \p shm_open, or any file descriptor
+        that can be mapped, for example, Linux \p memfd_create) so that the processes on the same host can
+        exchange the items. The mapping contains no pointers: positions are the indexes of the cells, the
+        cell array is located by its offset from the channel header, so each process may map the channel
+        at any address.
+
+        The algorithm is Dmitry Vyukov's bounded queue: each cell holds a sequence number that tells
+        whether the cell is ready for the producer or for the consumer.
+
+        Template parameters:
+            \li \p T - the item type. It is copied by memcpy-like assignment into the shared memory, so it
+                must be a POD type without pointers (the pointer value is meaningless in another process).
+            \li \p MULTIPLE_PRODUCERS - if \p false (the default), the channel is single-producer and
+                the producer advances its position with a plain store; if \p true, several producers
+                (in any processes) may enqueue concurrently.
+
+        The process that creates the channel initializes it; other processes attach to the channel
+        after it has been created. The channel created by name is removed from the namespace
+        when its creator destroys the object; already attached processes keep working.
+
+        The constructors throw cds::Exception on system errors or if the shared memory object
+        does not contain a compatible channel.
+    */
+    template <typename T, bool MULTIPLE_PRODUCERS = false>
+    class shm_channel
+    {
+    public:
+        typedef T       value_type  ;   ///< Item type
+        static const bool c_bMultipleProducers = MULTIPLE_PRODUCERS ;   ///< Multiple producers are allowed
+
+    protected:
+        //@cond
+        struct cell {
+            atomic<size_t>  m_nSequence ;
+            value_type      m_data      ;
+        };
+
+        static const size_t c_nMagic = 0x6364734348414e31ULL & ~size_t(0) ;    // "cdsCHAN1"
+
+        struct channel_header {
+            atomic<size_t>  m_nMagic        ;   // set last by the creator
+            size_t          m_nCapacity     ;
+            size_t          m_nCellSize     ;
+            size_t          m_nCellOffset   ;   // offset of the cell array from the header
+            size_t          m_nMultipleProducers ;
+
+            typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posEnqueue ;
+            typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posDequeue ;
+        };
+
+        static const size_t c_nCellOffset = (sizeof(channel_header) + c_nCacheLineSize - 1) & ~(c_nCacheLineSize - 1) ;
+
+        int                 m_fd            ;   // -1 if the descriptor is owned by the caller
+        std::string         m_strName       ;   // not empty if the channel is created by name
+        channel_header *    m_pHeader       ;
+        cell *              m_pCells        ;
+        size_t              m_nMappingSize  ;
+        size_t              m_nMask         ;
+        //@endcond
+
+    public:
+        /// Creates new channel named \p pszName (see \p shm_open) with \p nCapacity items
+        /**
+            The capacity is rounded up to the power of two. The name must not exist.
+        */
+        shm_channel( const char * pszName, size_t nCapacity )
+            : m_fd( -1 )
+            , m_pHeader( NULL )
+        {
+            int fd = ::shm_open( pszName, O_RDWR | O_CREAT | O_EXCL, 0600 )  ;
+            if ( fd == -1 )
+                throw_error( "shm_open", pszName )  ;
+            m_fd = fd   ;
+            m_strName = pszName ;
+            create( fd, nCapacity ) ;
+        }
+
+        /// Attaches to the existing channel named \p pszName
+        explicit shm_channel( const char * pszName )
+            : m_fd( -1 )
+            , m_pHeader( NULL )
+        {
+            int fd = ::shm_open( pszName, O_RDWR, 0 )  ;
+            if ( fd == -1 )
+                throw_error( "shm_open", pszName )  ;
+            m_fd = fd   ;
+            attach( fd )    ;
+        }
+
+        /// Creates new channel with \p nCapacity items in the empty shared file \p fd
+        /**
+            The file is resized to the channel size. The descriptor is not closed by the channel.
+        */
+        shm_channel( int fd, size_t nCapacity )
+            : m_fd( -1 )
+            , m_pHeader( NULL )
+        {
+            create( fd, nCapacity ) ;
+        }
+
+        /// Attaches to the channel created in the shared file \p fd
+        explicit shm_channel( int fd )
+            : m_fd( -1 )
+            , m_pHeader( NULL )
+        {
+            attach( fd )    ;
+        }
+
+        /// Unmaps the channel
+        /**
+            If the channel has been created by name, the name is removed.
+        */
+        ~shm_channel()
+        {
+            ::munmap( m_pHeader, m_nMappingSize )   ;
+            if ( m_fd != -1 )
+                ::close( m_fd ) ;
+            if ( !m_strName.empty() )
+                ::shm_unlink( m_strName.c_str() )   ;
+        }
+
+        /// Enqueues \p data. Returns \p false if the channel is full
+        bool enqueue( const value_type& data )
+        {
+            size_t pos = m_pHeader->m_posEnqueue.template load<membar_relaxed>()    ;
+            cell * pCell    ;
+            for (;;) {
+                pCell = m_pCells + (pos & m_nMask)  ;
+                size_t nSeq = pCell->m_nSequence.template load<membar_acquire>() ;
+                intptr_t nDiff = (intptr_t) nSeq - (intptr_t) pos   ;
+                if ( nDiff == 0 ) {
+                    if ( !c_bMultipleProducers ) {
+                        m_pHeader->m_posEnqueue.template store<membar_relaxed>( pos + 1 ) ;
+                        break   ;
+                    }
+                    size_t nCur = m_pHeader->m_posEnqueue.template vcas<membar_relaxed>( pos, pos + 1 ) ;
+                    if ( nCur == pos )
+                        break   ;
+                    pos = nCur  ;
+                }
+                else if ( nDiff < 0 )
+                    return false    ;   // full
+                else
+                    pos = m_pHeader->m_posEnqueue.template load<membar_relaxed>()    ;
+            }
+
+            pCell->m_data = data    ;
+            pCell->m_nSequence.template store<membar_release>( pos + 1 ) ;
+            return true ;
+        }
+
+        /// Dequeues the item into \p data. Returns \p false if the channel is empty. Consumer only
+        bool dequeue( value_type& data )
+        {
+            size_t pos = m_pHeader->m_posDequeue.template load<membar_relaxed>()    ;
+            cell * pCell = m_pCells + (pos & m_nMask)  ;
+            if ( pCell->m_nSequence.template load<membar_acquire>() != pos + 1 )
+                return false    ;   // empty
+
+            data = pCell->m_data    ;
+            pCell->m_nSequence.template store<membar_release>( pos + m_nMask + 1 ) ;
+            m_pHeader->m_posDequeue.template store<membar_relaxed>( pos + 1 ) ;
+            return true ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool push( const value_type& data )
+        {
+            return enqueue( data )  ;
+        }
+
+        /// Synonym for \ref dequeue
+        bool pop( value_type& data )
+        {
+            return dequeue( data )  ;
+        }
+
+        /// Checks if the channel is empty. Consumer only
+        bool empty() const
+        {
+            size_t pos = m_pHeader->m_posDequeue.template load<membar_relaxed>()    ;
+            return m_pCells[ pos & m_nMask ].m_nSequence.template load<membar_acquire>() != pos + 1 ;
+        }
+
+        /// Returns the channel capacity
+        size_t capacity() const
+        {
+            return m_nMask + 1  ;
+        }
+
+        /// Returns the size of the shared memory object for the channel of \p nCapacity items
+        static size_t mapping_size( size_t nCapacity )
+        {
+            return c_nCellOffset + calc_capacity( nCapacity ) * sizeof(cell)   ;
+        }
+
+    protected:
+        //@cond
+        static size_t calc_capacity( size_t nCapacity )
+        {
+            size_t nPow2 = 2    ;
+            while ( nPow2 < nCapacity )
+                nPow2 <<= 1 ;
+            return nPow2    ;
+        }
+
+        void throw_error( const char * pszFunc, const char * pszName )
+        {
+            std::string strMsg( "cds::queue::shm_channel: " ) ;
+            strMsg = strMsg + pszFunc + "(" + (pszName ? pszName : "") + ") failed: "
+                + cds::OS::getSystemErrorText( cds::OS::getErrorCode() )    ;
+            if ( m_fd != -1 )
+                ::close( m_fd ) ;
+            if ( !m_strName.empty() )
+                ::shm_unlink( m_strName.c_str() )   ;
+            throw cds::Exception( strMsg )  ;
+        }
+
+        void map( int fd, size_t nSize )
+        {
+            void * p = ::mmap( NULL, nSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 ) ;
+            if ( p == MAP_FAILED )
+                throw_error( "mmap", m_strName.c_str() )    ;
+            m_pHeader = reinterpret_cast<channel_header *>( p ) ;
+            m_nMappingSize = nSize  ;
+        }
+
+        void create( int fd, size_t nCapacity )
+        {
+            nCapacity = calc_capacity( nCapacity )  ;
+            size_t nSize = mapping_size( nCapacity )    ;
+            if ( ::ftruncate( fd, (off_t) nSize ) == -1 )
+                throw_error( "ftruncate", m_strName.c_str() )   ;
+            map( fd, nSize )    ;
+
+            m_pHeader->m_nCapacity = nCapacity  ;
+            m_pHeader->m_nCellSize = sizeof(cell)   ;
+            m_pHeader->m_nCellOffset = c_nCellOffset    ;
+            m_pHeader->m_nMultipleProducers = c_bMultipleProducers ? 1 : 0  ;
+            m_pHeader->m_posEnqueue.template store<membar_relaxed>( 0 ) ;
+            m_pHeader->m_posDequeue.template store<membar_relaxed>( 0 ) ;
+
+            m_nMask = nCapacity - 1 ;
+            m_pCells = cell_array() ;
+            for ( size_t i = 0; i < nCapacity; ++i )
+                m_pCells[i].m_nSequence.template store<membar_relaxed>( i ) ;
+
+            // The channel is ready to attach
+            m_pHeader->m_nMagic.template store<membar_release>( c_nMagic ) ;
+        }
+
+        void attach( int fd )
+        {
+            struct stat st  ;
+            if ( ::fstat( fd, &st ) == -1 )
+                throw_error( "fstat", m_strName.c_str() )   ;
+            if ( (size_t) st.st_size < c_nCellOffset )
+                throw_incompatible()    ;
+            map( fd, (size_t) st.st_size )  ;
+
+            if ( m_pHeader->m_nMagic.template load<membar_acquire>() != c_nMagic
+                || m_pHeader->m_nCellSize != sizeof(cell)
+                || m_pHeader->m_nMultipleProducers != (c_bMultipleProducers ? 1 : 0)
+                || m_pHeader->m_nCellOffset + m_pHeader->m_nCapacity * sizeof(cell) > m_nMappingSize )
+            {
+                ::munmap( m_pHeader, m_nMappingSize )   ;
+                throw_incompatible()    ;
+            }
+
+            m_nMask = m_pHeader->m_nCapacity - 1    ;
+            m_pCells = cell_array() ;
+        }
+
+        void throw_incompatible()
+        {
+            if ( m_fd != -1 )
+                ::close( m_fd ) ;
+            throw cds::Exception( "cds::queue::shm_channel: shared memory object does not contain a compatible channel" ) ;
+        }
+
+        cell * cell_array() const
+        {
+            return reinterpret_cast<cell *>( reinterpret_cast<char *>( m_pHeader ) + m_pHeader->m_nCellOffset ) ;
+        }
+        //@endcond
+    };
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_SHM_CHANNEL_H
@@ -0,0 +1,270 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_TZ_CYCLIC_VALUE_QUEUE_H
+#define __CDS_QUEUE_TZ_CYCLIC_VALUE_QUEUE_H
+
+#include <cds/queue/details/queue_base.h>
+#include <cds/details/allocator.h>
+#include <cds/details/aligned_type.h>
+#include <cds/user_setup/cache_line.h>
+
+namespace cds { namespace queue {
+
+    /// Lock-free cyclic queue storing the values in the array cells
+    /**
+        This is a value-based variant of Tsigas-Zhang cyclic queue (see \ref TZCyclicQueue).
+        Unlike TZCyclicQueue, the items are copied into the cells of the cyclic array, so no memory
+        is allocated for an item and any trivially copyable type may be stored.
+
+        The pointer-based original marks a free cell by two kinds of null value (null0/null1) to avoid ABA problem.
+        Here each cell has a state word instead: the upper bits of the word are the position (the unbounded index)
+        the cell is assigned for, the two lower bits are the cell's state: free, writing, full, reading.
+        A dequeued cell becomes free for the position <tt>pos + capacity</tt>.
+        As in the original algorithm, the head and tail indices are hints only: they are moved by CAS on every second
+        operation, the actual head/tail is found by scanning the cells from the hint.
+
+        Since the position is not masked, the capacity of the queue may be any positive number,
+        not only a power of two minus two. Note, if the capacity is not a power of two the cell index
+        <tt>pos % capacity</tt> is discontinuous when the position counter overflows; in practice
+        it may happen on 32bit platforms only.
+
+        Source:
+            \li [2000] Philippas Tsigas, Yi Zhang "A Simple, Fast and Scalable Non-Blocking Concurrent FIFO Queue
+            for Shared Memory Multiprocessor Systems"
+
+        Template arguments:
+            \li \p T is type of value stored in the queue. The type must be default-constructible and trivially copyable.
+            \li \p TRAITS is queue's traits class; default is cds::queue::traits.
+                The queue uses \p item_counter_type and \p backoff_strategy of the traits.
+            \li \p ALLOCATOR is memory allocator for the cyclic array. Default is \ref CDS_DEFAULT_ALLOCATOR
+    */
+    template < typename T,
+        class TRAITS = traits,
+        class ALLOCATOR = CDS_DEFAULT_ALLOCATOR >
+    class TZCyclicValueQueue: public concept::bounded_container
+    {
+    public:
+        typedef T                               value_type  ;   ///< value type
+        typedef normalized_type_traits<TRAITS>  type_traits ;   ///< type traits
+
+    protected:
+        //@cond
+        enum {
+            c_nFree     = 0,    // the cell is free for its position
+            c_nWriting  = 1,    // an enqueuer has acquired the cell and copies the value
+            c_nFull     = 2,    // the cell contains the value
+            c_nReading  = 3,    // a dequeuer has acquired the cell and copies the value
+
+            c_nStateBits = 2,
+            c_nStateMask = 3
+        };
+
+        struct cell_type {
+            atomic<size_t>  m_nState    ;
+            value_type      m_Value     ;
+        };
+
+        static size_t makeState( size_t nPos, size_t nState )
+        {
+            return (nPos << c_nStateBits) | nState  ;
+        }
+        static size_t cellPos( size_t nState )
+        {
+            return nState >> c_nStateBits   ;
+        }
+        static size_t cellState( size_t nState )
+        {
+            return nState & c_nStateMask    ;
+        }
+        // Signed distance between the cell's position and \p nPos; the positions wrap in the state word
+        static intptr_t posDiff( size_t nState, size_t nPos )
+        {
+            return ((intptr_t) ((cellPos( nState ) - nPos) << c_nStateBits)) >> c_nStateBits ;
+        }
+        //@endcond
+
+    protected:
+        //@cond
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_nHead  ;   // head position hint
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_nTail  ;   // tail position hint
+        size_t const    m_nCapacity ;
+        cell_type *     m_Cells     ;
+
+        cds::details::Allocator< cell_type, ALLOCATOR > m_Alloc         ;
+        typename type_traits::item_counter_type         m_ItemCounter   ;
+        //@endcond
+
+    public:
+        /// Constructs the queue of capacity \p nCapacity
+        TZCyclicValueQueue( size_t nCapacity = 1024 * 1024 )
+            : m_nCapacity( nCapacity )
+        {
+            assert( nCapacity > 0 ) ;
+            m_Cells = m_Alloc.NewArray( nCapacity ) ;
+            for ( size_t i = 0; i < nCapacity; ++i )
+                m_Cells[i].m_nState.template store<membar_relaxed>( makeState( i, c_nFree )) ;
+
+            m_nHead.store<membar_relaxed>( 0 )  ;
+            m_nTail.store<membar_release>( 0 )  ;
+        }
+
+        /// Destructor frees the cyclic array
+        ~TZCyclicValueQueue()
+        {
+            m_Alloc.Delete( m_Cells, m_nCapacity )  ;
+        }
+
+        /// Enqueues \p data
+        /**
+            Returns \p true if success, \p false if the queue is full
+        */
+        bool enqueue( const value_type& data )
+        {
+            typename type_traits::backoff_strategy bkoff    ;
+
+            size_t const nTail = m_nTail.load<membar_acquire>()   ;
+            size_t nPos = nTail ;
+            for (;;) {
+                cell_type& cell = m_Cells[ nPos % m_nCapacity ] ;
+                size_t nState = cell.m_nState.template load<membar_acquire>()   ;
+                intptr_t nDiff = posDiff( nState, nPos )    ;
+
+                if ( nDiff == 0 ) {
+                    if ( cellState( nState ) != c_nFree ) {
+                        // the position is taken by another enqueuer, look for actual tail
+                        ++nPos  ;
+                        continue    ;
+                    }
+
+                    if ( cell.m_nState.template cas<membar_acquire>( nState, makeState( nPos, c_nWriting ))) {
+                        cell.m_Value = data ;
+                        cell.m_nState.template store<membar_release>( makeState( nPos, c_nFull ))  ;
+
+                        // As in the original algorithm the tail is moved on every second item
+                        if ( nPos % 2 == 1 )
+                            m_nTail.cas<membar_release>( nTail, nPos + 1 )  ;
+                        ++m_ItemCounter ;
+                        return true ;
+                    }
+                    bkoff() ;
+                }
+                else if ( nDiff > 0 ) {
+                    // the position has been dequeued already, our tail hint is out of date
+                    size_t nActualTail = m_nTail.load<membar_acquire>() ;
+                    nPos = (intptr_t)(nActualTail - nPos) > 0 ? nActualTail : nPos + 1   ;
+                }
+                else {
+                    // the cell still contains the item of previous round
+                    return false    ;   // Queue is full
+                }
+            }
+        }
+
+        /// Dequeues a value to \p dest
+        /**
+            If queue is empty returns \a false, \p dest is not changed.
+            If queue is not empty returns \a true, \p dest contains the value dequeued
+        */
+        bool dequeue( value_type& dest )
+        {
+            typename type_traits::backoff_strategy bkoff    ;
+
+            size_t const nHead = m_nHead.load<membar_acquire>()   ;
+            size_t nPos = nHead ;
+            for (;;) {
+                cell_type& cell = m_Cells[ nPos % m_nCapacity ] ;
+                size_t nState = cell.m_nState.template load<membar_acquire>()   ;
+                intptr_t nDiff = posDiff( nState, nPos )    ;
+
+                if ( nDiff == 0 ) {
+                    switch ( cellState( nState )) {
+                    case c_nFull:
+                        if ( cell.m_nState.template cas<membar_acquire>( nState, makeState( nPos, c_nReading ))) {
+                            dest = cell.m_Value ;
+                            cell.m_nState.template store<membar_release>( makeState( nPos + m_nCapacity, c_nFree ))  ;
+
+                            // As in the original algorithm the head is moved on every second item
+                            if ( nPos % 2 == 1 )
+                                m_nHead.cas<membar_release>( nHead, nPos + 1 )  ;
+                            --m_ItemCounter ;
+                            return true ;
+                        }
+                        bkoff() ;
+                        break   ;
+                    case c_nReading:
+                        // the position is taken by another dequeuer, look for actual head
+                        ++nPos  ;
+                        break   ;
+                    default:
+                        // the position is free or its value is not written yet
+                        return false    ;
+                    }
+                }
+                else if ( nDiff > 0 ) {
+                    // the position has been dequeued already, our head hint is out of date
+                    size_t nActualHead = m_nHead.load<membar_acquire>() ;
+                    nPos = (intptr_t)(nActualHead - nPos) > 0 ? nActualHead : nPos + 1   ;
+                }
+                else {
+                    // the cell is not reused for the position yet
+                    return false    ;
+                }
+            }
+        }
+
+        /// Synonym for @ref enqueue
+        bool push( const value_type& data )     { return enqueue( data ); }
+
+        /// Synonym for @ref dequeue
+        bool pop( value_type& data )            { return dequeue( data ); }
+
+        /// Checks if the queue is empty
+        bool empty() const
+        {
+            size_t nPos = m_nHead.load<membar_acquire>()    ;
+            for (;;) {
+                size_t nState = m_Cells[ nPos % m_nCapacity ].m_nState.template load<membar_acquire>()   ;
+                intptr_t nDiff = posDiff( nState, nPos )    ;
+
+                if ( nDiff == 0 ) {
+                    if ( cellState( nState ) == c_nFull )
+                        return false    ;
+                    if ( cellState( nState ) != c_nReading )
+                        return true     ;
+                }
+                else if ( nDiff < 0 )
+                    return true ;
+                ++nPos  ;
+            }
+        }
+
+        /// Clears the queue
+        size_t clear()
+        {
+            return generic_clear( *this )   ;
+        }
+
+        /// Returns number of items in queue. Valid only if \p TRAITS::item_counter_type is not the cds::atomics::empty_item_counter
+        size_t size() const
+        {
+            return m_ItemCounter    ;
+        }
+
+        /// Returns capacity of the queue
+        size_t capacity() const
+        {
+            return m_nCapacity  ;
+        }
+    };
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_TZ_CYCLIC_VALUE_QUEUE_H
@@ -20,6 +20,9 @@
 #include <cds/details/aligned_type.h>
 #include <cds/ref.h>
 #include <cds/details/allocator.h>
+#include <cds/backoff_strategy.h>
+
+#include <iterator>
 
 namespace cds { namespace queue {
 
@@ -30,7 +33,8 @@ namespace cds { namespace queue {
         blocking producers and consumers queue. The algorithm is pretty simple and fast. It's not lockfree in the official meaning, 
         just implemented by means of atomic RMW operations w/o mutexes. 
 
-        The cost of enqueue/dequeue is 1 CAS per operation. 
+        The cost of enqueue/dequeue is 1 CAS per operation. The bulk operations \ref enqueue_bulk and \ref dequeue_bulk
+        reserve a range of cells by 1 CAS per range.
         No dynamic memory allocation/management during operation. Producers and consumers are separated from each other (as in the two-lock queue), 
         i.e. do not touch the same data while queue is not empty. 
 
@@ -107,10 +111,10 @@ namespace cds { namespace queue {
 
     protected:
         //@cond
-        typename details::aligned_type<buffer, c_nCacheLineSize>::type  m_buffer    ;
+        typename cds::details::aligned_type<buffer, c_nCacheLineSize>::type  m_buffer    ;
         size_t const    m_nBufferMask   ;
-        typename details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posEnqueue    ;
-        typename details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posDequeue    ;
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posEnqueue    ;
+        typename cds::details::aligned_type<atomic<size_t>, c_nCacheLineSize>::type  m_posDequeue    ;
         //@endcond
 
     public:
@@ -247,6 +251,98 @@ namespace cds { namespace queue {
             return dequeue( data, trivial_copy() )  ;
         }
 
+        /// Enqueues items of range [\p itFirst, \p itLast) by one reservation
+        /**
+            The function reserves up to <tt>std::distance(itFirst, itLast)</tt> consecutive cells
+            by single CAS on the enqueue position and then fills the cells reserved in range order.
+            If the queue has not enough free cells, only the head of the range is enqueued.
+            Returns the number of items enqueued; zero means the queue is full (or the range is empty).
+
+            The cells reserved may still be read by consumers that have already dequeued its previous content,
+            in this case the function spins until the cell is released.
+
+            \p ITERATOR must be a forward iterator, its value type must be convertible to \p T.
+        */
+        template <typename ITERATOR>
+        size_t enqueue_bulk( ITERATOR itFirst, ITERATOR itLast )
+        {
+            size_t const nCount = (size_t) std::distance( itFirst, itLast ) ;
+            if ( nCount == 0 )
+                return 0    ;
+
+            size_t const nCapacity = capacity() ;
+            size_t pos  ;
+            size_t nReserved    ;
+            for (;;) {
+                pos = m_posEnqueue.load<membar_relaxed>()   ;
+
+                // The cells preceding the dequeue position are taken by consumers
+                intptr_t nFree = (intptr_t)(m_posDequeue.load<membar_acquire>() + nCapacity - pos)  ;
+                if ( nFree <= 0 )
+                    return 0    ;
+                if ( (size_t) nFree > nCapacity )
+                    continue    ;   // pos is out of date
+
+                nReserved = nCount < (size_t) nFree ? nCount : (size_t) nFree  ;
+                if ( m_posEnqueue.cas<membar_relaxed>( pos, pos + nReserved ))
+                    break   ;
+            }
+
+            backoff::Default bkoff  ;
+            for ( size_t i = 0; i < nReserved; ++i, ++itFirst ) {
+                cell_type * cell = &m_buffer[(pos + i) & m_nBufferMask] ;
+                while ( cell->sequence.template load<membar_acquire>() != pos + i )
+                    bkoff() ;
+
+                cell->data = *itFirst   ;
+                cell->sequence.template store<membar_release>( pos + i + 1 ) ;
+            }
+            return nReserved    ;
+        }
+
+        /// Dequeues up to \p nMax items to output iterator \p itOut by one reservation
+        /**
+            The function reserves up to \p nMax consecutive cells by single CAS on the dequeue position
+            and then drains the cells reserved in queue order.
+            Returns the number of items dequeued; zero means the queue is empty.
+
+            The cells reserved may still be being filled by producers that have already enqueued into them,
+            in this case the function spins until the cell is published.
+        */
+        template <typename OUTPUT_ITERATOR>
+        size_t dequeue_bulk( OUTPUT_ITERATOR itOut, size_t nMax )
+        {
+            if ( nMax == 0 )
+                return 0    ;
+
+            size_t pos  ;
+            size_t nReserved    ;
+            for (;;) {
+                pos = m_posDequeue.load<membar_relaxed>()   ;
+
+                // The cells preceding the enqueue position are taken by producers
+                intptr_t nAvail = (intptr_t)(m_posEnqueue.load<membar_acquire>() - pos)  ;
+                if ( nAvail <= 0 )
+                    return 0    ;
+
+                nReserved = nMax < (size_t) nAvail ? nMax : (size_t) nAvail    ;
+                if ( m_posDequeue.cas<membar_relaxed>( pos, pos + nReserved ))
+                    break   ;
+            }
+
+            backoff::Default bkoff  ;
+            for ( size_t i = 0; i < nReserved; ++i, ++itOut ) {
+                cell_type * cell = &m_buffer[(pos + i) & m_nBufferMask] ;
+                while ( cell->sequence.template load<membar_acquire>() != pos + i + 1 )
+                    bkoff() ;
+
+                *itOut = cell->data ;
+                value_cleaner()( cell->data )   ;
+                cell->sequence.template store<membar_release>( pos + i + m_nBufferMask + 1 ) ;
+            }
+            return nReserved    ;
+        }
+
         /// Synonym of \ref enqueue
         bool push(value_type const& data)
         {
@@ -265,6 +361,12 @@ namespace cds { namespace queue {
             value_type v        ;
             while ( pop(v) )    ;
         }
+
+        /// Returns queue's capacity
+        size_t capacity() const
+        {
+            return m_nBufferMask + 1    ;
+        }
 
     };
 
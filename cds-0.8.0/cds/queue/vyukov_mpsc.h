@@ -0,0 +1,396 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_QUEUE_VYUKOV_MPSC_H
+#define __CDS_QUEUE_VYUKOV_MPSC_H
+
+/*
+    Source:
+        Dmitry Vyukov "Intrusive MPSC node-based queue"
+        http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+*/
+
+#include <cds/queue/details/queue_base.h>
+#include <cds/queue/node_cache.h>
+#include <cds/user_setup/cache_line.h>
+#include <cds/details/aligned_type.h>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace queue {
+
+    /// Node of intrusive Vyukov's MPSC queue
+    /**
+        The type stored in \ref intrusive_vyukov_mpsc must be derived from this struct.
+    */
+    struct vyukov_mpsc_node {
+        cds::atomic<vyukov_mpsc_node *>  m_pNext ;   ///< Next node in the queue
+
+        //@cond
+        vyukov_mpsc_node()
+        {
+            m_pNext.store<membar_relaxed>( NULL ) ;
+        }
+        //@endcond
+    };
+
+    /// Vyukov's intrusive multi-producer single-consumer queue
+    /**
+        \par Source:
+            Dmitry Vyukov "Intrusive MPSC node-based queue"
+
+        The producers are wait-free: \ref enqueue is one atomic exchange on the tail and one store.
+        The consumer does not use any RMW operation except the rare case when the queue contains one item.
+        There is no CAS, so no memory reclamation schema is needed: the node is owned by the queue
+        from \ref enqueue until \ref dequeue returns it, and then the consumer owns the node.
+
+        Only one thread may call \ref dequeue, \ref empty and \ref clear at the same time.
+
+        The queue is not linearizable: if a producer is preempted between the exchange and the linking of its node,
+        the consumer cannot see this node and the nodes enqueued after it, so \ref dequeue may return \p NULL
+        for non-empty queue. The queue statistics counts these events as dequeue race.
+
+        \par Template parameters
+            \li \p NODE - node type, must be derived from vyukov_mpsc_node
+            \li \p TRAITS - queue traits, default is cds::queue::traits. The item counter and the statistics are used.
+    */
+    template <typename NODE, class TRAITS = traits>
+    class intrusive_vyukov_mpsc
+    {
+    public:
+        typedef NODE    value_type  ;   ///< Node type
+        typedef normalized_type_traits<TRAITS>  type_traits ;   ///< Normalized queue traits
+
+    protected:
+        //@cond
+        typedef vyukov_mpsc_node    node_base   ;
+
+        typename cds::details::aligned_type<atomic<node_base *>, c_nCacheLineSize>::type  m_pTail  ;   // producers
+        typename cds::details::aligned_type<node_base *, c_nCacheLineSize>::type        m_pHead  ;   // consumer
+        node_base       m_Stub  ;
+
+        typename type_traits::item_counter_type m_ItemCounter   ;
+        typename type_traits::statistics        m_Stat          ;
+        //@endcond
+
+    public:
+        /// Constructs empty queue
+        intrusive_vyukov_mpsc()
+        {
+            m_pHead = &m_Stub   ;
+            m_pTail.store<membar_release>( &m_Stub )  ;
+        }
+
+        /// Enqueues the node \p node. Always returns \p true
+        /**
+            The node must not be in any queue.
+        */
+        bool enqueue( value_type& node )
+        {
+            push_node( &node )  ;
+            ++m_ItemCounter     ;
+            m_Stat.onEnqueue()  ;
+            return true ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool push( value_type& node )
+        {
+            return enqueue( node )  ;
+        }
+
+        /// Dequeues a node
+        /**
+            Returns \p NULL if the queue is empty or if the next node is not linked yet by its producer.
+            The node returned is owned by the caller.
+        */
+        value_type * dequeue()
+        {
+            node_base * pHead = m_pHead ;
+            node_base * pNext = pHead->m_pNext.load<membar_acquire>()    ;
+
+            if ( pHead == &m_Stub ) {
+                if ( pNext == NULL )
+                    return NULL ;
+                m_pHead = pNext ;
+                pHead = pNext   ;
+                pNext = pNext->m_pNext.load<membar_acquire>()   ;
+            }
+
+            if ( pNext == NULL ) {
+                if ( pHead != m_pTail.load<membar_acquire>() ) {
+                    // A producer has exchanged the tail but has not linked its node yet
+                    m_Stat.onDequeueRace()  ;
+                    return NULL ;
+                }
+
+                // pHead is the last node; the stub is enqueued so that pHead may be unlinked
+                push_node( &m_Stub )    ;
+                pNext = pHead->m_pNext.load<membar_acquire>()   ;
+                if ( pNext == NULL ) {
+                    m_Stat.onDequeueRace()  ;
+                    return NULL ;
+                }
+            }
+
+            m_pHead = pNext     ;
+            --m_ItemCounter     ;
+            m_Stat.onDequeue()  ;
+            return static_cast<value_type *>( pHead )  ;
+        }
+
+        /// Synonym for \ref dequeue
+        value_type * pop()
+        {
+            return dequeue()    ;
+        }
+
+        /// Checks if the queue is empty. Consumer only
+        bool empty() const
+        {
+            return m_pHead == &m_Stub && m_Stub.m_pNext.load<membar_acquire>() == NULL  ;
+        }
+
+        /// Dequeues all nodes. Consumer only
+        /**
+            Returns the number of nodes dequeued. The nodes are not freed.
+        */
+        size_t clear()
+        {
+            size_t nRemoved = 0 ;
+            while ( dequeue() )
+                ++nRemoved  ;
+            return nRemoved ;
+        }
+
+        /// Returns number of items in queue. Valid only if \p TRAITS::item_counter_type is not the cds::atomics::empty_item_counter
+        size_t size() const
+        {
+            return m_ItemCounter    ;
+        }
+
+        /// Returns queue's statistics
+        const typename type_traits::statistics& getStatistics() const
+        {
+            return m_Stat   ;
+        }
+
+    protected:
+        //@cond
+        void push_node( node_base * pNode )
+        {
+            pNode->m_pNext.store<membar_relaxed>( NULL )  ;
+            node_base * pPrev = m_pTail.xchg<membar_acq_rel>( pNode )  ;
+            pPrev->m_pNext.store<membar_release>( pNode )  ;
+        }
+        //@endcond
+    };
+
+    //@cond
+    namespace details {
+        template <typename T>
+        struct vyukov_mpsc_value_node: public vyukov_mpsc_node
+        {
+            T   m_data  ;
+
+            vyukov_mpsc_value_node()
+            {}
+            vyukov_mpsc_value_node( T const& data )
+                : m_data( data )
+            {}
+        };
+    }
+    //@endcond
+
+    /// Vyukov's multi-producer single-consumer queue
+    /**
+        Non-intrusive wrapper around \ref intrusive_vyukov_mpsc: \ref enqueue allocates a node for the value,
+        \ref dequeue copies the value and frees the node.
+
+        In MPSC workload the nodes are allocated by the producers and freed by the consumer. To avoid
+        this cross-thread traffic through the heap the queue supports the node cache policy
+        \p TRAITS::node_cache_type (see cds::queue::thread_node_cache). If the node cache is enabled,
+        the consumer does not free the nodes but pushes them to the list of free nodes of the queue.
+        A producer allocates the node from its per-thread node cache; if the cache is empty,
+        the producer takes all nodes of the free list by one atomic exchange, uses the first one and places
+        the rest into its per-thread cache. The free list is only pushed by the consumer and only taken entirely
+        by producers, so it is free from ABA-problem. The cache hit/miss counts are collected by queue_statistics.
+
+        Only one thread may call \ref dequeue, \ref empty and \ref clear at the same time.
+
+        \par Template parameters
+            \li \p T - value type, must be copy-constructible and assignable
+            \li \p TRAITS - queue traits, default is cds::queue::traits
+            \li \p ALLOCATOR - node allocator. With node cache the allocator should be stateless.
+
+        \par Example
+        \code
+        #include <cds/queue/vyukov_mpsc.h>
+
+        struct cached_traits: public cds::queue::traits {
+            typedef cds::queue::thread_node_cache<256>  node_cache_type ;
+        };
+        typedef cds::queue::vyukov_mpsc< int, cached_traits >  queue_type   ;
+        \endcode
+    */
+    template <typename T, class TRAITS = traits, class ALLOCATOR = CDS_DEFAULT_ALLOCATOR >
+    class vyukov_mpsc: protected intrusive_vyukov_mpsc< details::vyukov_mpsc_value_node<T>, TRAITS >
+    {
+        //@cond
+        typedef intrusive_vyukov_mpsc< details::vyukov_mpsc_value_node<T>, TRAITS >  base_class  ;
+        //@endcond
+    public:
+        typedef T   value_type  ;   ///< Value type
+        typedef details::vyukov_mpsc_value_node<T>  node_type   ;   ///< Node type
+        typedef typename base_class::type_traits    type_traits ;   ///< Normalized queue traits
+
+    protected:
+        //@cond
+        typedef cds::details::Allocator< node_type, ALLOCATOR >             node_allocator  ;
+        typedef cds::details::deferral_deleter< node_type, ALLOCATOR >      node_deleter    ;
+        typedef typename type_traits::node_cache_type::template rebind< node_type, node_deleter >::other    node_cache  ;
+
+        typename cds::details::aligned_type<atomic<vyukov_mpsc_node *>, c_nCacheLineSize>::type  m_pFreeList  ;   // nodes returned by the consumer
+        //@endcond
+
+    public:
+        /// Constructs empty queue
+        vyukov_mpsc()
+        {
+            m_pFreeList.store<membar_release>( NULL )   ;
+        }
+
+        /// Destroys the queue. Must be called when no thread uses the queue
+        ~vyukov_mpsc()
+        {
+            node_type * pNode   ;
+            while ( (pNode = base_class::dequeue()) != NULL )
+                node_deleter::free( pNode ) ;
+
+            vyukov_mpsc_node * p = m_pFreeList.load<membar_acquire>()   ;
+            while ( p ) {
+                vyukov_mpsc_node * pNext = p->m_pNext.load<membar_relaxed>()   ;
+                node_deleter::free( static_cast<node_type *>( p ))  ;
+                p = pNext   ;
+            }
+        }
+
+        /// Enqueues \p data. Always returns \p true
+        bool enqueue( value_type const& data )
+        {
+            return base_class::enqueue( *allocNode( data ))   ;
+        }
+
+        /// Synonym for \ref enqueue
+        bool push( value_type const& data )
+        {
+            return enqueue( data )  ;
+        }
+
+        /// Dequeues a value to \p dest. Consumer only
+        /**
+            If the queue is empty returns \p false, \p dest is unchanged.
+        */
+        bool dequeue( value_type& dest )
+        {
+            node_type * pNode = base_class::dequeue()   ;
+            if ( pNode == NULL )
+                return false    ;
+            dest = pNode->m_data    ;
+            freeNode( pNode )   ;
+            return true ;
+        }
+
+        /// Synonym for \ref dequeue
+        bool pop( value_type& dest )
+        {
+            return dequeue( dest )  ;
+        }
+
+        /// Checks if the queue is empty. Consumer only
+        bool empty() const
+        {
+            return base_class::empty()  ;
+        }
+
+        /// Clears the queue. Consumer only
+        size_t clear()
+        {
+            size_t nRemoved = 0 ;
+            node_type * pNode   ;
+            while ( (pNode = base_class::dequeue()) != NULL ) {
+                freeNode( pNode )   ;
+                ++nRemoved  ;
+            }
+            return nRemoved ;
+        }
+
+        /// Returns number of items in queue. Valid only if \p TRAITS::item_counter_type is not the cds::atomics::empty_item_counter
+        size_t size() const
+        {
+            return base_class::size()  ;
+        }
+
+        /// Returns queue's statistics
+        const typename type_traits::statistics& getStatistics() const
+        {
+            return base_class::getStatistics()  ;
+        }
+
+    protected:
+        //@cond
+        node_type * allocNode( value_type const& data )
+        {
+            void * p = node_cache::alloc()  ;
+            if ( p == NULL && node_cache::c_bEnabled ) {
+                // Take all nodes returned by the consumer
+                vyukov_mpsc_node * pList = m_pFreeList.xchg<membar_acquire>( NULL )   ;
+                if ( pList ) {
+                    node_type * pNode = static_cast<node_type *>( pList )   ;
+                    pList = pList->m_pNext.load<membar_relaxed>()   ;
+                    while ( pList ) {
+                        vyukov_mpsc_node * pNext = pList->m_pNext.load<membar_relaxed>()   ;
+                        node_cache::free( static_cast<node_type *>( pList ))    ;
+                        pList = pNext   ;
+                    }
+                    cds::details::call_dtor( pNode )    ;
+                    p = pNode   ;
+                }
+            }
+
+            if ( p ) {
+                base_class::m_Stat.onNodeCacheHit() ;
+                return node_allocator().Construct( p, data )    ;
+            }
+            if ( node_cache::c_bEnabled )
+                base_class::m_Stat.onNodeCacheMiss()    ;
+            return node_allocator().New( data )     ;
+        }
+
+        void freeNode( node_type * pNode )
+        {
+            if ( node_cache::c_bEnabled ) {
+                vyukov_mpsc_node * pHead = m_pFreeList.load<membar_relaxed>()   ;
+                for (;;) {
+                    pNode->m_pNext.template store<membar_relaxed>( pHead )    ;
+                    vyukov_mpsc_node * pCur = m_pFreeList.vcas<membar_release>( pHead, pNode )   ;
+                    if ( pCur == pHead )
+                        break   ;
+                    pHead = pCur    ;
+                }
+            }
+            else
+                node_cache::free( pNode )   ;
+        }
+        //@endcond
+    };
+
+}}  // namespace cds::queue
+
+#endif // #ifndef __CDS_QUEUE_VYUKOV_MPSC_H
@@ -0,0 +1,132 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __CDS_STACK_EPOCH_H
+#define __CDS_STACK_EPOCH_H
+
+#include <cds/stack/stack_base.h>
+#include <cds/gc/epoch/container.h>
+#include <cds/details/void_selector.h>
+
+namespace cds {
+    namespace stack {
+        namespace details {
+
+            /// Stack's node type for epoch-based memory reclamation schema
+            template <typename T>
+            struct node_epoch {
+                atomic< node_epoch<T> * >  m_pNext ;   ///< Pointer to next node in the stack
+                T                          m_Data  ;   ///< Data stored in the node
+
+                //@cond
+                node_epoch(): m_pNext( NULL ) {}
+                node_epoch( const T& data ): m_pNext( NULL ), m_Data( data ) {}
+                //@endcond
+            };
+        }
+
+        /// Lock-free stack based on epoch-based reclamation schema
+        /**
+            Source:
+                [1986] R. K. Treiber "Systems programming: Coping with parallelism"
+
+            This class is a specialization of stack::Stack template for gc::epoch_gc memory reclamation schema.
+            The \p pop operation is executed inside epoch critical region, so the top node read
+            cannot be freed and reused until the operation is done; there is no need to re-read
+            the top of the stack after the node has been guarded.
+        */
+        template < typename T, class TRAITS, class ALLOCATOR>
+        class Stack< gc::epoch_gc, T, TRAITS, ALLOCATOR >: public gc::epoch::Container< details::node_epoch<T>, ALLOCATOR >
+        {
+            typedef gc::epoch::Container< details::node_epoch<T>, ALLOCATOR >    base_class   ;   ///< Base class
+
+        public:
+            typedef gc::epoch_gc    gc_schema    ;    ///< Garbage collection schema
+            typedef T               value_type   ;    ///< Value type
+
+            typedef typename cds::details::void_selector<
+                typename TRAITS::backoff_strategy,
+                cds::backoff::empty
+            >::type                 backoff_strategy ; ///< Back-off strategy
+
+        protected:
+            typedef typename base_class::Node     Node    ;   ///< Node type
+
+        protected:
+            atomic<Node *>      m_pTop  ;   ///< Top of the stack
+
+        public:
+            Stack(): m_pTop( NULL )
+            {
+                assert( gc::epoch::GarbageCollector::isUsed() )   ;
+            }
+
+            /// Push data to stack
+            bool push( const T& data )
+            {
+                Node * pNew = base_class::allocNode( data )    ;
+                Node * t    ;
+                backoff_strategy bkoff ;
+                while( true ) {
+                    t = m_pTop.template load<membar_acquire>() ;
+                    pNew->m_pNext.template store<membar_relaxed>( t )  ;   // Next CAS orders memory
+                    if ( m_pTop.template cas<membar_acq_rel>( t, pNew ))
+                        return true    ;
+                    bkoff()    ;
+                }
+            }
+
+            /// Pop data from the stack. Returns \p false if stack is empty
+            bool pop( T& data )
+            {
+                backoff_strategy bkoff ;
+                gc::epoch::Guard guard( base_class::getGC() )    ;
+
+                while ( true ) {
+                    Node * t = m_pTop.template load<membar_acquire>()  ;
+                    if ( t == NULL )
+                        return false    ;    // stack is empty
+
+                    Node * pNext = t->m_pNext.template load<membar_acquire>()  ;
+                    if ( m_pTop.template cas<membar_acq_rel>( t, pNext ) ) {
+                        data = t->m_Data        ;
+                        guard.getGC().retirePtr( t, base_class::deferral_node_deleter::free ) ;
+                        return true    ;
+                    }
+                    bkoff()    ;
+                }
+            }
+
+            /// Checks if the stack is empty
+            bool empty() const
+            {
+                return m_pTop.template load<membar_acquire>() == NULL;
+            }
+
+            /// Clears the stack in lock-free manner
+            size_t clear()
+            {
+                gc::epoch::Guard guard( base_class::getGC() )    ;
+                Node * pTop = m_pTop.template xchg<membar_acq_rel>( (Node *) NULL )  ;
+
+                size_t nRemoved = 0    ;
+                while( pTop ) {
+                    Node * p = pTop    ;
+                    pTop = p->m_pNext.template load<membar_relaxed>()  ;
+                    guard.getGC().retirePtr( p, base_class::deferral_node_deleter::free ) ;
+                    ++nRemoved    ;
+                }
+                return nRemoved    ;
+            }
+        };
+    }    // namespace stack
+}    // namespace cds
+
+#endif    // #ifndef __CDS_STACK_EPOCH_H
@@ -142,6 +142,12 @@ namespace cds {
                 return atomics::load<membar_acquire>( &m_Top.m_data ) == NULL  ;
             }
 
+            /// Returns the free-list of the stack (for example, to get free-list statistics)
+            const free_list& getFreeList() const
+            {
+                return m_FreeList   ;
+            }
+
             /// Clears the stack in lock-free manner
             size_t clear()
             {
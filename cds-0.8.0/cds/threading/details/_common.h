@@ -14,6 +14,8 @@
 #include <cds/gc/hzp/hzp.h>
 #include <cds/gc/hrc/hrc.h>
 #include <cds/gc/ptb/ptb.h>
+#include <cds/gc/epoch/epoch.h>
+#include <cds/gc/ibr/ibr.h>
 
 namespace cds {
     /// Threading support
@@ -90,18 +92,45 @@ namespace cds {
         /// Thread-specific data
         struct ThreadData {
 
+            /// Thread-specific extension
+            /**
+                The extension is thread-specific object of a feature that is not a GC (for example,
+                per-thread node cache of a container). The extension is registered by \ref attachExtension
+                and is destroyed by \p m_funcDestroy when the thread is detached from \p libcds.
+                Each extension type is identified by unique key, usually it is the address of static object.
+            */
+            struct extension {
+                extension *     m_pNext         ;   ///< Next extension in the list
+                const void *    m_pKey          ;   ///< Unique key of extension type
+                void (* m_funcDestroy)( extension * )  ;   ///< Destroying function
+
+                //@cond
+                extension( const void * pKey, void (* funcDestroy)( extension * ) )
+                    : m_pNext( NULL )
+                    , m_pKey( pKey )
+                    , m_funcDestroy( funcDestroy )
+                {}
+                //@endcond
+            };
+
             //@cond
             char CDS_DATA_ALIGNMENT(8) m_hpManagerPlaceholder[sizeof(gc::hzp::ThreadGC)]   ;   ///< Michael's Hazard Pointer GC placeholder
             char CDS_DATA_ALIGNMENT(8) m_hrcManagerPlaceholder[sizeof(gc::hrc::ThreadGC)]  ;   ///< Gidenstam's GC placeholder
             char CDS_DATA_ALIGNMENT(8) m_ptbManagerPlaceholder[sizeof(gc::ptb::ThreadGC)]  ;   ///< Pass The Buck GC placeholder
+            char CDS_DATA_ALIGNMENT(8) m_epochManagerPlaceholder[sizeof(gc::epoch::ThreadGC)]  ; ///< Epoch-based GC placeholder
+            char CDS_DATA_ALIGNMENT(8) m_ibrManagerPlaceholder[sizeof(gc::ibr::ThreadGC)]  ;   ///< Interval-based GC placeholder
             //@endcond
 
             gc::hzp::ThreadGC * m_hpManager     ;   ///< Michael's Hazard Pointer GC thread-specific data
             gc::hrc::ThreadGC * m_hrcManager    ;   ///< Gidenstam's GC thread-specific data
             gc::ptb::ThreadGC * m_ptbManager    ;   ///< Pass The Buck GC thread-specific data
+            gc::epoch::ThreadGC * m_epochManager;   ///< Epoch-based GC thread-specific data
+            gc::ibr::ThreadGC * m_ibrManager    ;   ///< Interval-based GC thread-specific data
 
             size_t  m_nFakeProcessorNumber  ;   ///< fake "current processor" number
 
+            extension * m_pExtensions       ;   ///< List of thread-specific extensions
+
             //@cond
             static CDS_EXPORT_API volatile size_t  s_nLastUsedProcNo   ;
             static CDS_EXPORT_API size_t           s_nProcCount        ;
@@ -110,6 +139,7 @@ namespace cds {
             //@cond
             ThreadData()
                 : m_nFakeProcessorNumber( cds::atomics::inc<membar_relaxed>( &s_nLastUsedProcNo ) % s_nProcCount )
+                , m_pExtensions( NULL )
             {
                 if (gc::hzp::GarbageCollector::isUsed() )
                     m_hpManager = new (m_hpManagerPlaceholder) gc::hzp::ThreadGC ;
@@ -125,6 +155,16 @@ namespace cds {
                     m_ptbManager = new (m_ptbManagerPlaceholder) gc::ptb::ThreadGC  ;
                 else
                     m_ptbManager = NULL ;
+
+                if ( gc::epoch::GarbageCollector::isUsed() )
+                    m_epochManager = new (m_epochManagerPlaceholder) gc::epoch::ThreadGC  ;
+                else
+                    m_epochManager = NULL   ;
+
+                if ( gc::ibr::GarbageCollector::isUsed() )
+                    m_ibrManager = new (m_ibrManagerPlaceholder) gc::ibr::ThreadGC  ;
+                else
+                    m_ibrManager = NULL ;
             }
 
             ~ThreadData()
@@ -143,16 +183,31 @@ namespace cds {
                     m_ptbManager->gc::ptb::ThreadGC::~ThreadGC()  ;
                     m_ptbManager = NULL     ;
                 }
+
+                if ( m_epochManager ) {
+                    m_epochManager->gc::epoch::ThreadGC::~ThreadGC()  ;
+                    m_epochManager = NULL   ;
+                }
+
+                if ( m_ibrManager ) {
+                    m_ibrManager->gc::ibr::ThreadGC::~ThreadGC()  ;
+                    m_ibrManager = NULL     ;
+                }
+
+                destroyExtensions() ;
             }
 
+            /*
+                The records of HZP, HRC and PTB GC are not allocated here: the thread gets them
+                on first use (see cds::threading::getGC), so a short-lived thread that does not use a GC
+                does not touch the GC's global list.
+            */
             void init()
             {
-                if ( gc::hzp::GarbageCollector::isUsed() )
-                    m_hpManager->init()   ;
-                if ( gc::hrc::GarbageCollector::isUsed() )
-                    m_hrcManager->init()  ;
-                if ( gc::ptb::GarbageCollector::isUsed() )
-                    m_ptbManager->init()  ;
+                if ( gc::epoch::GarbageCollector::isUsed() )
+                    m_epochManager->init()  ;
+                if ( gc::ibr::GarbageCollector::isUsed() )
+                    m_ibrManager->init()  ;
             }
 
             void fini()
@@ -163,6 +218,13 @@ namespace cds {
                     m_hpManager->fini()   ;
                 if ( gc::ptb::GarbageCollector::isUsed() )
                     m_ptbManager->fini()   ;
+                if ( gc::epoch::GarbageCollector::isUsed() )
+                    m_epochManager->fini()   ;
+                if ( gc::ibr::GarbageCollector::isUsed() )
+                    m_ibrManager->fini()   ;
+
+                // The GCs may free the nodes into the extensions while finishing
+                destroyExtensions() ;
             }
 
             size_t fake_current_processor()
@@ -170,6 +232,36 @@ namespace cds {
                 return m_nFakeProcessorNumber   ;
             }
             //@endcond
+
+            /// Finds the extension by its \p pKey. Returns \p NULL if the extension is not registered
+            extension * findExtension( const void * pKey ) const
+            {
+                for ( extension * p = m_pExtensions; p; p = p->m_pNext ) {
+                    if ( p->m_pKey == pKey )
+                        return p    ;
+                }
+                return NULL ;
+            }
+
+            /// Registers the extension \p pExt for current thread
+            void attachExtension( extension * pExt )
+            {
+                assert( findExtension( pExt->m_pKey ) == NULL ) ;
+                pExt->m_pNext = m_pExtensions   ;
+                m_pExtensions = pExt    ;
+            }
+
+        private:
+            //@cond
+            void destroyExtensions()
+            {
+                while ( m_pExtensions ) {
+                    extension * p = m_pExtensions   ;
+                    m_pExtensions = p->m_pNext  ;
+                    p->m_funcDestroy( p )   ;
+                }
+            }
+            //@endcond
         };
 
         /*
@@ -48,7 +48,7 @@ namespace cds { namespace threading {
             static bool isThreadAttached()
             {
                 ThreadData * pData = _threadData()    ;
-                return pData != NULL && (pData->m_hpManager != NULL || pData->m_hrcManager != NULL || pData->m_ptbManager != NULL ) ;
+                return pData != NULL && (pData->m_hpManager != NULL || pData->m_hrcManager != NULL || pData->m_ptbManager != NULL || pData->m_epochManager != NULL || pData->m_ibrManager != NULL ) ;
             }
 
             /// This method must be called in beginning of thread execution
@@ -106,6 +106,38 @@ namespace cds { namespace threading {
                 return *(_threadData()->m_ptbManager)           ;
             }
 
+            /// Returns gc::epoch::ThreadGC object of current thread
+            /**
+                The object returned may be uninitialized if you did not call attachThread in the beginning of thread execution
+                or do not use gc::epoch::GarbageCollector.
+                To initialize global gc::epoch::GarbageCollector object you must call cds::gc::epoch::GarbageCollector::Construct()
+                in the beginning of your application
+            */
+            static gc::epoch_gc::thread_gc&   getEpochGC()
+            {
+                assert( _threadData()->m_epochManager != NULL ) ;
+                return *(_threadData()->m_epochManager)         ;
+            }
+
+            /// Returns gc::ibr::ThreadGC object of current thread
+            /**
+                The object returned may be uninitialized if you did not call attachThread in the beginning of thread execution
+                or do not use gc::ibr::GarbageCollector.
+                To initialize global gc::ibr::GarbageCollector object you must call cds::gc::ibr::GarbageCollector::Construct()
+                in the beginning of your application
+            */
+            static gc::ibr_gc::thread_gc&   getIBRGC()
+            {
+                assert( _threadData()->m_ibrManager != NULL ) ;
+                return *(_threadData()->m_ibrManager)         ;
+            }
+
+            /// Returns thread-specific data of current thread or \p NULL if the thread is not attached
+            static ThreadData * thread_data()
+            {
+                return isThreadAttached() ? _threadData() : NULL  ;
+            }
+
             //@cond
             static size_t fake_current_processor()
             {
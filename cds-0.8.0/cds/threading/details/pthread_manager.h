@@ -242,6 +242,36 @@ namespace cds { namespace threading {
                 return *(_threadData( do_getData )->m_ptbManager)   ;
             }
 
+            /// Returns gc::epoch::ThreadGC object of current thread
+            /**
+                The object returned may be uninitialized if you did not call Manager::attachThread in the beginning of thread execution
+                or do not use gc::epoch::GarbageCollector.
+                To initialize global gc::epoch::GarbageCollector object you must call cds::gc::epoch::GarbageCollector::Construct()
+                in the beginning of your application
+            */
+            static gc::epoch_gc::thread_gc&   getEpochGC()
+            {
+                return *(_threadData( do_getData )->m_epochManager)   ;
+            }
+
+            /// Returns gc::ibr::ThreadGC object of current thread
+            /**
+                The object returned may be uninitialized if you did not call Manager::attachThread in the beginning of thread execution
+                or do not use gc::ibr::GarbageCollector.
+                To initialize global gc::ibr::GarbageCollector object you must call cds::gc::ibr::GarbageCollector::Construct()
+                in the beginning of your application
+            */
+            static gc::ibr_gc::thread_gc&   getIBRGC()
+            {
+                return *(_threadData( do_getData )->m_ibrManager)   ;
+            }
+
+            /// Returns thread-specific data of current thread or \p NULL if the thread is not attached
+            static ThreadData * thread_data()
+            {
+                return _threadData( do_checkData )  ;
+            }
+
             //@cond
             static size_t fake_current_processor()
             {
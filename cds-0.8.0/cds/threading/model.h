@@ -18,6 +18,10 @@
 namespace cds { namespace threading {
 
     /// Returns thread specific data of \p GC garbage collector
+    /**
+        For HZP, HRC and PTB GC the thread's GC record is allocated on first call of the function
+        after Manager::attachThread, not in Manager::attachThread itself.
+    */
     template <class GC> typename GC::thread_gc&  getGC()  ;
 
     /// Returns gc::hzp::ThreadGC object of current thread
@@ -30,7 +34,10 @@ namespace cds { namespace threading {
     template <>
     inline gc::hzp_gc::thread_gc&   getGC<gc::hzp_gc>()
     {
-        return Manager::getHZPGC()  ;
+        gc::hzp_gc::thread_gc& tgc = Manager::getHZPGC()   ;
+        if ( !tgc.isInitialized() )
+            tgc.init()  ;
+        return tgc  ;
     }
 
     /// Returns gc::hrc::ThreadGC object of current thread
@@ -43,7 +50,10 @@ namespace cds { namespace threading {
     template <>
     inline gc::hrc_gc::thread_gc&   getGC<gc::hrc_gc>()
     {
-        return Manager::getHRCGC()  ;
+        gc::hrc_gc::thread_gc& tgc = Manager::getHRCGC()   ;
+        if ( !tgc.isInitialized() )
+            tgc.init()  ;
+        return tgc  ;
     }
 
     /// Returns gc::ptb::ThreadGC object of current thread
@@ -56,7 +66,36 @@ namespace cds { namespace threading {
     template <>
     inline gc::ptb_gc::thread_gc&   getGC<gc::ptb_gc>()
     {
-        return Manager::getPTBGC()  ;
+        gc::ptb_gc::thread_gc& tgc = Manager::getPTBGC()   ;
+        if ( !tgc.isInitialized() )
+            tgc.init()  ;
+        return tgc  ;
+    }
+
+    /// Returns gc::epoch::ThreadGC object of current thread
+    /**
+        The object returned may be uninitialized if you did not call attachThread in the beginning of thread execution
+        or do not use gc::epoch::GarbageCollector.
+        To initialize global gc::epoch::GarbageCollector object you must call cds::gc::epoch::GarbageCollector::Construct()
+        in the beginning of your application
+    */
+    template <>
+    inline gc::epoch_gc::thread_gc&   getGC<gc::epoch_gc>()
+    {
+        return Manager::getEpochGC()    ;
+    }
+
+    /// Returns gc::ibr::ThreadGC object of current thread
+    /**
+        The object returned may be uninitialized if you did not call attachThread in the beginning of thread execution
+        or do not use gc::ibr::GarbageCollector.
+        To initialize global gc::ibr::GarbageCollector object you must call cds::gc::ibr::GarbageCollector::Construct()
+        in the beginning of your application
+    */
+    template <>
+    inline gc::ibr_gc::thread_gc&   getGC<gc::ibr_gc>()
+    {
+        return Manager::getIBRGC()    ;
     }
 
 }} // namespace cds::threading
@@ -0,0 +1,154 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+// Epoch-based memory manager implementation
+
+#include <cds/gc/epoch/epoch.h>
+#include <cds/details/allocator.h>
+
+namespace cds { namespace gc { namespace epoch {
+
+    GarbageCollector * GarbageCollector::m_pManager = NULL  ;
+
+    void CDS_STDCALL GarbageCollector::Construct( size_t nScanThreshold )
+    {
+        if ( !m_pManager ) {
+            m_pManager = new GarbageCollector( nScanThreshold ) ;
+        }
+    }
+
+    void CDS_STDCALL GarbageCollector::Destruct()
+    {
+        if ( m_pManager ) {
+            delete m_pManager   ;
+            m_pManager = NULL   ;
+        }
+    }
+
+    GarbageCollector::GarbageCollector( size_t nScanThreshold )
+        : m_pThreadList( NULL )
+        , m_nThreadRecCount( 0 )
+        , m_nOrphanCount( 0 )
+        , m_nScanThreshold( nScanThreshold ? nScanThreshold : 128 )
+        , m_nAdvanceCount( 0 )
+        , m_nAdvanceFailed( 0 )
+        , m_nFreedCount( 0 )
+        , m_nScanCount( 0 )
+    {
+        m_nGlobalEpoch.store<membar_relaxed>( size_t(0) ) ;
+    }
+
+    GarbageCollector::~GarbageCollector()
+    {
+        // All threads are detached, so all orphans may be freed
+        for ( size_t i = 0; i < m_Orphans.size(); ++i )
+            m_Orphans[i].m_ptr.free()   ;
+        m_Orphans.clear()   ;
+
+        cds::details::Allocator< details::thread_record > al   ;
+        details::thread_record * pNext ;
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_relaxed>(); pRec; pRec = pNext ) {
+            assert( pRec->m_bInUse.load<membar_relaxed>() == 0 )  ;
+            pNext = pRec->m_pNext   ;
+            al.Delete( pRec )   ;
+        }
+    }
+
+    details::thread_record * GarbageCollector::allocRecord()
+    {
+        // Reuse the record of a detached thread
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_acquire>(); pRec; pRec = pRec->m_pNext ) {
+            if ( pRec->m_bInUse.load<membar_relaxed>() == 0 && pRec->m_bInUse.cas<membar_acquire>( 0, 1 ))
+                return pRec ;
+        }
+
+        // The list is never shrunk, so the ABA problem is impossible
+        details::thread_record * pRec = cds::details::Allocator< details::thread_record >().New() ;
+        details::thread_record * pHead ;
+        do {
+            pRec->m_pNext =
+                pHead = m_pThreadList.load<membar_acquire>()    ;
+        } while ( !m_pThreadList.cas<membar_release>( pHead, pRec ))    ;
+        m_nThreadRecCount.inc<membar_relaxed>()  ;
+        return pRec ;
+    }
+
+    void GarbageCollector::freeRecord( details::thread_record * pRec, details::limbo_list * pLimbo, size_t nLimboCount )
+    {
+        pRec->m_nState.store<membar_release>( size_t(0) )  ;
+
+        {
+            lock::AutoSpin al( m_lockOrphans )    ;
+            for ( size_t i = 0; i < nLimboCount; ++i ) {
+                for ( size_t k = 0; k < pLimbo[i].m_arr.size(); ++k )
+                    m_Orphans.push_back( details::epoch_retired_ptr( pLimbo[i].m_arr[k], pLimbo[i].m_nEpoch )) ;
+                pLimbo[i].m_arr.clear() ;
+            }
+            m_nOrphanCount.store<membar_relaxed>( m_Orphans.size() )    ;
+        }
+
+        pRec->m_bInUse.store<membar_release>( 0 )  ;
+    }
+
+    void GarbageCollector::free_orphans()
+    {
+        if ( !m_lockOrphans.tryLock() )
+            return  ;
+        lock::AutoUnlock<lock::Spin> aus( m_lockOrphans )   ;
+
+        size_t const nEpoch = epoch()   ;
+        size_t nKeep = 0    ;
+        for ( size_t i = 0; i < m_Orphans.size(); ++i ) {
+            if ( m_Orphans[i].m_nEpoch + 2 <= nEpoch )
+                m_Orphans[i].m_ptr.free()   ;
+            else
+                m_Orphans[nKeep++] = m_Orphans[i]    ;
+        }
+        onFreed( m_Orphans.size() - nKeep ) ;
+        m_Orphans.resize( nKeep, details::epoch_retired_ptr( retired_ptr(), 0 ))    ;
+        m_nOrphanCount.store<membar_relaxed>( nKeep )   ;
+    }
+
+    bool GarbageCollector::try_advance()
+    {
+        size_t const nEpoch = m_nGlobalEpoch.load<membar_relaxed>()  ;
+        atomics::fence( membar_seq_cst::order ) ;
+
+        size_t const nActive = (nEpoch << 1) | 1    ;
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_acquire>(); pRec; pRec = pRec->m_pNext ) {
+            size_t nState = pRec->m_nState.load<membar_acquire>()   ;
+            if ( (nState & 1) && nState != nActive ) {
+                // The thread is in critical region of previous epoch
+                m_nAdvanceFailed.inc<membar_relaxed>()  ;
+                return false    ;
+            }
+        }
+
+        if ( m_nGlobalEpoch.cas<membar_acq_rel>( nEpoch, nEpoch + 1 )) {
+            m_nAdvanceCount.inc<membar_relaxed>()   ;
+            return true ;
+        }
+        return false    ;
+    }
+
+    GarbageCollector::InternalState& GarbageCollector::getInternalState( InternalState& stat ) const
+    {
+        stat.m_nEpoch = epoch() ;
+        stat.m_nThreadRecCount = m_nThreadRecCount.load<membar_relaxed>()  ;
+        stat.m_nAdvanceCount = m_nAdvanceCount.load<membar_relaxed>()   ;
+        stat.m_nAdvanceFailed = m_nAdvanceFailed.load<membar_relaxed>() ;
+        stat.m_nFreedCount = m_nFreedCount.load<membar_relaxed>()   ;
+        stat.m_nOrphanCount = m_nOrphanCount.load<membar_relaxed>() ;
+        stat.m_nScanCount = m_nScanCount.load<membar_relaxed>() ;
+        stat.m_fScanTime = cds::OS::Timer().duration( m_ScanTime )  ;
+        return stat ;
+    }
+
+}}} // namespace cds::gc::epoch
@@ -18,6 +18,9 @@
 */
 
 #include <cds/gc/hrc/hrc.h>
+#include <cds/gc/details/reclaimer.h>
+#include <cds/gc/details/scan_timer.h>
+#include <cds/threading/model.h>
 
 #include "hzp_const.h"
 #include <vector>
@@ -30,20 +33,76 @@ namespace cds { namespace gc {
 
         GarbageCollector * GarbageCollector::m_pGC = NULL ;
 
+        /// Background reclaimer of HRC GC
+        /**
+            The reclaimer thread has its own ThreadGC. The nodes handed off by workers
+            are pushed to the array of retired nodes of the reclaimer; when the array is full the reclaimer
+            calls cleanUpLocal, Scan, HelpScan and CleanUpAll exactly like a worker does.
+        */
+        class GarbageCollector::reclaimer_impl: public cds::gc::details::reclaimer
+        {
+        public:
+            typedef cds::gc::details::retired_batch_queue<ContainerNode *>  batch_queue ;
+
+            batch_queue         m_Queue     ;   ///< Retired nodes handed off by workers
+
+        private:
+            ThreadGC *          m_pThreadGC ;   ///< ThreadGC of the reclaimer thread
+
+        public:
+            reclaimer_impl( GarbageCollector& gc, size_t nMaxBacklog )
+                : m_Queue( gc.getMaxRetiredPtrCount(), nMaxBacklog )
+                , m_pThreadGC( NULL )
+            {}
+
+        protected:
+            virtual void onStart()
+            {
+                m_pThreadGC = new ThreadGC  ;
+                m_pThreadGC->init() ;
+            }
+
+            virtual void reclaim()
+            {
+                batch_queue::batch * pBatch ;
+                while ( (pBatch = m_Queue.fetch()) != NULL ) {
+                    for ( size_t i = 0; i < pBatch->m_arr.size(); ++i )
+                        m_pThreadGC->pushRetired( pBatch->m_arr[i] )   ;
+                    m_Queue.recycle( pBatch )   ;
+                }
+            }
+
+            virtual void onStop()
+            {
+                m_pThreadGC->fini() ;
+                delete m_pThreadGC  ;
+                m_pThreadGC = NULL  ;
+            }
+        };
+
         GarbageCollector::GarbageCollector(
             size_t nHazardPtrCount,
             size_t nMaxThreadCount,
-            size_t nRetiredNodeArraySize
+            size_t nRetiredNodeArraySize,
+            bool bDeferredRC
             )
             : m_pListHead(NULL),
             m_bStatEnabled( true ),
             m_nHazardPointerCount( nHazardPtrCount ),
             m_nMaxThreadCount( nMaxThreadCount ),
-            m_nMaxRetiredPtrCount( nRetiredNodeArraySize )
+            m_nMaxRetiredPtrCount( nRetiredNodeArraySize ),
+            m_bDeferredRC( bDeferredRC ),
+            m_pReclaimer( NULL )
         {}
 
         GarbageCollector::~GarbageCollector()
         {
+            assert( m_pReclaimer.load<membar_relaxed>() == NULL )  ;
+
+            // The logs must be applied before any retired node is destroyed
+            for ( thread_list_node * pNode = atomics::load<membar_relaxed>( &m_pListHead ); pNode; pNode = pNode->m_pNext )
+                applyDeferredRC( pNode )    ;
+
             thread_list_node * pNode = atomics::load<membar_relaxed>( &m_pListHead ) ;
             while ( pNode ) {
                 assert( pNode->m_idOwner.load<membar_relaxed>() == cds::OS::nullThreadId() ) ;
@@ -58,7 +117,8 @@ namespace cds { namespace gc {
             size_t nHazardPtrCount,        // hazard pointers count
             size_t nMaxThreadCount,        // max thread count
             size_t nMaxNodeLinkCount,    // max HRC-pointer count in the HRC-container's item
-            size_t nMaxTransientLinks    // max HRC-container's item count that can point to deleting item of container
+            size_t nMaxTransientLinks,   // max HRC-container's item count that can point to deleting item of container
+            bool bDeferredRC            // deferred reference counting mode
             )
         {
             if ( !m_pGC ) {
@@ -71,19 +131,24 @@ namespace cds { namespace gc {
                 if ( nMaxTransientLinks == 0 )
                     nMaxTransientLinks = c_nHRCMaxTransientLinks    ;
 
-                size_t nRetiredNodeArraySize = nMaxThreadCount * ( nHazardPtrCount + nMaxNodeLinkCount + nMaxTransientLinks + 1 )    ;
+                // In deferred RC mode the nodes of the thread may be held by pending decrements of other threads
+                size_t nRetiredNodeArraySize = nMaxThreadCount * ( nHazardPtrCount + nMaxNodeLinkCount + nMaxTransientLinks + 1
+                    + ( bDeferredRC ? details::deferred_rc_log::c_nCapacity : 0 ))    ;
 
-                m_pGC = new GarbageCollector( nHazardPtrCount, nMaxThreadCount, nRetiredNodeArraySize ) ;
+                m_pGC = new GarbageCollector( nHazardPtrCount, nMaxThreadCount, nRetiredNodeArraySize, bDeferredRC ) ;
             }
         }
 
         void CDS_STDCALL GarbageCollector::Destruct()
         {
             if ( m_pGC ) {
+                m_pGC->enableReclaimer( false ) ;
                 {
                     ThreadGC tgc    ;
                     tgc.init()      ;
                     m_pGC->HelpScan( &tgc ) ;
+                    tgc.cleanUpLocal()      ;
+                    m_pGC->Scan( &tgc )     ;
                     tgc.fini()      ;
                 }
 
@@ -132,6 +197,14 @@ namespace cds { namespace gc {
             return NULL ;
         }
 
+        details::thread_descriptor * GarbageCollector::getCurrentThreadDesc()
+        {
+            cds::threading::ThreadData * pData = cds::threading::Manager::thread_data()  ;
+            if ( pData && pData->m_hrcManager )
+                return pData->m_hrcManager->m_pDesc ;
+            return NULL ;
+        }
+
         details::thread_descriptor * GarbageCollector::allocateHRCThreadDesc( ThreadGC * pThreadGC )
         {
             CDS_HRC_STATISTIC( ++m_Stat.m_AllocHRCThreadDesc )    ;
@@ -140,7 +213,18 @@ namespace cds { namespace gc {
             const cds::OS::ThreadId nullThreadId = cds::OS::nullThreadId() ;
             const cds::OS::ThreadId curThreadId  = cds::OS::getCurrentThreadId()    ;
 
-            // First try to reuse a retired (non-active) HP record
+            // First try the descriptors released recently
+            while ( (hprec = m_FreeRecCache.get()) != NULL ) {
+                if ( !hprec->m_idOwner.cas<membar_acq_rel>( nullThreadId, curThreadId ))
+                    continue    ;
+                CDS_HRC_STATISTIC( ++m_Stat.m_AllocHRCThreadDescCached )    ;
+                hprec->m_pOwner = pThreadGC        ;
+                hprec->m_bFree = false            ;
+                assert( hprec->m_hzp.size() == hprec->m_hzp.capacity() )  ;
+                return hprec    ;
+            }
+
+            // Try to reuse a retired (non-active) HP record
             for ( hprec = atomics::load<membar_acquire>( &m_pListHead ); hprec; hprec = hprec->m_pNext ) {
                 if ( !hprec->m_idOwner.cas<membar_acq_rel>( nullThreadId, curThreadId ))
                     continue    ;
@@ -171,6 +255,7 @@ namespace cds { namespace gc {
         {
             CDS_HRC_STATISTIC( ++m_Stat.m_RetireHRCThreadDesc )    ;
 
+            applyDeferredRC( pRec ) ;
             pRec->clear()   ;
             thread_list_node * pNode = static_cast<thread_list_node *>( pRec )  ;
             assert( pNode->m_hzp.size() == pNode->m_hzp.capacity() )  ;
@@ -183,18 +268,30 @@ namespace cds { namespace gc {
             assert( pNode->m_idOwner.load<membar_relaxed>() != cds::OS::nullThreadId() )  ;
             pNode->m_pOwner = NULL    ;
             pNode->m_idOwner.store<membar_release>( cds::OS::nullThreadId() ) ;
-            assert( pNode->m_hzp.size() == pNode->m_hzp.capacity() )  ;
+            m_FreeRecCache.put( pNode ) ;
+        }
+
+        void GarbageCollector::growHRCThreadDesc( details::thread_descriptor * pRec )
+        {
+            if ( !pRec->m_hzp.grow() )
+                throw HRCTooMany()  ;
+            CDS_HRC_STATISTIC( ++m_Stat.m_GrowHRCThreadDesc )    ;
         }
 
         void GarbageCollector::Scan( ThreadGC * pThreadGC )
         {
             CDS_HRC_STATISTIC( ++m_Stat.m_ScanCalls )    ;
+            gc::details::scan_timer timer( m_Stat.m_ScanTime, m_bStatEnabled )  ;
 
             typedef std::vector< ContainerNode * > PListType    ;
 
             details::thread_descriptor * pRec = pThreadGC->m_pDesc    ;
             assert( static_cast< thread_list_node *>( pRec )->m_idOwner.load<membar_relaxed>() == cds::OS::getCurrentThreadId() )    ;
 
+            // Own pending decrements must be visible before the reference counters are checked
+            applyDeferredRC( pRec ) ;
+            details::deferred_rc_log::scoped_bypass bypass( pRec->m_RCLog ) ;
+
             // Step 1: mark all pRec->m_arrRetired items as "traced"
             {
                 details::retired_vector::const_iterator itEnd = pRec->m_arrRetired.end() ;
@@ -218,14 +315,22 @@ namespace cds { namespace gc {
             assert( plist.size() == 0 ) ;
 
             // Stage 2: Scan HP list and insert non-null values to plist
+            // The descriptors that are not owned have no hazard pointers, they are skipped
             {
+                const cds::OS::ThreadId nullThreadId = cds::OS::nullThreadId()  ;
                 thread_list_node * pNode = atomics::load<membar_acquire>( &m_pListHead ) ;
 
                 while ( pNode ) {
-                    for ( size_t i = 0; i < m_nHazardPointerCount; ++i ) {
-                        ContainerNode * hptr = pNode->m_hzp[i]    ;
-                        if ( hptr )
-                            plist.push_back( hptr )        ;
+                    if ( pNode->m_idOwner.load<membar_acquire>() != nullThreadId ) {
+                        const size_t nBlockSize = pNode->m_hzp.blockSize()  ;
+                        for ( size_t nBlock = 0, nBlockCount = pNode->m_hzp.blockCount(); nBlock < nBlockCount; ++nBlock ) {
+                            ContainerNode * const * pHazards = pNode->m_hzp.block( nBlock )   ;
+                            for ( size_t i = 0; i < nBlockSize; ++i ) {
+                                ContainerNode * hptr = pHazards[i]  ;
+                                if ( hptr )
+                                    plist.push_back( hptr )        ;
+                            }
+                        }
                     }
                     pNode = pNode->m_pNext  ;
                 }
@@ -343,6 +448,9 @@ namespace cds { namespace gc {
         {
             CDS_HRC_STATISTIC( ++m_Stat.m_CleanUpAllCalls )    ;
 
+            applyDeferredRC( pThis->m_pDesc )   ;
+            details::deferred_rc_log::scoped_bypass bypass( pThis->m_pDesc->m_RCLog )  ;
+
             //const cds::OS::ThreadId nullThreadId = cds::OS::nullThreadId() ;
             thread_list_node * pThread = atomics::load<membar_acquire>( &m_pListHead ) ;
             while ( pThread ) {
@@ -360,6 +468,94 @@ namespace cds { namespace gc {
             }
         }
 
+        bool GarbageCollector::enableReclaimer( bool bEnable, size_t nMaxBacklog )
+        {
+            reclaimer_impl * pReclaimer = m_pReclaimer.load<membar_acquire>()  ;
+            bool bEnabled = pReclaimer != NULL    ;
+            if ( bEnable && !bEnabled ) {
+                pReclaimer = new reclaimer_impl( *this, nMaxBacklog ? nMaxBacklog : 1 )   ;
+                if ( pReclaimer->start() )
+                    m_pReclaimer.store<membar_release>( pReclaimer )  ;
+                else
+                    delete pReclaimer   ;
+            }
+            else if ( !bEnable && bEnabled ) {
+                m_pReclaimer.store<membar_release>( (reclaimer_impl *) NULL )  ;
+                pReclaimer->stop()  ;
+                delete pReclaimer   ;
+            }
+            return bEnabled ;
+        }
+
+        bool GarbageCollector::handOff( reclaimer_impl * pReclaimer, ThreadGC * pThreadGC )
+        {
+            if ( pReclaimer->isReclaimerThread() )
+                return false    ;
+
+            reclaimer_impl::batch_queue::batch * pBatch = pReclaimer->m_Queue.alloc()   ;
+            if ( !pBatch ) {
+                // The reclaimer falls behind
+                CDS_HRC_STATISTIC( ++m_Stat.m_HandOffReject )  ;
+                return false    ;
+            }
+
+            details::retired_vector& arr = pThreadGC->m_pDesc->m_arrRetired  ;
+            for ( size_t n = 0; n < arr.capacity(); ++n ) {
+                details::retired_node& node = arr[n]    ;
+                ContainerNode * pNode = node.m_pNode.load<membar_relaxed>()  ;
+                if ( pNode == NULL )
+                    continue    ;
+
+                // Exclude the slot from CleanUpAll of other threads like Scan does before the node is destroyed
+                if ( node.m_bDone.cas<membar_acquire>( false, true ) ) {
+                    while ( node.m_nClaim.value<membar_acquire>() != 0 )
+                        cds::OS::backoff()  ;
+                    arr.pop( n )    ;
+                    pBatch->m_arr.push_back( pNode )    ;
+                }
+            }
+
+            pReclaimer->m_Queue.post( pBatch )  ;
+            pReclaimer->wakeup()    ;
+            CDS_HRC_STATISTIC( ++m_Stat.m_HandOff )  ;
+            return true ;
+        }
+
+        void GarbageCollector::applyDeferredRC( details::thread_descriptor * pRec )
+        {
+            details::deferred_rc_log& log = pRec->m_RCLog   ;
+            if ( log.m_nCount ) {
+                // The counter may be transiently zero here: an increment may be still pending after the link CAS.
+                // This is the same as for immediate decrement, the node is guarded by the hazard pointer of the linking thread
+                for ( size_t i = 0; i < log.m_nCount; ++i )
+                    --log.m_arr[i]->m_RC    ;
+                log.m_nCount = 0    ;
+                CDS_HRC_STATISTIC( ++m_Stat.m_DeferredRCApply )  ;
+            }
+            if ( log.m_nLogged || log.m_nCancelled ) {
+                CDS_HRC_STATISTIC( m_Stat.m_DeferredDecRef += log.m_nLogged )  ;
+                CDS_HRC_STATISTIC( m_Stat.m_DeferredIncCancel += log.m_nCancelled )  ;
+                log.m_nLogged =
+                    log.m_nCancelled = 0    ;
+            }
+        }
+
+        bool GarbageCollector::deferDecRef( ContainerNode * pNode )
+        {
+            details::thread_descriptor * pRec = getCurrentThreadDesc()  ;
+            if ( !pRec || pRec->m_RCLog.isBypassed() )
+                return false    ;
+            if ( pRec->m_RCLog.push( pNode ))
+                m_pGC->applyDeferredRC( pRec )  ;
+            return true ;
+        }
+
+        bool GarbageCollector::cancelDecRef( ContainerNode * pNode )
+        {
+            details::thread_descriptor * pRec = getCurrentThreadDesc()  ;
+            return pRec && !pRec->m_RCLog.isBypassed() && pRec->m_RCLog.cancel( pNode )   ;
+        }
+
         GarbageCollector::internal_state& GarbageCollector::getInternalState( GarbageCollector::internal_state& stat) const
         {
             // Const
@@ -368,6 +564,7 @@ namespace cds { namespace gc {
             stat.nMaxRetiredPtrCount    = m_nMaxRetiredPtrCount    ;
             stat.nHRCRecSize            = sizeof( thread_list_node )
                                             + sizeof( details::retired_node) * m_nMaxRetiredPtrCount ;
+            stat.bDeferredRC            = m_bDeferredRC            ;
             stat.nHRCRecAllocated            =
                 stat.nHRCRecUsed             =
                 stat.nTotalRetiredPtrCount   =
@@ -388,15 +585,23 @@ namespace cds { namespace gc {
 
             // Events
             stat.evcAllocHRCRec            = m_Stat.m_AllocHRCThreadDesc   ;
+            stat.evcAllocHRCRecCached   = m_Stat.m_AllocHRCThreadDescCached ;
             stat.evcRetireHRCRec        = m_Stat.m_RetireHRCThreadDesc  ;
             stat.evcAllocNewHRCRec        = m_Stat.m_AllocNewHRCThreadDesc;
             stat.evcDeleteHRCRec        = m_Stat.m_DeleteHRCThreadDesc  ;
+            stat.evcGrowHRCRec          = m_Stat.m_GrowHRCThreadDesc    ;
             stat.evcScanCall            = m_Stat.m_ScanCalls            ;
             stat.evcHelpScanCalls       = m_Stat.m_HelpScanCalls        ;
             stat.evcCleanUpAllCalls     = m_Stat.m_CleanUpAllCalls      ;
             stat.evcDeletedNode         = m_Stat.m_DeletedNode          ;
             stat.evcScanGuarded         = m_Stat.m_ScanGuarded          ;
             stat.evcScanClaimGuarded    = m_Stat.m_ScanClaimGuarded     ;
+            stat.evcHandOff             = m_Stat.m_HandOff              ;
+            stat.evcHandOffReject       = m_Stat.m_HandOffReject        ;
+            stat.evcDeferredDecRef      = m_Stat.m_DeferredDecRef       ;
+            stat.evcDeferredIncCancel   = m_Stat.m_DeferredIncCancel    ;
+            stat.evcDeferredRCApply     = m_Stat.m_DeferredRCApply      ;
+            stat.fScanTime              = cds::OS::Timer().duration( m_Stat.m_ScanTime )  ;
 
 #       ifdef CDS_DEBUG
             stat.evcNodeConstruct       = m_Stat.m_NodeConstructed      ;
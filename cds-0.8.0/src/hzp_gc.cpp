@@ -19,6 +19,9 @@
 
 #include <cds/gc/hzp/hzp.h>
 #include <cds/details/markptr.h>
+#include <cds/gc/details/reclaimer.h>
+#include <cds/gc/details/scan_timer.h>
+#include <cds/os/timer.h>
 
 #include <algorithm>    // std::sort
 #include "hzp_const.h"
@@ -28,21 +31,76 @@
 namespace cds { namespace gc {
     namespace hzp {
 
-        /// Max array size of retired pointers
-        static const size_t c_nMaxRetireNodeCount = c_nHazardPointerPerThread * c_nMaxThreadCount * 2 ;
-
         GarbageCollector *    GarbageCollector::m_pHZPManager = NULL;
 
-        void CDS_STDCALL GarbageCollector::Construct( size_t nHazardPtrCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, scan_type nScanType )
+        bool details::hp_fence::s_bAsymmetric = false   ;
+
+        /// Background reclaimer of Hazard Pointer GC
+        /**
+            The reclaimer thread owns its own HP record. The retired pointers handed off by workers
+            are moved to the array of the record; when the array is full the reclaimer calls Scan and HelpScan
+            exactly like a worker does.
+        */
+        class GarbageCollector::reclaimer_impl: public cds::gc::details::reclaimer
+        {
+        public:
+            typedef cds::gc::details::retired_batch_queue<details::retired_ptr>  batch_queue ;
+
+            batch_queue         m_Queue ;   ///< Retired arrays handed off by workers
+
+        private:
+            GarbageCollector&   m_gc    ;
+            details::HPRec *    m_pRec  ;   ///< HP record of the reclaimer thread
+
+        public:
+            reclaimer_impl( GarbageCollector& gc, size_t nMaxBacklog )
+                : m_Queue( gc.getMaxRetiredPtrCount(), nMaxBacklog )
+                , m_gc( gc )
+                , m_pRec( NULL )
+            {}
+
+        protected:
+            virtual void onStart()
+            {
+                m_pRec = m_gc.AllocateHPRec()   ;
+            }
+
+            virtual void reclaim()
+            {
+                details::retired_vector& arr = m_pRec->m_arrRetired ;
+                batch_queue::batch * pBatch ;
+                while ( (pBatch = m_Queue.fetch()) != NULL ) {
+                    for ( size_t i = 0; i < pBatch->m_arr.size(); ++i ) {
+                        arr.push( pBatch->m_arr[i] )    ;
+                        if ( arr.size() >= m_gc.getScanThreshold() ) {
+                            m_gc.Scan( m_pRec )     ;
+                            m_gc.HelpScan( m_pRec ) ;
+                        }
+                    }
+                    m_Queue.recycle( pBatch )   ;
+                }
+            }
+
+            virtual void onStop()
+            {
+                if ( m_pRec->m_arrRetired.size() )
+                    m_gc.Scan( m_pRec ) ;
+                m_gc.RetireHPRec( m_pRec )  ;
+                m_pRec = NULL   ;
+            }
+        };
+
+        void CDS_STDCALL GarbageCollector::Construct( size_t nHazardPtrCount, size_t nMaxThreadCount, size_t nMaxRetiredPtrCount, scan_type nScanType, fence_type nFenceType )
         {
             if ( !m_pHZPManager ) {
-                m_pHZPManager = new GarbageCollector( nHazardPtrCount, nMaxThreadCount, nMaxRetiredPtrCount, nScanType )    ;
+                m_pHZPManager = new GarbageCollector( nHazardPtrCount, nMaxThreadCount, nMaxRetiredPtrCount, nScanType, nFenceType )    ;
             }
         }
 
         void CDS_STDCALL GarbageCollector::Destruct( bool bDetachAll )
         {
             if ( m_pHZPManager ) {
+                m_pHZPManager->enableReclaimer( false ) ;
                 if ( bDetachAll )
                     m_pHZPManager->detachAllThread()    ;
 
@@ -55,15 +113,22 @@ namespace cds { namespace gc {
             size_t nHazardPtrCount, 
             size_t nMaxThreadCount, 
             size_t nMaxRetiredPtrCount,
-            scan_type nScanType
+            scan_type nScanType,
+            fence_type nFenceType
         )
             : m_pListHead(NULL)
             ,m_bStatEnabled( true )
             ,m_nHazardPointerCount( nHazardPtrCount == 0 ? c_nHazardPointerPerThread : nHazardPtrCount )
             ,m_nMaxThreadCount( nMaxThreadCount == 0 ? c_nMaxThreadCount : nMaxThreadCount )
-            ,m_nMaxRetiredPtrCount( nMaxRetiredPtrCount > c_nMaxRetireNodeCount ? nMaxRetiredPtrCount : c_nMaxRetireNodeCount )
+            ,m_nMaxRetiredPtrCount( nMaxRetiredPtrCount )
             ,m_nScanType( nScanType )
-        {}
+            // asymmetric_fence::is_expedited registers the process for expedited membarrier
+            ,m_nFenceType( nFenceType == fence_asymmetric && cds::OS::asymmetric_fence::is_expedited() ? fence_asymmetric : fence_full )
+            ,m_nLiveHPCount( 0 )
+            ,m_pReclaimer( NULL )
+        {
+            details::hp_fence::s_bAsymmetric = m_nFenceType == fence_asymmetric ;
+        }
 
         GarbageCollector::~GarbageCollector()
         {
@@ -71,6 +136,7 @@ namespace cds { namespace gc {
             CDS_DEBUG_DO( const cds::OS::ThreadId mainThreadId = cds::OS::getCurrentThreadId() ;)
 
             //assert( mainThreadId == cds::OS::getMainThreadId() )    ;
+            assert( m_pReclaimer.load<membar_relaxed>() == NULL )  ;
             hplist_node * pHead = m_pListHead ;
             m_pListHead = NULL  ;
             hplist_node * pNext = NULL    ;
@@ -91,6 +157,7 @@ namespace cds { namespace gc {
                 hprec->m_bFree.store<membar_relaxed>( true )  ;
                 DeleteHPRec( hprec )    ;
             }
+            details::hp_fence::s_bAsymmetric = false    ;
         }
 
         inline GarbageCollector::hplist_node * GarbageCollector::NewHPRec()
@@ -119,11 +186,23 @@ namespace cds { namespace gc {
             hplist_node * hprec   ;
             const cds::OS::ThreadId nullThreadId = cds::OS::nullThreadId() ;
             const cds::OS::ThreadId curThreadId  = cds::OS::getCurrentThreadId()    ;
-            // First try to reuse a retired (non-active) HP record
+
+            // First try the records released recently
+            while ( (hprec = m_FreeRecCache.get()) != NULL ) {
+                if ( !hprec->m_idOwner.cas<membar_seq_cst>( nullThreadId, curThreadId ) )
+                    continue    ;
+                CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_AllocHPRecCached )    ;
+                hprec->m_bFree.store<membar_release>( false ) ;
+                m_nLiveHPCount.xadd<membar_relaxed>( hprec->m_hzp.capacity() )  ;
+                return hprec    ;
+            }
+
+            // Try to reuse a retired (non-active) HP record
             for ( hprec = atomics::load<membar_acquire>( &m_pListHead ); hprec; hprec = hprec->m_pNext.load<membar_acquire>() ) {
                 if ( !hprec->m_idOwner.cas<membar_seq_cst>( nullThreadId, curThreadId ) )
                     continue    ;
                 hprec->m_bFree.store<membar_release>( false ) ;
+                m_nLiveHPCount.xadd<membar_relaxed>( hprec->m_hzp.capacity() )  ;
                 return hprec    ;
             }
 
@@ -138,6 +217,7 @@ namespace cds { namespace gc {
                 hprec->m_pNext.store<membar_relaxed>( pOldHead ) ;    // CAS below orders memory access
             } while ( !atomics::cas<membar_release>( &m_pListHead, pOldHead, hprec ) ) ;
 
+            m_nLiveHPCount.xadd<membar_relaxed>( hprec->m_hzp.capacity() )  ;
             return hprec ;
         }
 
@@ -147,9 +227,60 @@ namespace cds { namespace gc {
             CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_RetireHPRec )    ;
 
             pRec->clear()   ;
+            m_nLiveHPCount.xadd<membar_relaxed>( 0 - pRec->m_hzp.capacity() )  ;
             hplist_node * pNode = static_cast<hplist_node *>( pRec )  ;
             //assert( pNode->m_idOwner.value() == cds::OS::getCurrentThreadId() )  ;
             pNode->m_idOwner.store<membar_release>( cds::OS::nullThreadId()) ;
+            m_FreeRecCache.put( pNode ) ;
+        }
+
+        void GarbageCollector::GrowHPRec( details::HPRec * pRec )
+        {
+            if ( !pRec->m_hzp.grow() )
+                throw HZPTooMany()  ;
+            CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_GrowHPRec )    ;
+            m_nLiveHPCount.xadd<membar_relaxed>( pRec->m_hzp.blockSize() )  ;
+        }
+
+        bool GarbageCollector::enableReclaimer( bool bEnable, size_t nMaxBacklog )
+        {
+            reclaimer_impl * pReclaimer = m_pReclaimer.load<membar_acquire>()  ;
+            bool bEnabled = pReclaimer != NULL    ;
+            if ( bEnable && !bEnabled ) {
+                pReclaimer = new reclaimer_impl( *this, nMaxBacklog ? nMaxBacklog : 1 )   ;
+                if ( pReclaimer->start() )
+                    m_pReclaimer.store<membar_release>( pReclaimer )  ;
+                else
+                    delete pReclaimer   ;
+            }
+            else if ( !bEnable && bEnabled ) {
+                m_pReclaimer.store<membar_release>( (reclaimer_impl *) NULL )  ;
+                pReclaimer->stop()  ;
+                delete pReclaimer   ;
+            }
+            return bEnabled ;
+        }
+
+        bool GarbageCollector::handOff( reclaimer_impl * pReclaimer, details::HPRec * pRec )
+        {
+            if ( pReclaimer->isReclaimerThread() )
+                return false    ;
+
+            reclaimer_impl::batch_queue::batch * pBatch = pReclaimer->m_Queue.alloc()   ;
+            if ( !pBatch ) {
+                // The reclaimer falls behind
+                CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_HandOffReject )  ;
+                return false    ;
+            }
+
+            details::retired_vector& arr = pRec->m_arrRetired   ;
+            pBatch->m_arr.assign( arr.begin(), arr.end() )  ;
+            arr.clear() ;
+
+            pReclaimer->m_Queue.post( pBatch )  ;
+            pReclaimer->wakeup()    ;
+            CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_HandOff )  ;
+            return true ;
         }
 
         void GarbageCollector::detachAllThread()
@@ -167,27 +298,36 @@ namespace cds { namespace gc {
         void GarbageCollector::classic_scan( details::HPRec * pRec )
         {
             CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_ScanCallCount )    ;
+            gc::details::scan_timer timer( m_Stat.m_ScanTime, m_bStatEnabled )  ;
 
-            std::vector< void * >   plist    ;
-            plist.reserve( m_nMaxThreadCount * m_nHazardPointerCount )  ;
-            assert( plist.size() == 0 ) ;
+            // The scan buffer is private for the current thread and is reused from scan to scan
+            details::hazard_set& plist = pRec->m_Hazards    ;
+            plist.reset( m_nLiveHPCount.load<membar_relaxed>() )  ;
 
             // Stage 1: Scan HP list and insert non-null values in plist
+            // The records that are not owned have no hazard pointers, they are skipped
 
+            const cds::OS::ThreadId nullThreadId = cds::OS::nullThreadId()  ;
             hplist_node * pNode = atomics::load<membar_acquire>( &m_pListHead )  ;
 
             while ( pNode ) {
-                for ( size_t i = 0; i < m_nHazardPointerCount; ++i ) {
-                    void * hptr = pNode->m_hzp[i]    ;
-                    if ( hptr )
-                        plist.push_back( hptr )        ;
+                if ( pNode->m_idOwner.load<membar_acquire>() != nullThreadId ) {
+                    const size_t nBlockSize = pNode->m_hzp.blockSize()  ;
+                    for ( size_t nBlock = 0, nBlockCount = pNode->m_hzp.blockCount(); nBlock < nBlockCount; ++nBlock ) {
+                        const HazardPtr * pHazards = pNode->m_hzp.block( nBlock )   ;
+                        for ( size_t i = 0; i < nBlockSize; ++i ) {
+                            void * hptr = pHazards[i]   ;
+                            if ( hptr )
+                                plist.push( hptr )  ;
+                        }
+                    }
                 }
                 pNode = pNode->m_pNext.load<membar_acquire>()   ;
             }
-            assert( plist.size() > 0 )    ;
+            CDS_HAZARDPTR_STATISTIC( m_Stat.m_ScanHazard += plist.size() )    ;
 
-            // Sort plist to simplify search in
-            std::sort( plist.begin(), plist.end() ) ;
+            // Build hash set of plist to simplify search in
+            plist.build()   ;
 
             // Stage 2: Search plist
             details::retired_vector& arrRetired = pRec->m_arrRetired    ;
@@ -198,10 +338,8 @@ namespace cds { namespace gc {
             // clear is just set up item counter to 0, the items is not destroying
             arrRetired.clear()    ;
 
-            std::vector< void * >::iterator itBegin = plist.begin()    ;
-            std::vector< void * >::iterator itEnd = plist.end()    ;
             while ( itRetired != itRetiredEnd ) {
-                if ( std::binary_search( itBegin, itEnd, itRetired->m_p) ) {
+                if ( plist.contains( itRetired->m_p ) ) {
                     CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_DeferredNode )    ;
                     arrRetired.push( *itRetired )    ;
                 }
@@ -226,27 +364,38 @@ namespace cds { namespace gc {
             for ( details::retired_vector::iterator it = itRetired; it != itRetiredEnd; ++it ) {
                 if ( cds::details::isMarkedBit<1>(it->m_p) ) {
                     // found a pointer with LSB bit set - use classic_scan
+                    // (it does not allocate memory after warm-up)
                     classic_scan( pRec )    ;
                     return ;
                 }
             }
+            gc::details::scan_timer timer( m_Stat.m_ScanTime, m_bStatEnabled )  ;
             
             // Sort retired pointer array
             std::sort( itRetired, itRetiredEnd, cds::gc::details::retired_ptr::less ) ;
 
             // Search guarded pointers in retired array
+            // The records that are not owned have no hazard pointers, they are skipped
 
+            const cds::OS::ThreadId nullThreadId = cds::OS::nullThreadId()  ;
             hplist_node * pNode = atomics::load<membar_acquire>( &m_pListHead )  ;
 
             while ( pNode ) {
-                for ( size_t i = 0; i < m_nHazardPointerCount; ++i ) {
-                    void * hptr = pNode->m_hzp[i]  ;
-                    if ( hptr ) {
-                        details::retired_ptr    dummyRetired ;
-                        dummyRetired.m_p = hptr ;
-                        details::retired_vector::iterator it = std::lower_bound( itRetired, itRetiredEnd, dummyRetired, cds::gc::details::retired_ptr::less ) ;
-                        if ( it != itRetiredEnd && it->m_p == hptr ) 
-                            it->m_p = cds::details::markBit<1>( it->m_p ) ;
+                if ( pNode->m_idOwner.load<membar_acquire>() != nullThreadId ) {
+                    const size_t nBlockSize = pNode->m_hzp.blockSize()  ;
+                    for ( size_t nBlock = 0, nBlockCount = pNode->m_hzp.blockCount(); nBlock < nBlockCount; ++nBlock ) {
+                        const HazardPtr * pHazards = pNode->m_hzp.block( nBlock )   ;
+                        for ( size_t i = 0; i < nBlockSize; ++i ) {
+                            void * hptr = pHazards[i]   ;
+                            if ( hptr ) {
+                                CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_ScanHazard )    ;
+                                details::retired_ptr    dummyRetired ;
+                                dummyRetired.m_p = hptr ;
+                                details::retired_vector::iterator it = std::lower_bound( itRetired, itRetiredEnd, dummyRetired, cds::gc::details::retired_ptr::less ) ;
+                                if ( it != itRetiredEnd && it->m_p == hptr ) 
+                                    it->m_p = cds::details::markBit<1>( it->m_p ) ;
+                            }
+                        }
                     }
                 }
                 pNode = pNode->m_pNext.load<membar_acquire>()   ;
@@ -297,12 +446,11 @@ namespace cds { namespace gc {
                 // If it has ones then we move to pThis that is private for current thread.
                 details::retired_vector& src = hprec->m_arrRetired    ;
                 details::retired_vector& dest = pThis->m_arrRetired   ;
-                assert( !dest.isFull())    ;
                 details::retired_vector::iterator itRetired = src.begin()    ;
                 details::retired_vector::iterator itRetiredEnd = src.end()    ;
                 while ( itRetired != itRetiredEnd ) {
                     dest.push( *itRetired ) ;
-                    if ( dest.isFull()) {
+                    if ( dest.size() >= getScanThreshold() ) {
                         CDS_HAZARDPTR_STATISTIC( ++m_Stat.m_CallScanFromHelpScan )    ;
                         Scan( pThis )   ;
                     }
@@ -321,7 +469,10 @@ namespace cds { namespace gc {
             stat.nMaxThreadCount         = m_nMaxThreadCount        ;
             stat.nMaxRetiredPtrCount     = m_nMaxRetiredPtrCount    ;
             stat.nHPRecSize              = sizeof( hplist_node )
-                                            + sizeof(details::retired_ptr) * m_nMaxRetiredPtrCount ;
+                                            + sizeof(HazardPtr) * m_nHazardPointerCount
+                                            + sizeof(details::retired_ptr) * m_nHazardPointerCount * 2 ;
+            stat.nLiveHPCount            = m_nLiveHPCount.load<membar_relaxed>() ;
+            stat.nScanThreshold          = getScanThreshold()       ;
 
             stat.nHPRecAllocated         =
                 stat.nHPRecUsed              =
@@ -344,9 +495,11 @@ namespace cds { namespace gc {
 
             // Events
             stat.evcAllocHPRec   = m_Stat.m_AllocHPRec  ;
+            stat.evcAllocHPRecCached = m_Stat.m_AllocHPRecCached    ;
             stat.evcRetireHPRec  = m_Stat.m_RetireHPRec ;
             stat.evcAllocNewHPRec= m_Stat.m_AllocNewHPRec   ;
             stat.evcDeleteHPRec  = m_Stat.m_DeleteHPRec ;
+            stat.evcGrowHPRec    = m_Stat.m_GrowHPRec   ;
 
             stat.evcScanCall     = m_Stat.m_ScanCallCount   ;
             stat.evcHelpScanCall = m_Stat.m_HelpScanCallCount   ;
@@ -354,6 +507,11 @@ namespace cds { namespace gc {
 
             stat.evcDeletedNode  = m_Stat.m_DeletedNode     ;
             stat.evcDeferredNode = m_Stat.m_DeferredNode    ;
+            stat.evcScanHazard   = m_Stat.m_ScanHazard      ;
+            stat.fScanTime       = cds::OS::Timer().duration( m_Stat.m_ScanTime )  ;
+
+            stat.evcHandOff      = m_Stat.m_HandOff         ;
+            stat.evcHandOffReject= m_Stat.m_HandOffReject   ;
 
             return stat ;
         }
@@ -0,0 +1,208 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+// Interval-based memory manager implementation
+
+#include <cds/gc/ibr/ibr.h>
+#include <cds/details/allocator.h>
+#include <cds/gc/details/scan_timer.h>
+
+#define    CDS_IBR_STATISTIC( _x )    if ( m_bStatEnabled ) { _x; }
+
+namespace cds { namespace gc { namespace ibr {
+
+    GarbageCollector * GarbageCollector::m_pManager = NULL  ;
+
+    void CDS_STDCALL GarbageCollector::Construct( size_t nEraFreq, size_t nScanThreshold )
+    {
+        if ( !m_pManager ) {
+            m_pManager = new GarbageCollector( nEraFreq, nScanThreshold ) ;
+        }
+    }
+
+    void CDS_STDCALL GarbageCollector::Destruct()
+    {
+        if ( m_pManager ) {
+            delete m_pManager   ;
+            m_pManager = NULL   ;
+        }
+    }
+
+    GarbageCollector::GarbageCollector( size_t nEraFreq, size_t nScanThreshold )
+        : m_pThreadList( NULL )
+        , m_bStatEnabled( true )
+        , m_nEraFreq( nEraFreq ? nEraFreq : 64 )
+        , m_nScanThreshold( nScanThreshold ? nScanThreshold : 128 )
+    {
+        m_nEra.store<membar_relaxed>( size_t(0) ) ;
+    }
+
+    GarbageCollector::~GarbageCollector()
+    {
+        // All threads are detached, so all retired pointers may be freed
+        cds::details::Allocator< details::thread_record > al   ;
+        details::thread_record * pNext ;
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_relaxed>(); pRec; pRec = pNext ) {
+            assert( pRec->m_bInUse.load<membar_relaxed>() == 0 )  ;
+            pNext = pRec->m_pNext   ;
+
+            details::retired_vector& arrRetired = pRec->m_arrRetired   ;
+            for ( size_t i = 0; i < arrRetired.size(); ++i ) {
+                arrRetired[i].m_ptr.free()  ;
+                CDS_IBR_STATISTIC( ++m_Stat.m_DeletedNode )    ;
+            }
+            al.Delete( pRec )   ;
+            CDS_IBR_STATISTIC( ++m_Stat.m_DeleteThreadRec )    ;
+        }
+    }
+
+    details::thread_record * GarbageCollector::allocRecord()
+    {
+        CDS_IBR_STATISTIC( ++m_Stat.m_AllocThreadRec )    ;
+
+        // Reuse the record of a detached thread together with its retired pointers
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_acquire>(); pRec; pRec = pRec->m_pNext ) {
+            if ( pRec->m_bInUse.load<membar_relaxed>() == 0 && pRec->m_bInUse.cas<membar_acquire>( 0, 1 ))
+                return pRec ;
+        }
+
+        // The list is never shrunk, so the ABA problem is impossible
+        details::thread_record * pRec = cds::details::Allocator< details::thread_record >().New() ;
+        details::thread_record * pHead ;
+        do {
+            pRec->m_pNext =
+                pHead = m_pThreadList.load<membar_acquire>()    ;
+        } while ( !m_pThreadList.cas<membar_release>( pHead, pRec ))    ;
+        CDS_IBR_STATISTIC( ++m_Stat.m_AllocNewThreadRec )    ;
+        return pRec ;
+    }
+
+    void GarbageCollector::freeRecord( details::thread_record * pRec )
+    {
+        CDS_IBR_STATISTIC( ++m_Stat.m_RetireThreadRec )    ;
+        pRec->m_nLower.store<membar_release>( details::c_nInactiveEra )  ;
+        pRec->m_bInUse.store<membar_release>( 0 )  ;
+    }
+
+    void GarbageCollector::Scan( details::thread_record * pThis )
+    {
+        CDS_IBR_STATISTIC( ++m_Stat.m_ScanCallCount )    ;
+        gc::details::scan_timer timer( m_Stat.m_ScanTime, m_bStatEnabled )  ;
+
+        // The fence orders the retiring of the pointers before reading the reservations
+        atomics::fence( membar_seq_cst::order ) ;
+
+        // Stage 1: collect the intervals reserved by the threads in critical region.
+        // The lower era is stored after the upper one, so the interval read is not narrower than the reserved one
+        std::vector<details::era_interval>& arrReserved = pThis->m_arrReserved  ;
+        arrReserved.clear() ;
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_acquire>(); pRec; pRec = pRec->m_pNext ) {
+            size_t nLower = pRec->m_nLower.load<membar_acquire>()   ;
+            if ( nLower != details::c_nInactiveEra )
+                arrReserved.push_back( details::era_interval( nLower, pRec->m_nUpper.load<membar_acquire>() )) ;
+        }
+
+        // Stage 2: free the pointers whose lifetime does not intersect any reserved interval
+        details::retired_vector& arrRetired = pThis->m_arrRetired   ;
+        size_t nKeep = 0    ;
+        for ( size_t i = 0; i < arrRetired.size(); ++i ) {
+            details::era_retired_ptr& p = arrRetired[i]    ;
+            bool bReserved = false  ;
+            for ( size_t k = 0; k < arrReserved.size(); ++k ) {
+                if ( arrReserved[k].intersects( p.m_nBirth, p.m_nRetire )) {
+                    bReserved = true    ;
+                    break   ;
+                }
+            }
+
+            if ( bReserved ) {
+                arrRetired[nKeep++] = p ;
+                CDS_IBR_STATISTIC( ++m_Stat.m_DeferredNode )    ;
+            }
+            else {
+                p.m_ptr.free()  ;
+                CDS_IBR_STATISTIC( ++m_Stat.m_DeletedNode )    ;
+            }
+        }
+        arrRetired.resize( nKeep )  ;
+    }
+
+    void GarbageCollector::HelpScan( details::thread_record * pThis )
+    {
+        CDS_IBR_STATISTIC( ++m_Stat.m_HelpScanCallCount )    ;
+
+        bool bAdopted = false   ;
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_acquire>(); pRec; pRec = pRec->m_pNext ) {
+            if ( pRec == pThis || pRec->m_bInUse.load<membar_relaxed>() != 0 || pRec->m_arrRetired.empty() )
+                continue    ;
+            // Own the free record for a while to move its retired pointers
+            if ( !pRec->m_bInUse.cas<membar_acquire>( 0, 1 ))
+                continue    ;
+
+            details::retired_vector& arrSrc = pRec->m_arrRetired   ;
+            pThis->m_arrRetired.insert( pThis->m_arrRetired.end(), arrSrc.begin(), arrSrc.end() )  ;
+            arrSrc.clear()  ;
+            pRec->m_bInUse.store<membar_release>( 0 )  ;
+            bAdopted = true ;
+        }
+
+        if ( bAdopted ) {
+            CDS_IBR_STATISTIC( ++m_Stat.m_CallScanFromHelpScan )    ;
+            Scan( pThis )   ;
+        }
+    }
+
+    GarbageCollector::InternalState& GarbageCollector::getInternalState( GarbageCollector::InternalState& stat) const
+    {
+        stat.nEraFreq                = m_nEraFreq           ;
+        stat.nMaxRetiredPtrCount     = m_nScanThreshold     ;
+        stat.nThreadRecSize          = sizeof( details::thread_record )
+                                        + sizeof(details::era_retired_ptr) * m_nScanThreshold ;
+        stat.nCurrentEra             = era()                ;
+
+        stat.nThreadRecAllocated     =
+            stat.nThreadRecUsed          =
+            stat.nTotalRetiredPtrCount   =
+            stat.nRetiredPtrInFreeThreadRecs = 0    ;
+
+        for ( details::thread_record * pRec = m_pThreadList.load<membar_acquire>(); pRec; pRec = pRec->m_pNext ) {
+            ++stat.nThreadRecAllocated  ;
+            stat.nTotalRetiredPtrCount += pRec->m_arrRetired.size()    ;
+
+            if ( pRec->m_bInUse.load<membar_relaxed>() == 0 ) {
+                // Free thread record
+                stat.nRetiredPtrInFreeThreadRecs += pRec->m_arrRetired.size()  ;
+            }
+            else {
+                // Used thread record
+                ++stat.nThreadRecUsed   ;
+            }
+        }
+
+        // Events
+        stat.evcAllocThreadRec   = m_Stat.m_AllocThreadRec  ;
+        stat.evcRetireThreadRec  = m_Stat.m_RetireThreadRec ;
+        stat.evcAllocNewThreadRec= m_Stat.m_AllocNewThreadRec   ;
+        stat.evcDeleteThreadRec  = m_Stat.m_DeleteThreadRec ;
+
+        stat.evcScanCall     = m_Stat.m_ScanCallCount   ;
+        stat.evcHelpScanCall = m_Stat.m_HelpScanCallCount   ;
+        stat.evcScanFromHelpScan= m_Stat.m_CallScanFromHelpScan ;
+
+        stat.evcDeletedNode  = m_Stat.m_DeletedNode     ;
+        stat.evcDeferredNode = m_Stat.m_DeferredNode    ;
+        stat.evcEraAdvance   = m_Stat.m_EraAdvance      ;
+
+        stat.fScanTime       = cds::OS::Timer().duration( m_Stat.m_ScanTime )  ;
+
+        return stat ;
+    }
+
+}}} // namespace cds::gc::ibr
@@ -12,6 +12,8 @@
 
 #include <cds/gc/ptb/ptb.h>
 #include <cds/details/markptr.h>
+#include <cds/gc/details/reclaimer.h>
+#include <cds/gc/details/scan_timer.h>
 
 #include <boost/tr1/unordered_set.hpp>
 #include <boost/intrusive/unordered_set.hpp>
@@ -81,6 +83,31 @@ namespace cds { namespace gc { namespace ptb {
 
     GarbageCollector * GarbageCollector::m_pManager = NULL  ;
 
+    /// Background reclaimer of PTB GC
+    /**
+        PTB keeps retired pointers in the global buffer, so nothing is handed off:
+        the reclaimer thread just calls \p liberate when it is woken up.
+    */
+    class GarbageCollector::reclaimer_impl: public cds::gc::details::reclaimer
+    {
+        GarbageCollector&   m_gc    ;
+
+    public:
+        const size_t        m_nMaxRetiredCount  ;   ///< max size of retired buffer to liberate in background
+
+    public:
+        reclaimer_impl( GarbageCollector& gc, size_t nMaxRetiredCount )
+            : m_gc( gc )
+            , m_nMaxRetiredCount( nMaxRetiredCount )
+        {}
+
+    protected:
+        virtual void reclaim()
+        {
+            m_gc.try_liberate() ;
+        }
+    };
+
     void CDS_STDCALL GarbageCollector::Construct(
         size_t nLiberateThreshold
         , size_t nInitialThreadGuardCount
@@ -94,6 +121,7 @@ namespace cds { namespace gc { namespace ptb {
     void CDS_STDCALL GarbageCollector::Destruct()
     {
         if ( m_pManager ) {
+            m_pManager->enableReclaimer( false )    ;
             delete m_pManager   ;
             m_pManager = NULL   ;
         }
@@ -102,11 +130,15 @@ namespace cds { namespace gc { namespace ptb {
     GarbageCollector::GarbageCollector( size_t nLiberateThreshold, size_t nInitialThreadGuardCount )
         : m_nLiberateThreshold( nLiberateThreshold ? nLiberateThreshold : 256 )
         , m_nInitialThreadGuardCount( nInitialThreadGuardCount ? nInitialThreadGuardCount : 8 )
+        , m_nRetiredBatchSize( m_nLiberateThreshold < c_nRetiredBatchSize ? m_nLiberateThreshold : c_nRetiredBatchSize )
+        , m_bStatEnabled( false )
+        , m_pReclaimer( NULL )
     {
     }
 
     GarbageCollector::~GarbageCollector()
     {
+        assert( m_pReclaimer.load<membar_relaxed>() == NULL )  ;
         liberate()  ;
 
         for ( details::guard_data * pGuard = m_GuardPool.begin(); pGuard; pGuard = pGuard->pGlobalNext.load<membar_relaxed>()) {
@@ -117,8 +149,39 @@ namespace cds { namespace gc { namespace ptb {
         }
     }
 
+    bool GarbageCollector::enableReclaimer( bool bEnable, size_t nMaxBacklog )
+    {
+        reclaimer_impl * pReclaimer = m_pReclaimer.load<membar_acquire>()  ;
+        bool bEnabled = pReclaimer != NULL    ;
+        if ( bEnable && !bEnabled ) {
+            pReclaimer = new reclaimer_impl( *this, m_nLiberateThreshold * ( nMaxBacklog ? nMaxBacklog : 1 ))   ;
+            if ( pReclaimer->start() )
+                m_pReclaimer.store<membar_release>( pReclaimer )  ;
+            else
+                delete pReclaimer   ;
+        }
+        else if ( !bEnable && bEnabled ) {
+            m_pReclaimer.store<membar_release>( (reclaimer_impl *) NULL )  ;
+            pReclaimer->stop()  ;
+            delete pReclaimer   ;
+        }
+        return bEnabled ;
+    }
+
+    bool GarbageCollector::wakeupReclaimer( reclaimer_impl * pReclaimer, size_t nRetiredCount )
+    {
+        if ( nRetiredCount >= pReclaimer->m_nMaxRetiredCount || pReclaimer->isReclaimerThread() )
+            return false    ;
+        pReclaimer->wakeup()  ;
+        return true ;
+    }
+
     void GarbageCollector::liberate()
     {
+        if ( m_bStatEnabled )
+            ++m_PoolStat.m_LiberateCall ;
+        gc::details::scan_timer timer( m_PoolStat.m_LiberateTime, m_bStatEnabled )  ;
+
         const size_t nBucketCount = 1 << ( beans::exp2Ceil( m_RetiredBuffer.size() ) + 1 ) ;
 
         cds::details::Allocator<details::liberate_set::bucket_type, CDS_DEFAULT_ALLOCATOR> al ;
@@ -166,6 +166,8 @@ namespace memory {
 
         TEST_ALLOC_STAT( michael_heap_stat,      MichaelHeap_Stat<int> )
         TEST_ALLOC( michael_heap_nostat,    MichaelHeap_NoStat<int> )
+        TEST_ALLOC_STAT( michael_heap_cached_stat,  MichaelHeap_Cached_Stat<int> )
+        TEST_ALLOC( michael_heap_cached_nostat,     MichaelHeap_Cached_NoStat<int> )
         TEST_ALLOC( std_alloc,              std_allocator<int> )
 
         TEST_ALLOC_STAT( michael_alignheap_stat,     t_MichaelAlignHeap_Stat )
@@ -176,6 +178,8 @@ namespace memory {
             CPPUNIT_TEST( std_alloc )
             CPPUNIT_TEST( michael_heap_stat )
             CPPUNIT_TEST( michael_heap_nostat )
+            CPPUNIT_TEST( michael_heap_cached_stat )
+            CPPUNIT_TEST( michael_heap_cached_nostat )
 
             CPPUNIT_TEST( system_aligned_alloc )
             CPPUNIT_TEST( michael_alignheap_stat )
@@ -11,6 +11,7 @@
 // Larson allocator test
 
 #include "alloc/michael_allocator.h"
+#include "alloc/perf_counters.h"
 
 #include <cds/os/timer.h>
 #include <cds/os/topology.h>
@@ -131,15 +132,23 @@ namespace memory {
                     }
             }
 
-            CppUnitMini::ThreadPool pool( *this )   ;
-            pool.add( new Thread<ALLOC>( pool, alloc ), nThreadCount ) ;
-            nThread = 0  ;
-            for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it )
-                static_cast<Thread<ALLOC> *>(*it)->m_arr = m_aThreadData[nThread++]    ;
-
-            cds::OS::Timer    timer    ;
-            pool.run()  ;
-            CPPUNIT_MSG( "  Duration=" << pool.avgDuration() ) ;
+            perf_counters   counters    ;
+            double          fDuration   ;
+            {
+                CppUnitMini::ThreadPool pool( *this )   ;
+                pool.add( new Thread<ALLOC>( pool, alloc ), nThreadCount ) ;
+                nThread = 0  ;
+                for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it )
+                    static_cast<Thread<ALLOC> *>(*it)->m_arr = m_aThreadData[nThread++]    ;
+
+                cds::OS::Timer    timer    ;
+                counters.start()    ;
+                pool.run()  ;
+                fDuration = pool.avgDuration()  ;
+            }
+            // The pool joins the threads; the counts of a thread are added to the counters when it exits
+            counters.stop() ;
+            CPPUNIT_MSG( "  Duration=" << fDuration << ", " << counters ) ;
 
             for ( nThread = 0; nThread < nThreadCount; ++nThread ) {
                 thread_data thData = m_aThreadData[nThread] ;
@@ -200,6 +209,10 @@ namespace memory {
 
         TEST_ALLOC_STAT( michael_heap_stat,      MichaelHeap_Stat<int> )
         TEST_ALLOC( michael_heap_nostat,    MichaelHeap_NoStat<int> )
+        TEST_ALLOC_STAT( michael_heap_cached_stat,  MichaelHeap_Cached_Stat<int> )
+        TEST_ALLOC( michael_heap_cached_nostat,     MichaelHeap_Cached_NoStat<int> )
+        TEST_ALLOC_STAT( michael_heap_hugepage_stat, MichaelHeap_HugePage_Stat<int> )
+        TEST_ALLOC_STAT( michael_heap_numa_stat,     MichaelHeap_Numa_Stat<int> )
         TEST_ALLOC( std_alloc,              std_allocator<int> )
 
         TEST_ALLOC_STAT( michael_alignheap_stat,     t_MichaelAlignHeap_Stat )
@@ -209,6 +222,10 @@ namespace memory {
         CPPUNIT_TEST_SUITE( Larson )
             CPPUNIT_TEST( michael_heap_stat )
             CPPUNIT_TEST( michael_heap_nostat )
+            CPPUNIT_TEST( michael_heap_cached_stat )
+            CPPUNIT_TEST( michael_heap_cached_nostat )
+            CPPUNIT_TEST( michael_heap_hugepage_stat )
+            CPPUNIT_TEST( michael_heap_numa_stat )
             CPPUNIT_TEST( std_alloc )
 
             CPPUNIT_TEST( system_aligned_alloc )
@@ -11,6 +11,7 @@
 // Linux scalability allocator test
 
 #include "alloc/michael_allocator.h"
+#include "alloc/perf_counters.h"
 
 #include <cds/os/timer.h>
 #include <cds/os/topology.h>
@@ -89,10 +90,18 @@ namespace memory {
             CPPUNIT_MSG( "   Block size=" << nSize )   ;
             s_nPassPerThread = s_nPassCount / nThreadCount  ;
 
-            CppUnitMini::ThreadPool pool( *this )   ;
-            pool.add( new Thread<ALLOC>( pool, alloc, nSize ), nThreadCount ) ;
-            pool.run()  ;
-            CPPUNIT_MSG( "      Duration=" << pool.avgDuration() ) ;
+            perf_counters   counters    ;
+            double          fDuration   ;
+            {
+                CppUnitMini::ThreadPool pool( *this )   ;
+                pool.add( new Thread<ALLOC>( pool, alloc, nSize ), nThreadCount ) ;
+                counters.start()    ;
+                pool.run()  ;
+                fDuration = pool.avgDuration()  ;
+            }
+            // The pool joins the threads; the counts of a thread are added to the counters when it exits
+            counters.stop() ;
+            CPPUNIT_MSG( "      Duration=" << fDuration << ", " << counters ) ;
         }
 
         template <class ALLOC>
@@ -144,6 +153,10 @@ namespace memory {
 
         TEST_ALLOC_STAT( michael_heap_stat,      MichaelHeap_Stat<char> )
         TEST_ALLOC( michael_heap_nostat,    MichaelHeap_NoStat<char> )
+        TEST_ALLOC_STAT( michael_heap_cached_stat,  MichaelHeap_Cached_Stat<char> )
+        TEST_ALLOC( michael_heap_cached_nostat,     MichaelHeap_Cached_NoStat<char> )
+        TEST_ALLOC_STAT( michael_heap_hugepage_stat, MichaelHeap_HugePage_Stat<char> )
+        TEST_ALLOC_STAT( michael_heap_numa_stat,     MichaelHeap_Numa_Stat<char> )
         TEST_ALLOC( std_alloc,              std_allocator<char> )
 
         TEST_ALLOC_STAT( michael_alignheap_stat,     t_MichaelAlignHeap_Stat )
@@ -153,6 +166,10 @@ namespace memory {
         CPPUNIT_TEST_SUITE( Linux_Scale )
             CPPUNIT_TEST( michael_heap_nostat )
             CPPUNIT_TEST( michael_heap_stat )
+            CPPUNIT_TEST( michael_heap_cached_nostat )
+            CPPUNIT_TEST( michael_heap_cached_stat )
+            CPPUNIT_TEST( michael_heap_hugepage_stat )
+            CPPUNIT_TEST( michael_heap_numa_stat )
             CPPUNIT_TEST( std_alloc )
 
             CPPUNIT_TEST( system_aligned_alloc )
@@ -13,4 +13,8 @@
 namespace memory {
     t_MichaelHeap_NoStat  s_MichaelHeap_NoStat  ;
     t_MichaelHeap_Stat    s_MichaelHeap_Stat  ;
+    t_MichaelHeap_Cached_NoStat  s_MichaelHeap_Cached_NoStat  ;
+    t_MichaelHeap_Cached_Stat    s_MichaelHeap_Cached_Stat  ;
+    t_MichaelHeap_HugePage_Stat  s_MichaelHeap_HugePage_Stat  ;
+    t_MichaelHeap_Numa_Stat      s_MichaelHeap_Numa_Stat  ;
 }
@@ -9,6 +9,7 @@
 
 
 #include <cds/memory/michael/allocator.h>
+#include <ostream>
 
 namespace memory {
     namespace ma = cds::memory::michael ;
@@ -28,10 +29,45 @@ namespace memory {
         ma::opt::check_bounds<ma::debug_bound_checking> 
     >  t_MichaelHeap_Stat    ;
 
+    // Heaps with per-thread cache
+    typedef ma::Heap<
+        ma::opt::procheap_stat<ma::procheap_empty_stat>, 
+        ma::opt::os_allocated_stat<ma::os_allocated_empty>,
+        ma::opt::check_bounds<ma::debug_bound_checking>,
+        ma::opt::thread_cache<ma::thread_magazine_cache<> >
+    >      t_MichaelHeap_Cached_NoStat  ;
+
+    typedef ma::Heap<
+        ma::opt::procheap_stat<ma::procheap_atomic_stat<> >, 
+        ma::opt::os_allocated_stat<ma::os_allocated_atomic<> >,
+        ma::opt::check_bounds<ma::debug_bound_checking>,
+        ma::opt::thread_cache<ma::thread_magazine_cache<> >,
+        ma::opt::thread_cache_stat<ma::thread_cache_atomic_stat<> >
+    >  t_MichaelHeap_Cached_Stat    ;
+
+    // Heaps with huge page superblocks
+    typedef ma::Heap<
+        ma::opt::procheap_stat<ma::procheap_atomic_stat<> >, 
+        ma::opt::os_allocated_stat<ma::os_allocated_atomic<> >,
+        ma::opt::check_bounds<ma::debug_bound_checking>,
+        ma::opt::page_heap<ma::huge_page_allocator<ma::huge_page_atomic_stat<> > >
+    >  t_MichaelHeap_HugePage_Stat    ;
+
+    typedef ma::Heap<
+        ma::opt::procheap_stat<ma::procheap_atomic_stat<> >, 
+        ma::opt::os_allocated_stat<ma::os_allocated_atomic<> >,
+        ma::opt::check_bounds<ma::debug_bound_checking>,
+        ma::opt::page_heap<ma::numa_page_allocator<ma::huge_page_atomic_stat<> > >
+    >  t_MichaelHeap_Numa_Stat    ;
+
     typedef ma::summary_stat            summary_stat   ;
 
     extern t_MichaelHeap_NoStat  s_MichaelHeap_NoStat  ;
     extern t_MichaelHeap_Stat    s_MichaelHeap_Stat  ;
+    extern t_MichaelHeap_Cached_NoStat  s_MichaelHeap_Cached_NoStat  ;
+    extern t_MichaelHeap_Cached_Stat    s_MichaelHeap_Cached_Stat  ;
+    extern t_MichaelHeap_HugePage_Stat  s_MichaelHeap_HugePage_Stat  ;
+    extern t_MichaelHeap_Numa_Stat      s_MichaelHeap_Numa_Stat  ;
 
     template <typename T>
     class MichaelHeap_NoStat
@@ -100,6 +136,114 @@ namespace memory {
         }
     };
 
+    template <typename T>
+    class MichaelHeap_Cached_NoStat
+    {
+    public:
+        typedef T value_type    ;
+        typedef T * pointer     ;
+
+        enum {
+            alignment = 1
+        };
+
+        pointer allocate( size_t nSize, const void * pHint )
+        {
+            return reinterpret_cast<pointer>( s_MichaelHeap_Cached_NoStat.alloc( sizeof(T) * nSize ) ) ;
+        }
+
+        void deallocate( pointer p, size_t nCount )
+        {
+            s_MichaelHeap_Cached_NoStat.free( p )    ;
+        }
+
+        static void stat(summary_stat& s)
+        {
+            s_MichaelHeap_Cached_NoStat.summaryStat(s) ;
+        }
+    };
+
+    template <typename T>
+    class MichaelHeap_Cached_Stat
+    {
+    public:
+        typedef T value_type    ;
+        typedef T * pointer     ;
+
+        enum {
+            alignment = 1
+        };
+
+        pointer allocate( size_t nSize, const void * pHint )
+        {
+            return reinterpret_cast<pointer>( s_MichaelHeap_Cached_Stat.alloc( sizeof(T) * nSize ) ) ;
+        }
+
+        void deallocate( pointer p, size_t nCount )
+        {
+            s_MichaelHeap_Cached_Stat.free( p )    ;
+        }
+
+        static void stat(summary_stat& s)
+        {
+            s_MichaelHeap_Cached_Stat.summaryStat(s) ;
+        }
+    };
+
+    template <typename T>
+    class MichaelHeap_HugePage_Stat
+    {
+    public:
+        typedef T value_type    ;
+        typedef T * pointer     ;
+
+        enum {
+            alignment = 1
+        };
+
+        pointer allocate( size_t nSize, const void * pHint )
+        {
+            return reinterpret_cast<pointer>( s_MichaelHeap_HugePage_Stat.alloc( sizeof(T) * nSize ) ) ;
+        }
+
+        void deallocate( pointer p, size_t nCount )
+        {
+            s_MichaelHeap_HugePage_Stat.free( p )    ;
+        }
+
+        static void stat(summary_stat& s)
+        {
+            s_MichaelHeap_HugePage_Stat.summaryStat(s) ;
+        }
+    };
+
+    template <typename T>
+    class MichaelHeap_Numa_Stat
+    {
+    public:
+        typedef T value_type    ;
+        typedef T * pointer     ;
+
+        enum {
+            alignment = 1
+        };
+
+        pointer allocate( size_t nSize, const void * pHint )
+        {
+            return reinterpret_cast<pointer>( s_MichaelHeap_Numa_Stat.alloc( sizeof(T) * nSize ) ) ;
+        }
+
+        void deallocate( pointer p, size_t nCount )
+        {
+            s_MichaelHeap_Numa_Stat.free( p )    ;
+        }
+
+        static void stat(summary_stat& s)
+        {
+            s_MichaelHeap_Numa_Stat.summaryStat(s) ;
+        }
+    };
+
     template <typename T, size_t ALIGN>
     class MichaelAlignHeap_NoStat
     {
@@ -199,7 +343,22 @@ namespace memory {
             << "\t updating active field of active block: " << s.nActiveDescCASFailureCount << "\n"
             << "\t updating anchor field of active block: " << s.nActiveAnchorCASFailureCount << "\n"
             << "\tupdating active field of partial block: " << s.nPartialDescCASFailureCount << "\n"
-            << "\tupdating anchor field of partial block: " << s.nPartialAnchorCASFailureCount 
+            << "\tupdating anchor field of partial block: " << s.nPartialAnchorCASFailureCount << "\n"
+            << "\tPer-thread cache\n"
+            << "\t                 alloc hit: " << s.nCacheAllocHit << "\n"
+            << "\t              refill count: " << s.nCacheRefillCount << "\n"
+            << "\t                  free hit: " << s.nCacheFreeHit << "\n"
+            << "\t               flush count: " << s.nCacheFlushCount << "\n"
+            << "\tRemote free\n"
+            << "\t        remote block count: " << s.nRemoteFreeCount << "\n"
+            << "\t        remote batch count: " << s.nRemoteBatchCount << "\n"
+            << "\t    remote list drain count: " << s.nRemoteDrainCount << "\n"
+            << "\tHuge page heap chunks\n"
+            << "\t        hugetlb (explicit): " << s.nHugeTLBChunkCount << "\n"
+            << "\t     transparent huge page: " << s.nTHPChunkCount << "\n"
+            << "\t             regular pages: " << s.nRegularChunkCount << "\n"
+            << "\t        bound to NUMA node: " << s.nNodeBindCount << "\n"
+            << "\t       NUMA binding failed: " << s.nNodeBindFailCount 
             << std::endl    ;
 
         return os   ;
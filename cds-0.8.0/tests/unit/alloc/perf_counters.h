@@ -0,0 +1,134 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#ifndef __UNIT_ALLOC_PERF_COUNTERS_H
+#define __UNIT_ALLOC_PERF_COUNTERS_H
+
+#include <cds/details/defs.h>
+#include <ostream>
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+#   include <linux/perf_event.h>
+#   include <sys/syscall.h>
+#   include <sys/ioctl.h>
+#   include <unistd.h>
+#   include <string.h>
+#endif
+
+namespace memory {
+
+    // Hardware counters of the allocator test: dTLB load misses and loads from remote NUMA node.
+    // The counters are opened by perf_event_open for the calling thread and inherited by the threads
+    // created after start(); the counts of a thread are added when the thread exits,
+    // so stop() must be called after the threads are joined.
+    // If the counter is not available (no PMU, perf_event_paranoid, virtualization) it is reported as n/a.
+    class perf_counters
+    {
+        enum {
+            counter_dtlb_miss,
+            counter_remote_node,
+            counter_count
+        };
+
+        int                 m_fd[counter_count]     ;
+        unsigned long long  m_nValue[counter_count] ;
+
+    public:
+        perf_counters()
+        {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            m_fd[counter_dtlb_miss] = open_counter( PERF_COUNT_HW_CACHE_DTLB )  ;
+            m_fd[counter_remote_node] = open_counter( PERF_COUNT_HW_CACHE_NODE )    ;
+#else
+            for ( int i = 0; i < counter_count; ++i )
+                m_fd[i] = -1    ;
+#endif
+            for ( int i = 0; i < counter_count; ++i )
+                m_nValue[i] = 0 ;
+        }
+
+        ~perf_counters()
+        {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            for ( int i = 0; i < counter_count; ++i ) {
+                if ( m_fd[i] >= 0 )
+                    ::close( m_fd[i] )  ;
+            }
+#endif
+        }
+
+        void start()
+        {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            for ( int i = 0; i < counter_count; ++i ) {
+                if ( m_fd[i] >= 0 ) {
+                    ::ioctl( m_fd[i], PERF_EVENT_IOC_RESET, 0 )     ;
+                    ::ioctl( m_fd[i], PERF_EVENT_IOC_ENABLE, 0 )    ;
+                }
+            }
+#endif
+        }
+
+        void stop()
+        {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            for ( int i = 0; i < counter_count; ++i ) {
+                if ( m_fd[i] >= 0 ) {
+                    ::ioctl( m_fd[i], PERF_EVENT_IOC_DISABLE, 0 )   ;
+                    if ( ::read( m_fd[i], m_nValue + i, sizeof(m_nValue[i]) ) != sizeof(m_nValue[i]) )
+                        m_nValue[i] = 0 ;
+                }
+            }
+#endif
+        }
+
+        friend std::ostream& operator <<( std::ostream& os, const perf_counters& c )
+        {
+            os << "dTLB misses=" ;
+            c.print( os, counter_dtlb_miss )    ;
+            os << ", remote node accesses=" ;
+            c.print( os, counter_remote_node )  ;
+            return os   ;
+        }
+
+    private:
+        void print( std::ostream& os, int nCounter ) const
+        {
+            if ( m_fd[nCounter] >= 0 )
+                os << m_nValue[nCounter]    ;
+            else
+                os << "n/a" ;
+        }
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+        static int open_counter( unsigned int nCache )
+        {
+#   ifdef SYS_perf_event_open
+            struct perf_event_attr attr ;
+            memset( &attr, 0, sizeof(attr) )    ;
+            attr.size = sizeof(attr)    ;
+            attr.type = PERF_TYPE_HW_CACHE  ;
+            attr.config = nCache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) ;
+            attr.disabled = 1   ;
+            attr.inherit = 1    ;
+            attr.exclude_kernel = 1 ;
+            attr.exclude_hv = 1 ;
+
+            return (int) syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 )  ;
+#   else
+            return -1   ;
+#   endif
+        }
+#endif
+    };
+
+}   // namespace memory
+
+#endif // #ifndef __UNIT_ALLOC_PERF_COUNTERS_H
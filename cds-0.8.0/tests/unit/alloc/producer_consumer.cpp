@@ -0,0 +1,376 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+// Producer/consumer allocator test: one thread allocates a block, another thread frees it
+
+#include "alloc/michael_allocator.h"
+
+#include <cds/os/timer.h>
+#include <cds/os/topology.h>
+#include <cds/queue/vyukov_mpmc_bounded.h>
+#include <cds/backoff_strategy.h>
+
+#include "cppunit/thread.h"
+
+namespace memory {
+
+    static size_t s_nPassCount = 1000000    ;
+    static size_t s_nMinBlockSize = 16      ;
+    static size_t s_nMaxBlockSize = 64      ;
+    static size_t s_nQueueSize = 1024       ;
+    static size_t s_nMaxPairCount = 4       ;
+
+    static size_t s_nPassPerProducer        ;
+
+#    define TEST_ALLOC(X, CLASS)        void X() { test< CLASS >(false)    ; }
+#    define TEST_ALLOC_STAT(X, CLASS)   void X() { test< CLASS >(true)     ; }
+
+    namespace ns_Producer_Consumer {
+
+        /// Two-processor topology: producers run on "processor" 0, consumers run on "processor" 1
+        /**
+            The topology emulates the ownership transfer between processors on any machine,
+            including single-processor one. The "processor" of the thread is stored in the extension
+            of thread's cds::threading::ThreadData.
+        */
+        struct pc_topology
+        {
+            static unsigned int processor_count()
+            {
+                return 2    ;
+            }
+
+            static unsigned int current_processor()
+            {
+                cds::threading::ThreadData * pData = cds::threading::Manager::thread_data()  ;
+                if ( pData ) {
+                    cds::threading::ThreadData::extension * pExt = pData->findExtension( &s_Key ) ;
+                    if ( pExt )
+                        return static_cast<processor_ext *>( pExt )->m_nProcessor  ;
+                }
+                return 0    ;
+            }
+
+            static unsigned int native_current_processor()
+            {
+                return current_processor()  ;
+            }
+
+            /// Binds current thread to "processor" \p nProcessor. The thread must be attached
+            static void bind( unsigned int nProcessor )
+            {
+                cds::threading::ThreadData * pData = cds::threading::Manager::thread_data()  ;
+                assert( pData != NULL ) ;
+                assert( pData->findExtension( &s_Key ) == NULL )    ;
+                pData->attachExtension( new processor_ext( nProcessor ))   ;
+            }
+
+        private:
+            struct processor_ext: public cds::threading::ThreadData::extension
+            {
+                unsigned int    m_nProcessor    ;
+
+                processor_ext( unsigned int nProcessor )
+                    : cds::threading::ThreadData::extension( &s_Key, destroy )
+                    , m_nProcessor( nProcessor )
+                {}
+
+                static void destroy( cds::threading::ThreadData::extension * pExt )
+                {
+                    delete static_cast<processor_ext *>( pExt ) ;
+                }
+            };
+
+            static char s_Key   ;
+        };
+        char pc_topology::s_Key = 0 ;
+
+        typedef ma::Heap<
+            ma::opt::sys_topology< pc_topology >,
+            ma::opt::procheap_stat<ma::procheap_atomic_stat<> >,
+            ma::opt::os_allocated_stat<ma::os_allocated_atomic<> >,
+            ma::opt::check_bounds<ma::debug_bound_checking>
+        >  t_Heap_Emulated    ;
+
+        typedef ma::Heap<
+            ma::opt::sys_topology< pc_topology >,
+            ma::opt::procheap_stat<ma::procheap_atomic_stat<> >,
+            ma::opt::os_allocated_stat<ma::os_allocated_atomic<> >,
+            ma::opt::check_bounds<ma::debug_bound_checking>,
+            ma::opt::remote_free< ma::remote_free_batch<> >
+        >  t_Heap_Emulated_Remote    ;
+
+        typedef ma::Heap<
+            ma::opt::procheap_stat<ma::procheap_atomic_stat<> >,
+            ma::opt::os_allocated_stat<ma::os_allocated_atomic<> >,
+            ma::opt::check_bounds<ma::debug_bound_checking>,
+            ma::opt::remote_free< ma::remote_free_batch<> >
+        >  t_Heap_Remote    ;
+
+        t_Heap_Emulated         s_Heap_Emulated         ;
+        t_Heap_Emulated_Remote  s_Heap_Emulated_Remote  ;
+        t_Heap_Remote           s_Heap_Remote           ;
+
+        template <typename T, typename HEAP, HEAP& s_Heap>
+        class heap_allocator
+        {
+        public:
+            typedef T value_type    ;
+            typedef T * pointer     ;
+
+            enum {
+                alignment = 1
+            };
+
+            pointer allocate( size_t nSize, const void * pHint )
+            {
+                return reinterpret_cast<pointer>( s_Heap.alloc( sizeof(T) * nSize ) ) ;
+            }
+
+            void deallocate( pointer p, size_t nCount )
+            {
+                s_Heap.free( p )    ;
+            }
+
+            static void stat(summary_stat& s)
+            {
+                s_Heap.summaryStat(s) ;
+            }
+        };
+
+        typedef cds::queue::vyukov_mpmc_bounded< void *,
+            cds::opt::buffer< cds::opt::v::dynamic_buffer< void * > >
+        >   ring_type   ;
+    }
+
+    /// Producer/consumer ownership transfer test
+    /**
+        The test runs pairs of threads. The producer allocates the blocks of size from s_nMinBlockSize to s_nMaxBlockSize
+        and passes them to its consumer through bounded queue, the consumer frees the blocks.
+        This is the memory pattern of the queue workloads where a node or a message allocated by one thread
+        is freed by another.
+
+        The "emulated" cases use two-processor topology (producers on processor 0, consumers on processor 1),
+        so each free is remote for Michael's heap regardless of the machine. The "remote" cases
+        use remote-free batching (see opt::remote_free).
+    */
+    class Producer_Consumer: public CppUnitMini::TestCase
+    {
+        typedef ns_Producer_Consumer::ring_type     ring_type   ;
+        typedef ns_Producer_Consumer::pc_topology   pc_topology ;
+
+        ring_type **    m_arrRing   ;
+
+        template <class ALLOC>
+        class Producer: public CppUnitMini::TestThread
+        {
+            ALLOC&      m_Alloc ;
+
+            virtual Producer *    clone()
+            {
+                return new Producer( *this )    ;
+            }
+        public:
+            Producer( CppUnitMini::ThreadPool& pool, ALLOC& a )
+                : CppUnitMini::TestThread( pool )
+                , m_Alloc( a )
+            {}
+            Producer( Producer& src )
+                : CppUnitMini::TestThread( src )
+                , m_Alloc( src.m_Alloc )
+            {}
+
+            Producer_Consumer&  getTest()
+            {
+                return reinterpret_cast<Producer_Consumer&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()   ;
+                pc_topology::bind( 0 )  ;
+            }
+            virtual void fini() { cds::threading::Manager::detachThread()   ; }
+
+            virtual void test()
+            {
+                ring_type& ring = *getTest().m_arrRing[ m_nThreadNo ]  ;
+                const size_t nSizeRange = s_nMaxBlockSize - s_nMinBlockSize + 1    ;
+                cds::backoff::yield bkoff   ;
+
+                for ( size_t i = 0; i < s_nPassPerProducer; ++i ) {
+                    size_t nSize = s_nMinBlockSize + (i * 37) % nSizeRange  ;
+                    char * p = reinterpret_cast<char *>( m_Alloc.allocate( nSize, NULL ))  ;
+                    CPPUNIT_ASSERT( p != NULL ) ;
+                    p[0] = p[nSize - 1] = char(i)   ;
+
+                    while ( !ring.enqueue( p ))
+                        bkoff() ;
+                }
+            }
+        };
+
+        template <class ALLOC>
+        class Consumer: public CppUnitMini::TestThread
+        {
+            ALLOC&      m_Alloc ;
+
+            virtual Consumer *    clone()
+            {
+                return new Consumer( *this )    ;
+            }
+        public:
+            size_t      m_nPairCount     ;
+            size_t      m_nFreed    ;
+
+        public:
+            Consumer( CppUnitMini::ThreadPool& pool, ALLOC& a, size_t nPairCount )
+                : CppUnitMini::TestThread( pool )
+                , m_Alloc( a )
+                , m_nPairCount( nPairCount )
+                , m_nFreed( 0 )
+            {}
+            Consumer( Consumer& src )
+                : CppUnitMini::TestThread( src )
+                , m_Alloc( src.m_Alloc )
+                , m_nPairCount( src.m_nPairCount )
+                , m_nFreed( 0 )
+            {}
+
+            Producer_Consumer&  getTest()
+            {
+                return reinterpret_cast<Producer_Consumer&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()   ;
+                pc_topology::bind( 1 )  ;
+            }
+            virtual void fini() { cds::threading::Manager::detachThread()   ; }
+
+            virtual void test()
+            {
+                // Consumers are added after m_nPairCount producers
+                ring_type& ring = *getTest().m_arrRing[ m_nThreadNo - m_nPairCount ]  ;
+                cds::backoff::yield bkoff   ;
+
+                m_nFreed = 0    ;
+                while ( m_nFreed < s_nPassPerProducer ) {
+                    void * p    ;
+                    if ( ring.dequeue( p )) {
+                        m_Alloc.deallocate( reinterpret_cast<typename ALLOC::value_type *>( p ), 1 )  ;
+                        ++m_nFreed  ;
+                    }
+                    else
+                        bkoff() ;
+                }
+            }
+        };
+
+        template <class ALLOC>
+        void test( size_t nPairCount )
+        {
+            ALLOC alloc ;
+
+            CPPUNIT_MSG( "Pair count=" << nPairCount )      ;
+
+            s_nPassPerProducer = s_nPassCount / nPairCount  ;
+
+            m_arrRing = new ring_type *[ nPairCount ]   ;
+            for ( size_t i = 0; i < nPairCount; ++i )
+                m_arrRing[i] = new ring_type( s_nQueueSize )    ;
+
+            CppUnitMini::ThreadPool pool( *this )   ;
+            pool.add( new Producer<ALLOC>( pool, alloc ), nPairCount ) ;
+            pool.add( new Consumer<ALLOC>( pool, alloc, nPairCount ), nPairCount ) ;
+
+            cds::OS::Timer    timer    ;
+            pool.run()  ;
+            double fDuration = timer.duration() ;
+            CPPUNIT_MSG( "  Duration=" << fDuration
+                << ", alloc/free pairs per sec=" << size_t( (s_nPassPerProducer * nPairCount) / (fDuration > 0 ? fDuration : 1e-9) ) ) ;
+
+            for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it ) {
+                Consumer<ALLOC> * pConsumer = dynamic_cast<Consumer<ALLOC> *>( *it )  ;
+                if ( pConsumer )
+                    CPPUNIT_CHECK( pConsumer->m_nFreed == s_nPassPerProducer )    ;
+            }
+
+            for ( size_t i = 0; i < nPairCount; ++i )
+                delete m_arrRing[i] ;
+            delete [] m_arrRing ;
+        }
+
+        template <class ALLOC>
+        void test( bool bStat )
+        {
+            CPPUNIT_MSG( "Block size=" << s_nMinBlockSize << "-" << s_nMaxBlockSize
+                << ", queue size=" << s_nQueueSize << ", pass count=" << s_nPassCount ) ;
+
+            for ( size_t nPairCount = 1; nPairCount <= s_nMaxPairCount; nPairCount *= 2 ) {
+                summary_stat stBegin    ;
+                if ( bStat )
+                    ALLOC::stat(stBegin)    ;
+
+                test<ALLOC>( nPairCount ) ;
+
+                if ( bStat ) {
+                    summary_stat    stEnd   ;
+                    ALLOC::stat( stEnd ) ;
+                    stEnd -= stBegin    ;
+                    std::cout << "\nDelta statistics:\n"
+                        << stEnd
+                        ;
+                }
+            }
+        }
+
+        void setUpParams( const CppUnitMini::TestCfg& cfg )
+        {
+            s_nPassCount = cfg.getULong( "PassCount", 1000000 )     ;
+            s_nMinBlockSize = cfg.getUInt( "MinBlockSize", 16 )     ;
+            s_nMaxBlockSize = cfg.getUInt( "MaxBlockSize", 64 )     ;
+            s_nQueueSize = cfg.getUInt( "QueueSize", 1024 )         ;
+            s_nMaxPairCount = cfg.getUInt( "MaxPairCount", 4 )      ;
+            if ( s_nMaxPairCount == 0 )
+                s_nMaxPairCount = cds::OS::topology::processor_count()  ;
+            if ( s_nMaxPairCount < 1 )
+                s_nMaxPairCount = 1 ;
+            if ( s_nMinBlockSize < 1 )
+                s_nMinBlockSize = 1 ;
+            if ( s_nMaxBlockSize < s_nMinBlockSize )
+                s_nMaxBlockSize = s_nMinBlockSize   ;
+        }
+
+        typedef ns_Producer_Consumer::heap_allocator< int,
+            ns_Producer_Consumer::t_Heap_Emulated, ns_Producer_Consumer::s_Heap_Emulated >    t_Heap_Emulated ;
+        typedef ns_Producer_Consumer::heap_allocator< int,
+            ns_Producer_Consumer::t_Heap_Emulated_Remote, ns_Producer_Consumer::s_Heap_Emulated_Remote >  t_Heap_Emulated_Remote  ;
+        typedef ns_Producer_Consumer::heap_allocator< int,
+            ns_Producer_Consumer::t_Heap_Remote, ns_Producer_Consumer::s_Heap_Remote >    t_Heap_Remote   ;
+
+        TEST_ALLOC_STAT( michael_heap_stat,             MichaelHeap_Stat<int> )
+        TEST_ALLOC_STAT( michael_heap_remote,           t_Heap_Remote )
+        TEST_ALLOC_STAT( michael_heap_emulated,         t_Heap_Emulated )
+        TEST_ALLOC_STAT( michael_heap_emulated_remote,  t_Heap_Emulated_Remote )
+        TEST_ALLOC( std_alloc,                          std_allocator<int> )
+
+        CPPUNIT_TEST_SUITE( Producer_Consumer )
+            CPPUNIT_TEST( michael_heap_stat )
+            CPPUNIT_TEST( michael_heap_remote )
+            CPPUNIT_TEST( michael_heap_emulated )
+            CPPUNIT_TEST( michael_heap_emulated_remote )
+            CPPUNIT_TEST( std_alloc )
+        CPPUNIT_TEST_SUITE_END();
+    };
+
+}   // namespace memory
+CPPUNIT_TEST_SUITE_REGISTRATION( memory::Producer_Consumer ) ;
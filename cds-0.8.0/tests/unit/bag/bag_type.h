@@ -12,7 +12,8 @@
 #define __UNIT_BAG_TYPES_H
 
 #include <cds/queue/ffqueue_sentinel.h>
-#include <cds/bag/sbag_hrc_gccthread.h>
+#include <cds/bag/sbag_hrc_gccthread.h>
+#include <cds/queue/vyukov_mpmc_bounded.h>
 
 
 #include "lock/win32_lock.h"
@@ -20,10 +21,38 @@
 
 namespace bag {
 
+    // Bag interface adapter for bounded queues; add() waits while the queue is full
+    template <typename VALUE>
+    class VyukovMPMCBoundedBag
+        : public cds::queue::vyukov_mpmc_bounded< VALUE, cds::opt::buffer< cds::opt::v::dynamic_buffer< VALUE > > >
+    {
+        typedef cds::queue::vyukov_mpmc_bounded< VALUE, cds::opt::buffer< cds::opt::v::dynamic_buffer< VALUE > > > base_class ;
+    public:
+        VyukovMPMCBoundedBag( size_t nCapacity )
+            : base_class( nCapacity )
+        {}
+
+        bool add( VALUE& data )
+        {
+            cds::backoff::yield bkoff   ;
+            while ( !base_class::enqueue( data ))
+                bkoff() ;
+            return true ;
+        }
+
+        bool tryRemoveAny( VALUE& data )
+        {
+            return base_class::dequeue( data )  ;
+        }
+
+        void initThread( int /*threadId*/ ) {}
+    };
+
     template <typename VALUE, int NR_THREADS>
     struct Types {
         typedef cds::bag::SBag<cds::gc::hrc_gc, VALUE, NR_THREADS>           SBag_HRC        ;
         typedef cds::queue::FastForwardQueue<VALUE, 64000>           FFQueue        ;
+        typedef VyukovMPMCBoundedBag<VALUE>                           VyukovMPMCBounded   ;
     };
 }
 
@@ -38,10 +38,12 @@ namespace bag {
 
 
 #define TEST_CASE( B, V, N ) void B() { test< Types<V, N>::B >(); }
+#define TEST_BOUNDED( B, V, N ) void B() { test_bounded< Types<V, N>::B >(); }
 
     namespace {
         static size_t s_nReaderThreadCount = 1  ;
         static size_t s_nWriterThreadCount = 1  ;
+        static size_t s_nQueueCapacity = 65536  ;   // for bounded queues
         static size_t s_nElementCount = 512000000   ;
         static size_t s_nRepetitionCount = 2  ;
 
@@ -173,6 +175,21 @@ namespace bag {
     protected:
         template <class BAG>
         void test()
+        {
+            Cacheline sentinel = { -1 };
+            BAG testBag ( sentinel ) ;
+            run( testBag ) ;
+        }
+
+        template <class BAG>
+        void test_bounded()
+        {
+            BAG testBag ( s_nQueueCapacity ) ;
+            run( testBag ) ;
+        }
+
+        template <class BAG>
+        void run( BAG& testBag )
         {
             double times[s_nRepetitionCount];
             m_nThreadPushCount = s_nElementCount / 8   ; // 8 = sizeof(Cacheline)
@@ -181,8 +198,6 @@ namespace bag {
                 " writer count=" << s_nWriterThreadCount << " element count=" << m_nThreadPushCount
                 << "..." << std::endl)   ;
 
-            Cacheline sentinel = { -1 };
-            BAG testBag ( sentinel ) ;
             CppUnitMini::ThreadPool pool( *this )   ;
 
             // For now we are hardcoding the number of threads because of NR_THREADS template param
@@ -225,16 +240,19 @@ namespace bag {
         void setUpParams( const CppUnitMini::TestCfg& cfg ) {
             s_nReaderThreadCount = cfg.getULong("ReaderCount", 1 ) ;
             s_nWriterThreadCount = cfg.getULong("WriterCount", 1 ) ;
-            s_nElementCount = cfg.getULong("ElementCount", 64000000 );
+            s_nElementCount = cfg.getULong("ElementCount", 64000000 );
+            s_nQueueCapacity = cfg.getULong("QueueCapacity", 65536 );
             s_nRepetitionCount = cfg.getULong("RepetitionCount", 2 );
         }
 
     protected:
-        TEST_CASE( SBag_HRC, Cacheline, 2 )
+        TEST_CASE( SBag_HRC, Cacheline, 2 )
+        TEST_BOUNDED( VyukovMPMCBounded, Cacheline, 2 )
         TEST_CASE( FFQueue, Cacheline, 2 )
 
         CPPUNIT_TEST_SUITE(Bag_Membench_Cacheline_MT)
-            CPPUNIT_TEST(SBag_HRC)              ;
+            CPPUNIT_TEST(SBag_HRC)              ;
+            CPPUNIT_TEST(VyukovMPMCBounded)     ;
             CPPUNIT_TEST(FFQueue)              ;
         CPPUNIT_TEST_SUITE_END();
     };
@@ -17,10 +17,12 @@
 namespace bag {
 
 #define TEST_CASE( B, V, N ) void B() { test< Types<V, N>::B >(); }
+#define TEST_BOUNDED( B, V, N ) void B() { test_bounded< Types<V, N>::B >(); }
 
     namespace {
         static size_t s_nReaderThreadCount = 1  ;
         static size_t s_nWriterThreadCount = 1  ;
+        static size_t s_nQueueCapacity = 65536  ;   // for bounded queues
         static size_t s_nElementCount = 64000000   ;
         static size_t s_nRepetitionCount = 2  ;
 
@@ -143,6 +145,21 @@ namespace bag {
     protected:
         template <class BAG>
         void test()
+        {
+            Value sentinel = { -1 };
+            BAG testBag ( sentinel ) ;
+            run( testBag ) ;
+        }
+
+        template <class BAG>
+        void test_bounded()
+        {
+            BAG testBag ( s_nQueueCapacity ) ;
+            run( testBag ) ;
+        }
+
+        template <class BAG>
+        void run( BAG& testBag )
         {
             double times[s_nRepetitionCount];
             m_nThreadPushCount = s_nElementCount;
@@ -151,8 +168,6 @@ namespace bag {
                 " writer count=" << s_nWriterThreadCount << " element count=" << m_nThreadPushCount
                 << "..." << std::endl)   ;
 
-            Value sentinel = { -1 };
-            BAG testBag ( sentinel ) ;
             CppUnitMini::ThreadPool pool( *this )   ;
 
             // For now we are hardcoding the number of threads because of NR_THREADS template param
@@ -191,15 +206,18 @@ namespace bag {
         void setUpParams( const CppUnitMini::TestCfg& cfg ) {
             s_nReaderThreadCount = cfg.getULong("ReaderCount", 1 ) ;
             s_nWriterThreadCount = cfg.getULong("WriterCount", 1 ) ;
-            s_nElementCount = cfg.getULong("ElementCount", 64000000 );
+            s_nElementCount = cfg.getULong("ElementCount", 64000000 );
+            s_nQueueCapacity = cfg.getULong("QueueCapacity", 65536 );
             s_nRepetitionCount = cfg.getULong("RepetitionCount", 2 );
         }
 
     protected:
         TEST_CASE( SBag_HRC, Value, 2 )
+        TEST_BOUNDED( VyukovMPMCBounded, Value, 2 )
 
         CPPUNIT_TEST_SUITE(Bag_Membench_MT)
             CPPUNIT_TEST(SBag_HRC)              ;
+            CPPUNIT_TEST(VyukovMPMCBounded)     ;
         CPPUNIT_TEST_SUITE_END();
     };
 
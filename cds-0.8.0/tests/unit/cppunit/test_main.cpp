@@ -38,6 +38,8 @@
 #include <cds/gc/hzp/gc.h>
 #include <cds/gc/hrc/gc.h>
 #include <cds/gc/ptb/gc.h>
+#include <cds/gc/epoch/gc.h>
+#include <cds/gc/ibr/gc.h>
 #include <cds/os/topology.h>
 
 #include "stdio.h"
@@ -60,16 +62,43 @@ std::ostream& operator << (std::ostream& s, const cds::gc::hzp::GarbageCollector
         << "\n\t\tHP records used=" << stat.nHPRecUsed
         << "\n\t\tTotal retired ptr count=" << stat.nTotalRetiredPtrCount
         << "\n\t\tRetired ptr in free HP records=" << stat.nRetiredPtrInFreeHPRecs
+        << "\n\t\tHazard pointers of attached threads=" << stat.nLiveHPCount
+        << "\n\t\tScan threshold=" << stat.nScanThreshold
         << "\n\tEvents:"
         << "\n\t\tHPRec allocations=" << stat.evcAllocHPRec
+        << "\n\t\tHPRec allocations from free-record cache=" << stat.evcAllocHPRecCached
         << "\n\t\tHPRec retire events=" << stat.evcRetireHPRec
         << "\n\t\tnew HPRec allocations from heap=" << stat.evcAllocNewHPRec
         << "\n\t\tHPRec deletions=" << stat.evcDeleteHPRec
+        << "\n\t\tHPRec HP block allocations=" << stat.evcGrowHPRec
         << "\n\t\tScan calling=" << stat.evcScanCall
         << "\n\t\tHelpScan calling=" << stat.evcHelpScanCall
         << "\n\t\tScan calls from HelpScan=" << stat.evcScanFromHelpScan
         << "\n\t\tretired objects deleting=" << stat.evcDeletedNode
         << "\n\t\tguarded objects on Scan=" << stat.evcDeferredNode
+        << "\n\t\thazard pointers seen on Scan=" << stat.evcScanHazard
+        << "\n\t\ttotal Scan time, sec=" << stat.fScanTime
+        << "\n\t\tretired arrays handed off to reclaimer=" << stat.evcHandOff
+        << "\n\t\thand-offs rejected by reclaimer=" << stat.evcHandOffReject
+        << std::endl ;
+
+    return s;
+}
+
+std::ostream& operator << (std::ostream& s, const cds::gc::ptb::GarbageCollector::InternalState& stat)
+{
+    s << "\nPTB GC internal state:"
+        << "\n\t\tRetired batch size=" << stat.nRetiredBatchSize
+        << "\n\tGlobal pool traffic:"
+        << "\n\t\tguard batches allocated=" << stat.evcGuardAllocList
+        << "\n\t\tguards allocated=" << stat.evcGuardAlloc
+        << "\n\t\tguard lists freed=" << stat.evcGuardFreeList
+        << "\n\t\tretired node batches allocated=" << stat.evcRetiredAllocList
+        << "\n\t\tretired node caches freed=" << stat.evcRetiredFreeList
+        << "\n\t\tretired batches pushed=" << stat.evcRetiredPushList
+        << "\n\t\tretired pointers pushed=" << stat.evcRetiredPush
+        << "\n\tliberate calling=" << stat.evcLiberateCall
+        << "\n\ttotal liberate time, sec=" << stat.fLiberateTime
         << std::endl ;
 
     return s;
@@ -84,15 +113,23 @@ std::ostream& operator << (std::ostream& s, const cds::gc::hrc::GarbageCollector
         << "\n\t\tRetired ptr in free HRC records=" << stat.nRetiredPtrInFreeHRCRecs
         << "\n\tEvents:"
         << "\n\t\tHRCrec allocations=" << stat.evcAllocHRCRec
+        << "\n\t\tHRCrec allocations from free-record cache=" << stat.evcAllocHRCRecCached
         << "\n\t\tHRCrec retire events=" << stat.evcRetireHRCRec
         << "\n\t\tnew HRCrec allocations from heap=" << stat.evcAllocNewHRCRec
         << "\n\t\tHRCrec deletions=" << stat.evcDeleteHRCRec
+        << "\n\t\tHRCrec HP block allocations=" << stat.evcGrowHRCRec
         << "\n\t\tScan calling=" << stat.evcScanCall
         << "\n\t\tHelpScan calling=" << stat.evcHelpScanCalls
         << "\n\t\tCleanUpAll calling=" << stat.evcCleanUpAllCalls
         << "\n\t\tretired objects deleting=" << stat.evcDeletedNode
         << "\n\t\tguarded nodes on Scan=" << stat.evcScanGuarded
         << "\n\t\tclaimed node on Scan=" << stat.evcScanClaimGuarded
+        << "\n\t\tretired arrays handed off to reclaimer=" << stat.evcHandOff
+        << "\n\t\thand-offs rejected by reclaimer=" << stat.evcHandOffReject
+        << "\n\t\tdeferred RC decrements=" << stat.evcDeferredDecRef
+        << "\n\t\tRC increments cancelled by deferred decrement=" << stat.evcDeferredIncCancel
+        << "\n\t\tdeferred RC batches applied=" << stat.evcDeferredRCApply
+        << "\n\t\ttotal Scan time, sec=" << stat.fScanTime
 #ifdef _DEBUG
         << "\n\t\tnode constructed count=" << stat.evcNodeConstruct
         << "\n\t\tnode destructed count=" << stat.evcNodeDestruct
@@ -146,6 +183,11 @@ namespace CppUnitMini
               cds::gc::hrc::GarbageCollector::internal_state stat  ;
               std::cout << cds::gc::hrc::GarbageCollector::instance().getInternalState( stat ) << std::endl ;
           }
+
+          {
+              cds::gc::ptb::GarbageCollector::InternalState stat  ;
+              std::cout << cds::gc::ptb::GarbageCollector::instance().getInternalState( stat ) << std::endl ;
+          }
       }
   }
 
@@ -351,17 +393,34 @@ int main(int argc, char** argv)
   // Init CDS runtime
   cds::Initialize() ;
 
+  // HZP fence mode is defined at GC construction time
+  cds::gc::hzp::fence_type nHZPFence = cds::gc::hzp::fence_full ;
+  {
+      CppUnitMini::TestCfg& cfg = CppUnitMini::TestCase::m_Cfg.get( "General" )    ;
+      std::string strHZPFence = cfg.get( "HZP_fence", std::string("full") ) ;
+      if ( strHZPFence == "asymmetric" )
+          nHZPFence = cds::gc::hzp::fence_asymmetric ;
+      else if ( strHZPFence != "full" )
+          std::cout << "Error value of HZP_fence in General section of test config\n" ;
+  }
+
+  // HRC deferred reference counting mode is defined at GC construction time too
+  bool bHRCDeferredRC = CppUnitMini::TestCase::m_Cfg.get( "General" ).getBool( "HRC_deferred_rc", false ) ;
+
   int num_errors;
   {
-      cds::gc::hzp::GC hzpGC    ;
-      cds::gc::hrc::GC hrcGC    ;
+      cds::gc::hzp::GC hzpGC( 0, 0, 0, cds::gc::hzp::inplace, nHZPFence )    ;
+      cds::gc::hrc::GC hrcGC( 0, 0, 0, 0, bHRCDeferredRC )    ;
       cds::gc::ptb::GC ptbGC    ;
+      cds::gc::epoch::GC epochGC    ;
+      cds::gc::ibr::GC ibrGC    ;
 
       // System topology
       {
           std::cout 
               << "System topology:\n"
               << "    Logical processor count: " << cds::OS::topology::processor_count() << "\n"
+              << "    HZP fence: " << (cds::gc::hzp::GarbageCollector::instance().getFenceType() == cds::gc::hzp::fence_asymmetric ? "asymmetric (membarrier)" : "full") << "\n"
               ;
           std::cout << std::endl ;
       }
@@ -376,6 +435,19 @@ int main(int argc, char** argv)
         else {
             std::cout << "Error value of HZP_scan_strategy in General section of test config\n" ;
         }
+
+        // Background reclaimer thread of HZP, HRC and PTB GC
+        if ( cfg.getBool( "GC_reclaimer", false )) {
+            size_t nBacklog = cfg.getULong( "GC_reclaimer_backlog", 16 ) ;
+            cds::gc::hzp::GarbageCollector::instance().enableReclaimer( true, nBacklog ) ;
+            cds::gc::hrc::GarbageCollector::instance().enableReclaimer( true, nBacklog ) ;
+            cds::gc::ptb::GarbageCollector::instance().enableReclaimer( true, nBacklog ) ;
+        }
+        std::cout << "GC reclaimer: " << (cds::gc::hzp::GarbageCollector::instance().isReclaimerEnabled() ? "on" : "off") << "\n" << std::endl ;
+
+        // PTB pool traffic statistics is disabled by default
+        if ( CppUnitMini::TestCase::m_bPrintGCState )
+            cds::gc::ptb::GarbageCollector::instance().enableStatistics( true ) ;
       }
 
       if ( CppUnitMini::TestCase::m_bPrintGCState ) {
@@ -383,10 +455,10 @@ int main(int argc, char** argv)
         cds::gc::hzp::GarbageCollector::instance().getInternalState( stat )     ;
 
         std::cout << "HZP GC constants:"
-            << "\n\tHP count per thread=" << stat.nHPCount
-            << "\n\tMax thread count=" << stat.nMaxThreadCount
-            << "\n\tMax retired pointer count per thread=" << stat.nMaxRetiredPtrCount
-            << "\n\tHP record size in bytes=" << stat.nHPRecSize
+            << "\n\tInitial HP count per thread=" << stat.nHPCount
+            << "\n\tExpected thread count=" << stat.nMaxThreadCount
+            << "\n\tScan threshold limit (0 - no limit)=" << stat.nMaxRetiredPtrCount
+            << "\n\tInitial HP record size in bytes=" << stat.nHPRecSize
             << "\n" << std::endl ;
       }
 
@@ -395,10 +467,11 @@ int main(int argc, char** argv)
           cds::gc::hrc::GarbageCollector::instance().getInternalState( stat )     ;
 
           std::cout << "HRC GC constants:"
-              << "\n\tHRC count per thread=" << stat.nHPCount
+              << "\n\tInitial HRC count per thread=" << stat.nHPCount
               << "\n\tMax thread count=" << stat.nMaxThreadCount
               << "\n\tMax retired pointer count per thread=" << stat.nMaxRetiredPtrCount
               << "\n\tHRC record size in bytes=" << stat.nHRCRecSize
+              << "\n\tDeferred reference counting=" << (stat.bDeferredRC ? "on" : "off")
               << "\n" << std::endl ;
       }
 
@@ -43,6 +43,12 @@ namespace CppUnitMini {
 
     ThreadPool::~ThreadPool()
     {
+        // The threads may still be inside m_pBarrierDone->wait(), so the barriers must outlive them
+        for ( size_t i = 0; i < m_arrThreads.size(); ++i ) {
+            if ( m_arrThreads[i]->m_pThread )
+                m_arrThreads[i]->m_pThread->join()  ;
+        }
+
         if ( m_pBarrierStart )
             delete m_pBarrierStart  ;
         if ( m_pBarrierDone )
@@ -238,6 +238,8 @@ namespace map {
         TEST_MAP(SplitListStatic_Michael_HRC)    ;
         TEST_MAP(SplitListDyn_Michael_PTB)        ;
         TEST_MAP(SplitListStatic_Michael_PTB)    ;
+        TEST_MAP(SplitListDyn_Michael_Epoch)      ;
+        TEST_MAP(SplitListStatic_Michael_Epoch)  ;
         TEST_MAP(SplitListDyn_Michael_NoGC)        ;
         TEST_MAP(SplitListStatic_Michael_NoGC)    ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
@@ -259,6 +261,8 @@ namespace map {
         TEST_MAP(MichaelHashMap_Michael_HP)
         TEST_MAP(MichaelHashMap_Michael_HRC)
         TEST_MAP(MichaelHashMap_Michael_PTB)
+        TEST_MAP(MichaelHashMap_Michael_Epoch)
+        TEST_MAP(MichaelHashMap_Michael_IBR)
         TEST_MAP(MichaelHashMap_Michael_NoGC)
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_MAP(MichaelHashMap_Michael_Tagged)
@@ -288,6 +292,8 @@ namespace map {
             CPPUNIT_TEST( SplitListStatic_Michael_HRC    )
             CPPUNIT_TEST( SplitListDyn_Michael_PTB        )
             CPPUNIT_TEST( SplitListStatic_Michael_PTB    )
+            CPPUNIT_TEST( SplitListDyn_Michael_Epoch      )
+            CPPUNIT_TEST( SplitListStatic_Michael_Epoch  )
             CPPUNIT_TEST( SplitListDyn_Michael_NoGC        )
             CPPUNIT_TEST( SplitListStatic_Michael_NoGC  )
 #ifdef CDS_DWORD_CAS_SUPPORTED
@@ -309,6 +315,8 @@ namespace map {
             CPPUNIT_TEST(MichaelHashMap_Michael_HP      )
             CPPUNIT_TEST(MichaelHashMap_Michael_HRC     )
             CPPUNIT_TEST(MichaelHashMap_Michael_PTB     )
+            CPPUNIT_TEST(MichaelHashMap_Michael_Epoch   )
+            CPPUNIT_TEST(MichaelHashMap_Michael_IBR     )
             CPPUNIT_TEST(MichaelHashMap_Michael_NoGC    )
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MichaelHashMap_Michael_Tagged  )
@@ -462,6 +462,8 @@ namespace map {
         TEST_MAP(SplitListStatic_Michael_HRC)    ;
         TEST_MAP(SplitListDyn_Michael_PTB)        ;
         TEST_MAP(SplitListStatic_Michael_PTB)    ;
+        TEST_MAP(SplitListDyn_Michael_Epoch)      ;
+        TEST_MAP(SplitListStatic_Michael_Epoch)  ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_MAP(SplitListDyn_Michael_Tagged)    ;
         TEST_MAP(SplitListStatic_Michael_Tagged);
@@ -477,10 +479,14 @@ namespace map {
         TEST_MAP(SplitListStatic_Lazy_HRC)        ;
         TEST_MAP(SplitListDyn_Lazy_PTB)            ;
         TEST_MAP(SplitListStatic_Lazy_PTB)        ;
+        TEST_MAP(SplitListDyn_Lazy_Epoch)          ;
+        TEST_MAP(SplitListStatic_Lazy_Epoch)      ;
 
         TEST_MAP(MichaelHashMap_Michael_HP)
         TEST_MAP(MichaelHashMap_Michael_HRC)
         TEST_MAP(MichaelHashMap_Michael_PTB)
+        TEST_MAP(MichaelHashMap_Michael_Epoch)
+        TEST_MAP(MichaelHashMap_Michael_IBR)
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_MAP(MichaelHashMap_Michael_Tagged)
         TEST_MAP(MichaelHashMap_Michael_TaggedShared)
@@ -491,6 +497,7 @@ namespace map {
         TEST_MAP(MichaelHashMap_Lazy_HP)
         TEST_MAP(MichaelHashMap_Lazy_HRC)
         TEST_MAP(MichaelHashMap_Lazy_PTB)
+        TEST_MAP(MichaelHashMap_Lazy_Epoch)
 
         TEST_MAP(StdMap_Spin)    ;
         TEST_MAP(StdHashMap_Spin)    ;
@@ -506,6 +513,8 @@ namespace map {
             CPPUNIT_TEST( SplitListStatic_Michael_HRC   )
             CPPUNIT_TEST( SplitListDyn_Michael_PTB      )
             CPPUNIT_TEST( SplitListStatic_Michael_PTB   )
+            CPPUNIT_TEST( SplitListDyn_Michael_Epoch    )
+            CPPUNIT_TEST( SplitListStatic_Michael_Epoch )
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST( SplitListDyn_Michael_Tagged   )
             CPPUNIT_TEST( SplitListStatic_Michael_Tagged)
@@ -516,10 +525,14 @@ namespace map {
             CPPUNIT_TEST( SplitListStatic_Lazy_HRC      )
             CPPUNIT_TEST( SplitListDyn_Lazy_PTB         )
             CPPUNIT_TEST( SplitListStatic_Lazy_PTB      )
+            CPPUNIT_TEST( SplitListDyn_Lazy_Epoch       )
+            CPPUNIT_TEST( SplitListStatic_Lazy_Epoch    )
 
             CPPUNIT_TEST(MichaelHashMap_Michael_HP)
             CPPUNIT_TEST(MichaelHashMap_Michael_HRC)
             CPPUNIT_TEST(MichaelHashMap_Michael_PTB)
+            CPPUNIT_TEST(MichaelHashMap_Michael_Epoch)
+            CPPUNIT_TEST(MichaelHashMap_Michael_IBR)
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MichaelHashMap_Michael_Tagged)
             CPPUNIT_TEST(MichaelHashMap_Michael_TaggedShared  )
@@ -527,6 +540,7 @@ namespace map {
             CPPUNIT_TEST(MichaelHashMap_Lazy_HP)
             CPPUNIT_TEST(MichaelHashMap_Lazy_HRC)
             CPPUNIT_TEST(MichaelHashMap_Lazy_PTB)
+            CPPUNIT_TEST(MichaelHashMap_Lazy_Epoch)
 
             CPPUNIT_TEST( StdMap_Spin )
             CPPUNIT_TEST( StdHashMap_Spin )
@@ -219,6 +219,8 @@ namespace map {
         TEST_MAP(SplitListStatic_Michael_HRC)    ;
         TEST_MAP(SplitListDyn_Michael_PTB)        ;
         TEST_MAP(SplitListStatic_Michael_PTB)    ;
+        TEST_MAP(SplitListDyn_Michael_Epoch)      ;
+        TEST_MAP(SplitListStatic_Michael_Epoch)  ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_MAP(SplitListDyn_Michael_Tagged)    ;
         TEST_MAP(SplitListStatic_Michael_Tagged);
@@ -230,10 +232,14 @@ namespace map {
         TEST_MAP(SplitListStatic_Lazy_HRC)        ;
         TEST_MAP(SplitListDyn_Lazy_PTB)            ;
         TEST_MAP(SplitListStatic_Lazy_PTB)        ;
+        TEST_MAP(SplitListDyn_Lazy_Epoch)          ;
+        TEST_MAP(SplitListStatic_Lazy_Epoch)      ;
 
         TEST_MAP(MichaelHashMap_Michael_HP)
         TEST_MAP(MichaelHashMap_Michael_HRC)
         TEST_MAP(MichaelHashMap_Michael_PTB)
+        TEST_MAP(MichaelHashMap_Michael_Epoch)
+        TEST_MAP(MichaelHashMap_Michael_IBR)
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_MAP(MichaelHashMap_Michael_Tagged)
         TEST_MAP(MichaelHashMap_Michael_TaggedShared)
@@ -242,6 +248,7 @@ namespace map {
         TEST_MAP(MichaelHashMap_Lazy_HP)
         TEST_MAP(MichaelHashMap_Lazy_HRC)
         TEST_MAP(MichaelHashMap_Lazy_PTB)
+        TEST_MAP(MichaelHashMap_Lazy_Epoch)
 
         TEST_MAP(StdMap_Spin)    ;
         TEST_MAP(StdHashMap_Spin)    ;
@@ -257,6 +264,8 @@ namespace map {
             CPPUNIT_TEST( SplitListStatic_Michael_HRC   )
             CPPUNIT_TEST( SplitListDyn_Michael_PTB      )
             CPPUNIT_TEST( SplitListStatic_Michael_PTB   )
+            CPPUNIT_TEST( SplitListDyn_Michael_Epoch    )
+            CPPUNIT_TEST( SplitListStatic_Michael_Epoch )
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST( SplitListDyn_Michael_Tagged   )
             CPPUNIT_TEST( SplitListStatic_Michael_Tagged)
@@ -268,10 +277,14 @@ namespace map {
             CPPUNIT_TEST( SplitListStatic_Lazy_HRC      )
             CPPUNIT_TEST( SplitListDyn_Lazy_PTB         )
             CPPUNIT_TEST( SplitListStatic_Lazy_PTB      )
+            CPPUNIT_TEST( SplitListDyn_Lazy_Epoch       )
+            CPPUNIT_TEST( SplitListStatic_Lazy_Epoch    )
 
             CPPUNIT_TEST(MichaelHashMap_Michael_HP)
             CPPUNIT_TEST(MichaelHashMap_Michael_HRC)
             CPPUNIT_TEST(MichaelHashMap_Michael_PTB)
+            CPPUNIT_TEST(MichaelHashMap_Michael_Epoch)
+            CPPUNIT_TEST(MichaelHashMap_Michael_IBR)
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MichaelHashMap_Michael_Tagged)
             CPPUNIT_TEST(MichaelHashMap_Michael_TaggedShared  )
@@ -279,6 +292,7 @@ namespace map {
             CPPUNIT_TEST(MichaelHashMap_Lazy_HP)
             CPPUNIT_TEST(MichaelHashMap_Lazy_HRC)
             CPPUNIT_TEST(MichaelHashMap_Lazy_PTB)
+            CPPUNIT_TEST(MichaelHashMap_Lazy_Epoch)
 
 //            CPPUNIT_TEST( StdMap_Spin )
 //            CPPUNIT_TEST( StdHashMap_Spin )
@@ -216,6 +216,8 @@ namespace map {
         TEST_MAP(SplitListStatic_Michael_HRC)    ;
         TEST_MAP(SplitListDyn_Michael_PTB)        ;
         TEST_MAP(SplitListStatic_Michael_PTB)    ;
+        TEST_MAP(SplitListDyn_Michael_Epoch)      ;
+        TEST_MAP(SplitListStatic_Michael_Epoch)  ;
         TEST_MAP(SplitListDyn_Michael_NoGC)        ;
         TEST_MAP(SplitListStatic_Michael_NoGC)    ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
@@ -233,12 +235,16 @@ namespace map {
         TEST_MAP(SplitListStatic_Lazy_HRC)      ;
         TEST_MAP(SplitListDyn_Lazy_PTB)         ;
         TEST_MAP(SplitListStatic_Lazy_PTB)      ;
+        TEST_MAP(SplitListDyn_Lazy_Epoch)       ;
+        TEST_MAP(SplitListStatic_Lazy_Epoch)    ;
         TEST_MAP(SplitListDyn_Lazy_NoGC)        ;
         TEST_MAP(SplitListStatic_Lazy_NoGC)     ;
 
         TEST_MAP(MichaelHashMap_Michael_HP)     ;
         TEST_MAP(MichaelHashMap_Michael_HRC)    ;
         TEST_MAP(MichaelHashMap_Michael_PTB)    ;
+        TEST_MAP(MichaelHashMap_Michael_Epoch)  ;
+        TEST_MAP(MichaelHashMap_Michael_IBR)    ;
         TEST_MAP(MichaelHashMap_Michael_NoGC)   ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_MAP(MichaelHashMap_Michael_Tagged) ;
@@ -249,6 +255,7 @@ namespace map {
         TEST_MAP(MichaelHashMap_Lazy_HP)        ;
         TEST_MAP(MichaelHashMap_Lazy_HRC)       ;
         TEST_MAP(MichaelHashMap_Lazy_PTB)       ;
+        TEST_MAP(MichaelHashMap_Lazy_Epoch)     ;
         TEST_MAP(MichaelHashMap_Lazy_NoGC)      ;
 
         CPPUNIT_TEST_SUITE( Map_Nonconcurrent_iterator_MT )
@@ -260,6 +267,8 @@ namespace map {
             CPPUNIT_TEST( SplitListStatic_Michael_HRC    )
             CPPUNIT_TEST( SplitListDyn_Michael_PTB        )
             CPPUNIT_TEST( SplitListStatic_Michael_PTB    )
+            CPPUNIT_TEST( SplitListDyn_Michael_Epoch      )
+            CPPUNIT_TEST( SplitListStatic_Michael_Epoch  )
             CPPUNIT_TEST( SplitListDyn_Michael_NoGC        )
             CPPUNIT_TEST( SplitListStatic_Michael_NoGC  )
 #ifdef CDS_DWORD_CAS_SUPPORTED
@@ -277,12 +286,16 @@ namespace map {
             CPPUNIT_TEST( SplitListStatic_Lazy_HRC      )
             CPPUNIT_TEST( SplitListDyn_Lazy_PTB         )
             CPPUNIT_TEST( SplitListStatic_Lazy_PTB      )
+            CPPUNIT_TEST( SplitListDyn_Lazy_Epoch       )
+            CPPUNIT_TEST( SplitListStatic_Lazy_Epoch    )
             CPPUNIT_TEST( SplitListDyn_Lazy_NoGC        )
             CPPUNIT_TEST( SplitListStatic_Lazy_NoGC     )
 
             CPPUNIT_TEST(MichaelHashMap_Michael_HP      )
             CPPUNIT_TEST(MichaelHashMap_Michael_HRC     )
             CPPUNIT_TEST(MichaelHashMap_Michael_PTB     )
+            CPPUNIT_TEST(MichaelHashMap_Michael_Epoch   )
+            CPPUNIT_TEST(MichaelHashMap_Michael_IBR     )
             CPPUNIT_TEST(MichaelHashMap_Michael_NoGC    )
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MichaelHashMap_Michael_Tagged  )
@@ -293,6 +306,7 @@ namespace map {
             CPPUNIT_TEST(MichaelHashMap_Lazy_HP         )
             CPPUNIT_TEST(MichaelHashMap_Lazy_HRC        )
             CPPUNIT_TEST(MichaelHashMap_Lazy_PTB        )
+            CPPUNIT_TEST(MichaelHashMap_Lazy_Epoch      )
             CPPUNIT_TEST(MichaelHashMap_Lazy_NoGC       )
 
             CPPUNIT_TEST( cleanTestSequence )
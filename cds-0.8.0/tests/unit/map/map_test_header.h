@@ -256,10 +256,13 @@ namespace map {
         void MichaelHash_Michael_hp()           ;
         void MichaelHash_Michael_hrc()          ;
         void MichaelHash_Michael_ptb()          ;
+        void MichaelHash_Michael_epoch()        ;
+        void MichaelHash_Michael_ibr()          ;
         void MichaelHash_Michael_tagged()       ;
         void MichaelHash_Lazy_hp()              ;
         void MichaelHash_Lazy_hrc()             ;
         void MichaelHash_Lazy_ptb()             ;
+        void MichaelHash_Lazy_epoch()           ;
 
         void SplitList()                        ;
         void SplitList_Static()                 ;
@@ -269,6 +272,8 @@ namespace map {
         void SplitList_Static_Michael_hrc()     ;
         void SplitList_Dynamic_Michael_ptb()    ;
         void SplitList_Static_Michael_ptb()     ;
+        void SplitList_Dynamic_Michael_epoch()  ;
+        void SplitList_Static_Michael_epoch()   ;
         void SplitList_Dynamic_Michael_tagged() ;
         void SplitList_Static_Michael_tagged()  ;
         void SplitList_Dynamic_Lazy_hp()        ;
@@ -277,16 +282,21 @@ namespace map {
         void SplitList_Static_Lazy_hrc()        ;
         void SplitList_Dynamic_Lazy_ptb()       ;
         void SplitList_Static_Lazy_ptb()        ;
+        void SplitList_Dynamic_Lazy_epoch()     ;
+        void SplitList_Static_Lazy_epoch()      ;
 
     CPPUNIT_TEST_SUITE(MapTestHeader);
         CPPUNIT_TEST(MichaelHash)                   ;
         CPPUNIT_TEST(MichaelHash_Michael_hp)        ;
         CPPUNIT_TEST(MichaelHash_Michael_hrc)       ;
         CPPUNIT_TEST(MichaelHash_Michael_ptb)       ;
+        CPPUNIT_TEST(MichaelHash_Michael_epoch)     ;
+        CPPUNIT_TEST(MichaelHash_Michael_ibr)       ;
         CPPUNIT_TEST(MichaelHash_Michael_tagged)    ;
         CPPUNIT_TEST(MichaelHash_Lazy_hp)           ;
         CPPUNIT_TEST(MichaelHash_Lazy_hrc)          ;
         CPPUNIT_TEST(MichaelHash_Lazy_ptb)          ;
+        CPPUNIT_TEST(MichaelHash_Lazy_epoch)        ;
 
         CPPUNIT_TEST(SplitList) ;
         CPPUNIT_TEST(SplitList_Static) ;
@@ -296,6 +306,8 @@ namespace map {
         CPPUNIT_TEST(SplitList_Static_Michael_hrc)      ;
         CPPUNIT_TEST(SplitList_Dynamic_Michael_ptb)     ;
         CPPUNIT_TEST(SplitList_Static_Michael_ptb)      ;
+        CPPUNIT_TEST(SplitList_Dynamic_Michael_epoch)   ;
+        CPPUNIT_TEST(SplitList_Static_Michael_epoch)    ;
         CPPUNIT_TEST(SplitList_Dynamic_Michael_tagged)  ;
         CPPUNIT_TEST(SplitList_Static_Michael_tagged)   ;
         CPPUNIT_TEST(SplitList_Dynamic_Lazy_hp)  ;
@@ -304,6 +316,8 @@ namespace map {
         CPPUNIT_TEST(SplitList_Static_Lazy_hrc)  ;
         CPPUNIT_TEST(SplitList_Dynamic_Lazy_ptb) ;
         CPPUNIT_TEST(SplitList_Static_Lazy_ptb)  ;
+        CPPUNIT_TEST(SplitList_Dynamic_Lazy_epoch) ;
+        CPPUNIT_TEST(SplitList_Static_Lazy_epoch)  ;
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -15,6 +15,8 @@
 #include <cds/map/michael_hash_map.h>
 #include <cds/ordered_list/michael_list_hrc.h>
 #include <cds/ordered_list/michael_list_ptb.h>
+#include <cds/ordered_list/michael_list_epoch.h>
+#include <cds/ordered_list/michael_list_ibr.h>
 #include <cds/ordered_list/michael_list_nogc.h>
 #ifdef CDS_DWORD_CAS_SUPPORTED
 #   include <cds/ordered_list/michael_list_tagged.h>
@@ -22,6 +24,7 @@
 #include <cds/ordered_list/lazy_list_hzp.h>
 #include <cds/ordered_list/lazy_list_hrc.h>
 #include <cds/ordered_list/lazy_list_ptb.h>
+#include <cds/ordered_list/lazy_list_epoch.h>
 #include <cds/ordered_list/lazy_list_nogc.h>
 
 #include <cds/lock/spinlock.h>
@@ -63,12 +66,23 @@ namespace map {
         };
         typedef cds::map::SplitOrderedList< KEY, VALUE, void, DynamicMichaelSplitListPTBTraits>            SplitListDyn_Michael_PTB   ;
 
+        struct DynamicMichaelSplitListEpochTraits: public cds::map::split_list::type_traits {
+            typedef cds::ordered_list::michael_list_tag<cds::gc::epoch_gc>    bucket_type ;
+        };
+        typedef cds::map::SplitOrderedList< KEY, VALUE, void, DynamicMichaelSplitListEpochTraits>            SplitListDyn_Michael_Epoch ;
+
         struct StaticMichaelSplitListPTBTraits: public cds::map::split_list::type_traits {
             typedef cds::ordered_list::michael_list_tag<cds::gc::ptb_gc>    bucket_type ;
             typedef cds::map::split_list::static_bucket_table< unsigned int >        bucket_table    ;
         };
         typedef cds::map::SplitOrderedList< KEY, VALUE, void, StaticMichaelSplitListPTBTraits>            SplitListStatic_Michael_PTB ;
 
+        struct StaticMichaelSplitListEpochTraits: public cds::map::split_list::type_traits {
+            typedef cds::ordered_list::michael_list_tag<cds::gc::epoch_gc>    bucket_type ;
+            typedef cds::map::split_list::static_bucket_table< unsigned int >        bucket_table    ;
+        };
+        typedef cds::map::SplitOrderedList< KEY, VALUE, void, StaticMichaelSplitListEpochTraits>            SplitListStatic_Michael_Epoch ;
+
         struct DynamicMichaelSplitListNoGCTraits: public cds::map::split_list::type_traits {
             typedef cds::ordered_list::michael_list_tag<cds::gc::no_gc>    bucket_type ;
         };
@@ -156,12 +170,23 @@ namespace map {
         };
         typedef cds::map::SplitOrderedList< KEY, VALUE, void, DynamicLazySplitListPTBTraits>                SplitListDyn_Lazy_PTB       ;
 
+        struct DynamicLazySplitListEpochTraits: public cds::map::split_list::type_traits {
+            typedef cds::ordered_list::lazy_list_tag<cds::gc::epoch_gc>    bucket_type ;
+        };
+        typedef cds::map::SplitOrderedList< KEY, VALUE, void, DynamicLazySplitListEpochTraits>                SplitListDyn_Lazy_Epoch     ;
+
         struct StaticLazySplitListPTBTraits: public cds::map::split_list::type_traits {
             typedef cds::ordered_list::lazy_list_tag<cds::gc::ptb_gc>    bucket_type ;
             typedef cds::map::split_list::static_bucket_table< unsigned int >        bucket_table    ;
         };
         typedef cds::map::SplitOrderedList< KEY, VALUE, void, StaticLazySplitListPTBTraits>                 SplitListStatic_Lazy_PTB    ;
 
+        struct StaticLazySplitListEpochTraits: public cds::map::split_list::type_traits {
+            typedef cds::ordered_list::lazy_list_tag<cds::gc::epoch_gc>    bucket_type ;
+            typedef cds::map::split_list::static_bucket_table< unsigned int >        bucket_table    ;
+        };
+        typedef cds::map::SplitOrderedList< KEY, VALUE, void, StaticLazySplitListEpochTraits>                 SplitListStatic_Lazy_Epoch  ;
+
         struct DynamicLazySplitListNoGCTraits: public cds::map::split_list::type_traits {
             typedef cds::ordered_list::lazy_list_tag<cds::gc::no_gc>    bucket_type ;
         };
@@ -186,6 +211,16 @@ namespace map {
         };
         typedef cds::map::MichaelHashMap< KEY, VALUE, void, MichaelHashMichaelPTBTraits >           MichaelHashMap_Michael_PTB  ;
 
+        struct MichaelHashMichaelEpochTraits: public cds::map::type_traits {
+            typedef cds::ordered_list::MichaelList<cds::gc::epoch_gc, int, int>    bucket_type    ;
+        };
+        typedef cds::map::MichaelHashMap< KEY, VALUE, void, MichaelHashMichaelEpochTraits >           MichaelHashMap_Michael_Epoch  ;
+
+        struct MichaelHashMichaelIBRTraits: public cds::map::type_traits {
+            typedef cds::ordered_list::MichaelList<cds::gc::ibr_gc, int, int>      bucket_type    ;
+        };
+        typedef cds::map::MichaelHashMap< KEY, VALUE, void, MichaelHashMichaelIBRTraits >             MichaelHashMap_Michael_IBR    ;
+
         struct MichaelHashMichaelHPTraits: public cds::map::type_traits {
             typedef cds::ordered_list::MichaelList<cds::gc::hzp_gc, int, int>    bucket_type    ;
         };
@@ -229,6 +264,11 @@ namespace map {
         };
         typedef cds::map::MichaelHashMap< KEY, VALUE, void, MichaelHashLazyPTBTraits >              MichaelHashMap_Lazy_PTB     ;
 
+        struct MichaelHashLazyEpochTraits: public cds::map::type_traits {
+            typedef cds::ordered_list::LazyList<cds::gc::epoch_gc, unsigned int, unsigned int>    bucket_type    ;
+        };
+        typedef cds::map::MichaelHashMap< KEY, VALUE, void, MichaelHashLazyEpochTraits >              MichaelHashMap_Lazy_Epoch   ;
+
         struct MichaelHashLazyNoGCTraits: public cds::map::type_traits {
             typedef cds::ordered_list::LazyList<cds::gc::no_gc, int, int>    bucket_type    ;
         };
@@ -10,10 +10,14 @@
 
 #include "cppunit/thread.h"
 #include <cds/threading/model.h>
+#include <cds/gc/hzp/gc.h>
+#include <cds/gc/hrc/gc.h>
+#include <cds/gc/ptb/gc.h>
 
 namespace {
     static size_t s_nThreadCount = 8  ;
     static size_t s_nPassCount = 1000000    ;
+    static bool   s_bBenchmark = false  ;
 }
 
 class thread_init_fini: public CppUnitMini::TestCase
@@ -25,12 +29,23 @@ class thread_init_fini: public CppUnitMini::TestCase
             return new Thread( *this )  ;
         }
 
+    public:
+        double  m_fAttach   ;   ///< total time of attachThread calls, seconds
+        double  m_fFirstUse ;   ///< total time of first guard allocation of HZP, HRC and PTB GC, seconds
+        double  m_fDetach   ;   ///< total time of detachThread calls, seconds
+
     public:
         Thread( CppUnitMini::ThreadPool& pool )
             : CppUnitMini::TestThread( pool )
+            , m_fAttach( 0 )
+            , m_fFirstUse( 0 )
+            , m_fDetach( 0 )
         {}
         Thread( Thread& src )
             : CppUnitMini::TestThread( src )
+            , m_fAttach( 0 )
+            , m_fFirstUse( 0 )
+            , m_fDetach( 0 )
         {}
 
         thread_init_fini&  getTest()
@@ -44,6 +59,15 @@ class thread_init_fini: public CppUnitMini::TestCase
         {}
 
         virtual void test()
+        {
+            if ( s_bBenchmark )
+                benchmark() ;
+            else
+                check()     ;
+        }
+
+    private:
+        void check()
         {
             for ( size_t i = 0; i < s_nPassCount; ++i ) {
                 CPPUNIT_ASSERT(!cds::threading::Manager::isThreadAttached())    ;
@@ -53,12 +77,35 @@ class thread_init_fini: public CppUnitMini::TestCase
                 cds::threading::Manager::detachThread()   ;
             }
         }
+
+        // Emulates short-lived thread: attach, one guard of each GC, detach
+        void benchmark()
+        {
+            cds::OS::Timer  timer   ;
+            for ( size_t i = 0; i < s_nPassCount; ++i ) {
+                timer.reset()   ;
+                cds::threading::Manager::attachThread() ;
+                m_fAttach += timer.duration()   ;
+
+                timer.reset()   ;
+                {
+                    cds::gc::hzp::GC::Guard hzpGuard    ;
+                    cds::gc::hrc::GC::Guard hrcGuard    ;
+                    cds::gc::ptb::GC::Guard ptbGuard    ;
+                }
+                m_fFirstUse += timer.duration() ;
+
+                timer.reset()   ;
+                cds::threading::Manager::detachThread()   ;
+                m_fDetach += timer.duration()   ;
+            }
+        }
     };
 
 protected:
     void init_fini()
     {
-        CPPUNIT_MSG( "Thread init/fini test,\n    thread count=" << s_nThreadCount << " pass count=" << s_nPassCount << "..." )   ;
+        CPPUNIT_MSG( "Thread init/fini " << (s_bBenchmark ? "benchmark" : "test") << ",\n    thread count=" << s_nThreadCount << " pass count=" << s_nPassCount << "..." )   ;
 
         CppUnitMini::ThreadPool pool( *this )   ;
 
@@ -70,11 +117,37 @@ protected:
         pool.run()  ;
 
         CPPUNIT_MSG( "   Duration=" << timer.duration() ) ;
+
+        if ( s_bBenchmark ) {
+            double fAttach = 0  ;
+            double fFirstUse = 0    ;
+            double fDetach = 0  ;
+            for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it ) {
+                Thread * pThread = reinterpret_cast<Thread *>(*it)  ;
+                fAttach += pThread->m_fAttach   ;
+                fFirstUse += pThread->m_fFirstUse   ;
+                fDetach += pThread->m_fDetach   ;
+            }
+            double fCount = double( s_nThreadCount * s_nPassCount ) / 1.0E9   ;
+            CPPUNIT_MSG( "   Cost per thread, ns: attach=" << fAttach / fCount
+                << " first use of HZP, HRC, PTB=" << fFirstUse / fCount
+                << " detach=" << fDetach / fCount ) ;
+
+            cds::gc::hzp::GarbageCollector::InternalState hzpStat   ;
+            cds::gc::hzp::GarbageCollector::instance().getInternalState( hzpStat )  ;
+            cds::gc::hrc::GarbageCollector::internal_state hrcStat  ;
+            cds::gc::hrc::GarbageCollector::instance().getInternalState( hrcStat )  ;
+            CPPUNIT_MSG( "   HP records: allocated=" << hzpStat.nHPRecAllocated
+                << " reused from cache=" << hzpStat.evcAllocHPRecCached
+                << "; HRC records: allocated=" << hrcStat.nHRCRecAllocated
+                << " reused from cache=" << hrcStat.evcAllocHRCRecCached ) ;
+        }
     }
 
     void setUpParams( const CppUnitMini::TestCfg& cfg ) {
         s_nThreadCount = cfg.getULong("ThreadCount", 8 ) ;
         s_nPassCount = cfg.getULong("PassCount", 1000000 );
+        s_bBenchmark = cfg.getBool("Benchmark", false )   ;
     }
 
     CPPUNIT_TEST_SUITE(thread_init_fini)
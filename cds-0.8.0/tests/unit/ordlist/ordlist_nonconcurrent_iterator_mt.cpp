@@ -176,6 +176,7 @@ namespace ordlist {
         TEST_LIST(MichaelList_HP)    ;
         TEST_LIST(MichaelList_HRC)    ;
         TEST_LIST(MichaelList_PTB)    ;
+        TEST_LIST(MichaelList_Epoch)  ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_LIST(MichaelList_Tagged);
 #endif
@@ -187,6 +188,7 @@ namespace ordlist {
         TEST_LIST(LazyList_HP)        ;
         TEST_LIST(LazyList_HRC)        ;
         TEST_LIST(LazyList_PTB)        ;
+        TEST_LIST(LazyList_Epoch)      ;
         TEST_LIST(LazyList_NoGC)    ;
 
         CPPUNIT_TEST_SUITE( OrdList_Nonconcurrent_iterator_MT )
@@ -195,6 +197,7 @@ namespace ordlist {
             CPPUNIT_TEST(MichaelList_HP)    ;
             CPPUNIT_TEST(MichaelList_HRC)    ;
             CPPUNIT_TEST(MichaelList_PTB)    ;
+            CPPUNIT_TEST(MichaelList_Epoch)  ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MichaelList_Tagged);
 #endif
@@ -206,6 +209,7 @@ namespace ordlist {
             CPPUNIT_TEST(LazyList_HP)        ;
             CPPUNIT_TEST(LazyList_HRC)        ;
             CPPUNIT_TEST(LazyList_PTB)        ;
+            CPPUNIT_TEST(LazyList_Epoch)      ;
             CPPUNIT_TEST(LazyList_NoGC)        ;
 
             CPPUNIT_TEST( cleanTestSequence )
@@ -14,6 +14,7 @@
 #include <cds/ordered_list/michael_list_hzp.h>
 #include <cds/ordered_list/michael_list_hrc.h>
 #include <cds/ordered_list/michael_list_ptb.h>
+#include <cds/ordered_list/michael_list_epoch.h>
 #include <cds/ordered_list/michael_list_nogc.h>
 #ifdef CDS_DWORD_CAS_SUPPORTED
 #   include <cds/ordered_list/michael_list_tagged.h>
@@ -21,6 +22,7 @@
 #include <cds/ordered_list/lazy_list_hzp.h>
 #include <cds/ordered_list/lazy_list_hrc.h>
 #include <cds/ordered_list/lazy_list_ptb.h>
+#include <cds/ordered_list/lazy_list_epoch.h>
 #include <cds/ordered_list/lazy_list_nogc.h>
 
 namespace ordlist {
@@ -44,6 +46,12 @@ namespace ordlist {
             , VALUE
         >    MichaelList_PTB    ;
 
+        typedef cds::ordered_list::MichaelList<
+            cds::gc::epoch_gc
+            , KEY
+            , VALUE
+        >    MichaelList_Epoch  ;
+
         typedef cds::ordered_list::MichaelList<
             cds::gc::no_gc
             , KEY
@@ -88,6 +96,12 @@ namespace ordlist {
             , VALUE
         > LazyList_PTB   ;
 
+        typedef cds::ordered_list::LazyList<
+            cds::gc::epoch_gc
+            , KEY
+            , VALUE
+        > LazyList_Epoch ;
+
         typedef cds::ordered_list::LazyList<
             cds::gc::no_gc
             , KEY
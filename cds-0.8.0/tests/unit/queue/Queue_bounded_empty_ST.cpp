@@ -14,6 +14,7 @@
 // Bounded queue tests
 namespace queue {
 #define TEST_CASE( Q, V ) void Q() { test< Types<V>::Q >(); }
+#define TEST_CAPACITY( Q, V ) void Q() { test_capacity< Types<V>::Q >(); }
 
     namespace {
         static size_t s_nPassCount = 100  ;
@@ -36,7 +37,21 @@ namespace queue {
             const size_t nLog2 = cds::beans::exp2Ceil( s_nQueueSize )   ;
             const size_t nSize = 1 << nLog2 ;
             Q   queue( (unsigned int) nLog2) ;
+            test( queue, nSize )    ;
+        }
 
+        // The capacity of the queue is exactly s_nQueueSize, not rounded to a power of two
+        template <class Q>
+        void test_capacity()
+        {
+            Q   queue( s_nQueueSize ) ;
+            CPPUNIT_ASSERT( queue.capacity() == s_nQueueSize )   ;
+            test( queue, s_nQueueSize ) ;
+        }
+
+        template <class Q>
+        void test( Q& queue, size_t nSize )
+        {
             CPPUNIT_MSG( "  queue.empty(), queue size=" << nSize << ", pass count=" << s_nPassCount ) ;
 
             for ( size_t nPass = 0; nPass < s_nPassCount; ++nPass ) {
@@ -75,10 +90,14 @@ namespace queue {
 
         TEST_CASE( TZCyclicQueue, size_t )
         TEST_CASE( TZCyclicQueue_Counted, size_t )
+        TEST_CAPACITY( TZCyclicValueQueue, size_t )
+        TEST_CAPACITY( TZCyclicValueQueue_Counted, size_t )
 
         CPPUNIT_TEST_SUITE(Queue_bounded_empty_ST)
             CPPUNIT_TEST( TZCyclicQueue )      
             CPPUNIT_TEST( TZCyclicQueue_Counted )      
+            CPPUNIT_TEST( TZCyclicValueQueue )
+            CPPUNIT_TEST( TZCyclicValueQueue_Counted )
         CPPUNIT_TEST_SUITE_END();
     };
 }   // namespace queue
@@ -0,0 +1,329 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include "cppunit/thread.h"
+#include "queue/queue_type.h"
+#include <cds/queue/broadcast_ring.h>
+#include <vector>
+
+// Multi-threaded broadcast test: each reader (consumer) must receive all items pushed by writers
+namespace queue {
+
+#define TEST_CASE( Q ) void Q() { test< Q##_type >(); }
+
+    namespace {
+        static size_t s_nReaderThreadCount = 4  ;
+        static size_t s_nWriterThreadCount = 1  ;
+        static size_t s_nQueueSize = 4000000    ;
+        static size_t s_nRingCapacity = 1024    ;
+        static size_t s_nBatchSize = 16         ;
+
+        struct Value {
+            size_t      nNo         ;
+            size_t      nWriterNo   ;
+        };
+
+        // Broadcast ring adapter
+        template <bool BATCH>
+        class BroadcastRingAdapter
+        {
+            typedef cds::queue::broadcast_ring< Value, cds::opt::buffer< cds::opt::v::dynamic_buffer<Value> > > ring_type ;
+            ring_type   m_Ring  ;
+        public:
+            BroadcastRingAdapter( size_t nCapacity, size_t nConsumerCount )
+                : m_Ring( nCapacity, nConsumerCount )
+            {}
+
+            bool push( Value const& v )
+            {
+                return m_Ring.enqueue( v )  ;
+            }
+
+            size_t pop( size_t nConsumer, Value * pBuf, size_t nMax )
+            {
+                if ( BATCH )
+                    return m_Ring.dequeue_batch( nConsumer, pBuf, nMax )    ;
+                return m_Ring.dequeue( nConsumer, *pBuf ) ? 1 : 0   ;
+            }
+        };
+
+        // Fan-out: one bounded queue per consumer, the writer pushes a copy of the item into each queue
+        template <class QUEUE>
+        class FanOutAdapter
+        {
+            std::vector<QUEUE *>   m_arrQueue  ;
+        public:
+            FanOutAdapter( size_t nCapacity, size_t nConsumerCount )
+            {
+                for ( size_t i = 0; i < nConsumerCount; ++i )
+                    m_arrQueue.push_back( new QUEUE( nCapacity ))   ;
+            }
+            ~FanOutAdapter()
+            {
+                for ( size_t i = 0; i < m_arrQueue.size(); ++i )
+                    delete m_arrQueue[i]    ;
+            }
+
+            bool push( Value const& v )
+            {
+                // Items must not be lost for slow consumer, so the push waits for free cell in each queue
+                for ( size_t i = 0; i < m_arrQueue.size(); ++i ) {
+                    cds::backoff::yield bkoff   ;
+                    while ( !m_arrQueue[i]->push( v ))
+                        bkoff() ;
+                }
+                return true ;
+            }
+
+            size_t pop( size_t nConsumer, Value * pBuf, size_t /*nMax*/ )
+            {
+                return m_arrQueue[ nConsumer ]->pop( *pBuf ) ? 1 : 0    ;
+            }
+        };
+
+        typedef BroadcastRingAdapter<false>     BroadcastRing_type          ;
+        typedef BroadcastRingAdapter<true>      BroadcastRing_Batch_type    ;
+        typedef FanOutAdapter< Types<Value>::VyukovMPMCBounded >    FanOut_VyukovMPMCBounded_type   ;
+    }
+
+    class Queue_Broadcast_MT: public CppUnitMini::TestCase
+    {
+        template <class QUEUE>
+        class WriterThread: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new WriterThread( *this )  ;
+            }
+        public:
+            QUEUE&              m_Queue ;
+            double              m_fTime ;
+            size_t              m_nPushFailed   ;
+
+        public:
+            WriterThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            WriterThread( WriterThread& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            Queue_Broadcast_MT&  getTest()
+            {
+                return reinterpret_cast<Queue_Broadcast_MT&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+
+            virtual void test()
+            {
+                size_t nPushCount = getTest().m_nThreadPushCount  ;
+                Value v             ;
+                v.nWriterNo = m_nThreadNo   ;
+                v.nNo = 0           ;
+                m_nPushFailed = 0   ;
+
+                m_fTime = m_Timer.duration()        ;
+
+                cds::backoff::yield bkoff   ;
+                while ( v.nNo < nPushCount ) {
+                    if ( m_Queue.push( v ))
+                        ++v.nNo             ;
+                    else {
+                        ++m_nPushFailed     ;
+                        bkoff()             ;
+                    }
+                }
+
+                m_fTime = m_Timer.duration() - m_fTime  ;
+            }
+        };
+
+        template <class QUEUE>
+        class ReaderThread: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new ReaderThread( *this )  ;
+            }
+        public:
+            QUEUE&              m_Queue ;
+            double              m_fTime ;
+            size_t              m_nPopEmpty     ;
+            size_t              m_nPopped       ;
+            size_t              m_nBadWriter    ;
+            size_t              m_nBadOrder     ;
+
+        public:
+            ReaderThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            ReaderThread( ReaderThread& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            Queue_Broadcast_MT&  getTest()
+            {
+                return reinterpret_cast<Queue_Broadcast_MT&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+
+            virtual void test()
+            {
+                m_nPopEmpty = 0     ;
+                m_nPopped = 0       ;
+                m_nBadWriter = 0    ;
+                m_nBadOrder = 0     ;
+
+                const size_t nTotalWriters = s_nWriterThreadCount   ;
+                const size_t nTotal = getTest().m_nThreadPushCount * nTotalWriters  ;
+                // Writers are first in the thread pool
+                const size_t nConsumer = m_nThreadNo - nTotalWriters    ;
+
+                // Next expected item number for each writer
+                std::vector<size_t> arrNext( nTotalWriters, 0 ) ;
+                std::vector<Value>  arrBuf( s_nBatchSize )      ;
+
+                m_fTime = m_Timer.duration()        ;
+
+                cds::backoff::yield bkoff   ;
+                while ( m_nPopped < nTotal ) {
+                    size_t nCount = m_Queue.pop( nConsumer, &arrBuf[0], arrBuf.size() ) ;
+                    if ( nCount == 0 ) {
+                        ++m_nPopEmpty   ;
+                        bkoff()         ;
+                        continue        ;
+                    }
+                    for ( size_t i = 0; i < nCount; ++i ) {
+                        Value const& v = arrBuf[i]  ;
+                        if ( v.nWriterNo < nTotalWriters ) {
+                            if ( arrNext[ v.nWriterNo ] != v.nNo )
+                                ++m_nBadOrder   ;
+                            arrNext[ v.nWriterNo ] = v.nNo + 1  ;
+                        }
+                        else
+                            ++m_nBadWriter  ;
+                    }
+                    m_nPopped += nCount ;
+                }
+
+                m_fTime = m_Timer.duration() - m_fTime ;
+            }
+        };
+
+    protected:
+        size_t                  m_nThreadPushCount  ;
+
+    protected:
+        template <class QUEUE>
+        void analyze( CppUnitMini::ThreadPool& pool, size_t nReaderCount )
+        {
+            typedef ReaderThread<QUEUE> Reader  ;
+            typedef WriterThread<QUEUE> Writer  ;
+
+            double fTimeWriter = 0      ;
+            double fTimeReader = 0      ;
+            size_t nPopFalse = 0        ;
+            size_t nPushFalse = 0       ;
+
+            size_t nExpected = m_nThreadPushCount * s_nWriterThreadCount ;
+            for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it ) {
+                Reader * pReader = dynamic_cast<Reader *>( *it ) ;
+                if ( pReader ) {
+                    fTimeReader += pReader->m_fTime     ;
+                    nPopFalse += pReader->m_nPopEmpty   ;
+                    CPPUNIT_ASSERT_MSG( pReader->m_nPopped == nExpected, "reader " << pReader->m_nThreadNo << " popped=" << pReader->m_nPopped << " must be " << nExpected ) ;
+                    CPPUNIT_ASSERT_MSG( pReader->m_nBadWriter == 0, "reader " << pReader->m_nThreadNo << " bad writer event count=" << pReader->m_nBadWriter ) ;
+                    CPPUNIT_ASSERT_MSG( pReader->m_nBadOrder == 0, "reader " << pReader->m_nThreadNo << " out of order item count=" << pReader->m_nBadOrder ) ;
+                }
+                else {
+                    Writer * pWriter = dynamic_cast<Writer *>( *it ) ;
+                    CPPUNIT_ASSERT( pWriter != NULL )   ;
+                    fTimeWriter += pWriter->m_fTime     ;
+                    nPushFalse += pWriter->m_nPushFailed ;
+                }
+            }
+            CPPUNIT_MSG( "     Duration: readers=" << (fTimeReader / nReaderCount)
+                << ", writer=" << (fTimeWriter / s_nWriterThreadCount)
+                << ", push false=" << nPushFalse
+                << ", pop false=" << nPopFalse
+            )   ;
+        }
+
+        template <class QUEUE>
+        void test()
+        {
+            m_nThreadPushCount = s_nQueueSize / s_nWriterThreadCount    ;
+
+            for ( size_t nReaderCount = 1; nReaderCount <= s_nReaderThreadCount; nReaderCount *= 2 ) {
+                CPPUNIT_MSG( "   Broadcast test, reader count=" << nReaderCount << " writer count=" << s_nWriterThreadCount << "..." )   ;
+
+                QUEUE testQueue( s_nRingCapacity, nReaderCount )    ;
+                CppUnitMini::ThreadPool pool( *this )   ;
+
+                // Writers must be first
+                pool.add( new WriterThread<QUEUE>( pool, testQueue ), s_nWriterThreadCount )   ;
+                pool.add( new ReaderThread<QUEUE>( pool, testQueue ), nReaderCount )           ;
+
+                pool.run()  ;
+
+                analyze<QUEUE>( pool, nReaderCount )     ;
+            }
+        }
+
+        void setUpParams( const CppUnitMini::TestCfg& cfg ) {
+            s_nReaderThreadCount = cfg.getULong("ReaderCount", 4 ) ;
+            s_nWriterThreadCount = cfg.getULong("WriterCount", 1 ) ;
+            s_nQueueSize = cfg.getULong("QueueSize", 4000000 );
+            s_nRingCapacity = cfg.getULong("RingCapacity", 1024 );
+            s_nBatchSize = cfg.getULong("BatchSize", 16 );
+
+            if ( s_nReaderThreadCount == 0 )
+                s_nReaderThreadCount = 1    ;
+            if ( s_nWriterThreadCount == 0 )
+                s_nWriterThreadCount = 1    ;
+            if ( s_nBatchSize == 0 )
+                s_nBatchSize = 1    ;
+        }
+
+    protected:
+        TEST_CASE( BroadcastRing )
+        TEST_CASE( BroadcastRing_Batch )
+        TEST_CASE( FanOut_VyukovMPMCBounded )
+
+        CPPUNIT_TEST_SUITE(Queue_Broadcast_MT)
+            CPPUNIT_TEST(BroadcastRing)             ;
+            CPPUNIT_TEST(BroadcastRing_Batch)       ;
+            CPPUNIT_TEST(FanOut_VyukovMPMCBounded)  ;
+        CPPUNIT_TEST_SUITE_END();
+    };
+
+} // namespace queue
+
+CPPUNIT_TEST_SUITE_REGISTRATION(queue::Queue_Broadcast_MT);
@@ -0,0 +1,478 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include "cppunit/thread.h"
+#include "queue/queue_type.h"
+
+#include <cds/gc/hzp/gc.h>
+#include <cds/gc/hrc/gc.h>
+#include <cds/gc/ptb/gc.h>
+#include <cds/gc/epoch/gc.h>
+#include <cds/gc/ibr/gc.h>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <stdio.h>
+
+#if CDS_OS_TYPE == CDS_OS_LINUX
+#   include <unistd.h>
+#endif
+
+// Multi-threaded queue test: reclamation overhead of the memory reclamation schemas.
+// The same MSQueue workload is run over each GC; the test reports the throughput,
+// the count of nodes removed from the queue but not yet freed (sampled by the monitor thread),
+// the count and the time of the GC scans and the process RSS.
+// Optionally one thread is stalled inside the GC critical section during the run.
+namespace queue {
+
+#define TEST_CASE( Q, GC )    void Q() { test< ns_Queue_GCOverhead_MT::Q, GC >(); }
+
+    namespace ns_Queue_GCOverhead_MT {
+        static size_t s_nThreadCount = 4  ;
+        static size_t s_nPassCount = 1000000 ;
+        static size_t s_nQueueSize = 1000 ;
+        static size_t s_nSampleInterval = 1 ;    // monitor sampling interval, msec
+        static bool   s_bStall = true   ;
+
+        // Node allocation counters
+        static cds::atomic<size_t>  s_nNodeAlloc( 0 )  ;
+        static cds::atomic<size_t>  s_nNodeFree( 0 )   ;
+        // Nodes not freed by previous test cases (for example, retired nodes of PTB), snapshot at start of run()
+        static size_t               s_nNodeBase = 0    ;
+
+        // Count of workers finished, the monitor and the stalled thread run until all workers are done
+        static cds::atomic<size_t>  s_nWorkerDone( 0 ) ;
+
+        // Allocator that counts the nodes allocated and freed.
+        // The counters are shared by all threads, so they add the same overhead for all GC tested
+        template <typename T>
+        class counting_allocator: public std::allocator<T>
+        {
+            typedef std::allocator<T>   base_class  ;
+        public:
+            typedef typename base_class::pointer    pointer     ;
+            typedef typename base_class::size_type  size_type   ;
+
+            template <typename Q>
+            struct rebind {
+                typedef counting_allocator<Q>   other   ;
+            };
+
+            counting_allocator() {}
+            counting_allocator( const counting_allocator& ) {}
+            template <typename Q>
+            counting_allocator( const counting_allocator<Q>& ) {}
+
+            pointer allocate( size_type nCount, const void * pHint = NULL )
+            {
+                s_nNodeAlloc.xadd<cds::membar_relaxed>( nCount )   ;
+                return base_class::allocate( nCount, pHint ) ;
+            }
+
+            void deallocate( pointer p, size_type nCount )
+            {
+                s_nNodeFree.xadd<cds::membar_relaxed>( nCount )    ;
+                base_class::deallocate( p, nCount )  ;
+            }
+        };
+
+        struct SimpleValue {
+            size_t    nNo ;
+
+            SimpleValue() {}
+            SimpleValue( size_t n ): nNo(n) {}
+            size_t getNo() const { return  nNo; }
+        };
+
+        typedef cds::queue::MSQueue< cds::gc::hzp_gc, SimpleValue, CountedTraits, counting_allocator<int> >     MSQueue_HP      ;
+        typedef cds::queue::MSQueue< cds::gc::hrc_gc, SimpleValue, CountedTraits, counting_allocator<int> >     MSQueue_HRC     ;
+        typedef cds::queue::MSQueue< cds::gc::ptb_gc, SimpleValue, CountedTraits, counting_allocator<int> >     MSQueue_PTB     ;
+        typedef cds::queue::MSQueue< cds::gc::epoch_gc, SimpleValue, CountedTraits, counting_allocator<int> >   MSQueue_Epoch   ;
+        typedef cds::queue::MSQueue< cds::gc::ibr_gc, SimpleValue, CountedTraits, counting_allocator<int> >     MSQueue_IBR     ;
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        typedef cds::queue::MSQueue< cds::gc::tagged_gc, SimpleValue, CountedTraits >                           MSQueue_Tagged  ;
+#endif
+
+        // Count of nodes owned by the queue: in the queue, retired or cached
+        template <class QUEUE>
+        static size_t ownedNodes( QUEUE& /*q*/ )
+        {
+            size_t nOwned = s_nNodeAlloc.load<cds::membar_relaxed>() - s_nNodeFree.load<cds::membar_relaxed>() ;
+            return nOwned > s_nNodeBase ? nOwned - s_nNodeBase : 0  ;
+        }
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        // The tagged queue never returns nodes to the heap, the free-list keeps them
+        static size_t ownedNodes( MSQueue_Tagged& q )
+        {
+            return q.getFreeList().getStatistics().m_nHeapAlloc ;
+        }
+#endif
+
+        // Resident set size of the process, KB. Returns 0 if the OS is not supported
+        static size_t processRSS()
+        {
+#if CDS_OS_TYPE == CDS_OS_LINUX
+            size_t nRSS = 0 ;
+            FILE * f = fopen( "/proc/self/statm", "r" ) ;
+            if ( f ) {
+                unsigned long nSize ;
+                unsigned long nResident ;
+                if ( fscanf( f, "%lu %lu", &nSize, &nResident ) == 2 )
+                    nRSS = size_t( nResident ) * size_t( sysconf( _SC_PAGESIZE )) / 1024  ;
+                fclose( f ) ;
+            }
+            return nRSS ;
+#else
+            return 0    ;
+#endif
+        }
+
+        // GC-specific part of the test: the guard held by the stalled thread and the scan statistics.
+        // HP, HRC and PTB guard protects one pointer only, so the stalled thread holding an empty guard
+        // pins nothing. For epoch and IBR the guard is the critical region.
+        template <typename GC>
+        struct gc_traits    ;
+
+        template <>
+        struct gc_traits< cds::gc::hzp_gc >
+        {
+            typedef cds::gc::hzp::GC::Guard     guard   ;
+            static void scanStat( size_t& nCount, double& fTime )
+            {
+                cds::gc::hzp::GarbageCollector::InternalState stat  ;
+                cds::gc::hzp::GarbageCollector::instance().getInternalState( stat ) ;
+                nCount = stat.evcScanCall   ;
+                fTime = stat.fScanTime  ;
+            }
+        };
+
+        template <>
+        struct gc_traits< cds::gc::hrc_gc >
+        {
+            typedef cds::gc::hrc::GC::Guard     guard   ;
+            static void scanStat( size_t& nCount, double& fTime )
+            {
+                cds::gc::hrc::GarbageCollector::internal_state stat  ;
+                cds::gc::hrc::GarbageCollector::instance().getInternalState( stat ) ;
+                nCount = stat.evcScanCall   ;
+                fTime = stat.fScanTime  ;
+            }
+        };
+
+        template <>
+        struct gc_traits< cds::gc::ptb_gc >
+        {
+            typedef cds::gc::ptb::GC::Guard     guard   ;
+            static void scanStat( size_t& nCount, double& fTime )
+            {
+                cds::gc::ptb::GarbageCollector::InternalState stat  ;
+                cds::gc::ptb::GarbageCollector::instance().getInternalState( stat ) ;
+                nCount = stat.evcLiberateCall   ;
+                fTime = stat.fLiberateTime  ;
+            }
+        };
+
+        template <>
+        struct gc_traits< cds::gc::epoch_gc >
+        {
+            typedef cds::gc::epoch::GC::Guard   guard   ;
+            static void scanStat( size_t& nCount, double& fTime )
+            {
+                cds::gc::epoch::GarbageCollector::InternalState stat  ;
+                cds::gc::epoch::GarbageCollector::instance().getInternalState( stat ) ;
+                nCount = stat.m_nScanCount  ;
+                fTime = stat.m_fScanTime    ;
+            }
+        };
+
+        template <>
+        struct gc_traits< cds::gc::ibr_gc >
+        {
+            typedef cds::gc::ibr::GC::Guard     guard   ;
+            static void scanStat( size_t& nCount, double& fTime )
+            {
+                cds::gc::ibr::GarbageCollector::InternalState stat  ;
+                cds::gc::ibr::GarbageCollector::instance().getInternalState( stat ) ;
+                nCount = stat.evcScanCall   ;
+                fTime = stat.fScanTime  ;
+            }
+        };
+
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        template <>
+        struct gc_traits< cds::gc::tagged_gc >
+        {
+            // No critical section; the user-provided ctor marks the guard object as used
+            struct guard {
+                guard() {}
+            } ;
+            static void scanStat( size_t& nCount, double& fTime )
+            {
+                nCount = 0  ;
+                fTime = 0   ;
+            }
+        };
+#endif
+
+        static void sleepMsec( size_t nMsec )
+        {
+            boost::this_thread::sleep( boost::posix_time::milliseconds( nMsec ))   ;
+        }
+    }
+    using namespace ns_Queue_GCOverhead_MT ;
+
+    class Queue_GCOverhead_MT: public CppUnitMini::TestCase
+    {
+        // Each worker pushes and pops s_nPassCount items
+        template <class QUEUE>
+        class Worker: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new Worker( *this )  ;
+            }
+        public:
+            QUEUE&              m_Queue ;
+            size_t              m_nPopCount ;
+            size_t              m_nPopEmpty ;
+
+        public:
+            Worker( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            Worker( Worker& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+
+            virtual void test()
+            {
+                typedef typename QUEUE::value_type value_type ;
+                value_type value = value_type() ;
+                size_t nPopCount = 0    ;
+                size_t nPopEmpty = 0    ;
+
+                for ( size_t nPass = 0; nPass < s_nPassCount; ++nPass ) {
+                    m_Queue.push( nPass )   ;
+                    if ( m_Queue.pop( value ) )
+                        ++nPopCount ;
+                    else
+                        ++nPopEmpty ;
+                }
+                m_nPopCount = nPopCount ;
+                m_nPopEmpty = nPopEmpty ;
+
+                s_nWorkerDone.inc<cds::membar_release>()  ;
+            }
+        };
+
+        // Samples the count of unreclaimed nodes and RSS until all workers are done
+        template <class QUEUE>
+        class Monitor: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new Monitor( *this )  ;
+            }
+        public:
+            QUEUE&              m_Queue ;
+            size_t              m_nSampleCount  ;
+            size_t              m_nPeakUnreclaimed  ;
+            double              m_fAvgUnreclaimed   ;
+            size_t              m_nStartRSS ;
+            size_t              m_nPeakRSS  ;
+
+        public:
+            Monitor( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            Monitor( Monitor& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            virtual void test()
+            {
+                size_t nSampleCount = 0 ;
+                size_t nPeak = 0    ;
+                double fSum = 0 ;
+                m_nStartRSS = m_nPeakRSS = processRSS()  ;
+
+                while ( s_nWorkerDone.load<cds::membar_acquire>() < s_nThreadCount ) {
+                    sleepMsec( s_nSampleInterval )  ;
+
+                    // The queue contains the items and the dummy node
+                    size_t nInQueue = m_Queue.size() + 1    ;
+                    size_t nOwned = ownedNodes( m_Queue )   ;
+                    size_t nUnreclaimed = nOwned > nInQueue ? nOwned - nInQueue : 0 ;
+                    if ( nUnreclaimed > nPeak )
+                        nPeak = nUnreclaimed    ;
+                    fSum += nUnreclaimed    ;
+                    ++nSampleCount  ;
+
+                    size_t nRSS = processRSS()  ;
+                    if ( nRSS > m_nPeakRSS )
+                        m_nPeakRSS = nRSS   ;
+                }
+
+                m_nSampleCount = nSampleCount   ;
+                m_nPeakUnreclaimed = nPeak  ;
+                m_fAvgUnreclaimed = nSampleCount ? fSum / nSampleCount : 0  ;
+            }
+        };
+
+        // Enters GC critical section and sleeps until all workers are done
+        template <class GC>
+        class Staller: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new Staller( *this )  ;
+            }
+        public:
+            Staller( CppUnitMini::ThreadPool& pool )
+                : CppUnitMini::TestThread( pool )
+            {}
+            Staller( Staller& src )
+                : CppUnitMini::TestThread( src )
+            {}
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+
+            virtual void test()
+            {
+                // The guard keeps the thread in GC critical section until the workers are done
+                typename gc_traits<GC>::guard stallGuard  ;
+                while ( s_nWorkerDone.load<cds::membar_acquire>() < s_nThreadCount )
+                    sleepMsec( 10 ) ;
+            }
+        };
+
+    protected:
+        template <class QUEUE, class GC>
+        void run( bool bStall )
+        {
+            size_t nScanStart ;
+            double fScanStart ;
+            gc_traits<GC>::scanStat( nScanStart, fScanStart )   ;
+
+            s_nWorkerDone.store<cds::membar_release>( (size_t) 0 )  ;
+            s_nNodeBase = s_nNodeAlloc.load<cds::membar_relaxed>() - s_nNodeFree.load<cds::membar_relaxed>() ;
+
+            QUEUE testQueue ;
+            for ( size_t i = 0; i < s_nQueueSize; ++i )
+                testQueue.push( i )    ;
+
+            CppUnitMini::ThreadPool pool( *this )   ;
+            pool.add( new Worker<QUEUE>( pool, testQueue ), s_nThreadCount )    ;
+            pool.add( new Monitor<QUEUE>( pool, testQueue ), 1 )    ;
+            if ( bStall )
+                pool.add( new Staller<GC>( pool ), 1 )  ;
+
+            CPPUNIT_MSG( "   Push/pop test, thread count=" << s_nThreadCount
+                << ", pass count=" << s_nPassCount
+                << ", queue size=" << s_nQueueSize
+                << ", stalled thread=" << (bStall ? "yes" : "no") << " ...")   ;
+            pool.run()  ;
+
+            size_t nScanEnd ;
+            double fScanEnd ;
+            gc_traits<GC>::scanStat( nScanEnd, fScanEnd )   ;
+
+            size_t nTotalPops = 0   ;
+            size_t nPopEmpty = 0    ;
+            double fDuration = 0    ;
+            Monitor<QUEUE> * pMonitor = NULL    ;
+            for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it ) {
+                Worker<QUEUE> * pWorker = dynamic_cast<Worker<QUEUE> *>( *it )    ;
+                if ( pWorker ) {
+                    nTotalPops += pWorker->m_nPopCount  ;
+                    nPopEmpty += pWorker->m_nPopEmpty   ;
+                    if ( pWorker->m_nDuration > fDuration )
+                        fDuration = pWorker->m_nDuration    ;
+                }
+                else if ( !pMonitor )
+                    pMonitor = dynamic_cast<Monitor<QUEUE> *>( *it )  ;
+            }
+            CPPUNIT_ASSERT( pMonitor != NULL )  ;
+
+            size_t nOps = s_nThreadCount * s_nPassCount * 2 ;
+            CPPUNIT_MSG( "     Duration=" << fDuration
+                << ", ops/sec=" << (fDuration > 0 ? size_t( nOps / fDuration ) : 0) ) ;
+            CPPUNIT_MSG( "     Unreclaimed nodes: peak=" << pMonitor->m_nPeakUnreclaimed
+                << ", avg=" << size_t( pMonitor->m_fAvgUnreclaimed )
+                << ", samples=" << pMonitor->m_nSampleCount )   ;
+            CPPUNIT_MSG( "     Scan: count=" << nScanEnd - nScanStart
+                << ", time, sec=" << fScanEnd - fScanStart )    ;
+            CPPUNIT_MSG( "     RSS, KB: start=" << pMonitor->m_nStartRSS
+                << ", peak=" << pMonitor->m_nPeakRSS )    ;
+
+            CPPUNIT_ASSERT( nTotalPops + nPopEmpty == s_nThreadCount * s_nPassCount )   ;
+            CPPUNIT_ASSERT( testQueue.size() == s_nQueueSize + nPopEmpty )  ;
+        }
+
+        template <class QUEUE, class GC>
+        void test()
+        {
+            run<QUEUE, GC>( false )   ;
+            if ( s_bStall )
+                run<QUEUE, GC>( true )    ;
+        }
+
+        void setUpParams( const CppUnitMini::TestCfg& cfg ) {
+            s_nThreadCount = cfg.getULong("ThreadCount", 4 ) ;
+            s_nPassCount = cfg.getULong("PassCount", 1000000 );
+            s_nQueueSize = cfg.getULong("QueueSize", 1000 );
+            s_nSampleInterval = cfg.getULong("SampleInterval", 1 );
+            s_bStall = cfg.getBool("StalledThread", true ) ;
+        }
+
+    protected:
+        TEST_CASE( MSQueue_HP, cds::gc::hzp_gc )
+        TEST_CASE( MSQueue_HRC, cds::gc::hrc_gc )
+        TEST_CASE( MSQueue_PTB, cds::gc::ptb_gc )
+        TEST_CASE( MSQueue_Epoch, cds::gc::epoch_gc )
+        TEST_CASE( MSQueue_IBR, cds::gc::ibr_gc )
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        TEST_CASE( MSQueue_Tagged, cds::gc::tagged_gc )
+#endif
+
+        CPPUNIT_TEST_SUITE(Queue_GCOverhead_MT)
+            CPPUNIT_TEST(MSQueue_HP)                ;
+            CPPUNIT_TEST(MSQueue_HRC)               ;
+            CPPUNIT_TEST(MSQueue_PTB)               ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+#ifdef CDS_DWORD_CAS_SUPPORTED
+            CPPUNIT_TEST(MSQueue_Tagged)            ;
+#endif
+        CPPUNIT_TEST_SUITE_END();
+    };
+
+} // namespace queue
+
+CPPUNIT_TEST_SUITE_REGISTRATION(queue::Queue_GCOverhead_MT);
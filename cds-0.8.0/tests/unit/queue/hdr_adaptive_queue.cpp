@@ -0,0 +1,99 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/adaptive_queue.h>
+
+#include "queue/queue_test_header.h"
+
+namespace queue {
+    namespace {
+        struct StatTraits: public QueueCountedTraits {
+            typedef cds::queue::queue_statistics    statistics  ;
+        };
+    }
+
+    void Queue_TestHeader::AdaptiveQueue_()
+    {
+        testNoItemCounter< cds::queue::adaptive_queue< int > >()    ;
+    }
+
+    void Queue_TestHeader::AdaptiveQueue_Counted()
+    {
+        testWithItemCounter< cds::queue::adaptive_queue< int, QueueCountedTraits > >()  ;
+    }
+
+    void Queue_TestHeader::AdaptiveQueue_Switch()
+    {
+        typedef cds::queue::adaptive_queue< int, StatTraits >   queue_type  ;
+
+        queue_type  q( 10 ) ;
+        int         it      ;
+
+        CPPUNIT_ASSERT( q.capacity() == 16 )    ;
+        CPPUNIT_ASSERT( q.is_spsc() )           ;
+
+        // Fill the queue in single-thread mode
+        for ( int i = 0; i < 16; ++i )
+            CPPUNIT_ASSERT( q.enqueue( i ))     ;
+        CPPUNIT_ASSERT( !q.enqueue( 16 ))       ;
+        CPPUNIT_ASSERT( q.size() == 16 )        ;
+
+        {
+            queue_type::scoped_producer p1( q ) ;
+            CPPUNIT_ASSERT( q.is_spsc() )       ;
+            {
+                // The second producer switches the producer side to shared mode
+                queue_type::scoped_producer p2( q ) ;
+                CPPUNIT_ASSERT( !q.is_spsc() )  ;
+                CPPUNIT_ASSERT( q.getStatistics().m_ModeUpgrade.get() == 1 )    ;
+                CPPUNIT_ASSERT( !q.enqueue( 16 ))   ;
+
+                // The items enqueued before the switch are dequeued in FIFO order
+                for ( int i = 0; i < 8; ++i ) {
+                    CPPUNIT_ASSERT( q.dequeue( it ))    ;
+                    CPPUNIT_ASSERT( it == i )   ;
+                }
+                for ( int i = 16; i < 24; ++i )
+                    CPPUNIT_ASSERT( q.push( i ))    ;
+                CPPUNIT_ASSERT( !q.push( 24 ))      ;
+            }
+            CPPUNIT_ASSERT( q.is_spsc() )       ;
+            CPPUNIT_ASSERT( q.getStatistics().m_ModeDowngrade.get() == 1 )  ;
+
+            // The consumer side is switched independently
+            queue_type::scoped_consumer c1( q ) ;
+            queue_type::scoped_consumer c2( q ) ;
+            CPPUNIT_ASSERT( !q.is_spsc() )      ;
+            for ( int i = 8; i < 20; ++i ) {
+                CPPUNIT_ASSERT( q.pop( it ))    ;
+                CPPUNIT_ASSERT( it == i )       ;
+            }
+            CPPUNIT_ASSERT( q.getStatistics().m_ModeUpgrade.get() == 2 )    ;
+        }
+        CPPUNIT_ASSERT( q.is_spsc() )           ;
+        CPPUNIT_ASSERT( q.getStatistics().m_ModeDowngrade.get() == 2 )  ;
+
+        // Wrap around in single-thread mode
+        for ( int i = 24; i < 36; ++i )
+            CPPUNIT_ASSERT( q.enqueue( i ))     ;
+        CPPUNIT_ASSERT( q.size() == 16 )        ;
+        for ( int i = 20; i < 36; ++i ) {
+            CPPUNIT_ASSERT( q.dequeue( it ))    ;
+            CPPUNIT_ASSERT( it == i )           ;
+        }
+        CPPUNIT_ASSERT( q.empty() )             ;
+        CPPUNIT_ASSERT( !q.dequeue( it ))       ;
+
+        CPPUNIT_ASSERT( q.enqueue( 100 ))       ;
+        CPPUNIT_ASSERT( q.clear() == 1 )        ;
+        CPPUNIT_ASSERT( q.empty() )             ;
+        CPPUNIT_ASSERT( q.size() == 0 )         ;
+    }
+}
@@ -0,0 +1,138 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/byte_ring.h>
+
+#include "queue/queue_test_header.h"
+
+namespace queue {
+    namespace {
+        template <class RING>
+        void testByteRing()
+        {
+            const size_t c_nLineSize = RING::c_nRecordAlignment ;
+            RING r( c_nLineSize * 8 )   ;
+            CPPUNIT_ASSERT( r.capacity() == c_nLineSize * 8 )   ;
+            CPPUNIT_ASSERT( r.empty() ) ;
+
+            size_t nLength  ;
+            CPPUNIT_ASSERT( r.read( nLength ) == NULL ) ;
+
+            // The record is invisible until committed
+            char * p = reinterpret_cast<char *>( r.reserve( 10 ))   ;
+            CPPUNIT_ASSERT( p != NULL ) ;
+            memcpy( p, "0123456789", 10 )   ;
+            CPPUNIT_ASSERT( r.empty() ) ;
+            r.commit( p )   ;
+            CPPUNIT_ASSERT( !r.empty() )    ;
+
+            char * pRead = reinterpret_cast<char *>( r.read( nLength ))  ;
+            CPPUNIT_ASSERT( pRead == p )    ;
+            CPPUNIT_ASSERT( nLength == 10 ) ;
+            CPPUNIT_ASSERT( memcmp( pRead, "0123456789", 10 ) == 0 )    ;
+            // read() before release() returns the same record
+            CPPUNIT_ASSERT( r.read( nLength ) == pRead )    ;
+            r.release() ;
+            CPPUNIT_ASSERT( r.empty() ) ;
+
+            // Record starts are cache-line aligned
+            p = reinterpret_cast<char *>( r.reserve( 1 ))   ;
+            CPPUNIT_ASSERT( p != NULL ) ;
+            CPPUNIT_ASSERT( (p - pRead) == (ptrdiff_t) RING::record_size( 10 ))   ;
+            CPPUNIT_ASSERT( ((p - RING::c_nHeaderSize - (char *) 0) & (c_nLineSize - 1)) == 0 ) ;
+            *p = 'a'    ;
+            r.commit( p )   ;
+
+            // Records of 3 and 2 lines; the last line of the buffer and the first one are free
+            size_t const nBig = c_nLineSize * 3 - RING::c_nHeaderSize  ;
+            size_t const nMid = c_nLineSize * 2 - RING::c_nHeaderSize  ;
+            char * p1 = reinterpret_cast<char *>( r.reserve( nBig ))   ;
+            CPPUNIT_ASSERT( p1 != NULL )    ;
+            char * p2 = reinterpret_cast<char *>( r.reserve( nMid ))   ;
+            CPPUNIT_ASSERT( p2 != NULL )    ;
+            memset( p1, 1, nBig )   ;
+            memset( p2, 2, nMid )   ;
+            r.commit( p1 )  ;
+            r.commit( p2 )  ;
+
+            // The record of 2 lines needs the padding up to the end of the buffer and does not fit
+            CPPUNIT_ASSERT( r.reserve( nMid ) == NULL ) ;
+
+            // Too big message never fits
+            CPPUNIT_ASSERT( r.reserve( r.capacity() ) == NULL ) ;
+
+            pRead = reinterpret_cast<char *>( r.read( nLength ))  ;
+            CPPUNIT_ASSERT( pRead != NULL && nLength == 1 && *pRead == 'a' )    ;
+            r.release() ;
+            pRead = reinterpret_cast<char *>( r.read( nLength ))  ;
+            CPPUNIT_ASSERT( pRead == p1 && nLength == nBig && pRead[0] == 1 && pRead[nBig - 1] == 1 ) ;
+            r.release() ;
+
+            // Now 5 lines are free at the start of the buffer and 1 line at the end.
+            // The record of 2 lines is placed at the start, the padding record fills the end
+            p = reinterpret_cast<char *>( r.reserve( nMid ))   ;
+            CPPUNIT_ASSERT( p != NULL ) ;
+            CPPUNIT_ASSERT( p < p1 )    ;
+            memset( p, 3, nMid )    ;
+            r.commit( p )   ;
+
+            pRead = reinterpret_cast<char *>( r.read( nLength ))  ;
+            CPPUNIT_ASSERT( pRead == p2 && nLength == nMid && pRead[0] == 2 && pRead[nMid - 1] == 2 ) ;
+            r.release() ;
+
+            // The padding record is skipped
+            pRead = reinterpret_cast<char *>( r.read( nLength ))  ;
+            CPPUNIT_ASSERT( pRead == p && nLength == nMid && pRead[0] == 3 && pRead[nMid - 1] == 3 ) ;
+            r.release() ;
+            CPPUNIT_ASSERT( r.empty() ) ;
+
+            // Many wrap-arounds with various sizes
+            for ( size_t i = 0; i < 1000; ++i ) {
+                size_t nLen = 1 + (i * 37) % nBig   ;
+                unsigned char * pw = reinterpret_cast<unsigned char *>( r.reserve( nLen ))  ;
+                CPPUNIT_ASSERT( pw != NULL )    ;
+                memset( pw, (int) (i & 0xFF), nLen )    ;
+                r.commit( pw )  ;
+
+                unsigned char * pr = reinterpret_cast<unsigned char *>( r.read( nLength ))  ;
+                CPPUNIT_ASSERT( pr == pw && nLength == nLen )    ;
+                CPPUNIT_ASSERT( pr[0] == (i & 0xFF) && pr[nLen - 1] == (i & 0xFF) ) ;
+                r.release() ;
+            }
+            CPPUNIT_ASSERT( r.empty() ) ;
+        }
+    }
+
+    void Queue_TestHeader::ByteRing_SPSC()
+    {
+        testByteRing< cds::queue::spsc_byte_ring >()    ;
+    }
+
+    void Queue_TestHeader::ByteRing_MPSC()
+    {
+        testByteRing< cds::queue::mpsc_byte_ring >()    ;
+
+        // Several uncommitted records: the consumer waits for the first one
+        cds::queue::mpsc_byte_ring r( 4096 )    ;
+        char * p1 = reinterpret_cast<char *>( r.reserve( 8 ))   ;
+        char * p2 = reinterpret_cast<char *>( r.reserve( 8 ))   ;
+        CPPUNIT_ASSERT( p1 != NULL && p2 != NULL && p1 != p2 )  ;
+        r.commit( p2 )  ;
+        CPPUNIT_ASSERT( r.empty() ) ;
+        r.commit( p1 )  ;
+
+        size_t nLength  ;
+        CPPUNIT_ASSERT( r.read( nLength ) == p1 )   ;
+        r.release() ;
+        CPPUNIT_ASSERT( r.read( nLength ) == p2 )   ;
+        r.release() ;
+        CPPUNIT_ASSERT( r.empty() ) ;
+    }
+}
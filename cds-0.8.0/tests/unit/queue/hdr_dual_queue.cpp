@@ -0,0 +1,74 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/dual_queue.h>
+
+#include "queue/queue_test_header.h"
+
+namespace queue {
+    namespace {
+        struct StatTraits: public QueueCountedTraits {
+            typedef cds::queue::queue_statistics    statistics  ;
+        };
+    }
+
+    void Queue_TestHeader::DualQueue_HP()
+    {
+        testNoItemCounter< cds::queue::dual_queue< int > >()    ;
+    }
+
+    void Queue_TestHeader::DualQueue_HP_Counted()
+    {
+        testWithItemCounter< cds::queue::dual_queue< int, QueueCountedTraits > >()  ;
+    }
+
+    void Queue_TestHeader::DualQueue_HP_Transfer()
+    {
+        typedef cds::queue::dual_queue< int, StatTraits >   queue_type  ;
+
+        queue_type  q   ;
+        int         it  ;
+
+        // No consumer is waiting: tryTransfer fails and does not enqueue
+        CPPUNIT_ASSERT( !q.tryTransfer( 1 ))    ;
+        CPPUNIT_ASSERT( q.empty() ) ;
+        CPPUNIT_ASSERT( q.size() == 0 ) ;
+        CPPUNIT_ASSERT( !q.poll( it ))  ;
+
+        // take and poll receive the items in FIFO order
+        for ( int i = 0; i < 10; ++i )
+            CPPUNIT_ASSERT( q.put( i )) ;
+        CPPUNIT_ASSERT( q.size() == 10 )    ;
+        // The queue contains data, tryTransfer does not append the item
+        CPPUNIT_ASSERT( !q.tryTransfer( 100 ))  ;
+        CPPUNIT_ASSERT( q.size() == 10 )    ;
+
+        for ( int i = 0; i < 10; ++i ) {
+            it = -1 ;
+            if ( i & 1 )
+                q.take( it )    ;
+            else
+                CPPUNIT_ASSERT( q.poll( it ))   ;
+            CPPUNIT_ASSERT( it == i )   ;
+        }
+        CPPUNIT_ASSERT( q.empty() ) ;
+        CPPUNIT_ASSERT( q.size() == 0 ) ;
+        CPPUNIT_ASSERT( !q.poll( it ))  ;
+
+        CPPUNIT_ASSERT( q.getStatistics().m_EnqueueCount.get() == 10 )  ;
+        CPPUNIT_ASSERT( q.getStatistics().m_DequeueCount.get() == 10 )  ;
+        CPPUNIT_ASSERT( q.getStatistics().m_ParkCount.get() == 0 )  ;
+
+        CPPUNIT_ASSERT( q.push( 5 ))    ;
+        CPPUNIT_ASSERT( q.push( 6 ))    ;
+        CPPUNIT_ASSERT( q.clear() == 2 )    ;
+        CPPUNIT_ASSERT( q.empty() ) ;
+    }
+}
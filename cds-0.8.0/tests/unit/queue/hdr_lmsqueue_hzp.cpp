@@ -24,4 +24,9 @@ namespace queue {
         testWithItemCounter< cds::queue::LMSQueue<cds::gc::hzp_gc, int, QueueCountedTraits > >() ;
     }
 
+    void Queue_TestHeader::LMSQueue_HP_NodeCache()
+    {
+        testNodeCache< cds::queue::LMSQueue<cds::gc::hzp_gc, int, QueueNodeCacheTraits > >() ;
+    }
+
 }
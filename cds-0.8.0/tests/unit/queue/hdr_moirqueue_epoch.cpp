@@ -0,0 +1,32 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/moir_queue_epoch.h>
+
+#include "queue/queue_test_header.h"
+
+namespace queue {
+
+    void Queue_TestHeader::MoirQueue_Epoch()
+    {
+        testNoItemCounter<cds::queue::MoirQueue<cds::gc::epoch_gc, int> >()    ;
+    }
+
+    void Queue_TestHeader::MoirQueue_Epoch_Counted()
+    {
+        testWithItemCounter< cds::queue::MoirQueue<cds::gc::epoch_gc, int, QueueCountedTraits > >() ;
+    }
+
+    void Queue_TestHeader::MoirQueue_Epoch_Batch()
+    {
+        testBatch< cds::queue::MoirQueue<cds::gc::epoch_gc, int, QueueCountedTraits > >() ;
+    }
+}
+
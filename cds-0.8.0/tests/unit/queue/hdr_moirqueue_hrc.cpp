@@ -25,5 +25,10 @@ namespace queue {
     {
         testWithItemCounter< cds::queue::MoirQueue<cds::gc::hrc_gc, int, QueueCountedTraits > >() ;
     }
+
+    void Queue_TestHeader::MoirQueue_HRC_Batch()
+    {
+        testBatch< cds::queue::MoirQueue<cds::gc::hrc_gc, int, QueueCountedTraits > >() ;
+    }
 
 }
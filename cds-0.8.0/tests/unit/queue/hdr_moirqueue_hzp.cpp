@@ -23,5 +23,15 @@ namespace queue {
     {
         testWithItemCounter< cds::queue::MoirQueue<cds::gc::hzp_gc, int, QueueCountedTraits > >() ;
     }
+
+    void Queue_TestHeader::MoirQueue_HP_Batch()
+    {
+        testBatch< cds::queue::MoirQueue<cds::gc::hzp_gc, int, QueueCountedTraits > >() ;
+    }
+
+    void Queue_TestHeader::MoirQueue_HP_NodeCache()
+    {
+        testNodeCache< cds::queue::MoirQueue<cds::gc::hzp_gc, int, QueueNodeCacheTraits > >() ;
+    }
 }
 
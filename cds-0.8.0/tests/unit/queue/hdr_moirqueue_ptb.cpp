@@ -23,5 +23,10 @@ namespace queue {
     {
         testWithItemCounter< cds::queue::MoirQueue<cds::gc::ptb_gc, int, QueueCountedTraits > >() ;
     }
+
+    void Queue_TestHeader::MoirQueue_PTB_Batch()
+    {
+        testBatch< cds::queue::MoirQueue<cds::gc::ptb_gc, int, QueueCountedTraits > >() ;
+    }
 }
 
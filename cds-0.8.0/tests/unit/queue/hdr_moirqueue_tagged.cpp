@@ -24,6 +24,20 @@ namespace queue {
     {
 #ifdef CDS_DWORD_CAS_SUPPORTED
         testWithItemCounter< cds::queue::MoirQueue<cds::gc::tagged_gc, int, QueueCountedTraits > >() ;
+#endif
+    }
+
+    void Queue_TestHeader::MoirQueue_tagged_Batch()
+    {
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        testBatch< cds::queue::MoirQueue<cds::gc::tagged_gc, int, QueueCountedTraits > >() ;
+#endif
+    }
+
+    void Queue_TestHeader::MoirQueue_tagged_FreeList()
+    {
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        testFreeList< cds::queue::MoirQueue<cds::gc::tagged_gc, int > >() ;
 #endif
     }
 }
@@ -22,4 +22,9 @@ namespace queue {
     {
         testWithItemCounter< cds::queue::MSQueue<cds::gc::hrc_gc, int, QueueCountedTraits > >() ;
     }
+
+    void Queue_TestHeader::MSQueue_HRC_Batch()
+    {
+        testBatch< cds::queue::MSQueue<cds::gc::hrc_gc, int, QueueCountedTraits > >() ;
+    }
 }
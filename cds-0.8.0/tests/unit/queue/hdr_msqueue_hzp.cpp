@@ -22,4 +22,14 @@ namespace queue {
     {
         testWithItemCounter< cds::queue::MSQueue<cds::gc::hzp_gc, int, QueueCountedTraits > >() ;
     }
+
+    void Queue_TestHeader::MSQueue_HP_Batch()
+    {
+        testBatch< cds::queue::MSQueue<cds::gc::hzp_gc, int, QueueCountedTraits > >() ;
+    }
+
+    void Queue_TestHeader::MSQueue_HP_NodeCache()
+    {
+        testNodeCache< cds::queue::MSQueue<cds::gc::hzp_gc, int, QueueNodeCacheTraits > >() ;
+    }
 }
@@ -22,4 +22,14 @@ namespace queue {
     {
         testWithItemCounter< cds::queue::MSQueue<cds::gc::ptb_gc, int, QueueCountedTraits > >() ;
     }
+
+    void Queue_TestHeader::MSQueue_PTB_Batch()
+    {
+        testBatch< cds::queue::MSQueue<cds::gc::ptb_gc, int, QueueCountedTraits > >() ;
+    }
+
+    void Queue_TestHeader::MSQueue_PTB_NodeCache()
+    {
+        testNodeCache< cds::queue::MSQueue<cds::gc::ptb_gc, int, QueueNodeCacheTraits > >() ;
+    }
 }
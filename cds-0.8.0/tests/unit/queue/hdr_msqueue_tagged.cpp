@@ -23,6 +23,20 @@ namespace queue {
     {
 #ifdef CDS_DWORD_CAS_SUPPORTED
         testWithItemCounter< cds::queue::MSQueue<cds::gc::tagged_gc, int, QueueCountedTraits > >() ;
+#endif
+    }
+
+    void Queue_TestHeader::MSQueue_tagged_Batch()
+    {
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        testBatch< cds::queue::MSQueue<cds::gc::tagged_gc, int, QueueCountedTraits > >() ;
+#endif
+    }
+
+    void Queue_TestHeader::MSQueue_tagged_FreeList()
+    {
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        testFreeList< cds::queue::MSQueue<cds::gc::tagged_gc, int > >() ;
 #endif
     }
 }
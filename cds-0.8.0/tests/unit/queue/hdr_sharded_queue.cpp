@@ -0,0 +1,82 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/msqueue_hzp.h>
+#include <cds/queue/rwqueue.h>
+#include <cds/lock/spinlock.h>
+#include <cds/queue/sharded_queue.h>
+
+#include "queue/queue_test_header.h"
+
+namespace queue {
+    namespace {
+        struct StatTraits: public cds::queue::traits {
+            typedef cds::queue::queue_statistics    statistics  ;
+        };
+    }
+
+    void Queue_TestHeader::ShardedQueue_MSQueue_HP()
+    {
+        testNoItemCounter< cds::queue::sharded_queue< cds::queue::MSQueue<cds::gc::hzp_gc, int> > >()    ;
+    }
+
+    void Queue_TestHeader::ShardedQueue_MSQueue_HP_Counted()
+    {
+        testWithItemCounter< cds::queue::sharded_queue< cds::queue::MSQueue<cds::gc::hzp_gc, int, QueueCountedTraits > > >() ;
+    }
+
+    void Queue_TestHeader::ShardedQueue_RWQueue_Steal()
+    {
+        typedef cds::queue::sharded_queue< cds::queue::RWQueue<int, cds::lock::Spin, QueueCountedTraits>, StatTraits >   queue_type  ;
+
+        const size_t c_nShardCount = 4  ;
+        const int c_nItemPerShard = 10  ;
+
+        queue_type  q( c_nShardCount ) ;
+        CPPUNIT_ASSERT( q.shard_count() == c_nShardCount )  ;
+        CPPUNIT_ASSERT( q.empty() )     ;
+
+        // Fill each shard directly: the item is shard * 100 + no
+        for ( size_t nShard = 0; nShard < c_nShardCount; ++nShard ) {
+            for ( int i = 0; i < c_nItemPerShard; ++i )
+                CPPUNIT_ASSERT( q.get_shard( nShard ).push( (int) nShard * 100 + i ))  ;
+        }
+        CPPUNIT_ASSERT( !q.empty() )    ;
+        CPPUNIT_ASSERT( q.size() == c_nShardCount * c_nItemPerShard )   ;
+
+        // All items are dequeued; the order within each shard is FIFO
+        int arrNext[c_nShardCount]  ;
+        for ( size_t i = 0; i < c_nShardCount; ++i )
+            arrNext[i] = 0  ;
+
+        int it  ;
+        size_t nPopped = 0  ;
+        while ( q.pop( it )) {
+            size_t nShard = it / 100    ;
+            CPPUNIT_ASSERT( nShard < c_nShardCount )    ;
+            CPPUNIT_ASSERT( it % 100 == arrNext[nShard] )   ;
+            ++arrNext[nShard]   ;
+            ++nPopped   ;
+        }
+        CPPUNIT_ASSERT( nPopped == c_nShardCount * c_nItemPerShard )    ;
+        CPPUNIT_ASSERT( q.empty() )     ;
+        CPPUNIT_ASSERT( q.size() == 0 ) ;
+
+        // The items of non-local shards are stolen
+        CPPUNIT_ASSERT( q.getStatistics().m_DequeueCount.get() == nPopped ) ;
+        CPPUNIT_ASSERT( q.getStatistics().m_DequeueSteal.get() > 0 ) ;
+
+        // The items pushed to the queue are dequeued from the local shard
+        for ( int i = 0; i < c_nItemPerShard; ++i )
+            CPPUNIT_ASSERT( q.push( i ))    ;
+        CPPUNIT_ASSERT( q.clear() == (size_t) c_nItemPerShard ) ;
+        CPPUNIT_ASSERT( q.empty() )     ;
+    }
+}
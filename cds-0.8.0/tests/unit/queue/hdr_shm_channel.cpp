@@ -0,0 +1,126 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/shm_channel.h>
+
+#include "queue/queue_test_header.h"
+
+#include <stdio.h>
+
+namespace queue {
+    namespace {
+        struct Message {
+            int     nNo     ;
+            char    arrData[20] ;
+        };
+
+        template <class CHANNEL>
+        void testShmChannel( CHANNEL& producer, CHANNEL& consumer )
+        {
+            CPPUNIT_ASSERT( producer.capacity() == consumer.capacity() )    ;
+            CPPUNIT_ASSERT( consumer.empty() )  ;
+
+            Message m   ;
+            CPPUNIT_ASSERT( !consumer.pop( m ))  ;
+
+            // The channel is filled up to its capacity
+            for ( int i = 0; i < (int) producer.capacity(); ++i ) {
+                m.nNo = i   ;
+                m.arrData[0] = (char) i ;
+                CPPUNIT_ASSERT( producer.push( m )) ;
+            }
+            m.nNo = -1  ;
+            CPPUNIT_ASSERT( !producer.push( m ))    ;
+            CPPUNIT_ASSERT( !consumer.empty() ) ;
+
+            for ( int i = 0; i < (int) producer.capacity(); ++i ) {
+                CPPUNIT_ASSERT( consumer.pop( m ))  ;
+                CPPUNIT_ASSERT( m.nNo == i )    ;
+                CPPUNIT_ASSERT( m.arrData[0] == (char) i )  ;
+            }
+            CPPUNIT_ASSERT( consumer.empty() )  ;
+            CPPUNIT_ASSERT( !consumer.pop( m ))  ;
+
+            // Interleaved push/pop wraps the channel many times
+            for ( int i = 0; i < 1000; ++i ) {
+                m.nNo = i   ;
+                CPPUNIT_ASSERT( producer.push( m )) ;
+                m.nNo = i + 1   ;
+                CPPUNIT_ASSERT( producer.push( m )) ;
+                CPPUNIT_ASSERT( consumer.pop( m ))  ;
+                CPPUNIT_ASSERT( m.nNo == i )    ;
+                CPPUNIT_ASSERT( consumer.pop( m ))  ;
+                CPPUNIT_ASSERT( m.nNo == i + 1 )    ;
+            }
+            CPPUNIT_ASSERT( consumer.empty() )  ;
+        }
+
+        template <class CHANNEL>
+        void testShmChannelByName()
+        {
+            char szName[64] ;
+            sprintf( szName, "/cds_test_shm_channel_%d", (int) getpid() )  ;
+
+            CHANNEL chCreated( szName, 100 )    ;
+            CPPUNIT_ASSERT( chCreated.capacity() == 128 )   ;
+
+            // The attached channel is mapped at another address
+            CHANNEL chAttached( szName )    ;
+            CPPUNIT_ASSERT( chAttached.capacity() == 128 )  ;
+
+            testShmChannel( chCreated, chAttached ) ;
+            testShmChannel( chAttached, chCreated ) ;
+        }
+    }
+
+    void Queue_TestHeader::ShmChannel_SPSC()
+    {
+        typedef cds::queue::shm_channel< Message >  channel_type    ;
+        testShmChannelByName< channel_type >()  ;
+
+        // The channel is created in the file descriptor
+        char szName[64] ;
+        sprintf( szName, "/cds_test_shm_channel_fd_%d", (int) getpid() )  ;
+        int fd = shm_open( szName, O_RDWR | O_CREAT | O_EXCL, 0600 ) ;
+        CPPUNIT_ASSERT( fd != -1 )  ;
+        shm_unlink( szName )    ;
+        {
+            channel_type chCreated( fd, 16 )    ;
+            channel_type chAttached( fd )   ;
+            testShmChannel( chCreated, chAttached ) ;
+
+            // The channel of other type cannot be attached
+            bool bThrown = false    ;
+            try {
+                cds::queue::shm_channel< Message, true > chWrong( fd )  ;
+            }
+            catch ( cds::Exception& ) {
+                bThrown = true  ;
+            }
+            CPPUNIT_ASSERT( bThrown )   ;
+        }
+        close( fd ) ;
+
+        // Attaching to nonexistent channel
+        bool bThrown = false    ;
+        try {
+            channel_type chNone( szName )   ;
+        }
+        catch ( cds::Exception& ) {
+            bThrown = true  ;
+        }
+        CPPUNIT_ASSERT( bThrown )   ;
+    }
+
+    void Queue_TestHeader::ShmChannel_MPSC()
+    {
+        testShmChannelByName< cds::queue::shm_channel< Message, true > >()  ;
+    }
+}
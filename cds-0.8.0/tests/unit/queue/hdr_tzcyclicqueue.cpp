@@ -9,6 +9,7 @@
 
 
 #include <cds/queue/tz_cyclic_queue.h>
+#include <cds/queue/tz_cyclic_value_queue.h>
 
 #include "queue/queue_test_header.h"
 
@@ -21,5 +22,15 @@ namespace queue {
     void Queue_TestHeader::TZCyclicQueue_Counted()
     {
         testWithItemCounter< cds::queue::TZCyclicQueue<int, QueueCountedTraits > >() ;
+    }
+
+    void Queue_TestHeader::TZCyclicValueQueue_()
+    {
+        testNoItemCounter<cds::queue::TZCyclicValueQueue<int> >()    ;
+    }
+
+    void Queue_TestHeader::TZCyclicValueQueue_Counted()
+    {
+        testWithItemCounter< cds::queue::TZCyclicValueQueue<int, QueueCountedTraits > >() ;
     }
 }
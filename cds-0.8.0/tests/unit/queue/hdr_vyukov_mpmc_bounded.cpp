@@ -0,0 +1,25 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/vyukov_mpmc_bounded.h>
+
+#include "queue/queue_test_header.h"
+
+namespace queue {
+    void Queue_TestHeader::VyukovMPMCBounded_static()
+    {
+        testBulk< cds::queue::vyukov_mpmc_bounded< int, cds::opt::buffer< cds::opt::v::static_buffer<int, 16> > > >()  ;
+    }
+
+    void Queue_TestHeader::VyukovMPMCBounded_dynamic()
+    {
+        testBulk< cds::queue::vyukov_mpmc_bounded< int, cds::opt::buffer< cds::opt::v::dynamic_buffer<int> > > >()  ;
+    }
+}
@@ -0,0 +1,79 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/queue/vyukov_mpsc.h>
+
+#include "queue/queue_test_header.h"
+
+namespace queue {
+    namespace {
+        struct mpsc_item: public cds::queue::vyukov_mpsc_node
+        {
+            int nValue  ;
+        };
+    }
+
+    void Queue_TestHeader::VyukovMPSC_()
+    {
+        testNoItemCounter< cds::queue::vyukov_mpsc< int > >()    ;
+    }
+
+    void Queue_TestHeader::VyukovMPSC_Counted()
+    {
+        testWithItemCounter< cds::queue::vyukov_mpsc< int, QueueCountedTraits > >() ;
+    }
+
+    void Queue_TestHeader::VyukovMPSC_NodeCache()
+    {
+        testNodeCache< cds::queue::vyukov_mpsc< int, QueueNodeCacheTraits > >() ;
+    }
+
+    void Queue_TestHeader::VyukovMPSC_Intrusive()
+    {
+        typedef cds::queue::intrusive_vyukov_mpsc< mpsc_item, QueueCountedTraits >    queue_type  ;
+
+        queue_type  q   ;
+        mpsc_item   arr[10] ;
+        for ( int i = 0; i < 10; ++i )
+            arr[i].nValue = i   ;
+
+        // several passes: the stub node is re-enqueued when the queue has one item
+        for ( size_t nPass = 0; nPass < 3; ++nPass ) {
+            CPPUNIT_ASSERT( q.empty() )         ;
+            CPPUNIT_ASSERT( q.dequeue() == NULL )   ;
+
+            CPPUNIT_ASSERT( q.enqueue( arr[0] ))    ;
+            CPPUNIT_ASSERT( !q.empty() )        ;
+            CPPUNIT_ASSERT( q.size() == 1 )     ;
+            CPPUNIT_ASSERT( q.dequeue() == &arr[0] )    ;
+            CPPUNIT_ASSERT( q.empty() )         ;
+            CPPUNIT_ASSERT( q.dequeue() == NULL )   ;
+
+            for ( int i = 0; i < 10; ++i )
+                CPPUNIT_ASSERT( q.push( arr[i] ))   ;
+            CPPUNIT_ASSERT( q.size() == 10 )    ;
+            for ( int i = 0; i < 5; ++i ) {
+                mpsc_item * p = q.pop()     ;
+                CPPUNIT_ASSERT( p == &arr[i] )  ;
+                CPPUNIT_ASSERT( p->nValue == i )    ;
+            }
+
+            // the dequeued nodes may be enqueued again
+            for ( int i = 0; i < 5; ++i )
+                CPPUNIT_ASSERT( q.push( arr[i] ))   ;
+            for ( int i = 5; i < 10; ++i )
+                CPPUNIT_ASSERT( q.dequeue() == &arr[i] )    ;
+            CPPUNIT_ASSERT( !q.empty() )        ;
+            CPPUNIT_ASSERT( q.clear() == 5 )    ;
+            CPPUNIT_ASSERT( q.empty() )         ;
+            CPPUNIT_ASSERT( q.size() == 0 )     ;
+        }
+    }
+}
@@ -17,12 +17,14 @@
 namespace queue {
 
 #define TEST_CASE( Q, V ) void Q() { test< Types<V>::Q >(); }
+#define TEST_BOUNDED( Q, V ) void Q() { test_bounded< Types<V>::Q >(); }
 
     namespace {
         static size_t s_nReaderThreadCount = 1  ;
         static size_t s_nWriterThreadCount = 1  ;
         static size_t s_nQueueSize = 64000000   ;
         static size_t s_nRepetitionCount = 2  ;
+        static size_t s_nQueueCapacity = 65536  ;   // for bounded queues
 
         struct Value {
             long nNo;
@@ -120,6 +122,29 @@ namespace queue {
             }
         };
 
+        template <class QUEUE>
+        class TakeReaderThread: public ReaderThread<QUEUE>
+        {
+            typedef ReaderThread<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new TakeReaderThread( *this ); }
+        public:
+            TakeReaderThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            TakeReaderThread( TakeReaderThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPushCount = base_class::getTest().m_nThreadPushCount;
+                Value v;
+
+                for (size_t i = 0; i < nPushCount; i++)
+                    base_class::m_Queue.take( v ) ;
+            }
+        };
+
     protected:
         size_t                  m_nThreadPushCount  ;
 
@@ -127,18 +152,39 @@ namespace queue {
         template <class QUEUE>
         void test()
         {
+            QUEUE testQueue ;
+            run< WriterThread<QUEUE>, ReaderThread<QUEUE> >( testQueue ) ;
+        }
+
+        // The consumer blocks in take() like TransferQueueCachelineBench.java
+        template <class QUEUE>
+        void test_take()
+        {
+            QUEUE testQueue ;
+            run< WriterThread<QUEUE>, TakeReaderThread<QUEUE> >( testQueue ) ;
+        }
+
+        template <class QUEUE>
+        void test_bounded()
+        {
+            QUEUE testQueue( s_nQueueCapacity ) ;
+            run< WriterThread<QUEUE>, ReaderThread<QUEUE> >( testQueue ) ;
+        }
+
+        template <class WRITER, class READER, class QUEUE>
+        void run( QUEUE& testQueue )
+        {
             double times[s_nRepetitionCount];
 
             m_nThreadPushCount = s_nQueueSize / 8;
 
             CPPUNIT_MSG( "Queue MEMBENCH test,\n    reader count=" << s_nReaderThreadCount << " writer count=" << s_nWriterThreadCount << " element count=" << m_nThreadPushCount << "..." )   ;
 
-            QUEUE testQueue ;
             CppUnitMini::ThreadPool pool( *this )   ;
 
             // Writers must be first
-            pool.add( new WriterThread<QUEUE>( pool, testQueue ), s_nWriterThreadCount );
-            pool.add( new ReaderThread<QUEUE>( pool, testQueue ), s_nReaderThreadCount );
+            pool.add( new WRITER( pool, testQueue ), s_nWriterThreadCount );
+            pool.add( new READER( pool, testQueue ), s_nReaderThreadCount );
 
             for (long i = 0; i < s_nRepetitionCount; i++) {
               cds::OS::Timer m;
@@ -172,6 +218,7 @@ namespace queue {
             s_nWriterThreadCount = cfg.getULong("WriterCount", 1 ) ;
             s_nQueueSize = cfg.getULong("QueueSize", 64000000 );
             s_nRepetitionCount = cfg.getULong("RepetitionCount", 2 );
+            s_nQueueCapacity = cfg.getULong("QueueCapacity", 65536 );
         }
 
     protected:
@@ -179,35 +226,49 @@ namespace queue {
         TEST_CASE( MoirQueue_HP, Value )
         TEST_CASE( MoirQueue_HRC, Value )
         TEST_CASE( MoirQueue_PTB, Value )
+        TEST_CASE( MoirQueue_Epoch, Value )
+        TEST_CASE( MoirQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged, Value )
 #endif
         TEST_CASE( MSQueue_HP, Value  )
         TEST_CASE( MSQueue_HRC, Value )
         TEST_CASE( MSQueue_PTB, Value )
+        TEST_CASE( MSQueue_Epoch, Value )
+        TEST_CASE( MSQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged, Value )
 #endif
         TEST_CASE( LMSQueue_HP, Value  )
         TEST_CASE( LMSQueue_PTB, Value )
+        TEST_CASE( LMSQueue_Epoch, Value )
 
         TEST_CASE( MoirQueue_HP_Counted, Value )
         TEST_CASE( MoirQueue_HRC_Counted, Value )
         TEST_CASE( MoirQueue_PTB_Counted, Value )
+        TEST_CASE( MoirQueue_Epoch_Counted, Value )
+        TEST_CASE( MoirQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( MSQueue_HP_Counted, Value )
         TEST_CASE( MSQueue_HRC_Counted, Value )
         TEST_CASE( MSQueue_PTB_Counted, Value )
+        TEST_CASE( MSQueue_Epoch_Counted, Value )
+        TEST_CASE( MSQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( LMSQueue_HP_Counted, Value )
         TEST_CASE( LMSQueue_PTB_Counted, Value)
+        TEST_CASE( LMSQueue_Epoch_Counted, Value)
 
         TEST_CASE( TZCyclicQueue, Value )
         TEST_CASE( TZCyclicQueue_Counted, Value )
+        TEST_BOUNDED( TZCyclicValueQueue, Value )
+        TEST_BOUNDED( TZCyclicValueQueue_Counted, Value )
+
+        TEST_BOUNDED( VyukovMPMCBounded, Value )
 
         TEST_CASE( RWQueue_Spinlock, Value )
         TEST_CASE( RWQueue_Spinlock_Counted, Value )
@@ -224,6 +285,9 @@ namespace queue {
 #endif
         TEST_CASE( HASQueue_Spinlock, Value )
 
+        TEST_CASE( DualQueue_HP, Value )
+        void DualQueue_HP_Take() { test_take< Types<Value>::DualQueue_HP >(); }
+
         CPPUNIT_TEST_SUITE(Queue_Membench_Cacheline_MT)
             CPPUNIT_TEST(CSQueue)              ;
             CPPUNIT_TEST(MoirQueue_HP)              ;
@@ -232,6 +296,10 @@ namespace queue {
             CPPUNIT_TEST(MoirQueue_HRC_Counted)      ;
             CPPUNIT_TEST(MoirQueue_PTB)              ;
             CPPUNIT_TEST(MoirQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(MoirQueue_Epoch)            ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Counted)    ;
+            CPPUNIT_TEST(MoirQueue_IBR)              ;
+            CPPUNIT_TEST(MoirQueue_IBR_Counted)      ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MoirQueue_Tagged)          ;
             CPPUNIT_TEST(MoirQueue_Tagged_Counted)  ;
@@ -243,6 +311,10 @@ namespace queue {
             CPPUNIT_TEST(MSQueue_HRC_Counted)       ;
             CPPUNIT_TEST(MSQueue_PTB)               ;
             CPPUNIT_TEST(MSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_Epoch_Counted)     ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+            CPPUNIT_TEST(MSQueue_IBR_Counted)       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MSQueue_Tagged)            ;
             CPPUNIT_TEST(MSQueue_Tagged_Counted)    ;
@@ -251,9 +323,15 @@ namespace queue {
             CPPUNIT_TEST(LMSQueue_HP_Counted)       ;
             CPPUNIT_TEST(LMSQueue_PTB)              ;
             CPPUNIT_TEST(LMSQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(LMSQueue_Epoch)            ;
+            CPPUNIT_TEST(LMSQueue_Epoch_Counted)    ;
+
+            CPPUNIT_TEST(TZCyclicQueue)             ;
+            CPPUNIT_TEST(TZCyclicQueue_Counted)     ;
+            CPPUNIT_TEST(TZCyclicValueQueue)        ;
+            CPPUNIT_TEST(TZCyclicValueQueue_Counted);
 
-            //CPPUNIT_TEST(TZCyclicQueue)             ;
-            //CPPUNIT_TEST(TZCyclicQueue_Counted)     ;
+            CPPUNIT_TEST(VyukovMPMCBounded)         ;
 
             CPPUNIT_TEST(RWQueue_Spinlock)          ;
             CPPUNIT_TEST(RWQueue_Spinlock_Counted)  ;
@@ -269,6 +347,9 @@ namespace queue {
             //CPPUNIT_TEST(StdQueue_list_WinMutex)  ;
 #endif
             CPPUNIT_TEST( HASQueue_Spinlock )       ;
+
+            CPPUNIT_TEST( DualQueue_HP )            ;
+            CPPUNIT_TEST( DualQueue_HP_Take )       ;
         CPPUNIT_TEST_SUITE_END();
     };
 
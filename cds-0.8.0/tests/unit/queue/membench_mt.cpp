@@ -10,24 +10,54 @@
 
 #include "cppunit/thread.h"
 #include "queue/queue_type.h"
+#include <cds/queue/byte_ring.h>
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <math.h>
 
 // Multi-threaded random queue test
 namespace queue {
 
 #define TEST_CASE( Q, V ) void Q() { test< Types<V>::Q >(); }
+#define TEST_BOUNDED( Q, V ) void Q() { test_bounded< Types<V>::Q >(); }
+#define TEST_BULK( Q, V ) void Q##_Bulk() { test_bulk< Types<V>::Q >(); }
+#define TEST_MESSAGE( R ) void R() { test_message< cds::queue::R >(); }
 
     namespace {
         static size_t s_nReaderThreadCount = 1  ;
         static size_t s_nWriterThreadCount = 1  ;
         static size_t s_nQueueSize = 64000000   ;
         static size_t s_nRepetitionCount = 2  ;
+        static size_t s_nQueueCapacity = 65536  ;   // for bounded queues
+        static size_t s_nBulkSize = 16  ;
+        static size_t s_nRingCapacity = 1024 * 1024 ;   // for byte rings, in bytes
+        static size_t s_nMessageSizeMin = 16    ;
+        static size_t s_nMessageSizeMax = 4096  ;
+        static size_t s_nMessageCount = 1000000 ;   // messages per writer
 
         struct Value {
             long nNo;
         };
+
+        // Message sizes are log-uniformly distributed in [s_nMessageSizeMin, s_nMessageSizeMax]
+        static std::vector<size_t>  s_arrMessageSize    ;
+        static const size_t c_nMessageSizeMask = 4096 - 1 ;
+
+        static double makeMessageSizes()
+        {
+            s_arrMessageSize.resize( c_nMessageSizeMask + 1 ) ;
+            double fRatio = (double) s_nMessageSizeMax / s_nMessageSizeMin ;
+            double fTotal = 0   ;
+            unsigned int nRand = 1  ;
+            for ( size_t i = 0; i < s_arrMessageSize.size(); ++i ) {
+                nRand = nRand * 1103515245 + 12345  ;
+                double u = ((nRand >> 8) & 0xFFFF) / 65536.0 ;
+                s_arrMessageSize[i] = (size_t)( s_nMessageSizeMin * pow( fRatio, u ))   ;
+                fTotal += s_arrMessageSize[i]   ;
+            }
+            return fTotal / s_arrMessageSize.size()  ;
+        }
     }
 
     class Queue_Membench_MT: public CppUnitMini::TestCase
@@ -114,25 +144,380 @@ namespace queue {
             }
         };
 
+        template <class QUEUE>
+        class BulkWriterThread: public WriterThread<QUEUE>
+        {
+            typedef WriterThread<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new BulkWriterThread( *this ); }
+        public:
+            BulkWriterThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            BulkWriterThread( BulkWriterThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPushCount = base_class::getTest().m_nThreadPushCount;
+                std::vector<Value> arr( s_nBulkSize );
+
+                for ( size_t nPushed = 0; nPushed < nPushCount; ) {
+                    size_t nBulk = std::min( s_nBulkSize, nPushCount - nPushed );
+                    for ( size_t i = 0; i < nBulk; ++i )
+                        arr[i].nNo = (long) (nPushed + i);
+                    for ( size_t k = 0; k < nBulk; )
+                        k += base_class::m_Queue.enqueue_bulk( arr.begin() + k, arr.begin() + nBulk );
+                    nPushed += nBulk;
+                }
+            }
+        };
+
+        template <class QUEUE>
+        class BulkReaderThread: public ReaderThread<QUEUE>
+        {
+            typedef ReaderThread<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new BulkReaderThread( *this ); }
+        public:
+            BulkReaderThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            BulkReaderThread( BulkReaderThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPushCount = base_class::getTest().m_nThreadPushCount;
+                std::vector<Value> arr( s_nBulkSize );
+
+                for ( size_t nPopped = 0; nPopped < nPushCount; )
+                    nPopped += base_class::m_Queue.dequeue_bulk( arr.begin(), std::min( s_nBulkSize, nPushCount - nPopped ));
+            }
+        };
+
+        template <class QUEUE>
+        class TakeReaderThread: public ReaderThread<QUEUE>
+        {
+            typedef ReaderThread<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new TakeReaderThread( *this ); }
+        public:
+            TakeReaderThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            TakeReaderThread( TakeReaderThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPushCount = base_class::getTest().m_nThreadPushCount;
+                Value v;
+
+                for (size_t i = 0; i < nPushCount; i++)
+                    base_class::m_Queue.take( v ) ;
+            }
+        };
+
+        // Writer attached to the adaptive queue as a producer
+        template <class QUEUE>
+        class AttachedWriterThread: public WriterThread<QUEUE>
+        {
+            typedef WriterThread<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new AttachedWriterThread( *this ); }
+        public:
+            AttachedWriterThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            AttachedWriterThread( AttachedWriterThread& src )
+                : base_class( src )
+            {}
+
+            virtual void init()
+            {
+                base_class::init()  ;
+                base_class::m_Queue.attach_producer()   ;
+            }
+            virtual void fini()
+            {
+                base_class::m_Queue.detach_producer()   ;
+                base_class::fini()  ;
+            }
+        };
+
+        // Reader attached to the adaptive queue as a consumer
+        template <class QUEUE>
+        class AttachedReaderThread: public ReaderThread<QUEUE>
+        {
+            typedef ReaderThread<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new AttachedReaderThread( *this ); }
+        public:
+            AttachedReaderThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            AttachedReaderThread( AttachedReaderThread& src )
+                : base_class( src )
+            {}
+
+            virtual void init()
+            {
+                base_class::init()  ;
+                base_class::m_Queue.attach_consumer()   ;
+            }
+            virtual void fini()
+            {
+                base_class::m_Queue.detach_consumer()   ;
+                base_class::fini()  ;
+            }
+        };
+
+        // Common part of the message writer/reader threads
+        template <class QUEUE>
+        class MessageThreadBase: public CppUnitMini::TestThread
+        {
+        public:
+            QUEUE&              m_Queue ;
+
+            MessageThreadBase( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            MessageThreadBase( MessageThreadBase& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            Queue_Membench_MT&  getTest()
+            {
+                return reinterpret_cast<Queue_Membench_MT&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+        };
+
+        // Writes the messages of variable size into the byte ring in place
+        template <class RING>
+        class MessageWriterThread: public MessageThreadBase<RING>
+        {
+            typedef MessageThreadBase<RING> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new MessageWriterThread( *this ); }
+        public:
+            MessageWriterThread( CppUnitMini::ThreadPool& pool, RING& r )
+                : base_class( pool, r )
+            {}
+            MessageWriterThread( MessageWriterThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPushCount = base_class::getTest().m_nThreadPushCount;
+
+                for ( size_t i = 0; i < nPushCount; ++i ) {
+                    size_t nLen = s_arrMessageSize[ (i + base_class::m_nThreadNo) & c_nMessageSizeMask ] ;
+                    void * p    ;
+                    while ( (p = base_class::m_Queue.reserve( nLen )) == NULL )
+                        ;
+                    memset( p, (int) i, nLen )  ;
+                    base_class::m_Queue.commit( p ) ;
+                }
+            }
+        };
+
+        template <class RING>
+        class MessageReaderThread: public MessageThreadBase<RING>
+        {
+            typedef MessageThreadBase<RING> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new MessageReaderThread( *this ); }
+        public:
+            size_t  m_nChecksum ;
+
+            MessageReaderThread( CppUnitMini::ThreadPool& pool, RING& r )
+                : base_class( pool, r )
+            {}
+            MessageReaderThread( MessageReaderThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPopCount = base_class::getTest().m_nThreadPushCount * s_nWriterThreadCount ;
+                m_nChecksum = 0 ;
+
+                for ( size_t i = 0; i < nPopCount; ++i ) {
+                    size_t nLen ;
+                    unsigned char * p   ;
+                    while ( (p = reinterpret_cast<unsigned char *>( base_class::m_Queue.read( nLen ))) == NULL )
+                        ;
+                    m_nChecksum += p[0] + p[nLen - 1] ;
+                    base_class::m_Queue.release()   ;
+                }
+            }
+        };
+
+        // Baseline for byte rings: the message is allocated by malloc and the pointer is passed through the queue
+        template <class QUEUE>
+        class MallocMessageWriterThread: public MessageThreadBase<QUEUE>
+        {
+            typedef MessageThreadBase<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new MallocMessageWriterThread( *this ); }
+        public:
+            MallocMessageWriterThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            MallocMessageWriterThread( MallocMessageWriterThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPushCount = base_class::getTest().m_nThreadPushCount;
+
+                for ( size_t i = 0; i < nPushCount; ++i ) {
+                    size_t nLen = s_arrMessageSize[ (i + base_class::m_nThreadNo) & c_nMessageSizeMask ] ;
+                    size_t * p = reinterpret_cast<size_t *>( malloc( sizeof(size_t) + nLen ))   ;
+                    *p = nLen   ;
+                    memset( p + 1, (int) i, nLen )  ;
+                    while ( !base_class::m_Queue.push( p ))
+                        ;
+                }
+            }
+        };
+
+        template <class QUEUE>
+        class MallocMessageReaderThread: public MessageThreadBase<QUEUE>
+        {
+            typedef MessageThreadBase<QUEUE> base_class  ;
+            virtual CppUnitMini::TestThread *clone() { return new MallocMessageReaderThread( *this ); }
+        public:
+            size_t  m_nChecksum ;
+
+            MallocMessageReaderThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : base_class( pool, q )
+            {}
+            MallocMessageReaderThread( MallocMessageReaderThread& src )
+                : base_class( src )
+            {}
+
+            virtual void test()
+            {
+                size_t nPopCount = base_class::getTest().m_nThreadPushCount * s_nWriterThreadCount ;
+                m_nChecksum = 0 ;
+
+                for ( size_t i = 0; i < nPopCount; ++i ) {
+                    size_t * p  ;
+                    while ( !base_class::m_Queue.pop( p ))
+                        ;
+                    unsigned char * pMsg = reinterpret_cast<unsigned char *>( p + 1 )  ;
+                    m_nChecksum += pMsg[0] + pMsg[*p - 1]   ;
+                    free( p )   ;
+                }
+            }
+        };
+
     protected:
         size_t                  m_nThreadPushCount  ;
+        double                  m_fItemSize         ;   // average item size in bytes for throughput calculation
 
     protected:
         template <class QUEUE>
         void test()
+        {
+            QUEUE testQueue ;
+            m_fItemSize = sizeof(Value) ;
+            run< WriterThread<QUEUE>, ReaderThread<QUEUE> >( testQueue ) ;
+        }
+
+        template <class QUEUE>
+        void test_bounded()
+        {
+            QUEUE testQueue( s_nQueueCapacity ) ;
+            m_fItemSize = sizeof(Value) ;
+            run< WriterThread<QUEUE>, ReaderThread<QUEUE> >( testQueue ) ;
+        }
+
+        template <class QUEUE>
+        void test_bulk()
+        {
+            QUEUE testQueue( s_nQueueCapacity ) ;
+            m_fItemSize = sizeof(Value) ;
+            CPPUNIT_MSG( "    bulk size=" << s_nBulkSize ) ;
+            run< BulkWriterThread<QUEUE>, BulkReaderThread<QUEUE> >( testQueue ) ;
+        }
+
+        // The consumer blocks in take() like TransferQueueBench.java
+        template <class QUEUE>
+        void test_take()
+        {
+            QUEUE testQueue ;
+            m_fItemSize = sizeof(Value) ;
+            run< WriterThread<QUEUE>, TakeReaderThread<QUEUE> >( testQueue ) ;
+        }
+
+        // The queue works in SPSC mode for one writer and one reader, in MPMC mode otherwise
+        template <class QUEUE>
+        void test_adaptive()
+        {
+            QUEUE testQueue( s_nQueueCapacity ) ;
+            m_fItemSize = sizeof(Value) ;
+            run< AttachedWriterThread<QUEUE>, AttachedReaderThread<QUEUE> >( testQueue ) ;
+            CPPUNIT_MSG( "    mode: " << (s_nWriterThreadCount > 1 ? "MP" : "SP") << (s_nReaderThreadCount > 1 ? "MC" : "SC") ) ;
+        }
+
+        template <class RING>
+        void test_message()
+        {
+            if ( s_nReaderThreadCount != 1 || (!RING::c_bMultipleProducers && s_nWriterThreadCount != 1) ) {
+                CPPUNIT_MSG( "    skipped: the byte ring supports one reader" << (RING::c_bMultipleProducers ? "" : " and one writer") ) ;
+                return  ;
+            }
+            RING testRing( s_nRingCapacity )    ;
+            // all writers' messages pass through the single reader
+            m_fItemSize = makeMessageSizes() * s_nWriterThreadCount ;
+            CPPUNIT_MSG( "    ring capacity=" << testRing.capacity() << " message size=[" << s_nMessageSizeMin << ", " << s_nMessageSizeMax
+                << "], average=" << m_fItemSize / s_nWriterThreadCount ) ;
+            run< MessageWriterThread<RING>, MessageReaderThread<RING> >( testRing, s_nMessageCount ) ;
+        }
+
+        template <class QUEUE>
+        void test_malloc_message()
+        {
+            if ( s_nReaderThreadCount != 1 ) {
+                CPPUNIT_MSG( "    skipped: one reader is supported" ) ;
+                return  ;
+            }
+            QUEUE testQueue( s_nQueueCapacity ) ;
+            m_fItemSize = makeMessageSizes() * s_nWriterThreadCount ;
+            CPPUNIT_MSG( "    message size=[" << s_nMessageSizeMin << ", " << s_nMessageSizeMax << "], average=" << m_fItemSize / s_nWriterThreadCount ) ;
+            run< MallocMessageWriterThread<QUEUE>, MallocMessageReaderThread<QUEUE> >( testQueue, s_nMessageCount ) ;
+        }
+
+        void MallocMessage_VyukovMPMCBounded()
+        {
+            test_malloc_message< Types<size_t *>::VyukovMPMCBounded >() ;
+        }
+
+        template <class WRITER, class READER, class QUEUE>
+        void run( QUEUE& testQueue, size_t nItemCount = s_nQueueSize )
         {
             double times[s_nRepetitionCount];
 
-            m_nThreadPushCount = s_nQueueSize;
+            m_nThreadPushCount = nItemCount;
 
             CPPUNIT_MSG( "Queue MEMBENCH test,\n    reader count=" << s_nReaderThreadCount << " writer count=" << s_nWriterThreadCount << " element count=" << m_nThreadPushCount << "..." )   ;
 
-            QUEUE testQueue ;
             CppUnitMini::ThreadPool pool( *this )   ;
 
             // Writers must be first
-            pool.add( new WriterThread<QUEUE>( pool, testQueue ), s_nWriterThreadCount );
-            pool.add( new ReaderThread<QUEUE>( pool, testQueue ), s_nReaderThreadCount );
+            pool.add( new WRITER( pool, testQueue ), s_nWriterThreadCount );
+            pool.add( new READER( pool, testQueue ), s_nReaderThreadCount );
 
             for (long i = 0; i < s_nRepetitionCount; i++) {
               cds::OS::Timer m;
@@ -142,7 +527,7 @@ namespace queue {
               times[i] = end-start;
             }
 
-            double mbs = (s_nQueueSize*1e-06)*8*2;
+            double mbs = (m_nThreadPushCount*1e-06)*m_fItemSize*2;
             double avgtime = 0;
             double mintime = std::numeric_limits<double>::max();
             double maxtime = 0;
@@ -166,6 +551,16 @@ namespace queue {
             s_nWriterThreadCount = cfg.getULong("WriterCount", 1 ) ;
             s_nQueueSize = cfg.getULong("QueueSize", 64000000 );
             s_nRepetitionCount = cfg.getULong("RepetitionCount", 2 );
+            s_nQueueCapacity = cfg.getULong("QueueCapacity", 65536 );
+            s_nBulkSize = cfg.getULong("BulkSize", 16 );
+            s_nRingCapacity = cfg.getULong("RingCapacity", 1024 * 1024 );
+            s_nMessageSizeMin = cfg.getULong("MessageSizeMin", 16 );
+            s_nMessageSizeMax = cfg.getULong("MessageSizeMax", 4096 );
+            s_nMessageCount = cfg.getULong("MessageCount", 1000000 );
+            if ( s_nMessageSizeMin == 0 )
+                s_nMessageSizeMin = 1   ;
+            if ( s_nMessageSizeMax < s_nMessageSizeMin )
+                s_nMessageSizeMax = s_nMessageSizeMin   ;
         }
 
     protected:
@@ -174,35 +569,65 @@ namespace queue {
         TEST_CASE( MoirQueue_HP, Value )
         TEST_CASE( MoirQueue_HRC, Value )
         TEST_CASE( MoirQueue_PTB, Value )
+        TEST_CASE( MoirQueue_Epoch, Value )
+        TEST_CASE( MoirQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged, Value )
 #endif
         TEST_CASE( MSQueue_HP, Value  )
         TEST_CASE( MSQueue_HRC, Value )
         TEST_CASE( MSQueue_PTB, Value )
+        TEST_CASE( MSQueue_Epoch, Value )
+        TEST_CASE( MSQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged, Value )
 #endif
         TEST_CASE( LMSQueue_HP, Value  )
         TEST_CASE( LMSQueue_PTB, Value )
+        TEST_CASE( LMSQueue_Epoch, Value )
 
         TEST_CASE( MoirQueue_HP_Counted, Value )
         TEST_CASE( MoirQueue_HRC_Counted, Value )
         TEST_CASE( MoirQueue_PTB_Counted, Value )
+        TEST_CASE( MoirQueue_Epoch_Counted, Value )
+        TEST_CASE( MoirQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( MSQueue_HP_Counted, Value )
         TEST_CASE( MSQueue_HRC_Counted, Value )
         TEST_CASE( MSQueue_PTB_Counted, Value )
+        TEST_CASE( MSQueue_Epoch_Counted, Value )
+        TEST_CASE( MSQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( LMSQueue_HP_Counted, Value )
         TEST_CASE( LMSQueue_PTB_Counted, Value)
+        TEST_CASE( LMSQueue_Epoch_Counted, Value)
+
+        TEST_CASE( MoirQueue_HP_NodeCache, Value )
+        TEST_CASE( MoirQueue_PTB_NodeCache, Value )
+        TEST_CASE( MoirQueue_Epoch_NodeCache, Value )
+        TEST_CASE( MoirQueue_IBR_NodeCache, Value )
+        TEST_CASE( MSQueue_HP_NodeCache, Value )
+        TEST_CASE( MSQueue_PTB_NodeCache, Value )
+        TEST_CASE( MSQueue_Epoch_NodeCache, Value )
+        TEST_CASE( MSQueue_IBR_NodeCache, Value )
+        TEST_CASE( LMSQueue_HP_NodeCache, Value )
+        TEST_CASE( LMSQueue_PTB_NodeCache, Value )
+        TEST_CASE( LMSQueue_Epoch_NodeCache, Value )
 
         TEST_CASE( TZCyclicQueue, Value )
         TEST_CASE( TZCyclicQueue_Counted, Value )
+        TEST_BOUNDED( TZCyclicValueQueue, Value )
+        TEST_BOUNDED( TZCyclicValueQueue_Counted, Value )
+
+        TEST_BOUNDED( VyukovMPMCBounded, Value )
+        TEST_BULK( VyukovMPMCBounded, Value )
+
+        TEST_MESSAGE( spsc_byte_ring )
+        TEST_MESSAGE( mpsc_byte_ring )
 
         TEST_CASE( RWQueue_Spinlock, Value )
         TEST_CASE( RWQueue_Spinlock_Counted, Value )
@@ -219,6 +644,11 @@ namespace queue {
 #endif
         TEST_CASE( HASQueue_Spinlock, Value )
 
+        TEST_CASE( DualQueue_HP, Value )
+        void DualQueue_HP_Take() { test_take< Types<Value>::DualQueue_HP >(); }
+
+        void AdaptiveQueue() { test_adaptive< Types<Value>::AdaptiveQueue >(); }
+
         CPPUNIT_TEST_SUITE(Queue_Membench_MT)
             CPPUNIT_TEST(CSQueue)              ;
             CPPUNIT_TEST(MoirQueue_HP)              ;
@@ -227,6 +657,10 @@ namespace queue {
             CPPUNIT_TEST(MoirQueue_HRC_Counted)      ;
             CPPUNIT_TEST(MoirQueue_PTB)              ;
             CPPUNIT_TEST(MoirQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(MoirQueue_Epoch)            ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Counted)    ;
+            CPPUNIT_TEST(MoirQueue_IBR)              ;
+            CPPUNIT_TEST(MoirQueue_IBR_Counted)      ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MoirQueue_Tagged)          ;
             CPPUNIT_TEST(MoirQueue_Tagged_Counted)  ;
@@ -238,6 +672,10 @@ namespace queue {
             CPPUNIT_TEST(MSQueue_HRC_Counted)       ;
             CPPUNIT_TEST(MSQueue_PTB)               ;
             CPPUNIT_TEST(MSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_Epoch_Counted)     ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+            CPPUNIT_TEST(MSQueue_IBR_Counted)       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MSQueue_Tagged)            ;
             CPPUNIT_TEST(MSQueue_Tagged_Counted)    ;
@@ -246,9 +684,32 @@ namespace queue {
             CPPUNIT_TEST(LMSQueue_HP_Counted)       ;
             CPPUNIT_TEST(LMSQueue_PTB)              ;
             CPPUNIT_TEST(LMSQueue_PTB_Counted)      ;
-
-            //CPPUNIT_TEST(TZCyclicQueue)             ;
-            //CPPUNIT_TEST(TZCyclicQueue_Counted)     ;
+            CPPUNIT_TEST(LMSQueue_Epoch)            ;
+            CPPUNIT_TEST(LMSQueue_Epoch_Counted)    ;
+
+            CPPUNIT_TEST(MoirQueue_HP_NodeCache)    ;
+            CPPUNIT_TEST(MoirQueue_PTB_NodeCache)   ;
+            CPPUNIT_TEST(MoirQueue_Epoch_NodeCache) ;
+            CPPUNIT_TEST(MoirQueue_IBR_NodeCache)   ;
+            CPPUNIT_TEST(MSQueue_HP_NodeCache)      ;
+            CPPUNIT_TEST(MSQueue_PTB_NodeCache)     ;
+            CPPUNIT_TEST(MSQueue_Epoch_NodeCache)   ;
+            CPPUNIT_TEST(MSQueue_IBR_NodeCache)     ;
+            CPPUNIT_TEST(LMSQueue_HP_NodeCache)     ;
+            CPPUNIT_TEST(LMSQueue_PTB_NodeCache)    ;
+            CPPUNIT_TEST(LMSQueue_Epoch_NodeCache)  ;
+
+            CPPUNIT_TEST(TZCyclicQueue)             ;
+            CPPUNIT_TEST(TZCyclicQueue_Counted)     ;
+            CPPUNIT_TEST(TZCyclicValueQueue)        ;
+            CPPUNIT_TEST(TZCyclicValueQueue_Counted);
+
+            CPPUNIT_TEST(VyukovMPMCBounded)         ;
+            CPPUNIT_TEST(VyukovMPMCBounded_Bulk)    ;
+
+            CPPUNIT_TEST(spsc_byte_ring)            ;
+            CPPUNIT_TEST(mpsc_byte_ring)            ;
+            CPPUNIT_TEST(MallocMessage_VyukovMPMCBounded)   ;
 
             CPPUNIT_TEST(RWQueue_Spinlock)          ;
             CPPUNIT_TEST(RWQueue_Spinlock_Counted)  ;
@@ -264,6 +725,11 @@ namespace queue {
             //CPPUNIT_TEST(StdQueue_list_WinMutex)  ;
 #endif
             CPPUNIT_TEST( HASQueue_Spinlock )       ;
+
+            CPPUNIT_TEST( DualQueue_HP )            ;
+            CPPUNIT_TEST( DualQueue_HP_Take )       ;
+
+            CPPUNIT_TEST( AdaptiveQueue )           ;
         CPPUNIT_TEST_SUITE_END();
     };
 
@@ -18,12 +18,14 @@
 namespace queue {
 
 #define TEST_CASE( Q, V ) void Q() { test< Types<V>::Q >(); }
+#define TEST_BOUNDED( Q, V ) void Q() { test_bounded< Types<V>::Q >(); }
 
     namespace {
         static size_t s_nReaderThreadCount = 1  ;
         static size_t s_nWriterThreadCount = 1  ;
         static size_t s_nQueueSize = 64000000   ;
         static size_t s_nRepetitionCount = 2  ;
+        static size_t s_nQueueCapacity = 65536  ;   // for bounded queues
 
         typedef void* Value;
     }
@@ -121,13 +123,26 @@ namespace queue {
         template <class QUEUE>
         void test()
         {
+            QUEUE testQueue ;
+            run( testQueue ) ;
+        }
+
+        template <class QUEUE>
+        void test_bounded()
+        {
+            QUEUE testQueue( s_nQueueCapacity ) ;
+            run( testQueue ) ;
+        }
+
+        template <class QUEUE>
+        void run( QUEUE& testQueue )
+        {
             double times[s_nRepetitionCount];
 
             m_nThreadPushCount = s_nQueueSize;
 
             CPPUNIT_MSG( "Queue MEMBENCH test,\n    reader count=" << s_nReaderThreadCount << " writer count=" << s_nWriterThreadCount << " element count=" << m_nThreadPushCount << "..." )   ;
 
-            QUEUE testQueue ;
             CppUnitMini::ThreadPool pool( *this )   ;
 
             // Writers must be first
@@ -166,6 +181,7 @@ namespace queue {
             s_nWriterThreadCount = cfg.getULong("WriterCount", 1 ) ;
             s_nQueueSize = cfg.getULong("QueueSize", 64000000 );
             s_nRepetitionCount = cfg.getULong("RepetitionCount", 2 );
+            s_nQueueCapacity = cfg.getULong("QueueCapacity", 65536 );
         }
 
     protected:
@@ -174,35 +190,49 @@ namespace queue {
         TEST_CASE( MoirQueue_HP, Value )
         TEST_CASE( MoirQueue_HRC, Value )
         TEST_CASE( MoirQueue_PTB, Value )
+        TEST_CASE( MoirQueue_Epoch, Value )
+        TEST_CASE( MoirQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged, Value )
 #endif
         TEST_CASE( MSQueue_HP, Value  )
         TEST_CASE( MSQueue_HRC, Value )
         TEST_CASE( MSQueue_PTB, Value )
+        TEST_CASE( MSQueue_Epoch, Value )
+        TEST_CASE( MSQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged, Value )
 #endif
         TEST_CASE( LMSQueue_HP, Value  )
         TEST_CASE( LMSQueue_PTB, Value )
+        TEST_CASE( LMSQueue_Epoch, Value )
 
         TEST_CASE( MoirQueue_HP_Counted, Value )
         TEST_CASE( MoirQueue_HRC_Counted, Value )
         TEST_CASE( MoirQueue_PTB_Counted, Value )
+        TEST_CASE( MoirQueue_Epoch_Counted, Value )
+        TEST_CASE( MoirQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( MSQueue_HP_Counted, Value )
         TEST_CASE( MSQueue_HRC_Counted, Value )
         TEST_CASE( MSQueue_PTB_Counted, Value )
+        TEST_CASE( MSQueue_Epoch_Counted, Value )
+        TEST_CASE( MSQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( LMSQueue_HP_Counted, Value )
         TEST_CASE( LMSQueue_PTB_Counted, Value)
+        TEST_CASE( LMSQueue_Epoch_Counted, Value)
 
         TEST_CASE( TZCyclicQueue, Value )
         TEST_CASE( TZCyclicQueue_Counted, Value )
+        TEST_BOUNDED( TZCyclicValueQueue, Value )
+        TEST_BOUNDED( TZCyclicValueQueue_Counted, Value )
+
+        TEST_BOUNDED( VyukovMPMCBounded, Value )
 
         TEST_CASE( RWQueue_Spinlock, Value )
         TEST_CASE( RWQueue_Spinlock_Counted, Value )
@@ -228,6 +258,10 @@ namespace queue {
             CPPUNIT_TEST(MoirQueue_HRC_Counted)      ;
             CPPUNIT_TEST(MoirQueue_PTB)              ;
             CPPUNIT_TEST(MoirQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(MoirQueue_Epoch)            ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Counted)    ;
+            CPPUNIT_TEST(MoirQueue_IBR)              ;
+            CPPUNIT_TEST(MoirQueue_IBR_Counted)      ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MoirQueue_Tagged)          ;
             CPPUNIT_TEST(MoirQueue_Tagged_Counted)  ;
@@ -239,6 +273,10 @@ namespace queue {
             CPPUNIT_TEST(MSQueue_HRC_Counted)       ;
             CPPUNIT_TEST(MSQueue_PTB)               ;
             CPPUNIT_TEST(MSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_Epoch_Counted)     ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+            CPPUNIT_TEST(MSQueue_IBR_Counted)       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MSQueue_Tagged)            ;
             CPPUNIT_TEST(MSQueue_Tagged_Counted)    ;
@@ -247,9 +285,16 @@ namespace queue {
             CPPUNIT_TEST(LMSQueue_HP_Counted)       ;
             CPPUNIT_TEST(LMSQueue_PTB)              ;
             CPPUNIT_TEST(LMSQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(LMSQueue_Epoch)            ;
+            CPPUNIT_TEST(LMSQueue_Epoch_Counted)    ;
 
+            // TZCyclicQueue<void *> uses LSB of the pointer as a flag, the test pushes odd values
             //CPPUNIT_TEST(TZCyclicQueue)             ;
             //CPPUNIT_TEST(TZCyclicQueue_Counted)     ;
+            CPPUNIT_TEST(TZCyclicValueQueue)        ;
+            CPPUNIT_TEST(TZCyclicValueQueue_Counted);
+
+            CPPUNIT_TEST(VyukovMPMCBounded)         ;
 
             CPPUNIT_TEST(RWQueue_Spinlock)          ;
             CPPUNIT_TEST(RWQueue_Spinlock_Counted)  ;
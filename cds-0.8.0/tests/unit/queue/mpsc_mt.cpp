@@ -0,0 +1,246 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include "cppunit/thread.h"
+#include "queue/queue_type.h"
+#include <vector>
+
+// Multi-threaded queue test: many producers, single consumer
+namespace queue {
+
+#define TEST_CASE( Q, V ) void Q() { test< Types<V>::Q >(); }
+
+    namespace ns_Queue_MPSC_MT {
+        static size_t s_nProducerCount = 32 ;
+        static size_t s_nQueueSize = 10000000   ;
+
+        struct Value {
+            size_t      nNo         ;
+            size_t      nWriterNo   ;
+        };
+    }
+    using namespace ns_Queue_MPSC_MT ;
+
+    class Queue_MPSC_MT: public CppUnitMini::TestCase
+    {
+        template <class QUEUE>
+        class ProducerThread: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new ProducerThread( *this )  ;
+            }
+        public:
+            QUEUE&              m_Queue ;
+            double              m_fTime ;
+            size_t              m_nPushFailed   ;
+
+        public:
+            ProducerThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            ProducerThread( ProducerThread& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            Queue_MPSC_MT&  getTest()
+            {
+                return reinterpret_cast<Queue_MPSC_MT&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+
+            virtual void test()
+            {
+                size_t nPushCount = getTest().m_nThreadPushCount  ;
+                Value v             ;
+                v.nWriterNo = m_nThreadNo   ;
+                v.nNo = 0           ;
+                m_nPushFailed = 0   ;
+
+                m_fTime = m_Timer.duration()        ;
+
+                while ( v.nNo < nPushCount ) {
+                    if ( m_Queue.push( v ))
+                        ++v.nNo             ;
+                    else
+                        ++m_nPushFailed     ;
+                }
+
+                m_fTime = m_Timer.duration() - m_fTime  ;
+            }
+        };
+
+        template <class QUEUE>
+        class ConsumerThread: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new ConsumerThread( *this )  ;
+            }
+        public:
+            QUEUE&              m_Queue ;
+            double              m_fTime ;
+            size_t              m_nPopEmpty     ;
+            size_t              m_nPopped       ;
+            size_t              m_nBadWriter    ;
+            size_t              m_nBadOrder     ;
+
+        public:
+            ConsumerThread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            ConsumerThread( ConsumerThread& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            Queue_MPSC_MT&  getTest()
+            {
+                return reinterpret_cast<Queue_MPSC_MT&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+
+            virtual void test()
+            {
+                m_nPopEmpty = 0     ;
+                m_nPopped = 0       ;
+                m_nBadWriter = 0    ;
+                m_nBadOrder = 0     ;
+
+                const size_t nProducerCount = getTest().m_nProducerCount    ;
+                const size_t nTotal = getTest().m_nThreadPushCount * nProducerCount  ;
+
+                // Next expected item number for each producer
+                std::vector<size_t> arrNext( nProducerCount, 0 ) ;
+                Value v ;
+
+                m_fTime = m_Timer.duration()        ;
+
+                cds::backoff::yield bkoff   ;
+                while ( m_nPopped < nTotal ) {
+                    if ( !m_Queue.pop( v )) {
+                        ++m_nPopEmpty   ;
+                        bkoff()         ;
+                        continue        ;
+                    }
+                    ++m_nPopped ;
+                    if ( v.nWriterNo < nProducerCount ) {
+                        if ( arrNext[ v.nWriterNo ] != v.nNo )
+                            ++m_nBadOrder   ;
+                        arrNext[ v.nWriterNo ] = v.nNo + 1  ;
+                    }
+                    else
+                        ++m_nBadWriter  ;
+                }
+
+                m_fTime = m_Timer.duration() - m_fTime ;
+            }
+        };
+
+    protected:
+        size_t                  m_nThreadPushCount  ;
+        size_t                  m_nProducerCount    ;
+
+    protected:
+        template <class QUEUE>
+        void analyze( CppUnitMini::ThreadPool& pool, QUEUE& testQueue )
+        {
+            typedef ConsumerThread<QUEUE>   Consumer    ;
+            typedef ProducerThread<QUEUE>   Producer    ;
+
+            double fTimeProducer = 0    ;
+            double fTimeConsumer = 0    ;
+            size_t nPopEmpty = 0        ;
+
+            for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it ) {
+                Consumer * pConsumer = dynamic_cast<Consumer *>( *it ) ;
+                if ( pConsumer ) {
+                    fTimeConsumer = pConsumer->m_fTime  ;
+                    nPopEmpty = pConsumer->m_nPopEmpty  ;
+                    CPPUNIT_ASSERT_MSG( pConsumer->m_nBadWriter == 0, "consumer bad writer event count=" << pConsumer->m_nBadWriter ) ;
+                    CPPUNIT_ASSERT_MSG( pConsumer->m_nBadOrder == 0, "consumer out of order item count=" << pConsumer->m_nBadOrder ) ;
+                }
+                else {
+                    Producer * pProducer = dynamic_cast<Producer *>( *it ) ;
+                    CPPUNIT_ASSERT( pProducer != NULL )   ;
+                    fTimeProducer += pProducer->m_fTime   ;
+                    CPPUNIT_ASSERT_MSG( pProducer->m_nPushFailed == 0,
+                        "producer " << pProducer->m_nThreadNo << " push failed count=" << pProducer->m_nPushFailed ) ;
+                }
+            }
+            CPPUNIT_MSG( "     Duration: consumer=" << fTimeConsumer
+                << ", producer=" << (fTimeProducer / m_nProducerCount)
+                << ", pop empty=" << nPopEmpty
+            )   ;
+            CPPUNIT_ASSERT( testQueue.empty() )             ;
+        }
+
+        template <class QUEUE>
+        void test()
+        {
+            for ( m_nProducerCount = 1; m_nProducerCount <= s_nProducerCount; m_nProducerCount *= 2 ) {
+                m_nThreadPushCount = s_nQueueSize / m_nProducerCount    ;
+
+                CPPUNIT_MSG( "   MPSC test, producer count=" << m_nProducerCount << " ..." )   ;
+
+                QUEUE testQueue ;
+                CppUnitMini::ThreadPool pool( *this )   ;
+
+                // Producers must be first
+                pool.add( new ProducerThread<QUEUE>( pool, testQueue ), m_nProducerCount )  ;
+                pool.add( new ConsumerThread<QUEUE>( pool, testQueue ), 1 )                 ;
+
+                pool.run()  ;
+
+                analyze( pool, testQueue )     ;
+            }
+        }
+
+        void setUpParams( const CppUnitMini::TestCfg& cfg ) {
+            s_nProducerCount = cfg.getULong("ProducerCount", 32 ) ;
+            s_nQueueSize = cfg.getULong("QueueSize", 10000000 );
+        }
+
+    protected:
+        TEST_CASE( VyukovMPSC, Value )
+        TEST_CASE( VyukovMPSC_NodeCache, Value )
+        TEST_CASE( MSQueue_HP, Value )
+        TEST_CASE( MSQueue_HP_NodeCache, Value )
+
+        CPPUNIT_TEST_SUITE(Queue_MPSC_MT)
+            CPPUNIT_TEST(VyukovMPSC)            ;
+            CPPUNIT_TEST(VyukovMPSC_NodeCache)  ;
+            CPPUNIT_TEST(MSQueue_HP)            ;
+            CPPUNIT_TEST(MSQueue_HP_NodeCache)  ;
+        CPPUNIT_TEST_SUITE_END();
+    };
+
+} // namespace queue
+
+CPPUNIT_TEST_SUITE_REGISTRATION(queue::Queue_MPSC_MT);
@@ -0,0 +1,241 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include "cppunit/thread.h"
+#include "queue/queue_type.h"
+
+// Multi-threaded queue test: latency histogram of pop operation
+// with inline GC reclamation and with the background reclaimer thread
+namespace queue {
+
+#define TEST_CASE( Q, V )    void Q() { test< Types<V>::Q >(); }
+
+    namespace ns_Queue_PopLatency_MT {
+        static size_t s_nThreadCount = 4  ;
+        static size_t s_nQueueSize = 2000000 ;
+
+        // Histogram bucket k contains the latencies in [2**k, 2**(k+1)) nanoseconds
+        static const size_t c_nBucketCount = 32 ;
+
+        struct SimpleValue {
+            size_t    nNo ;
+
+            SimpleValue() {}
+            SimpleValue( size_t n ): nNo(n) {}
+            size_t getNo() const { return  nNo; }
+        };
+
+        struct histogram {
+            size_t      arr[c_nBucketCount] ;
+            long long   nMax    ;
+
+            histogram()
+            {
+                memset( arr, 0, sizeof(arr) )   ;
+                nMax = 0    ;
+            }
+
+            void add( long long nNanosec )
+            {
+                size_t k = 0    ;
+                while ( k < c_nBucketCount - 1 && (nNanosec >> (k + 1)) != 0 )
+                    ++k ;
+                ++arr[k]    ;
+                if ( nNanosec > nMax )
+                    nMax = nNanosec ;
+            }
+
+            void add( const histogram& h )
+            {
+                for ( size_t k = 0; k < c_nBucketCount; ++k )
+                    arr[k] += h.arr[k]  ;
+                if ( h.nMax > nMax )
+                    nMax = h.nMax   ;
+            }
+
+            size_t count() const
+            {
+                size_t n = 0    ;
+                for ( size_t k = 0; k < c_nBucketCount; ++k )
+                    n += arr[k] ;
+                return n    ;
+            }
+
+            // Upper bound (ns) of the bucket that contains the percentile fPercent
+            long long percentile( double fPercent ) const
+            {
+                size_t nLimit = size_t( double( count() ) * fPercent / 100 )    ;
+                size_t n = 0    ;
+                for ( size_t k = 0; k < c_nBucketCount; ++k ) {
+                    n += arr[k] ;
+                    if ( n > nLimit )
+                        return 2LL << k ;
+                }
+                return nMax ;
+            }
+        };
+    }
+    using namespace ns_Queue_PopLatency_MT ;
+
+    class Queue_PopLatency_MT: public CppUnitMini::TestCase
+    {
+        template <class QUEUE>
+        class Thread: public CppUnitMini::TestThread
+        {
+            virtual TestThread *    clone()
+            {
+                return new Thread( *this )  ;
+            }
+        public:
+            QUEUE&              m_Queue ;
+            histogram           m_Hist  ;
+            size_t              m_nPopCount ;
+            size_t              m_nPopSum   ;
+
+        public:
+            Thread( CppUnitMini::ThreadPool& pool, QUEUE& q )
+                : CppUnitMini::TestThread( pool )
+                , m_Queue( q )
+            {}
+            Thread( Thread& src )
+                : CppUnitMini::TestThread( src )
+                , m_Queue( src.m_Queue )
+            {}
+
+            Queue_PopLatency_MT&  getTest()
+            {
+                return reinterpret_cast<Queue_PopLatency_MT&>( m_Pool.m_Test )   ;
+            }
+
+            virtual void init()
+            {
+                cds::threading::Manager::attachThread()     ;
+            }
+            virtual void fini()
+            {
+                cds::threading::Manager::detachThread()   ;
+            }
+
+            virtual void test()
+            {
+                typedef typename QUEUE::value_type value_type ;
+                value_type value = value_type() ;
+                size_t nPopCount = 0    ;
+                size_t nPopSum = 0  ;
+
+                cds::OS::Timer::native_timer_type tmStart   ;
+                cds::OS::Timer::native_timer_type tmEnd     ;
+                while ( true ) {
+                    cds::OS::Timer::current( tmStart )  ;
+                    bool bPopped = m_Queue.pop( value ) ;
+                    cds::OS::Timer::current( tmEnd )    ;
+                    if ( !bPopped )
+                        break   ;
+                    m_Hist.add( (long long)( m_Timer.duration( cds::OS::Timer::native_duration( tmStart, tmEnd )) * 1.0E9 ))   ;
+                    nPopSum += value.getNo()    ;
+                    ++nPopCount ;
+                }
+                m_nPopCount = nPopCount ;
+                m_nPopSum = nPopSum ;
+            }
+        };
+
+    protected:
+        template <class QUEUE>
+        void analyze( CppUnitMini::ThreadPool& pool, QUEUE& testQueue  )
+        {
+            histogram hist  ;
+            size_t nTotalPops = 0   ;
+            size_t nPopSum = 0  ;
+            for ( CppUnitMini::ThreadPool::iterator it = pool.begin(); it != pool.end(); ++it ) {
+                Thread<QUEUE> * pThread = reinterpret_cast<Thread<QUEUE> *>(*it)  ;
+                hist.add( pThread->m_Hist ) ;
+                nTotalPops += pThread->m_nPopCount  ;
+                nPopSum += pThread->m_nPopSum   ;
+            }
+
+            CPPUNIT_MSG( "     Latency, ns: p50<" << hist.percentile( 50 )
+                << " p99<" << hist.percentile( 99 )
+                << " p99.9<" << hist.percentile( 99.9 )
+                << " p99.99<" << hist.percentile( 99.99 )
+                << " max=" << hist.nMax )   ;
+            for ( size_t k = 0; k < c_nBucketCount; ++k ) {
+                if ( hist.arr[k] )
+                    CPPUNIT_MSG( "       [" << (1LL << k) << ", " << (2LL << k) << "): " << hist.arr[k] ) ;
+            }
+
+            CPPUNIT_ASSERT( nTotalPops == s_nQueueSize )    ;
+            CPPUNIT_ASSERT( nPopSum == s_nQueueSize * (s_nQueueSize - 1) / 2 )  ;
+            CPPUNIT_ASSERT( testQueue.empty() )
+        }
+
+        // Starts/stops the background reclaimer of all GCs. Returns previous state of HP GC reclaimer
+        static bool enableReclaimer( bool bEnable )
+        {
+            bool bEnabled = cds::gc::hzp::GarbageCollector::instance().enableReclaimer( bEnable ) ;
+            cds::gc::hrc::GarbageCollector::instance().enableReclaimer( bEnable )   ;
+            cds::gc::ptb::GarbageCollector::instance().enableReclaimer( bEnable )   ;
+            return bEnabled ;
+        }
+
+        template <class QUEUE>
+        void run( bool bReclaimer )
+        {
+            QUEUE testQueue ;
+            CppUnitMini::ThreadPool pool( *this )   ;
+            pool.add( new Thread<QUEUE>( pool, testQueue ), s_nThreadCount )       ;
+
+            for ( size_t i = 0; i < s_nQueueSize; ++i )
+                testQueue.push( i )    ;
+
+            CPPUNIT_MSG( "   Pop test, thread count=" << s_nThreadCount
+                << ", queue size=" << s_nQueueSize
+                << ", GC reclaimer=" << (bReclaimer ? "on" : "off") << " ...")   ;
+            pool.run()  ;
+
+            analyze( pool, testQueue )     ;
+        }
+
+        template <class QUEUE>
+        void test()
+        {
+            bool bEnabled = enableReclaimer( false )    ;
+            run<QUEUE>( false ) ;
+            enableReclaimer( true ) ;
+            run<QUEUE>( true )  ;
+            enableReclaimer( bEnabled ) ;
+        }
+
+        void setUpParams( const CppUnitMini::TestCfg& cfg ) {
+            s_nThreadCount = cfg.getULong("ThreadCount", 4 ) ;
+            s_nQueueSize = cfg.getULong("QueueSize", 2000000 );
+        }
+
+    protected:
+        TEST_CASE( MoirQueue_HP, SimpleValue )
+        TEST_CASE( MoirQueue_HRC, SimpleValue )
+        TEST_CASE( MoirQueue_PTB, SimpleValue )
+        TEST_CASE( MSQueue_HP, SimpleValue  )
+        TEST_CASE( MSQueue_HRC, SimpleValue )
+        TEST_CASE( MSQueue_PTB, SimpleValue )
+
+        CPPUNIT_TEST_SUITE(Queue_PopLatency_MT)
+            CPPUNIT_TEST(MoirQueue_HP)              ;
+            CPPUNIT_TEST(MoirQueue_HRC)             ;
+            CPPUNIT_TEST(MoirQueue_PTB)             ;
+            CPPUNIT_TEST(MSQueue_HP)                ;
+            CPPUNIT_TEST(MSQueue_HRC)               ;
+            CPPUNIT_TEST(MSQueue_PTB)               ;
+        CPPUNIT_TEST_SUITE_END();
+    };
+
+} // namespace queue
+
+CPPUNIT_TEST_SUITE_REGISTRATION(queue::Queue_PopLatency_MT);
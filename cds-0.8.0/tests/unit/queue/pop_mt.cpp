@@ -175,32 +175,42 @@ namespace queue {
         TEST_CASE( MoirQueue_HP, SimpleValue )
         TEST_CASE( MoirQueue_HRC, SimpleValue )
         TEST_CASE( MoirQueue_PTB, SimpleValue )
+        TEST_CASE( MoirQueue_Epoch, SimpleValue )
+        TEST_CASE( MoirQueue_IBR, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged, SimpleValue )
 #endif
         TEST_CASE( MSQueue_HP, SimpleValue  )
         TEST_CASE( MSQueue_HRC, SimpleValue )
         TEST_CASE( MSQueue_PTB, SimpleValue )
+        TEST_CASE( MSQueue_Epoch, SimpleValue )
+        TEST_CASE( MSQueue_IBR, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged, SimpleValue )
 #endif
         TEST_CASE( LMSQueue_HP, SimpleValue  )
         TEST_CASE( LMSQueue_PTB, SimpleValue )
+        TEST_CASE( LMSQueue_Epoch, SimpleValue )
 
         TEST_CASE( MoirQueue_HP_Counted, SimpleValue )
         TEST_CASE( MoirQueue_HRC_Counted, SimpleValue )
         TEST_CASE( MoirQueue_PTB_Counted, SimpleValue )
+        TEST_CASE( MoirQueue_Epoch_Counted, SimpleValue )
+        TEST_CASE( MoirQueue_IBR_Counted, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged_Counted, SimpleValue )
 #endif
         TEST_CASE( MSQueue_HP_Counted, SimpleValue )
         TEST_CASE( MSQueue_HRC_Counted, SimpleValue )
         TEST_CASE( MSQueue_PTB_Counted, SimpleValue )
+        TEST_CASE( MSQueue_Epoch_Counted, SimpleValue )
+        TEST_CASE( MSQueue_IBR_Counted, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged_Counted, SimpleValue )
 #endif
         TEST_CASE( LMSQueue_HP_Counted, SimpleValue )
         TEST_CASE( LMSQueue_PTB_Counted, SimpleValue)
+        TEST_CASE( LMSQueue_Epoch_Counted, SimpleValue)
 
         TEST_CASE( RWQueue_Spinlock, SimpleValue )
         TEST_CASE( RWQueue_Spinlock_Counted, SimpleValue )
@@ -218,6 +228,14 @@ namespace queue {
 #endif
         TEST_CASE( HASQueue_Spinlock, SimpleValue )
 
+        TEST_CASE( ShardedQueue_MSQueue_HP, SimpleValue )
+        TEST_CASE( ShardedQueue_MSQueue_HP_NodeCache, SimpleValue )
+        TEST_CASE( ShardedQueue_MoirQueue_HP, SimpleValue )
+        TEST_CASE( ShardedQueue_RWQueue_Spinlock, SimpleValue )
+
+        TEST_CASE( DualQueue_HP, SimpleValue )
+        TEST_CASE( DualQueue_HP_Counted, SimpleValue )
+
         CPPUNIT_TEST_SUITE(Queue_Pop_MT)
             CPPUNIT_TEST(MoirQueue_HP)              ;
             CPPUNIT_TEST(MoirQueue_HP_Counted)      ;
@@ -225,6 +243,10 @@ namespace queue {
             CPPUNIT_TEST(MoirQueue_HRC_Counted)     ;
             CPPUNIT_TEST(MoirQueue_PTB)             ;
             CPPUNIT_TEST(MoirQueue_PTB_Counted)     ;
+            CPPUNIT_TEST(MoirQueue_Epoch)           ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Counted)   ;
+            CPPUNIT_TEST(MoirQueue_IBR)             ;
+            CPPUNIT_TEST(MoirQueue_IBR_Counted)     ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MoirQueue_Tagged)          ;
             CPPUNIT_TEST(MoirQueue_Tagged_Counted)  ;
@@ -236,6 +258,10 @@ namespace queue {
             CPPUNIT_TEST(MSQueue_HRC_Counted)       ;
             CPPUNIT_TEST(MSQueue_PTB)               ;
             CPPUNIT_TEST(MSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_Epoch_Counted)     ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+            CPPUNIT_TEST(MSQueue_IBR_Counted)       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MSQueue_Tagged)            ;
             CPPUNIT_TEST(MSQueue_Tagged_Counted)    ;
@@ -244,6 +270,8 @@ namespace queue {
             CPPUNIT_TEST(LMSQueue_HP_Counted)        ;
             CPPUNIT_TEST(LMSQueue_PTB)               ;
             CPPUNIT_TEST(LMSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(LMSQueue_Epoch)             ;
+            CPPUNIT_TEST(LMSQueue_Epoch_Counted)     ;
 
             CPPUNIT_TEST(RWQueue_Spinlock)          ;
             CPPUNIT_TEST(RWQueue_Spinlock_Counted)  ;
@@ -260,6 +288,14 @@ namespace queue {
             CPPUNIT_TEST(StdQueue_list_WinCS)  ;
 #endif
             CPPUNIT_TEST( HASQueue_Spinlock )       ;
+
+            CPPUNIT_TEST( ShardedQueue_MSQueue_HP )             ;
+            CPPUNIT_TEST( ShardedQueue_MSQueue_HP_NodeCache )   ;
+            CPPUNIT_TEST( ShardedQueue_MoirQueue_HP )           ;
+            CPPUNIT_TEST( ShardedQueue_RWQueue_Spinlock )       ;
+
+            CPPUNIT_TEST( DualQueue_HP )            ;
+            CPPUNIT_TEST( DualQueue_HP_Counted )    ;
         CPPUNIT_TEST_SUITE_END();
     };
 
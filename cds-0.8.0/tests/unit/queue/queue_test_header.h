@@ -12,13 +12,18 @@
 #define __UNIT_QUEUE_SIMPLE_H
 
 #include "cppunit/cppunit_proxy.h"
-#include <cds/queue/details/queue_base.h>
+#include <cds/queue/node_cache.h>
 
 namespace queue {
     struct QueueCountedTraits: public cds::queue::traits {
         typedef cds::atomics::item_counter<>  item_counter_type    ;
     };
 
+    struct QueueNodeCacheTraits: public QueueCountedTraits {
+        typedef cds::queue::thread_node_cache<>   node_cache_type ;
+        typedef cds::queue::queue_statistics      statistics      ;
+    };
+
     //
     // Test queue operation in single thread mode
     //
@@ -99,66 +104,321 @@ namespace queue {
             }
         }
 
+        template <class QUEUE_COUNTED>
+        void testBatch()
+        {
+            QUEUE_COUNTED   q       ;
+            int     arr[10]         ;
+            int     dest[16]        ;
+            int     it              ;
+
+            for ( int i = 0; i < 10; ++i )
+                arr[i] = i + 1  ;
+
+            for ( size_t nPass = 0; nPass < 3; ++nPass ) {
+                CPPUNIT_ASSERT( q.empty() )         ;
+                CPPUNIT_ASSERT( q.enqueue_batch( arr, arr ) == 0 )  ;
+                CPPUNIT_ASSERT( q.empty() )         ;
+                CPPUNIT_ASSERT( q.dequeue_batch( dest, 16 ) == 0 )  ;
+
+                CPPUNIT_ASSERT( q.enqueue_batch( arr, arr + 10 ) == 10 )  ;
+                CPPUNIT_ASSERT( q.size() == 10 )    ;
+                CPPUNIT_ASSERT( q.push( 100 ) )     ;
+                CPPUNIT_ASSERT( q.size() == 11 )    ;
+
+                CPPUNIT_ASSERT( q.dequeue_batch( dest, 0 ) == 0 )  ;
+                CPPUNIT_ASSERT( q.dequeue_batch( dest, 4 ) == 4 )  ;
+                for ( int i = 0; i < 4; ++i )
+                    CPPUNIT_ASSERT( dest[i] == i + 1 )  ;
+                CPPUNIT_ASSERT( q.size() == 7 )     ;
+
+                CPPUNIT_ASSERT( q.pop( it ) )       ;
+                CPPUNIT_ASSERT( it == 5 )           ;
+
+                CPPUNIT_ASSERT( q.dequeue_batch( dest, 16 ) == 6 )  ;
+                for ( int i = 0; i < 5; ++i )
+                    CPPUNIT_ASSERT( dest[i] == i + 6 )  ;
+                CPPUNIT_ASSERT( dest[5] == 100 )    ;
+
+                CPPUNIT_ASSERT( q.empty() )         ;
+                CPPUNIT_ASSERT( q.size() == 0 )     ;
+                CPPUNIT_ASSERT( !q.dequeue( it ) )  ;
+                CPPUNIT_ASSERT( q.dequeue_batch( dest, 16 ) == 0 )  ;
+            }
+        }
+
+        template <class QUEUE_CACHED>
+        void testNodeCache()
+        {
+            const int c_nPassCount = 10000  ;
+            QUEUE_CACHED    q   ;
+            int             it  ;
+
+            for ( int i = 0; i < c_nPassCount; ++i ) {
+                CPPUNIT_ASSERT( q.push( i ) )   ;
+                CPPUNIT_ASSERT( q.pop( it ) )   ;
+                CPPUNIT_ASSERT( it == i )       ;
+            }
+            CPPUNIT_ASSERT( q.empty() )         ;
+            CPPUNIT_ASSERT( q.size() == 0 )     ;
+
+            // The dequeued nodes are reclaimed by GC's scan into the node cache of current thread
+            CPPUNIT_ASSERT( q.getStatistics().m_NodeCacheHit.get() + q.getStatistics().m_NodeCacheMiss.get() == (size_t) c_nPassCount ) ;
+            CPPUNIT_ASSERT( q.getStatistics().m_NodeCacheHit.get() > 0 ) ;
+        }
+
+        template <class QUEUE_TAGGED>
+        void testFreeList()
+        {
+            const int c_nItemCount = 1000  ;
+            QUEUE_TAGGED    q   ;
+            int             it  ;
+
+            for ( int nPass = 0; nPass < 2; ++nPass ) {
+                for ( int i = 0; i < c_nItemCount; ++i )
+                    CPPUNIT_ASSERT( q.push( i ) )   ;
+                for ( int i = 0; i < c_nItemCount; ++i ) {
+                    CPPUNIT_ASSERT( q.pop( it ) )   ;
+                    CPPUNIT_ASSERT( it == i )       ;
+                }
+            }
+            CPPUNIT_ASSERT( q.empty() )         ;
+
+            typename QUEUE_TAGGED::type_traits::free_list_type::statistics s = q.getFreeList().getStatistics()  ;
+            // The nodes are moved between the processor cache and the global stack by batches
+            CPPUNIT_ASSERT( s.m_nCacheFree > 0 )    ;
+            CPPUNIT_ASSERT( s.m_nGlobalPush > 0 )   ;
+            CPPUNIT_ASSERT( s.m_nGlobalPushNodes > s.m_nGlobalPush )  ;
+            CPPUNIT_ASSERT( s.m_nGlobalPop + s.m_nGlobalPush < (size_t) c_nItemCount / 4 )  ;
+            // The second pass reuses the nodes of the first one
+            CPPUNIT_ASSERT( s.m_nHeapAlloc < (size_t) c_nItemCount * 2 )  ;
+        }
+
+        template <class BOUNDED_QUEUE>
+        void testBulk()
+        {
+            BOUNDED_QUEUE   q( 16 ) ;
+            int     arr[20]         ;
+            int     dest[20]        ;
+            int     it              ;
+
+            CPPUNIT_ASSERT( q.capacity() == 16 ) ;
+            for ( int i = 0; i < 20; ++i )
+                arr[i] = i + 1  ;
+
+            // several passes to wrap positions around the buffer
+            for ( size_t nPass = 0; nPass < 5; ++nPass ) {
+                CPPUNIT_ASSERT( q.enqueue_bulk( arr, arr ) == 0 )  ;
+                CPPUNIT_ASSERT( q.dequeue_bulk( dest, 16 ) == 0 )  ;
+
+                CPPUNIT_ASSERT( q.enqueue_bulk( arr, arr + 10 ) == 10 )  ;
+                CPPUNIT_ASSERT( q.push( 100 ) )     ;
+
+                CPPUNIT_ASSERT( q.dequeue_bulk( dest, 0 ) == 0 )  ;
+                CPPUNIT_ASSERT( q.dequeue_bulk( dest, 4 ) == 4 )  ;
+                for ( int i = 0; i < 4; ++i )
+                    CPPUNIT_ASSERT( dest[i] == i + 1 )  ;
+
+                CPPUNIT_ASSERT( q.pop( it ) )       ;
+                CPPUNIT_ASSERT( it == 5 )           ;
+
+                CPPUNIT_ASSERT( q.dequeue_bulk( dest, 20 ) == 6 )  ;
+                for ( int i = 0; i < 5; ++i )
+                    CPPUNIT_ASSERT( dest[i] == i + 6 )  ;
+                CPPUNIT_ASSERT( dest[5] == 100 )    ;
+                CPPUNIT_ASSERT( !q.pop( it ) )      ;
+
+                // overflow: only the head of the range is enqueued
+                CPPUNIT_ASSERT( q.push( 0 ) )       ;
+                CPPUNIT_ASSERT( q.enqueue_bulk( arr, arr + 20 ) == 15 )  ;
+                CPPUNIT_ASSERT( q.enqueue_bulk( arr, arr + 20 ) == 0 )  ;
+                CPPUNIT_ASSERT( !q.push( 100 ) )    ;
+
+                CPPUNIT_ASSERT( q.pop( it ) )       ;
+                CPPUNIT_ASSERT( it == 0 )           ;
+                CPPUNIT_ASSERT( q.dequeue_bulk( dest, 20 ) == 15 )  ;
+                for ( int i = 0; i < 15; ++i )
+                    CPPUNIT_ASSERT( dest[i] == i + 1 )  ;
+                CPPUNIT_ASSERT( q.dequeue_bulk( dest, 20 ) == 0 )  ;
+            }
+        }
+
     public:
         void MSQueue_HP()   ;
         void MSQueue_HP_Counted()   ;
+        void MSQueue_HP_Batch()   ;
+        void MSQueue_HP_NodeCache() ;
         void MSQueue_HRC()  ;
         void MSQueue_HRC_Counted()  ;
+        void MSQueue_HRC_Batch()  ;
         void MSQueue_PTB()  ;
         void MSQueue_PTB_Counted()  ;
+        void MSQueue_PTB_Batch()  ;
+        void MSQueue_PTB_NodeCache() ;
+        void MSQueue_Epoch()  ;
+        void MSQueue_IBR()  ;
+        void MSQueue_Epoch_Counted()  ;
+        void MSQueue_IBR_Counted()  ;
+        void MSQueue_Epoch_Batch()  ;
+        void MSQueue_IBR_Batch()  ;
+        void MSQueue_Epoch_NodeCache() ;
+        void MSQueue_IBR_NodeCache() ;
         void MSQueue_tagged()  ;
         void MSQueue_tagged_Counted()  ;
+        void MSQueue_tagged_Batch()  ;
+        void MSQueue_tagged_FreeList()  ;
 
         void MoirQueue_HP()   ;
         void MoirQueue_HP_Counted()   ;
+        void MoirQueue_HP_Batch()   ;
+        void MoirQueue_HP_NodeCache() ;
         void MoirQueue_HRC()  ;
         void MoirQueue_HRC_Counted()  ;
+        void MoirQueue_HRC_Batch()  ;
         void MoirQueue_PTB()  ;
         void MoirQueue_PTB_Counted()  ;
+        void MoirQueue_PTB_Batch()  ;
+        void MoirQueue_Epoch()  ;
+        void MoirQueue_IBR()  ;
+        void MoirQueue_Epoch_Counted()  ;
+        void MoirQueue_IBR_Counted()  ;
+        void MoirQueue_Epoch_Batch()  ;
+        void MoirQueue_IBR_Batch()  ;
         void MoirQueue_tagged()  ;
         void MoirQueue_tagged_Counted()  ;
+        void MoirQueue_tagged_Batch()  ;
+        void MoirQueue_tagged_FreeList()  ;
 
         void LMSQueue_HP()      ;
         void LMSQueue_HP_Counted()      ;
+        void LMSQueue_HP_NodeCache()    ;
         void LMSQueue_PTB()     ;
         void LMSQueue_PTB_Counted()     ;
+        void LMSQueue_Epoch()     ;
+        void LMSQueue_Epoch_Counted()     ;
 
         void TZCyclicQueue_()   ;
         void TZCyclicQueue_Counted()   ;
+        void TZCyclicValueQueue_()   ;
+        void TZCyclicValueQueue_Counted()   ;
 
         void RWQueue_()   ;
         void RWQueue_Counted()   ;
 
+        void VyukovMPMCBounded_static()     ;
+        void VyukovMPMCBounded_dynamic()    ;
+
+        void VyukovMPSC_()              ;
+        void VyukovMPSC_Counted()       ;
+        void VyukovMPSC_NodeCache()     ;
+        void VyukovMPSC_Intrusive()     ;
+
+        void ShardedQueue_MSQueue_HP()          ;
+        void ShardedQueue_MSQueue_HP_Counted()  ;
+        void ShardedQueue_RWQueue_Steal()       ;
+
+        void ByteRing_SPSC()    ;
+        void ByteRing_MPSC()    ;
+
+        void ShmChannel_SPSC()  ;
+        void ShmChannel_MPSC()  ;
+
+        void DualQueue_HP()             ;
+        void DualQueue_HP_Counted()     ;
+        void DualQueue_HP_Transfer()    ;
+
+        void AdaptiveQueue_()           ;
+        void AdaptiveQueue_Counted()    ;
+        void AdaptiveQueue_Switch()     ;
+
         CPPUNIT_TEST_SUITE(Queue_TestHeader)
             //CPPUNIT_TEST(MSQueue_HP)                ;
             CPPUNIT_TEST(MSQueue_HP)                ;
             CPPUNIT_TEST(MSQueue_HP_Counted)        ;
+            CPPUNIT_TEST(MSQueue_HP_Batch)          ;
+            CPPUNIT_TEST(MSQueue_HP_NodeCache)      ;
             CPPUNIT_TEST(MSQueue_HRC)               ;
             CPPUNIT_TEST(MSQueue_HRC_Counted)       ;
+            CPPUNIT_TEST(MSQueue_HRC_Batch)         ;
             CPPUNIT_TEST(MSQueue_PTB)               ;
             CPPUNIT_TEST(MSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(MSQueue_PTB_Batch)         ;
+            CPPUNIT_TEST(MSQueue_PTB_NodeCache)     ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+            CPPUNIT_TEST(MSQueue_Epoch_Counted)     ;
+            CPPUNIT_TEST(MSQueue_IBR_Counted)       ;
+            CPPUNIT_TEST(MSQueue_Epoch_Batch)       ;
+            CPPUNIT_TEST(MSQueue_IBR_Batch)         ;
+            CPPUNIT_TEST(MSQueue_Epoch_NodeCache)   ;
+            CPPUNIT_TEST(MSQueue_IBR_NodeCache)     ;
             CPPUNIT_TEST(MSQueue_tagged)            ;
             CPPUNIT_TEST(MSQueue_tagged_Counted)    ;
+            CPPUNIT_TEST(MSQueue_tagged_Batch)      ;
+            CPPUNIT_TEST(MSQueue_tagged_FreeList)   ;
 
             CPPUNIT_TEST(MoirQueue_HP)              ;
             CPPUNIT_TEST(MoirQueue_HP_Counted)      ;
+            CPPUNIT_TEST(MoirQueue_HP_Batch)        ;
+            CPPUNIT_TEST(MoirQueue_HP_NodeCache)    ;
             CPPUNIT_TEST(MoirQueue_HRC)             ;
             CPPUNIT_TEST(MoirQueue_HRC_Counted)     ;
+            CPPUNIT_TEST(MoirQueue_HRC_Batch)       ;
             CPPUNIT_TEST(MoirQueue_PTB)             ;
             CPPUNIT_TEST(MoirQueue_PTB_Counted)     ;
+            CPPUNIT_TEST(MoirQueue_PTB_Batch)       ;
+            CPPUNIT_TEST(MoirQueue_Epoch)           ;
+            CPPUNIT_TEST(MoirQueue_IBR)             ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Counted)   ;
+            CPPUNIT_TEST(MoirQueue_IBR_Counted)     ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Batch)     ;
+            CPPUNIT_TEST(MoirQueue_IBR_Batch)       ;
             CPPUNIT_TEST(MoirQueue_tagged)          ;
             CPPUNIT_TEST(MoirQueue_tagged_Counted)  ;
+            CPPUNIT_TEST(MoirQueue_tagged_Batch)    ;
+            CPPUNIT_TEST(MoirQueue_tagged_FreeList) ;
 
             CPPUNIT_TEST(LMSQueue_HP)               ;
             CPPUNIT_TEST(LMSQueue_HP_Counted)       ;
+            CPPUNIT_TEST(LMSQueue_HP_NodeCache)     ;
             CPPUNIT_TEST(LMSQueue_PTB)              ;
             CPPUNIT_TEST(LMSQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(LMSQueue_Epoch)            ;
+            CPPUNIT_TEST(LMSQueue_Epoch_Counted)    ;
 
             CPPUNIT_TEST(TZCyclicQueue_)            ;
             CPPUNIT_TEST(TZCyclicQueue_Counted)     ;
+            CPPUNIT_TEST(TZCyclicValueQueue_)       ;
+            CPPUNIT_TEST(TZCyclicValueQueue_Counted);
 
             CPPUNIT_TEST(RWQueue_)                  ;
             CPPUNIT_TEST(RWQueue_Counted)           ;
+
+            CPPUNIT_TEST(VyukovMPMCBounded_static)  ;
+            CPPUNIT_TEST(VyukovMPMCBounded_dynamic) ;
+
+            CPPUNIT_TEST(VyukovMPSC_)               ;
+            CPPUNIT_TEST(VyukovMPSC_Counted)        ;
+            CPPUNIT_TEST(VyukovMPSC_NodeCache)      ;
+            CPPUNIT_TEST(VyukovMPSC_Intrusive)      ;
+
+            CPPUNIT_TEST(ShardedQueue_MSQueue_HP)           ;
+            CPPUNIT_TEST(ShardedQueue_MSQueue_HP_Counted)   ;
+            CPPUNIT_TEST(ShardedQueue_RWQueue_Steal)        ;
+
+            CPPUNIT_TEST(ByteRing_SPSC)     ;
+            CPPUNIT_TEST(ByteRing_MPSC)     ;
+
+            CPPUNIT_TEST(ShmChannel_SPSC)   ;
+            CPPUNIT_TEST(ShmChannel_MPSC)   ;
+
+            CPPUNIT_TEST(DualQueue_HP)              ;
+            CPPUNIT_TEST(DualQueue_HP_Counted)      ;
+            CPPUNIT_TEST(DualQueue_HP_Transfer)     ;
+
+            CPPUNIT_TEST(AdaptiveQueue_)            ;
+            CPPUNIT_TEST(AdaptiveQueue_Counted)     ;
+            CPPUNIT_TEST(AdaptiveQueue_Switch)      ;
         CPPUNIT_TEST_SUITE_END();
 
     };
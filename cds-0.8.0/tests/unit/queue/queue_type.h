@@ -17,6 +17,8 @@
 #include <cds/queue/moir_queue_hzp.h>
 #include <cds/queue/moir_queue_hrc.h>
 #include <cds/queue/moir_queue_ptb.h>
+#include <cds/queue/moir_queue_epoch.h>
+#include <cds/queue/moir_queue_ibr.h>
 #ifdef CDS_DWORD_CAS_SUPPORTED
 #   include <cds/queue/moir_queue_tagged.h>
 #endif
@@ -24,15 +26,26 @@
 #include <cds/queue/msqueue_hzp.h>
 #include <cds/queue/msqueue_hrc.h>
 #include <cds/queue/msqueue_ptb.h>
+#include <cds/queue/msqueue_epoch.h>
+#include <cds/queue/msqueue_ibr.h>
 #ifdef CDS_DWORD_CAS_SUPPORTED
 #   include <cds/queue/msqueue_tagged.h>
 #endif
 
 #include <cds/queue/lmsqueue_hzp.h>
 #include <cds/queue/lmsqueue_ptb.h>
+#include <cds/queue/lmsqueue_epoch.h>
+
+#include <cds/queue/node_cache.h>
 
 #include <cds/queue/rwqueue.h>
 #include <cds/queue/tz_cyclic_queue.h>
+#include <cds/queue/tz_cyclic_value_queue.h>
+#include <cds/queue/vyukov_mpmc_bounded.h>
+#include <cds/queue/vyukov_mpsc.h>
+#include <cds/queue/sharded_queue.h>
+#include <cds/queue/dual_queue.h>
+#include <cds/queue/adaptive_queue.h>
 
 #include "queue/std_queue.h"
 #include "lock/win32_lock.h"
@@ -160,6 +173,10 @@ namespace queue {
         typedef cds::atomics::item_counter<cds::membar_release, cds::membar_acquire>        item_counter_type    ;
     };
 
+    struct NodeCacheTraits: public cds::queue::traits {
+        typedef cds::queue::thread_node_cache<>     node_cache_type ;
+    };
+
     template <typename VALUE>
     struct Types {
       typedef cds::queue::CircularFifo<VALUE, 64000>             CSQueue        ;
@@ -167,37 +184,80 @@ namespace queue {
         typedef cds::queue::MoirQueue<cds::gc::hzp_gc, VALUE>           MoirQueue_HP        ;
         typedef cds::queue::MoirQueue<cds::gc::hrc_gc, VALUE>           MoirQueue_HRC       ;
         typedef cds::queue::MoirQueue<cds::gc::ptb_gc, VALUE>           MoirQueue_PTB       ;
+        typedef cds::queue::MoirQueue<cds::gc::epoch_gc, VALUE>         MoirQueue_Epoch     ;
+        typedef cds::queue::MoirQueue<cds::gc::ibr_gc, VALUE>           MoirQueue_IBR       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         typedef cds::queue::MoirQueue<cds::gc::tagged_gc, VALUE>        MoirQueue_Tagged    ;
 #endif
         typedef cds::queue::MSQueue<cds::gc::hrc_gc, VALUE>             MSQueue_HRC         ;
         typedef cds::queue::MSQueue<cds::gc::hzp_gc, VALUE>             MSQueue_HP          ;
         typedef cds::queue::MSQueue<cds::gc::ptb_gc, VALUE>             MSQueue_PTB         ;
+        typedef cds::queue::MSQueue<cds::gc::epoch_gc, VALUE>           MSQueue_Epoch       ;
+        typedef cds::queue::MSQueue<cds::gc::ibr_gc, VALUE>             MSQueue_IBR         ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         typedef cds::queue::MSQueue<cds::gc::tagged_gc, VALUE>          MSQueue_Tagged      ;
 #endif
         typedef cds::queue::LMSQueue<cds::gc::hzp_gc, VALUE>            LMSQueue_HP         ;
         typedef cds::queue::LMSQueue<cds::gc::ptb_gc, VALUE>            LMSQueue_PTB        ;
+        typedef cds::queue::LMSQueue<cds::gc::epoch_gc, VALUE>          LMSQueue_Epoch      ;
 
         typedef cds::queue::TZCyclicQueue< VALUE >                        TZCyclicQueue        ;
 
         typedef cds::queue::MoirQueue<cds::gc::hzp_gc, VALUE, CountedTraits>           MoirQueue_HP_Counted        ;
         typedef cds::queue::MoirQueue<cds::gc::hrc_gc, VALUE, CountedTraits>           MoirQueue_HRC_Counted       ;
         typedef cds::queue::MoirQueue<cds::gc::hrc_gc, VALUE, CountedTraits>           MoirQueue_PTB_Counted       ;
+        typedef cds::queue::MoirQueue<cds::gc::epoch_gc, VALUE, CountedTraits>         MoirQueue_Epoch_Counted     ;
+        typedef cds::queue::MoirQueue<cds::gc::ibr_gc, VALUE, CountedTraits>           MoirQueue_IBR_Counted       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         typedef cds::queue::MoirQueue<cds::gc::tagged_gc, VALUE, CountedTraits>        MoirQueue_Tagged_Counted    ;
 #endif
         typedef cds::queue::MSQueue<cds::gc::hrc_gc, VALUE, CountedTraits>             MSQueue_HRC_Counted         ;
         typedef cds::queue::MSQueue<cds::gc::hzp_gc, VALUE, CountedTraits>             MSQueue_HP_Counted          ;
         typedef cds::queue::MSQueue<cds::gc::ptb_gc, VALUE, CountedTraits>             MSQueue_PTB_Counted         ;
+        typedef cds::queue::MSQueue<cds::gc::epoch_gc, VALUE, CountedTraits>           MSQueue_Epoch_Counted       ;
+        typedef cds::queue::MSQueue<cds::gc::ibr_gc, VALUE, CountedTraits>             MSQueue_IBR_Counted         ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         typedef cds::queue::MSQueue<cds::gc::tagged_gc, VALUE, CountedTraits>          MSQueue_Tagged_Counted      ;
 #endif
 
         typedef cds::queue::LMSQueue<cds::gc::hzp_gc, VALUE, CountedTraits>            LMSQueue_HP_Counted          ;
         typedef cds::queue::LMSQueue<cds::gc::ptb_gc, VALUE, CountedTraits>            LMSQueue_PTB_Counted         ;
+        typedef cds::queue::LMSQueue<cds::gc::epoch_gc, VALUE, CountedTraits>          LMSQueue_Epoch_Counted       ;
+
+        typedef cds::queue::MoirQueue<cds::gc::hzp_gc, VALUE, NodeCacheTraits>         MoirQueue_HP_NodeCache       ;
+        typedef cds::queue::MoirQueue<cds::gc::ptb_gc, VALUE, NodeCacheTraits>         MoirQueue_PTB_NodeCache      ;
+        typedef cds::queue::MoirQueue<cds::gc::epoch_gc, VALUE, NodeCacheTraits>       MoirQueue_Epoch_NodeCache    ;
+        typedef cds::queue::MoirQueue<cds::gc::ibr_gc, VALUE, NodeCacheTraits>         MoirQueue_IBR_NodeCache      ;
+        typedef cds::queue::MSQueue<cds::gc::hzp_gc, VALUE, NodeCacheTraits>           MSQueue_HP_NodeCache         ;
+        typedef cds::queue::MSQueue<cds::gc::ptb_gc, VALUE, NodeCacheTraits>           MSQueue_PTB_NodeCache        ;
+        typedef cds::queue::MSQueue<cds::gc::epoch_gc, VALUE, NodeCacheTraits>         MSQueue_Epoch_NodeCache      ;
+        typedef cds::queue::MSQueue<cds::gc::ibr_gc, VALUE, NodeCacheTraits>           MSQueue_IBR_NodeCache        ;
+        typedef cds::queue::LMSQueue<cds::gc::hzp_gc, VALUE, NodeCacheTraits>          LMSQueue_HP_NodeCache        ;
+        typedef cds::queue::LMSQueue<cds::gc::ptb_gc, VALUE, NodeCacheTraits>          LMSQueue_PTB_NodeCache       ;
+        typedef cds::queue::LMSQueue<cds::gc::epoch_gc, VALUE, NodeCacheTraits>        LMSQueue_Epoch_NodeCache     ;
 
         typedef cds::queue::TZCyclicQueue< VALUE, CountedTraits >                       TZCyclicQueue_Counted       ;
+        typedef cds::queue::TZCyclicValueQueue< VALUE >                                 TZCyclicValueQueue          ;
+        typedef cds::queue::TZCyclicValueQueue< VALUE, CountedTraits >                  TZCyclicValueQueue_Counted  ;
+
+        typedef cds::queue::vyukov_mpmc_bounded< VALUE,
+            cds::opt::buffer< cds::opt::v::dynamic_buffer< VALUE > >
+        >                                                                               VyukovMPMCBounded           ;
+
+        typedef cds::queue::vyukov_mpsc< VALUE >                                        VyukovMPSC                  ;
+        typedef cds::queue::vyukov_mpsc< VALUE, CountedTraits >                         VyukovMPSC_Counted          ;
+        typedef cds::queue::vyukov_mpsc< VALUE, NodeCacheTraits >                       VyukovMPSC_NodeCache        ;
+
+        typedef cds::queue::sharded_queue< MSQueue_HP >                                 ShardedQueue_MSQueue_HP     ;
+        typedef cds::queue::sharded_queue< MoirQueue_HP >                               ShardedQueue_MoirQueue_HP   ;
+        typedef cds::queue::sharded_queue< MSQueue_HP_NodeCache >                       ShardedQueue_MSQueue_HP_NodeCache   ;
+        typedef cds::queue::sharded_queue< cds::queue::RWQueue<VALUE, cds::lock::Spin> >    ShardedQueue_RWQueue_Spinlock   ;
+
+        typedef cds::queue::dual_queue< VALUE >                                         DualQueue_HP                ;
+        typedef cds::queue::dual_queue< VALUE, CountedTraits >                          DualQueue_HP_Counted        ;
+
+        typedef cds::queue::adaptive_queue< VALUE >                                     AdaptiveQueue               ;
+        typedef cds::queue::adaptive_queue< VALUE, CountedTraits >                      AdaptiveQueue_Counted       ;
 
         typedef cds::queue::RWQueue<VALUE, cds::lock::Spin>                             RWQueue_Spinlock           ;
         typedef cds::queue::RWQueue<VALUE, cds::lock::Spin, CountedTraits>              RWQueue_Spinlock_Counted   ;
@@ -204,8 +204,38 @@ namespace queue {
 
             for ( size_t i = 0; i < s_nThreadCount; ++i )
                 CPPUNIT_ASSERT( arrPushCount[i] == m_nThreadPushCount ) ;
+
+            printFreeListStat( testQueue )  ;
+        }
+
+        template <class QUEUE>
+        void printFreeListStat( QUEUE const& )
+        {}
+
+#ifdef CDS_DWORD_CAS_SUPPORTED
+        template <class FREE_LIST>
+        void printFreeListStat( FREE_LIST const& fl, bool )
+        {
+            typename FREE_LIST::statistics s = fl.getStatistics()  ;
+            CPPUNIT_MSG( "     Free-list: cache alloc=" << s.m_nCacheAlloc << " free=" << s.m_nCacheFree << " busy=" << s.m_nCacheBusy
+                << "; global pop=" << s.m_nGlobalPop << " (nodes=" << s.m_nGlobalPopNodes << ")"
+                << " push=" << s.m_nGlobalPush << " (nodes=" << s.m_nGlobalPushNodes << ")"
+                << "; heap alloc=" << s.m_nHeapAlloc ) ;
         }
 
+        template <typename T, class TRAITS, class ALLOCATOR>
+        void printFreeListStat( cds::queue::MSQueue< cds::gc::tagged_gc, T, TRAITS, ALLOCATOR > const& q )
+        {
+            printFreeListStat( q.getFreeList(), true )  ;
+        }
+
+        template <typename T, class TRAITS, class ALLOCATOR>
+        void printFreeListStat( cds::queue::MoirQueue< cds::gc::tagged_gc, T, TRAITS, ALLOCATOR > const& q )
+        {
+            printFreeListStat( q.getFreeList(), true )  ;
+        }
+#endif
+
         template <class QUEUE>
         void test()
         {
@@ -231,32 +261,42 @@ namespace queue {
         TEST_CASE( MoirQueue_HP, SimpleValue )
         TEST_CASE( MoirQueue_HRC, SimpleValue )
         TEST_CASE( MoirQueue_PTB, SimpleValue )
+        TEST_CASE( MoirQueue_Epoch, SimpleValue )
+        TEST_CASE( MoirQueue_IBR, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged, SimpleValue )
 #endif
         TEST_CASE( MSQueue_HP, SimpleValue  )
         TEST_CASE( MSQueue_HRC, SimpleValue )
         TEST_CASE( MSQueue_PTB, SimpleValue )
+        TEST_CASE( MSQueue_Epoch, SimpleValue )
+        TEST_CASE( MSQueue_IBR, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged, SimpleValue )
 #endif
         TEST_CASE( LMSQueue_HP, SimpleValue  )
         TEST_CASE( LMSQueue_PTB, SimpleValue )
+        TEST_CASE( LMSQueue_Epoch, SimpleValue )
 
         TEST_CASE( MoirQueue_HP_Counted, SimpleValue )
         TEST_CASE( MoirQueue_HRC_Counted, SimpleValue )
         TEST_CASE( MoirQueue_PTB_Counted, SimpleValue )
+        TEST_CASE( MoirQueue_Epoch_Counted, SimpleValue )
+        TEST_CASE( MoirQueue_IBR_Counted, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged_Counted, SimpleValue )
 #endif
         TEST_CASE( MSQueue_HP_Counted, SimpleValue )
         TEST_CASE( MSQueue_HRC_Counted, SimpleValue )
         TEST_CASE( MSQueue_PTB_Counted, SimpleValue )
+        TEST_CASE( MSQueue_Epoch_Counted, SimpleValue )
+        TEST_CASE( MSQueue_IBR_Counted, SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged_Counted, SimpleValue )
 #endif
         TEST_CASE( LMSQueue_HP_Counted, SimpleValue )
         TEST_CASE( LMSQueue_PTB_Counted, SimpleValue)
+        TEST_CASE( LMSQueue_Epoch_Counted, SimpleValue)
 
         TEST_CASE( RWQueue_Spinlock, SimpleValue )
         TEST_CASE( RWQueue_Spinlock_Counted, SimpleValue )
@@ -281,6 +321,10 @@ namespace queue {
             CPPUNIT_TEST(MoirQueue_HRC_Counted)     ;
             CPPUNIT_TEST(MoirQueue_PTB)             ;
             CPPUNIT_TEST(MoirQueue_PTB_Counted)     ;
+            CPPUNIT_TEST(MoirQueue_Epoch)           ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Counted)   ;
+            CPPUNIT_TEST(MoirQueue_IBR)             ;
+            CPPUNIT_TEST(MoirQueue_IBR_Counted)     ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MoirQueue_Tagged)          ;
             CPPUNIT_TEST(MoirQueue_Tagged_Counted)  ;
@@ -292,6 +336,10 @@ namespace queue {
             CPPUNIT_TEST(MSQueue_HRC_Counted)       ;
             CPPUNIT_TEST(MSQueue_PTB)               ;
             CPPUNIT_TEST(MSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_Epoch_Counted)     ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+            CPPUNIT_TEST(MSQueue_IBR_Counted)       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MSQueue_Tagged)            ;
             CPPUNIT_TEST(MSQueue_Tagged_Counted)    ;
@@ -300,6 +348,8 @@ namespace queue {
             CPPUNIT_TEST(LMSQueue_HP_Counted)       ;
             CPPUNIT_TEST(LMSQueue_PTB)              ;
             CPPUNIT_TEST(LMSQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(LMSQueue_Epoch)            ;
+            CPPUNIT_TEST(LMSQueue_Epoch_Counted)    ;
 
             //CPPUNIT_TEST( HASQueue_Spinlock )       ;
 
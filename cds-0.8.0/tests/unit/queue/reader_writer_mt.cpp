@@ -291,32 +291,42 @@ namespace queue {
         TEST_CASE( MoirQueue_HP, Value )
         TEST_CASE( MoirQueue_HRC, Value )
         TEST_CASE( MoirQueue_PTB, Value )
+        TEST_CASE( MoirQueue_Epoch, Value )
+        TEST_CASE( MoirQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged, Value )
 #endif
         TEST_CASE( MSQueue_HP, Value  )
         TEST_CASE( MSQueue_HRC, Value )
         TEST_CASE( MSQueue_PTB, Value )
+        TEST_CASE( MSQueue_Epoch, Value )
+        TEST_CASE( MSQueue_IBR, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged, Value )
 #endif
         TEST_CASE( LMSQueue_HP, Value  )
         TEST_CASE( LMSQueue_PTB, Value )
+        TEST_CASE( LMSQueue_Epoch, Value )
 
         TEST_CASE( MoirQueue_HP_Counted, Value )
         TEST_CASE( MoirQueue_HRC_Counted, Value )
         TEST_CASE( MoirQueue_PTB_Counted, Value )
+        TEST_CASE( MoirQueue_Epoch_Counted, Value )
+        TEST_CASE( MoirQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MoirQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( MSQueue_HP_Counted, Value )
         TEST_CASE( MSQueue_HRC_Counted, Value )
         TEST_CASE( MSQueue_PTB_Counted, Value )
+        TEST_CASE( MSQueue_Epoch_Counted, Value )
+        TEST_CASE( MSQueue_IBR_Counted, Value )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( MSQueue_Tagged_Counted, Value )
 #endif
         TEST_CASE( LMSQueue_HP_Counted, Value )
         TEST_CASE( LMSQueue_PTB_Counted, Value)
+        TEST_CASE( LMSQueue_Epoch_Counted, Value)
 
         TEST_CASE( TZCyclicQueue, Value )
         TEST_CASE( TZCyclicQueue_Counted, Value )
@@ -343,6 +353,10 @@ namespace queue {
             CPPUNIT_TEST(MoirQueue_HRC_Counted)      ;
             CPPUNIT_TEST(MoirQueue_PTB)              ;
             CPPUNIT_TEST(MoirQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(MoirQueue_Epoch)            ;
+            CPPUNIT_TEST(MoirQueue_Epoch_Counted)    ;
+            CPPUNIT_TEST(MoirQueue_IBR)              ;
+            CPPUNIT_TEST(MoirQueue_IBR_Counted)      ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MoirQueue_Tagged)          ;
             CPPUNIT_TEST(MoirQueue_Tagged_Counted)  ;
@@ -354,6 +368,10 @@ namespace queue {
             CPPUNIT_TEST(MSQueue_HRC_Counted)       ;
             CPPUNIT_TEST(MSQueue_PTB)               ;
             CPPUNIT_TEST(MSQueue_PTB_Counted)       ;
+            CPPUNIT_TEST(MSQueue_Epoch)             ;
+            CPPUNIT_TEST(MSQueue_Epoch_Counted)     ;
+            CPPUNIT_TEST(MSQueue_IBR)               ;
+            CPPUNIT_TEST(MSQueue_IBR_Counted)       ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(MSQueue_Tagged)            ;
             CPPUNIT_TEST(MSQueue_Tagged_Counted)    ;
@@ -362,6 +380,8 @@ namespace queue {
             CPPUNIT_TEST(LMSQueue_HP_Counted)       ;
             CPPUNIT_TEST(LMSQueue_PTB)              ;
             CPPUNIT_TEST(LMSQueue_PTB_Counted)      ;
+            CPPUNIT_TEST(LMSQueue_Epoch)            ;
+            CPPUNIT_TEST(LMSQueue_Epoch_Counted)    ;
 
             //CPPUNIT_TEST(TZCyclicQueue)             ;
             //CPPUNIT_TEST(TZCyclicQueue_Counted)     ;
@@ -0,0 +1,20 @@
+/*
+    This file is a part of libcds - Concurrent Data Structures library
+    See http://libcds.sourceforge.net/
+
+    (C) Copyright Maxim Khiszinsky [khizmax at gmail dot com] 2006-2011
+
+    Version 0.8.0
+*/
+
+
+#include <cds/stack/stack_epoch.h>
+
+#include "stack/stack_test_header.h"
+
+namespace stack {
+    void StackTestHeader::Stack_epoch()
+    {
+        test< cds::stack::Stack< cds::gc::epoch_gc, int > >() ;
+    }
+}
@@ -167,6 +167,9 @@ namespace stack {
         TEST_CASE( Stack_HP,            SimpleValue )
         TEST_CASE( Stack_HP_yield,      SimpleValue )
         TEST_CASE( Stack_HP_pause,      SimpleValue )
+        TEST_CASE( Stack_Epoch,         SimpleValue )
+        TEST_CASE( Stack_Epoch_yield,   SimpleValue )
+        TEST_CASE( Stack_Epoch_pause,   SimpleValue )
 #ifdef CDS_DWORD_CAS_SUPPORTED
         TEST_CASE( Stack_Tagged,        SimpleValue )
         TEST_CASE( Stack_Tagged_yield,  SimpleValue )
@@ -177,6 +180,9 @@ namespace stack {
             CPPUNIT_TEST(Stack_HP)              ;
             CPPUNIT_TEST(Stack_HP_yield)        ;
             CPPUNIT_TEST(Stack_HP_pause)        ;
+            CPPUNIT_TEST(Stack_Epoch)           ;
+            CPPUNIT_TEST(Stack_Epoch_yield)     ;
+            CPPUNIT_TEST(Stack_Epoch_pause)     ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
             CPPUNIT_TEST(Stack_Tagged)          ;
             CPPUNIT_TEST(Stack_Tagged_yield)    ;
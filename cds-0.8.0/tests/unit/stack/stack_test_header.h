@@ -57,12 +57,14 @@ namespace stack {
     protected:
         void Stack_tagged() ;
         void Stack_hp()    ;
+        void Stack_epoch() ;
 
     CPPUNIT_TEST_SUITE(StackTestHeader);
 #ifdef CDS_DWORD_CAS_SUPPORTED
         CPPUNIT_TEST(Stack_tagged)                   ;
 #endif
         CPPUNIT_TEST(Stack_hp)                   ;
+        CPPUNIT_TEST(Stack_epoch)                ;
     CPPUNIT_TEST_SUITE_END();
 
     } ;
@@ -13,11 +13,13 @@
 
 #include <cds/stack/stack_tagged.h>
 #include <cds/stack/stack_hzp.h>
+#include <cds/stack/stack_epoch.h>
 
 namespace stack {
     template <typename T>
     struct Types {
         typedef cds::stack::Stack< cds::gc::hzp_gc, T >         Stack_HP        ;
+        typedef cds::stack::Stack< cds::gc::epoch_gc, T >       Stack_Epoch     ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         typedef cds::stack::Stack< cds::gc::tagged_gc, T >      Stack_Tagged    ;
 #endif
@@ -26,6 +28,7 @@ namespace stack {
             typedef cds::backoff::yield     backoff_strategy    ;
         };
         typedef cds::stack::Stack< cds::gc::hzp_gc, T, Yield_Traits >         Stack_HP_yield        ;
+        typedef cds::stack::Stack< cds::gc::epoch_gc, T, Yield_Traits >       Stack_Epoch_yield     ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         typedef cds::stack::Stack< cds::gc::tagged_gc, T, Yield_Traits >      Stack_Tagged_yield    ;
 #endif
@@ -34,6 +37,7 @@ namespace stack {
             typedef cds::backoff::pause     backoff_strategy    ;
         };
         typedef cds::stack::Stack< cds::gc::hzp_gc, T, Pause_Traits >         Stack_HP_pause        ;
+        typedef cds::stack::Stack< cds::gc::epoch_gc, T, Pause_Traits >       Stack_Epoch_pause     ;
 #ifdef CDS_DWORD_CAS_SUPPORTED
         typedef cds::stack::Stack< cds::gc::tagged_gc, T, Pause_Traits >      Stack_Tagged_pause    ;
 #endif
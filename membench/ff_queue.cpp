@@ -0,0 +1,124 @@
+/*
+ * In-process producer/consumer benchmark over cds::queue::FastForwardQueue,
+ * the baseline for shm_channel.cpp. Driven by modstream.c; finalize() also
+ * reports the one-way latency measured by ping-pong over two queues.
+ */
+#include <iostream>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include <cds/queue/ffqueue.h>
+
+using namespace std;
+
+#ifndef BENCH_N
+#   define BENCH_N  2000000
+#endif
+#ifndef LATENCY_N
+#   define LATENCY_N  1000000
+#endif
+#ifndef CHANNEL_CAPACITY
+#   define CHANNEL_CAPACITY  8192
+#endif
+
+/* FastForwardQueue uses NULL as the empty cell, so the item i is passed as (void *)(i + 1) */
+typedef cds::queue::FastForwardQueue<void *, CHANNEL_CAPACITY> Queue;
+
+extern double mysecond();
+
+static Queue **queue;
+static int ntasks = 0;
+
+static void *producer(void *arg) {
+  Queue *q = (Queue *) arg;
+  for (long i = 0; i < BENCH_N; i++) {
+    void *v = (void *) (i + 1);
+    while (!q->push(v))
+      ;/* busy wait for free cell */
+  }
+  return NULL;
+}
+
+static void *consumer(void *arg) {
+  Queue *q = (Queue *) arg;
+  for (long i = 0; i < BENCH_N; i++) {
+    void *v;
+    while (!q->pop(v))
+      ;/* busy wait on next element */
+    if ((long) v - 1 != i)
+      cout << "Unexpected value: got " << (long) v - 1 << " while expecting " << i << endl;
+  }
+  return NULL;
+}
+
+static Queue *ping, *pong;
+
+static void *echo(void *) {
+  for (long i = 0; i < LATENCY_N; i++) {
+    void *v;
+    while (!ping->pop(v))
+      ;
+    while (!pong->push(v))
+      ;
+  }
+  return NULL;
+}
+
+/* Ping-pong: the second thread echoes every message back through the second queue */
+static void latency() {
+  ping = new Queue();
+  pong = new Queue();
+
+  pthread_t thread;
+  pthread_create(&thread, NULL, echo, NULL);
+
+  double t = mysecond();
+  for (long i = 0; i < LATENCY_N; i++) {
+    void *v = (void *) (i + 1);
+    while (!ping->push(v))
+      ;
+    while (!pong->pop(v))
+      ;
+  }
+  t = mysecond() - t;
+  pthread_join(thread, NULL);
+
+  printf("One-way latency (ns): %11.4f\n", t * 1.0E9 / LATENCY_N / 2);
+
+  delete ping;
+  delete pong;
+}
+
+void reset() {
+  for (int i = 0; i < ntasks/2; i++) {
+    delete queue[i];
+    queue[i] = new Queue();
+  }
+}
+
+void init(int nthreads) {
+  ntasks = nthreads;
+  queue = new Queue*[ntasks];
+  for (int i = 0; i < ntasks/2; i++)
+    queue[i] = NULL;
+}
+
+void kernel() {
+  pthread_t *threads = new pthread_t[ntasks];
+  for (int i = 0; i < ntasks/2; i++) {
+    pthread_create(&threads[2*i], NULL, producer, queue[i]);
+    pthread_create(&threads[2*i+1], NULL, consumer, queue[i]);
+  }
+  for (int i = 0; i < 2*(ntasks/2); i++)
+    pthread_join(threads[i], NULL);
+  delete [] threads;
+}
+
+void finalize() {
+  for (int i = 0; i < ntasks/2; i++)
+    delete queue[i];
+  delete [] queue;
+
+  latency();
+}
@@ -0,0 +1,147 @@
+/*
+ * Cross-process producer/consumer benchmark over cds::queue::shm_channel.
+ *
+ * Each producer/consumer pair runs in two forked processes that attach to the
+ * named shared memory channel created by the parent, so the channel is mapped
+ * at different addresses in every process. Driven by modstream.c; finalize()
+ * also reports the one-way latency measured by ping-pong over two channels.
+ * Compare with ff_queue.cpp, the same benchmark over the in-process FastForwardQueue.
+ */
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+
+#include <cds/queue/shm_channel.h>
+
+using namespace std;
+
+#ifndef BENCH_N
+#   define BENCH_N  2000000
+#endif
+#ifndef LATENCY_N
+#   define LATENCY_N  1000000
+#endif
+#ifndef CHANNEL_CAPACITY
+#   define CHANNEL_CAPACITY  8192
+#endif
+
+typedef cds::queue::shm_channel<long> Channel;
+
+extern double mysecond();
+
+static Channel **channel;
+static char (*names)[64];
+static int ntasks = 0;
+
+static void producer(const char *name) {
+  Channel q(name);
+  for (long i = 0; i < BENCH_N; i++)
+    while (!q.push(i))
+      ;/* busy wait for free cell */
+}
+
+static void consumer(const char *name) {
+  Channel q(name);
+  for (long i = 0; i < BENCH_N; i++) {
+    long j;
+    while (!q.pop(j))
+      ;/* busy wait on next element */
+    if (i != j)
+      cout << "Unexpected value: got " << j << " while expecting " << i << endl;
+  }
+}
+
+static pid_t spawn(void (*fn)(const char *), const char *name) {
+  pid_t pid = fork();
+  if (pid == -1) {
+    perror("fork");
+    exit(1);
+  }
+  if (pid == 0) {
+    fn(name);
+    _exit(0);
+  }
+  return pid;
+}
+
+static void wait_all(pid_t *pids, int n) {
+  for (int i = 0; i < n; i++) {
+    int status;
+    waitpid(pids[i], &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      cout << "Child process " << pids[i] << " failed" << endl;
+  }
+}
+
+/* Ping-pong: the child echoes every message back through the second channel */
+static void latency() {
+  char ping_name[64], pong_name[64];
+  sprintf(ping_name, "/membench_shm_ping_%d", (int) getpid());
+  sprintf(pong_name, "/membench_shm_pong_%d", (int) getpid());
+  Channel ping(ping_name, CHANNEL_CAPACITY);
+  Channel pong(pong_name, CHANNEL_CAPACITY);
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    Channel in(ping_name);
+    Channel out(pong_name);
+    for (long i = 0; i < LATENCY_N; i++) {
+      long v;
+      while (!in.pop(v))
+        ;
+      while (!out.push(v))
+        ;
+    }
+    _exit(0);
+  }
+
+  double t = mysecond();
+  for (long i = 0; i < LATENCY_N; i++) {
+    long v;
+    while (!ping.push(i))
+      ;
+    while (!pong.pop(v))
+      ;
+  }
+  t = mysecond() - t;
+  wait_all(&pid, 1);
+
+  printf("One-way latency (ns): %11.4f\n", t * 1.0E9 / LATENCY_N / 2);
+}
+
+void reset() {
+  for (int i = 0; i < ntasks/2; i++) {
+    delete channel[i];
+    channel[i] = new Channel(names[i], CHANNEL_CAPACITY);
+  }
+}
+
+void init(int nthreads) {
+  ntasks = nthreads;
+  channel = new Channel*[ntasks];
+  names = new char[ntasks][64];
+  for (int i = 0; i < ntasks/2; i++) {
+    channel[i] = NULL;
+    sprintf(names[i], "/membench_shm_%d_%d", (int) getpid(), i);
+  }
+}
+
+void kernel() {
+  pid_t *pids = new pid_t[ntasks];
+  for (int i = 0; i < ntasks/2; i++) {
+    pids[2*i] = spawn(producer, names[i]);
+    pids[2*i+1] = spawn(consumer, names[i]);
+  }
+  wait_all(pids, 2*(ntasks/2));
+  delete [] pids;
+}
+
+void finalize() {
+  for (int i = 0; i < ntasks/2; i++)
+    delete channel[i];
+  delete [] channel;
+  delete [] names;
+
+  latency();
+}